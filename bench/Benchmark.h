@@ -0,0 +1,158 @@
+#ifndef _OPTPARSE_BENCH_BENCHMARK_H
+#define _OPTPARSE_BENCH_BENCHMARK_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+/**
+ * Minimal self-contained benchmark harness.
+ *
+ * Each benchmark is a function object which performs one operation.
+ * `run` calls it repeatedly until the minimum time elapses and reports
+ * the average time and number of heap allocations per operation.
+ * `runMemory` reports the heap memory held by an object instead.
+ * Allocations are counted by the global `operator new` replaced in
+ * `main.cpp`.
+ */
+namespace bench {
+
+	/**
+	 * Number of the calls of the global `operator new`.
+	 * Atomic because the batch benchmarks allocate in worker threads.
+	 */
+	extern std::atomic< size_t > allocationCount;
+
+	/**
+	 * Number of the bytes allocated by the global `operator new` and not
+	 * yet released.
+	 */
+	extern std::atomic< size_t > liveBytes;
+
+	/** Keeps a given value from being optimized away. */
+	template < typename T >
+	inline void keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "g"(&value) : "memory");
+#else
+		static const void* volatile sink;
+		sink = &value;
+#endif
+	}
+
+	/** Runner of benchmarks. */
+	class Runner {
+	private:
+		/** Only benchmarks whose names contain this are run. */
+		std::string filter;
+
+		/** Minimum time in seconds spent by each benchmark. */
+		double minTime;
+	public:
+		/**
+		 * Initializes with command line arguments.
+		 *
+		 * Accepts the following arguments,
+		 *  - `--filter=SUBSTRING`: runs only matching benchmarks
+		 *  - `--min-time=SECONDS`: minimum time of each benchmark
+		 */
+		Runner(int argc, char** argv) : minTime(0.2) {
+			for (int i = 1; i < argc; ++i) {
+				if (std::strncmp(argv[i], "--filter=", 9) == 0) {
+					this->filter = argv[i] + 9;
+				} else if (std::strncmp(argv[i], "--min-time=", 11) == 0) {
+					this->minTime = std::atof(argv[i] + 11);
+				}
+			}
+			std::printf("%-48s %14s %12s %12s\n",
+						"benchmark", "iterations", "ns/op", "allocs/op");
+		}
+
+		/**
+		 * Runs a given benchmark.
+		 *
+		 * @param name
+		 *     Name of the benchmark.
+		 * @param f
+		 *     Function object which performs one operation.
+		 */
+		template < typename F >
+		void run(const std::string& name, F f) {
+			if (name.find(this->filter) == std::string::npos) {
+				return;
+			}
+			// warms up and grows the iterations until a measurable time
+			size_t iterations = 1;
+			double elapsed = measure(f, iterations);
+			while (elapsed < this->minTime) {
+				const double scale = elapsed > 0
+					? 1.2 * this->minTime / elapsed : 10.0;
+				iterations = static_cast< size_t >(
+					iterations * (scale < 10.0 ? scale : 10.0)) + 1;
+				elapsed = measure(f, iterations);
+			}
+			const size_t allocations = allocationCount.load();
+			measure(f, 1);
+			const size_t allocationsPerOp =
+				allocationCount.load() - allocations;
+			std::printf("%-48s %14lu %12.1f %12lu\n",
+						name.c_str(),
+						static_cast< unsigned long >(iterations),
+						elapsed * 1e9 / iterations,
+						static_cast< unsigned long >(allocationsPerOp));
+		}
+
+		/**
+		 * Measures the memory held by an object built by a given function.
+		 *
+		 * Reports the bytes allocated by the global `operator new` and
+		 * not released while the object lives, in total and per item.
+		 *
+		 * @param name
+		 *     Name of the benchmark.
+		 * @param items
+		 *     Number of the items which the object has; e.g., options.
+		 * @param build
+		 *     Function object which builds the object and returns
+		 *     a `std::unique_ptr` which owns it.
+		 */
+		template < typename F >
+		void runMemory(const std::string& name, size_t items, F build) {
+			if (name.find(this->filter) == std::string::npos) {
+				return;
+			}
+			const size_t before = liveBytes.load();
+			auto pObject = build();
+			const size_t bytes = liveBytes.load() - before;
+			keep(*pObject);
+			std::printf("%-48s %14lu bytes %12.1f bytes/item\n",
+						name.c_str(),
+						static_cast< unsigned long >(bytes),
+						static_cast< double >(bytes) / items);
+		}
+	private:
+		/**
+		 * Measures the time spent by given iterations.
+		 *
+		 * @return
+		 *     Elapsed time in seconds.
+		 */
+		template < typename F >
+		static double measure(F& f, size_t iterations) {
+			typedef std::chrono::steady_clock Clock;
+			const Clock::time_point start = Clock::now();
+			for (size_t i = 0; i < iterations; ++i) {
+				f();
+			}
+			return std::chrono::duration< double >(
+				Clock::now() - start).count();
+		}
+	};
+
+}
+
+#endif
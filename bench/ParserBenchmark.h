@@ -0,0 +1,860 @@
+#ifndef _OPTPARSE_BENCH_PARSER_BENCHMARK_H
+#define _OPTPARSE_BENCH_PARSER_BENCHMARK_H
+
+#include "Benchmark.h"
+
+#include "optparse/CachedUsagePrinter.h"
+#include "optparse/DefaultFormatter.h"
+#include "optparse/DefaultUsagePrinter.h"
+#include "optparse/EnumFormatter.h"
+#include "optparse/Executor.h"
+#include "optparse/FastFormatter.h"
+#include "optparse/OptionParserBase.h"
+#include "optparse/ParseObserver.h"
+#include "optparse/ParserSnapshot.h"
+#include "optparse/Transcoder.h"
+#include "optparse/UnitFormatter.h"
+
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace bench {
+
+	/** Enumeration of 8 names converted by the benchmarks. */
+	enum class Level {
+		TRACE, DEBUG, INFO, NOTICE, WARNING, ERROR, CRITICAL, FATAL
+	};
+
+	/** Names of `Level` in the order of `Level`. */
+	static const char* const LEVEL_NAMES[] = {
+		"trace", "debug", "info", "notice", "warning", "error", "critical",
+		"fatal"
+	};
+
+}
+
+namespace optparse {
+
+	/** Names of `bench::Level`. */
+	template <>
+	struct EnumTraits< bench::Level > {
+		static size_t getNames(const EnumName< bench::Level >*& names) {
+			typedef bench::Level Level;
+			static const EnumName< Level > NAMES[] = {
+				{ "trace", Level::TRACE }, { "debug", Level::DEBUG },
+				{ "info", Level::INFO }, { "notice", Level::NOTICE },
+				{ "warning", Level::WARNING }, { "error", Level::ERROR },
+				{ "critical", Level::CRITICAL }, { "fatal", Level::FATAL }
+			};
+			names = NAMES;
+			return sizeof(NAMES) / sizeof(NAMES[0]);
+		}
+	};
+
+}
+
+namespace bench {
+
+	/**
+	 * Benchmarks of `OptionParserBase` for a character type.
+	 *
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename Ch >
+	class ParserBenchmark {
+	private:
+		/** String of `Ch`. */
+		typedef std::basic_string< Ch > String;
+
+		/** Options container. */
+		struct Options {
+			/** Substituted by the int options. */
+			int i;
+
+			/** Substituted by the double options. */
+			double d;
+
+			/** Substituted by the string options. */
+			String s;
+
+			/** Substituted by the flag options. */
+			bool flag;
+
+			/** Appended by the list options. */
+			std::vector< String > list;
+
+			/** Substituted by the commands. */
+			int command;
+
+			/** Initializes with default values. */
+			Options() : i(0), d(0), flag(false), command(0) {}
+		};
+
+		/** Parser under test. */
+		typedef optparse::OptionParserBase<
+			Options, Ch, optparse::DefaultFormatter > Parser;
+
+		/** Command line arguments. */
+		class Args {
+		private:
+			/** Storage of the arguments. */
+			std::vector< String > storage;
+
+			/** Pointers to the arguments. */
+			std::vector< const Ch* > pointers;
+		public:
+			/** Appends a given argument. */
+			void add(const String& arg) {
+				this->storage.push_back(arg);
+			}
+
+			/** Makes the pointers to the arguments. */
+			void seal() {
+				this->pointers.clear();
+				for (size_t i = 0; i < this->storage.size(); ++i) {
+					this->pointers.push_back(this->storage[i].c_str());
+				}
+			}
+
+			/** Returns the number of the arguments. */
+			int argc() const {
+				return static_cast< int >(this->pointers.size());
+			}
+
+			/** Returns the arguments. */
+			const Ch* const* argv() const {
+				return this->pointers.data();
+			}
+		};
+
+		/** Widens a given ASCII string. */
+		static String widen(const std::string& str) {
+			return String(str.begin(), str.end());
+		}
+
+		/** Returns the label of the `i`-th option. */
+		static String label(size_t i) {
+			std::ostringstream out;
+			out << "--option" << i;
+			return widen(out.str());
+		}
+
+		/**
+		 * Configures a parser with `n` options.
+		 *
+		 * Every fourth option is an int, a double, a string and a flag
+		 * option, respectively.
+		 */
+		template < typename P >
+		static void configure(P& parser, size_t n) {
+			for (size_t i = 0; i < n; ++i) {
+				switch (i % 4) {
+				case 0:
+					parser.addOption(label(i), widen("N"),
+									 widen("int option"), &Options::i);
+					break;
+				case 1:
+					parser.addOption(label(i), widen("R"),
+									 widen("double option"), &Options::d);
+					break;
+				case 2:
+					parser.addOption(label(i), widen("STR"),
+									 widen("string option"), &Options::s);
+					break;
+				default:
+					parser.addOption(label(i), widen("flag option"),
+									 &Options::flag, true);
+					break;
+				}
+			}
+		}
+
+		/**
+		 * Makes command line arguments which specify `n` options.
+		 *
+		 * @param flags
+		 *     Whether only the flag options are specified.
+		 */
+		static Args makeArgs(size_t optionCount, size_t n, bool flags) {
+			Args args;
+			args.add(widen("bench.exe"));
+			for (size_t j = 0; j < n; ++j) {
+				const size_t i = flags
+					? (4 * j + 3) % optionCount : j % optionCount;
+				args.add(label(i));
+				switch (i % 4) {
+				case 0:
+					args.add(widen("12345"));
+					break;
+				case 1:
+					args.add(widen("3.14159"));
+					break;
+				case 2:
+					args.add(widen("value"));
+					break;
+				default:
+					break;
+				}
+			}
+			args.seal();
+			return args;
+		}
+	public:
+		/**
+		 * Runs the benchmarks.
+		 *
+		 * @param runner
+		 *     Runner of the benchmarks.
+		 * @param prefix
+		 *     Prefix of the benchmark names; e.g., "char".
+		 */
+		static void run(Runner& runner, const std::string& prefix) {
+			runConstruction(runner, prefix, 10);
+			runConstruction(runner, prefix, 200);
+			runMemory(runner, prefix, 2000);
+			runSnapshot(runner, prefix);
+			runParse(runner, prefix);
+			runTranscoding(runner, prefix);
+			runObserved(runner, prefix);
+			runFlags(runner, prefix);
+			runLists(runner, prefix);
+			runCommands(runner, prefix);
+			runFailingParse(runner, prefix);
+			runSuggestions(runner, prefix);
+			runCompletion(runner, prefix);
+			runBatch(runner, prefix);
+			runParallel(runner, prefix);
+			runParseLine(runner, prefix);
+			runFormat(runner, prefix);
+			runUsage(runner, prefix);
+		}
+	private:
+		/** Measures the construction of a parser with `n` options. */
+		static void runConstruction(Runner& runner,
+									const std::string& prefix,
+									size_t n)
+		{
+			std::ostringstream name;
+			name << prefix << "/construct/" << n;
+			runner.run(name.str(), [n]() {
+				Parser parser(widen("benchmark"));
+				configure(parser, n);
+				keep(parser);
+			});
+			name << "/compiled";
+			runner.run(name.str(), [n]() {
+				Parser parser(widen("benchmark"));
+				configure(parser, n);
+				parser.compile();
+				keep(parser);
+			});
+			name.str("");
+			name << prefix << "/construct/" << n << "/arena";
+			runner.run(name.str(), [n]() {
+				optparse::Arena arena(64 * 1024);
+				Parser parser(widen("benchmark"), arena);
+				configure(parser, n);
+				keep(parser);
+			});
+		}
+
+		/**
+		 * Measures the memory held by a parser with `n` options.
+		 *
+		 * The options made by `configure` share their value names and
+		 * descriptions. The other parser gives every option a long label
+		 * and a description of its own, and shares only the value names.
+		 */
+		static void runMemory(Runner& runner,
+							  const std::string& prefix,
+							  size_t n)
+		{
+			std::ostringstream name;
+			name << prefix << "/memory/" << n;
+			runner.runMemory(name.str(), n, [n]() {
+				std::unique_ptr< Parser > pParser(
+					new Parser(widen("benchmark")));
+				configure(*pParser, n);
+				return pParser;
+			});
+			name << "/unique";
+			runner.runMemory(name.str(), n, [n]() {
+				std::unique_ptr< Parser > pParser(
+					new Parser(widen("benchmark")));
+				for (size_t i = 0; i < n; ++i) {
+					std::ostringstream label;
+					label << "--long-option-label-" << i;
+					std::ostringstream description;
+					description << "description of the option " << i
+								<< " shown in the usage";
+					pParser->addOption(widen(label.str()),
+									   widen(i % 2 == 0 ? "N" : "COUNT"),
+									   widen(description.str()),
+									   &Options::i);
+				}
+				return pParser;
+			});
+		}
+
+		/** Parser with a snapshot. */
+		typedef optparse::SnapshotOptionParser<
+			Options, Ch, optparse::DefaultFormatter > SnapshotParser;
+
+		/** Binds the options made by `configure` to a given parser. */
+		static void bind(SnapshotParser& parser,
+						 const std::vector< String >& labels)
+		{
+			for (size_t i = 0; i < labels.size(); ++i) {
+				switch (i % 4) {
+				case 0:
+					parser.bindOption(labels[i], &Options::i);
+					break;
+				case 1:
+					parser.bindOption(labels[i], &Options::d);
+					break;
+				case 2:
+					parser.bindOption(labels[i], &Options::s);
+					break;
+				default:
+					parser.bindFlag(labels[i], &Options::flag);
+					break;
+				}
+			}
+		}
+
+		/**
+		 * Measures the startup with a snapshot of 200 options, and parsing
+		 * with it.
+		 */
+		static void runSnapshot(Runner& runner, const std::string& prefix) {
+			const size_t N = 200;
+			Parser parser(widen("benchmark"));
+			configure(parser, N);
+			const optparse::ParserSnapshotBuilder< Ch > builder(parser);
+			const optparse::ParserSnapshot< Ch > snapshot =
+				builder.getSnapshot();
+			std::vector< String > labels;
+			for (size_t i = 0; i < N; ++i) {
+				labels.push_back(label(i));
+			}
+			runner.run(prefix + "/construct/200/snapshot", [&]() {
+				SnapshotParser snapshotParser(snapshot);
+				bind(snapshotParser, labels);
+				keep(snapshotParser);
+			});
+			SnapshotParser snapshotParser(snapshot);
+			bind(snapshotParser, labels);
+			const Args args = makeArgs(N, 100, false);
+			runner.run(prefix + "/parse/snapshot/long/values", [&]() {
+				Options options;
+				snapshotParser.parseInto(options, args.argc(), args.argv());
+				keep(options);
+			});
+		}
+
+		/** Measures parsing. */
+		static void runParse(Runner& runner, const std::string& prefix) {
+			Parser parser(widen("benchmark"));
+			configure(parser, 200);
+			const Args shortFlags = makeArgs(200, 8, true);
+			const Args shortValues = makeArgs(200, 8, false);
+			const Args longFlags = makeArgs(200, 100, true);
+			const Args longValues = makeArgs(200, 100, false);
+			for (int compiled = 0; compiled < 2; ++compiled) {
+				if (compiled) {
+					parser.compile();
+				}
+				const std::string base =
+					prefix + (compiled ? "/parse/compiled/" : "/parse/");
+				runParse(runner, base + "short/flags", parser, shortFlags);
+				runParse(runner, base + "short/values", parser, shortValues);
+				runParse(runner, base + "long/flags", parser, longFlags);
+				runParse(runner, base + "long/values", parser, longValues);
+			}
+			runner.run(prefix + "/parse/lazy/long/values", [&]() {
+				typename Parser::Matches matches;
+				parser.tryParseLazy(
+					longValues.argc(), longValues.argv(), matches);
+				keep(matches);
+			});
+		}
+
+		/** Measures parsing given arguments. */
+		template < typename P >
+		static void runParse(Runner& runner,
+							 const std::string& name,
+							 const P& parser,
+							 const Args& args)
+		{
+			runner.run(name, [&]() {
+				Options options;
+				String programName;
+				parser.parseInto(
+					options, args.argc(), args.argv(), programName);
+				keep(options);
+			});
+		}
+
+		/** Transcodes a given string by `Transcoder`. */
+		template < typename To, typename From >
+		static std::basic_string< To > transcode(const From* str) {
+			typedef optparse::Transcoder< From, To > Transcoder;
+			const size_t size = std::char_traits< From >::length(str);
+			std::basic_string< To > out(Transcoder::getMaxSize(size) + 1, To());
+			out.resize(Transcoder::transcode(str, str + size, &out[0]));
+			return out;
+		}
+
+		/**
+		 * Measures parsing arguments of the other character type transcoded
+		 * as a whole beforehand and by `parseTranscoded`.
+		 */
+		static void runTranscoding(Runner& runner, const std::string& prefix) {
+			typedef typename std::conditional<
+				std::is_same< Ch, char >::value, wchar_t, char >::type OtherCh;
+			Parser parser(widen("benchmark"));
+			configure(parser, 200);
+			parser.compile();
+			const Args args = makeArgs(200, 100, false);
+			std::vector< std::basic_string< OtherCh > > storage;
+			for (int i = 0; i < args.argc(); ++i) {
+				storage.push_back(transcode< OtherCh >(args.argv()[i]));
+			}
+			std::vector< const OtherCh* > others;
+			for (size_t i = 0; i < storage.size(); ++i) {
+				others.push_back(storage[i].c_str());
+			}
+			const int argc = static_cast< int >(others.size());
+			runner.run(prefix + "/parse/transcode/whole", [&]() {
+				std::vector< String > converted;
+				converted.reserve(others.size());
+				std::vector< const Ch* > pointers;
+				for (size_t i = 0; i < others.size(); ++i) {
+					converted.push_back(transcode< Ch >(others[i]));
+					pointers.push_back(converted.back().c_str());
+				}
+				Options options;
+				String programName;
+				parser.parseInto(options, argc, &pointers[0], programName);
+				keep(options);
+			});
+			runner.run(prefix + "/parse/transcode/on-the-fly", [&]() {
+				Options options;
+				String programName;
+				parser.tryParseTranscoded(
+					options, argc, &others[0], programName);
+				keep(options);
+			});
+		}
+
+		/**
+		 * Measures parsing 100 values of 200 options while recording
+		 * statistics; compare with "/parse/compiled/long/values".
+		 */
+		static void runObserved(Runner& runner, const std::string& prefix) {
+			typedef optparse::OptionParserBase<
+				Options,
+				Ch,
+				optparse::DefaultFormatter,
+				optparse::StatisticsObserver > ObservedParser;
+			ObservedParser parser(widen("benchmark"));
+			configure(parser, 200);
+			parser.compile();
+			optparse::ParseStatistics statistics(parser);
+			parser.setObserver(optparse::StatisticsObserver(statistics));
+			runParse(runner, prefix + "/parse/observed/long/values", parser,
+					 makeArgs(200, 100, false));
+			keep(statistics.getParseCount());
+		}
+
+		/**
+		 * Measures parsing 80 flags added by `addOption` and by
+		 * `addFlag`.
+		 */
+		static void runFlags(Runner& runner, const std::string& prefix) {
+			const size_t N = 80;
+			Parser options(widen("benchmark"));
+			Parser flags(widen("benchmark"));
+			Args args;
+			args.add(widen("bench.exe"));
+			for (size_t i = 0; i < N; ++i) {
+				options.addOption(label(i), widen("flag option"),
+								  &Options::flag, true);
+				flags.addFlag(label(i), widen("flag option"), &Options::flag);
+				args.add(label(i));
+			}
+			args.seal();
+			options.compile();
+			flags.compile();
+			runParse(runner, prefix + "/parse/flags/80/option", options, args);
+			runParse(runner, prefix + "/parse/flags/80/flag", flags, args);
+		}
+
+		/** Appends a given value to the list. */
+		static void appendList(Options& options, const String& value) {
+			options.list.push_back(value);
+		}
+
+		/** Adds 2000 options like "--cache-size" to a given parser. */
+		static void configureWords(Parser& parser) {
+			// labels made of 50 x 40 distinct words
+			static const char* const VERBS[] = {
+				"add", "allow", "bind", "build", "cache", "check", "clean",
+				"copy", "debug", "defer", "deny", "drop", "dump", "emit",
+				"enable", "fetch", "filter", "flush", "force", "format",
+				"group", "hash", "ignore", "index", "keep", "limit", "link",
+				"load", "lock", "log", "map", "merge", "mount", "no",
+				"pack", "parse", "patch", "print", "pull", "push", "quote",
+				"read", "retry", "scan", "seed", "show", "skip", "sort",
+				"trace", "write"
+			};
+			static const char* const NOUNS[] = {
+				"address", "agent", "archive", "backend", "branch",
+				"buffer", "channel", "color", "commit", "config", "cookie",
+				"depth", "device", "driver", "editor", "encoding", "entry",
+				"factor", "filter", "format", "graph", "header", "host",
+				"image", "journal", "kernel", "layout", "locale", "module",
+				"object", "output", "packet", "policy", "prefix", "quota",
+				"remote", "schema", "socket", "tag", "timeout"
+			};
+			for (size_t i = 0; i < 50; ++i) {
+				for (size_t j = 0; j < 40; ++j) {
+					const String label = widen(
+						std::string("--") + VERBS[i] + "-" + NOUNS[j]);
+					parser.addOption(label, widen("N"), widen("option"),
+									 &Options::i);
+				}
+			}
+		}
+
+		/**
+		 * Measures suggestions for a misspelled label among 2000 labels
+		 * with and without the index built by `compile`.
+		 */
+		static void runSuggestions(Runner& runner, const std::string& prefix) {
+			Parser linear(widen("benchmark"));
+			Parser indexed(widen("benchmark"));
+			configureWords(linear);
+			configureWords(indexed);
+			indexed.compile();
+			const String unknown = widen("--fecth-remtoe");
+			runner.run(prefix + "/suggest/2000/linear", [&]() {
+				std::vector< String > suggestions;
+				linear.suggestLabels(unknown, suggestions);
+				keep(suggestions);
+			});
+			runner.run(prefix + "/suggest/2000/indexed", [&]() {
+				std::vector< String > suggestions;
+				indexed.suggestLabels(unknown, suggestions);
+				keep(suggestions);
+			});
+		}
+
+		/**
+		 * Measures completing a prefix of labels among 2000 labels by
+		 * scanning every option and by `complete`.
+		 */
+		static void runCompletion(Runner& runner, const std::string& prefix) {
+			typedef typename Parser::Completion Completion;
+			Parser parser(widen("benchmark"));
+			configureWords(parser);
+			parser.compile();
+			const String word = widen("--fetch-");
+			runner.run(prefix + "/complete/2000/linear", [&]() {
+				std::vector< Completion > completions;
+				for (size_t i = 0; i < parser.getOptionCount(); ++i) {
+					const optparse::OptionSpec< Ch >& option =
+						parser.getOption(i);
+					if (option.getLabel().compare(0, word.size(), word) == 0) {
+						completions.push_back(
+							Completion(Completion::OPTION,
+									   option.getLabel(),
+									   option.getDescription()));
+					}
+				}
+				keep(completions);
+			});
+			const String program = widen("bench.exe");
+			const Ch* const ARGS[] = { program.c_str(), word.c_str() };
+			runner.run(prefix + "/complete/2000/indexed", [&]() {
+				std::vector< Completion > completions;
+				parser.complete(2, ARGS, completions);
+				keep(completions);
+			});
+		}
+
+		/**
+		 * Measures parsing 200 values appended by a function option and by
+		 * a list option.
+		 */
+		static void runLists(Runner& runner, const std::string& prefix) {
+			Parser function(widen("benchmark"));
+			function.addOption(
+				widen("-I"), widen("DIR"), widen("include"), &appendList);
+			Parser list(widen("benchmark"));
+			list.addListOption(
+				widen("-I"), widen("DIR"), widen("include"), &Options::list);
+			Args args;
+			args.add(widen("bench.exe"));
+			for (size_t i = 0; i < 200; ++i) {
+				args.add(widen("-I"));
+				args.add(label(i));
+			}
+			args.seal();
+			runParse(runner, prefix + "/parse/list/200/function",
+					 function, args);
+			runParse(runner, prefix + "/parse/list/200/list", list, args);
+		}
+
+		/** Configures the parser of a command with 10 options. */
+		static void configureCommand(Parser& parser) {
+			configure(parser, 10);
+		}
+
+		/**
+		 * Measures building 40 parsers of sub-commands at once, and
+		 * parsing with 40 commands of which only the selected one is built.
+		 */
+		static void runCommands(Runner& runner, const std::string& prefix) {
+			const int N = 40;
+			runner.run(prefix + "/commands/40/eager", [N]() {
+				std::vector< std::unique_ptr< Parser > > parsers;
+				for (int i = 0; i < N; ++i) {
+					parsers.emplace_back(new Parser(widen("command")));
+					configureCommand(*parsers.back());
+				}
+				keep(parsers);
+			});
+			Args args;
+			args.add(widen("bench.exe"));
+			args.add(widen("command7"));
+			args.add(label(0));
+			args.add(widen("12345"));
+			args.seal();
+			runner.run(prefix + "/commands/40/lazy", [&]() {
+				Parser parser(widen("benchmark"));
+				for (int i = 0; i < N; ++i) {
+					std::ostringstream name;
+					name << "command" << i;
+					parser.addCommand(widen(name.str()), widen("command"),
+									  &Options::command, i,
+									  &configureCommand);
+				}
+				Options options;
+				String programName;
+				parser.parseInto(
+					options, args.argc(), args.argv(), programName);
+				keep(options);
+			});
+		}
+
+		/** Measures failing parsing. */
+		static void runFailingParse(Runner& runner,
+									const std::string& prefix)
+		{
+			Parser parser(widen("benchmark"));
+			configure(parser, 200);
+			parser.compile();
+			Args args;
+			args.add(widen("bench.exe"));
+			args.add(label(0));
+			args.add(widen("not-a-number"));
+			args.seal();
+			runner.run(prefix + "/parse/fail/exception", [&]() {
+				Options options;
+				String programName;
+				try {
+					parser.parseInto(
+						options, args.argc(), args.argv(), programName);
+				} catch (optparse::BadValue< Ch >& ex) {
+					keep(ex);
+				}
+			});
+			runner.run(prefix + "/parse/fail/result", [&]() {
+				Options options;
+				String programName;
+				keep(parser.tryParseInto(
+					options, args.argc(), args.argv(), programName));
+			});
+		}
+
+		/** Measures parsing 1000 command lines at once. */
+		static void runBatch(Runner& runner, const std::string& prefix) {
+			typedef optparse::ParseResult< Ch > ParseResult;
+			Parser parser(widen("benchmark"));
+			configure(parser, 200);
+			parser.compile();
+			const Args args = makeArgs(200, 8, false);
+			const size_t N = 1000;
+			const std::vector< optparse::ArgvSpan< Ch > > spans(
+				N, optparse::ArgvSpan< Ch >(args.argc(), args.argv()));
+			std::vector< Options > options(N);
+			std::vector< ParseResult > results(N);
+			runner.run(prefix + "/batch/1000/serial", [&]() {
+				parser.tryParseBatch(spans.begin(), spans.end(),
+									 options.begin(), results.begin());
+				keep(results);
+			});
+			const optparse::ThreadExecutor executor;
+			runner.run(prefix + "/batch/1000/threads", [&]() {
+				parser.tryParseBatch(spans.begin(), spans.end(),
+									 options.begin(), results.begin(),
+									 executor);
+				keep(results);
+			});
+		}
+
+		/** Formatter which waits 50us as if it resolved a host name. */
+		struct SlowFormat {
+			int operator ()(const optparse::StringView< Ch >& value) const {
+				std::this_thread::sleep_for(std::chrono::microseconds(50));
+				return static_cast< int >(value.size());
+			}
+		};
+
+		/**
+		 * Measures parsing 32 values of slow independent options serially
+		 * and with threads.
+		 */
+		static void runParallel(Runner& runner, const std::string& prefix) {
+			const size_t N = 32;
+			Parser parser(widen("benchmark"));
+			Args args;
+			args.add(widen("bench.exe"));
+			for (size_t i = 0; i < N; ++i) {
+				parser.addOption(label(i), widen("HOST"), widen("host"),
+								 &Options::i, SlowFormat());
+				parser.setIndependent(label(i));
+				args.add(label(i));
+				args.add(widen("example.com"));
+			}
+			args.seal();
+			parser.compile();
+			runner.run(prefix + "/parse/slow/32/serial", [&]() {
+				Options options;
+				String programName;
+				parser.tryParseInto(
+					options, args.argc(), args.argv(), programName);
+				keep(options);
+			});
+			const optparse::ThreadExecutor executor(8);
+			runner.run(prefix + "/parse/slow/32/parallel", [&]() {
+				Options options;
+				parser.tryParseParallel(
+					options, args.argc(), args.argv(), executor);
+				keep(options);
+			});
+		}
+
+		/**
+		 * Measures parsing a command line string directly and through
+		 * splitting it into `argv`.
+		 */
+		static void runParseLine(Runner& runner, const std::string& prefix) {
+			Parser parser(widen("benchmark"));
+			configure(parser, 200);
+			parser.compile();
+			const String line = widen(
+				"--option0 12345 --option1 3.14159 --option2 'a value' "
+				"--option3 --option4 678 --option5 2.5 --option6 \"x y\"");
+			String buffer;
+			runner.run(prefix + "/parse/line/direct", [&]() {
+				Options options;
+				buffer = line;
+				parser.parseLine(options, buffer);
+				keep(options);
+			});
+			runner.run(prefix + "/parse/line/split", [&]() {
+				Options options;
+				buffer = line;
+				Ch* first = &buffer[0];
+				optparse::CommandLineTokenizer< Ch > tokenizer(
+					first, first + buffer.size());
+				std::vector< String > tokens(1, widen("bench.exe"));
+				optparse::StringView< Ch > token;
+				while (tokenizer.next(token)) {
+					tokens.push_back(token.str());
+				}
+				std::vector< const Ch* > argv;
+				for (size_t i = 0; i < tokens.size(); ++i) {
+					argv.push_back(tokens[i].c_str());
+				}
+				String programName;
+				parser.parseInto(options, static_cast< int >(argv.size()),
+								 argv.data(), programName);
+				keep(options);
+			});
+		}
+
+		/** Measures the numeric conversion. */
+		static void runFormat(Runner& runner, const std::string& prefix) {
+			const String intValue = widen("-1234567");
+			const String doubleValue = widen("3.14159265");
+			runner.run(prefix + "/format/default/int", [&]() {
+				keep(optparse::DefaultFormatter< int, Ch >()(intValue));
+			});
+			runner.run(prefix + "/format/default/double", [&]() {
+				keep(optparse::DefaultFormatter< double, Ch >()(doubleValue));
+			});
+			runner.run(prefix + "/format/fast/int", [&]() {
+				keep(optparse::FastFormatter< int, Ch >()(intValue));
+			});
+			runner.run(prefix + "/format/fast/double", [&]() {
+				keep(optparse::FastFormatter< double, Ch >()(doubleValue));
+			});
+			// the last of 8 names
+			const String enumValue = widen("fatal");
+			std::vector< String > levelNames;
+			for (size_t i = 0; i < 8; ++i) {
+				levelNames.push_back(widen(LEVEL_NAMES[i]));
+			}
+			runner.run(prefix + "/format/enum/chain", [&]() {
+				Level level = Level::TRACE;
+				for (size_t i = 0; i < levelNames.size(); ++i) {
+					if (enumValue == levelNames[i]) {
+						level = static_cast< Level >(i);
+						break;
+					}
+				}
+				keep(level);
+			});
+			runner.run(prefix + "/format/enum/table", [&]() {
+				keep(optparse::DefaultFormatter< Level, Ch >()(enumValue));
+			});
+			const String durationValue = widen("1500ms");
+			runner.run(prefix + "/format/duration", [&]() {
+				keep(optparse::DefaultFormatter<
+					std::chrono::microseconds, Ch >()(durationValue).count());
+			});
+			const String sizeValue = widen("64MiB");
+			runner.run(prefix + "/format/byte-size", [&]() {
+				keep(optparse::DefaultFormatter< optparse::ByteSize, Ch >()(
+					sizeValue).getBytes());
+			});
+		}
+
+		/** Measures printing usage. */
+		static void runUsage(Runner& runner, const std::string& prefix) {
+			Parser parser(widen("benchmark"));
+			configure(parser, 200);
+			runner.run(prefix + "/usage/200", [&]() {
+				std::basic_ostringstream< Ch > out;
+				optparse::DefaultUsagePrinter< Ch >(out).printUsage(parser);
+				keep(out);
+			});
+			optparse::CachedUsagePrinter< Ch > printer;
+			runner.run(prefix + "/usage/200/cached", [&]() {
+				keep(printer.getUsage(parser));
+			});
+		}
+	};
+
+}
+
+#endif
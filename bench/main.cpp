@@ -0,0 +1,82 @@
+#include "Benchmark.h"
+#include "ParserBenchmark.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// keeps GCC from inlining the replaced operators into their callers and
+// then mistaking `free` for a mismatch of `operator new`
+#if defined(__GNUC__) || defined(__clang__)
+#define OPTPARSE_BENCH_NOINLINE __attribute__((noinline))
+#else
+#define OPTPARSE_BENCH_NOINLINE
+#endif
+
+std::atomic< size_t > bench::allocationCount(0);
+
+std::atomic< size_t > bench::liveBytes(0);
+
+namespace {
+
+	/**
+	 * Size of the header which records the size of a block.
+	 * Keeps the alignment of `std::malloc`.
+	 */
+	const size_t HEADER_SIZE = alignof(std::max_align_t);
+
+}
+
+/** Counts allocations and the allocated bytes. */
+OPTPARSE_BENCH_NOINLINE void* operator new(size_t size) {
+	bench::allocationCount.fetch_add(1, std::memory_order_relaxed);
+	bench::liveBytes.fetch_add(size, std::memory_order_relaxed);
+	char* p = static_cast< char* >(std::malloc(HEADER_SIZE + size));
+	if (p == 0) {
+		throw std::bad_alloc();
+	}
+	*reinterpret_cast< size_t* >(p) = size;
+	return p + HEADER_SIZE;
+}
+
+/** Counts allocations and the allocated bytes. */
+OPTPARSE_BENCH_NOINLINE void* operator new[](size_t size) {
+	return operator new(size);
+}
+
+/** Releases memory allocated by `operator new`. */
+OPTPARSE_BENCH_NOINLINE void operator delete(void* p) noexcept {
+	if (p != 0) {
+		char* block = static_cast< char* >(p) - HEADER_SIZE;
+		bench::liveBytes.fetch_sub(*reinterpret_cast< size_t* >(block),
+								   std::memory_order_relaxed);
+		std::free(block);
+	}
+}
+
+/** Releases memory allocated by `operator new[]`. */
+OPTPARSE_BENCH_NOINLINE void operator delete[](void* p) noexcept {
+	operator delete(p);
+}
+
+/** Releases memory allocated by `operator new`. */
+OPTPARSE_BENCH_NOINLINE void operator delete(void* p, size_t) noexcept {
+	operator delete(p);
+}
+
+/** Releases memory allocated by `operator new[]`. */
+OPTPARSE_BENCH_NOINLINE void operator delete[](void* p, size_t) noexcept {
+	operator delete(p);
+}
+
+/**
+ * Runs the benchmarks.
+ *
+ * Usage: optparse-bench [--filter=SUBSTRING] [--min-time=SECONDS]
+ */
+int main(int argc, char** argv) {
+	bench::Runner runner(argc, argv);
+	bench::ParserBenchmark< char >::run(runner, "char");
+	bench::ParserBenchmark< wchar_t >::run(runner, "wchar_t");
+	return 0;
+}
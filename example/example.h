@@ -3,6 +3,7 @@
 #include "optparse/OptionParserBase.h"
 #include "optparse/optparse.h"
 
+#include <cstring>
 #include <cwchar>
 #include <iostream>
 
@@ -177,6 +178,11 @@ int main(int argc, char** argv) {
 		return 1;
 	} catch (optparse::UnknownOption< Char >& ex) {
 		stdErr << STR("unknown option: ") << ex.getLabel();
+		if (!ex.getSuggestions().empty()) {
+			stdErr << STR(", did you mean ") << ex.getSuggestions()[0]
+				<< STR("?");
+		}
+		stdErr << std::endl;
 		return 1;
 	} catch (optparse::HelpNeeded&) {
 		optparse::DefaultUsagePrinter< Char > printer;
@@ -0,0 +1,295 @@
+#ifndef _OPTPARSE_OPTPARSE_ARENA_H
+#define _OPTPARSE_OPTPARSE_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace optparse {
+
+	/**
+	 * Monotonic memory arena.
+	 *
+	 * Memory is carved out of large blocks by bumping a pointer, and is
+	 * released only when the arena is destroyed or `release` is called.
+	 * An arena sized for all of the allocations needs a single block; i.e.,
+	 * a single allocation and a single free.
+	 * If a block runs out, a new block twice as large as the previous one
+	 * is added.
+	 *
+	 * Objects created by `create` are not destroyed by the arena; their
+	 * owners must call the destructors, e.g., through `ArenaDeleter`.
+	 *
+	 * An arena is not thread-safe.
+	 */
+	class Arena {
+	private:
+		/** Header of a block. */
+		struct Block {
+			/** Previous block. 0 if this is the first block. */
+			Block* prev;
+		};
+
+		/** Strictest alignment of the fundamental types. */
+		static const size_t MAX_ALIGN = alignof(std::max_align_t);
+
+		/** Size of the header of a block rounded up to `MAX_ALIGN`. */
+		static const size_t HEADER_SIZE =
+			(sizeof(Block) + MAX_ALIGN - 1) / MAX_ALIGN * MAX_ALIGN;
+
+		/** Last block. 0 if no block has been allocated. */
+		Block* last;
+
+		/** Next free byte in the last block. */
+		char* next;
+
+		/** End of the last block. */
+		char* end;
+
+		/** Size of the next block to be allocated. */
+		size_t nextBlockSize;
+
+		/** Total number of the bytes allocated from this arena. */
+		size_t usedBytes;
+	public:
+		/**
+		 * Initializes an arena whose first block has a given size.
+		 *
+		 * No memory is allocated until the first allocation.
+		 *
+		 * @param initialSize
+		 *     Size in bytes of the first block.
+		 */
+		explicit Arena(size_t initialSize = 4096)
+			: last(0),
+			  next(0),
+			  end(0),
+			  nextBlockSize(initialSize > 0 ? initialSize : 1),
+			  usedBytes(0) {}
+
+		/** Frees all of the blocks. */
+		~Arena() {
+			this->release();
+		}
+
+		/**
+		 * Allocates memory.
+		 *
+		 * @param size
+		 *     Size in bytes of the memory to be allocated.
+		 * @param align
+		 *     Alignment of the memory. Must be a power of two not greater
+		 *     than `alignof(std::max_align_t)`.
+		 * @return
+		 *     Allocated memory, which lives until this arena is released.
+		 * @throws std::bad_alloc
+		 *     If no memory is available.
+		 */
+		void* allocate(size_t size, size_t align = MAX_ALIGN) {
+			char* p = alignUp(this->next, align);
+			if (this->last == 0 || p + size > this->end) {
+				this->addBlock(size);
+				p = alignUp(this->next, align);
+			}
+			this->next = p + size;
+			this->usedBytes += size;
+			return p;
+		}
+
+		/**
+		 * Creates an object in this arena.
+		 *
+		 * @tparam T
+		 *     Type of the object.
+		 * @param args
+		 *     Arguments given to the constructor of `T`.
+		 * @return
+		 *     Created object.
+		 *     Its destructor must be called before this arena is released.
+		 */
+		template < typename T, typename... Args >
+		T* create(Args&&... args) {
+			void* p = this->allocate(sizeof(T), alignof(T));
+			return new (p) T(std::forward< Args >(args)...);
+		}
+
+		/**
+		 * Frees all of the blocks.
+		 *
+		 * Every memory allocated from this arena becomes invalid.
+		 */
+		void release() {
+			while (this->last != 0) {
+				Block* prev = this->last->prev;
+				::operator delete(this->last);
+				this->last = prev;
+			}
+			this->next = 0;
+			this->end = 0;
+			this->usedBytes = 0;
+		}
+
+		/**
+		 * Returns the total number of the bytes allocated from this arena.
+		 *
+		 * Padding for alignment is not included.
+		 */
+		inline size_t getUsedBytes() const {
+			return this->usedBytes;
+		}
+	private:
+		/** Rounds up a given pointer to a given alignment. */
+		static inline char* alignUp(char* p, size_t align) {
+			const std::uintptr_t addr = reinterpret_cast< std::uintptr_t >(p);
+			return p + ((align - (addr & (align - 1))) & (align - 1));
+		}
+
+		/**
+		 * Adds a block which can hold at least a given number of bytes.
+		 *
+		 * @throws std::bad_alloc
+		 *     If no memory is available.
+		 */
+		void addBlock(size_t size) {
+			size_t blockSize = this->nextBlockSize;
+			while (blockSize < size + MAX_ALIGN) {
+				blockSize *= 2;
+			}
+			void* p = ::operator new(HEADER_SIZE + blockSize);
+			Block* block = static_cast< Block* >(p);
+			block->prev = this->last;
+			this->last = block;
+			this->next = static_cast< char* >(p) + HEADER_SIZE;
+			this->end = this->next + blockSize;
+			this->nextBlockSize = blockSize * 2;
+		}
+
+		/** Copy is not allowed. */
+		Arena(const Arena&) = delete;
+
+		/** Assignment is not allowed. */
+		void operator =(const Arena&) = delete;
+	};
+
+	/**
+	 * Standard allocator backed by an `Arena`.
+	 *
+	 * Falls back to the global `operator new` if no arena is given.
+	 * Deallocation does nothing if an arena is given.
+	 *
+	 * @tparam T
+	 *     Type of an allocated object.
+	 */
+	template < typename T >
+	class ArenaAllocator {
+	public:
+		/** Type of an allocated object. */
+		typedef T value_type;
+
+		/** Arena. 0 if the global `operator new` is used. */
+		Arena* pArena;
+
+		/**
+		 * Initializes an allocator backed by a given arena.
+		 *
+		 * @param pArena
+		 *     Arena which backs the allocator.
+		 *     0 to use the global `operator new`.
+		 */
+		inline ArenaAllocator(Arena* pArena = 0) : pArena(pArena) {}
+
+		/** Converts from an allocator of another type. */
+		template < typename U >
+		inline ArenaAllocator(const ArenaAllocator< U >& other)
+			: pArena(other.pArena) {}
+
+		/** Allocates memory for `n` objects. */
+		T* allocate(size_t n) {
+			if (this->pArena != 0) {
+				return static_cast< T* >(
+					this->pArena->allocate(n * sizeof(T), alignof(T)));
+			}
+			return static_cast< T* >(::operator new(n * sizeof(T)));
+		}
+
+		/** Deallocates memory. */
+		void deallocate(T* p, size_t) {
+			if (this->pArena == 0) {
+				::operator delete(p);
+			}
+		}
+
+		/** Rebinds to another type. Needed by old standard libraries. */
+		template < typename U >
+		struct rebind {
+			typedef ArenaAllocator< U > other;
+		};
+	};
+
+	/** Returns whether two allocators share the same arena. */
+	template < typename T, typename U >
+	inline bool operator ==(const ArenaAllocator< T >& lhs,
+							const ArenaAllocator< U >& rhs)
+	{
+		return lhs.pArena == rhs.pArena;
+	}
+
+	/** Returns whether two allocators have different arenas. */
+	template < typename T, typename U >
+	inline bool operator !=(const ArenaAllocator< T >& lhs,
+							const ArenaAllocator< U >& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	/**
+	 * Deleter for `std::unique_ptr` of an object created either in an
+	 * `Arena` or by the standard `new` operator.
+	 *
+	 * @tparam T
+	 *     Type of the object.
+	 */
+	template < typename T >
+	class ArenaDeleter {
+	private:
+		/** Whether the object is in an arena. */
+		bool inArena;
+	public:
+		/**
+		 * Initializes a deleter.
+		 *
+		 * @param inArena
+		 *     Whether the object is in an arena.
+		 *     `false` if it is allocated by the standard `new` operator.
+		 */
+		inline ArenaDeleter(bool inArena = false) : inArena(inArena) {}
+
+		/** Converts from a deleter of a derived type. */
+		template < typename U >
+		inline ArenaDeleter(const ArenaDeleter< U >& other)
+			: inArena(other.isInArena()) {}
+
+		/** Returns whether the object is in an arena. */
+		inline bool isInArena() const {
+			return this->inArena;
+		}
+
+		/**
+		 * Destroys a given object.
+		 *
+		 * Only calls the destructor if the object is in an arena,
+		 * and the memory is left to the arena.
+		 */
+		void operator ()(T* p) const {
+			if (this->inArena) {
+				p->~T();
+			} else {
+				delete p;
+			}
+		}
+	};
+
+}
+
+#endif
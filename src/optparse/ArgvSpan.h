@@ -0,0 +1,39 @@
+#ifndef _OPTPARSE_OPTPARSE_ARGV_SPAN_H
+#define _OPTPARSE_OPTPARSE_ARGV_SPAN_H
+
+namespace optparse {
+
+	/**
+	 * Command line arguments given as a pair of `argc` and `argv`.
+	 *
+	 * Does not own the arguments.
+	 *
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename Ch >
+	struct ArgvSpan {
+		/** Number of the arguments including the program name. */
+		int argc;
+
+		/** Arguments. First element is the program name. */
+		const Ch* const* argv;
+
+		/** Initializes empty arguments. */
+		inline ArgvSpan() : argc(0), argv(0) {}
+
+		/**
+		 * Initializes with given arguments.
+		 *
+		 * @param argc
+		 *     Number of the arguments including the program name.
+		 * @param argv
+		 *     Arguments. First element must be the program name.
+		 */
+		inline ArgvSpan(int argc, const Ch* const* argv)
+			: argc(argc), argv(argv) {}
+	};
+
+}
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef _OPTPARSE_OPTPARSE_CACHED_USAGE_PRINTER_H
+#define _OPTPARSE_OPTPARSE_CACHED_USAGE_PRINTER_H
+
+#include "optparse/DefaultUsagePrinter.h"
+
+#include <iostream>
+#include <string>
+
+namespace optparse {
+
+	/**
+	 * Usage printer which keeps the usage rendered by `DefaultUsagePrinter`.
+	 *
+	 * The usage is rendered again only if another parser is given, or if
+	 * the generation of the parser (see `OptionParserBase::getGeneration`)
+	 * has changed since the last rendering.
+	 * Otherwise, printing the usage just writes the kept string.
+	 *
+	 * An instance is not thread-safe.
+	 *
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename Ch >
+	class CachedUsagePrinter {
+	public:
+		/** String of `Ch`. */
+		typedef std::basic_string< Ch > String;
+	private:
+		/** Output stream where usage is written. */
+		std::basic_ostream< Ch >& out;
+
+		/** Rendered usage. */
+		String usage;
+
+		/** Parser whose usage is kept. 0 if no usage is kept. */
+		const void* pParser;
+
+		/** Generation of the parser when the usage was rendered. */
+		size_t generation;
+	public:
+		/**
+		 * Initializes an instance associated with a given output stream.
+		 *
+		 * @param out
+		 *     Output stream where usage is written.
+		 *     Standard error by default.
+		 */
+		inline CachedUsagePrinter(
+			std::basic_ostream< Ch >& out =
+				DefaultUsagePrinterTraits< Ch >::defaultOut())
+			: out(out), pParser(0), generation(0) {}
+
+		/**
+		 * Prints the usage of a given option parser.
+		 *
+		 * @tparam Parser
+		 *     Type of the option parser.
+		 *     Must satisfy the requirements of
+		 *     `DefaultUsagePrinter::printUsage`, and have `getGeneration`.
+		 * @param parser
+		 *     Parser whose usage is to be printed.
+		 */
+		template < typename Parser >
+		void printUsage(const Parser& parser) {
+			const String& usage = this->getUsage(parser);
+			this->out.write(
+				usage.data(), static_cast< std::streamsize >(usage.size()));
+			this->out.flush();
+		}
+
+		/**
+		 * Returns the usage of a given option parser.
+		 *
+		 * @tparam Parser
+		 *     See `printUsage`.
+		 * @param parser
+		 *     Parser whose usage is to be obtained.
+		 * @return
+		 *     Usage of `parser`.
+		 *     Valid until the next call of this function or `invalidate`.
+		 */
+		template < typename Parser >
+		const String& getUsage(const Parser& parser) {
+			if (this->pParser != &parser
+				|| this->generation != parser.getGeneration())
+			{
+				this->usage.clear();
+				DefaultUsagePrinter< Ch >::renderUsage(parser, this->usage);
+				this->pParser = &parser;
+				this->generation = parser.getGeneration();
+			}
+			return this->usage;
+		}
+
+		/** Discards the kept usage. */
+		void invalidate() {
+			this->usage.clear();
+			this->pParser = 0;
+			this->generation = 0;
+		}
+
+		/** Returns whether the usage of a given parser is kept and valid. */
+		template < typename Parser >
+		bool isCached(const Parser& parser) const {
+			return this->pParser == &parser
+				&& this->generation == parser.getGeneration();
+		}
+	private:
+		/** Assignment is not allowed. */
+		void operator =(const CachedUsagePrinter&) = delete;
+	};
+
+}
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef _OPTPARSE_OPTPARSE_COMMAND_LINE_TOKENIZER_H
+#define _OPTPARSE_OPTPARSE_COMMAND_LINE_TOKENIZER_H
+
+#include "optparse/StringView.h"
+
+#include <cstddef>
+
+namespace optparse {
+
+	/**
+	 * Tokenizer which splits a command line string into arguments in place.
+	 *
+	 * Follows a subset of the POSIX shell syntax,
+	 *  - Arguments are separated by whitespace (space, tab, CR, LF, VT, FF)
+	 *  - A backslash (`\`) outside quotes escapes the next character
+	 *  - Characters between single quotes (`'`) are taken literally
+	 *  - Characters between double quotes (`"`) are taken literally, except
+	 *    that a backslash escapes a following double quote or backslash
+	 *  - Quoted and unquoted parts next to each other make one argument;
+	 *    e.g., `a"b c"d` is `ab cd`
+	 *
+	 * No variable expansion or globbing is performed.
+	 *
+	 * Quotes and escapes are removed by moving characters toward the
+	 * beginning of the buffer, so every token is a view of the buffer and
+	 * no memory is allocated.
+	 * Tokens are not null-terminated.
+	 *
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename Ch >
+	class CommandLineTokenizer {
+	public:
+		/** Non-owning view of a string of `Ch`. */
+		typedef optparse::StringView< Ch > StringView;
+	private:
+		/** Next character to be read. */
+		Ch* in;
+
+		/** End of the buffer. */
+		Ch* last;
+
+		/** Explanation about a syntax error. 0 if there is no error. */
+		const char* error;
+	public:
+		/**
+		 * Initializes with a given buffer.
+		 *
+		 * @param first
+		 *     Beginning of the command line.
+		 *     Overwritten as tokens are read.
+		 * @param last
+		 *     End of the command line.
+		 */
+		inline CommandLineTokenizer(Ch* first, Ch* last)
+			: in(first), last(last), error(0) {}
+
+		/**
+		 * Reads the next token.
+		 *
+		 * @param[out] token
+		 *     Set to the next token if there is.
+		 *     Valid as long as the buffer.
+		 * @return
+		 *     Whether a token has been read.
+		 *     `false` at the end of the buffer or on a syntax error.
+		 */
+		bool next(StringView& token) {
+			if (this->error != 0) {
+				return false;
+			}
+			while (this->in != this->last && isSpace(*this->in)) {
+				++this->in;
+			}
+			if (this->in == this->last) {
+				return false;
+			}
+			Ch* const start = this->in;
+			Ch* out = this->in;
+			Ch quote = Ch('\0');
+			while (this->in != this->last) {
+				const Ch c = *this->in;
+				if (quote == Ch('\'')) {
+					++this->in;
+					if (c == quote) {
+						quote = Ch('\0');
+					} else {
+						*out++ = c;
+					}
+				} else if (quote == Ch('"')) {
+					++this->in;
+					if (c == quote) {
+						quote = Ch('\0');
+					} else if (c == Ch('\\')
+						&& this->in != this->last
+						&& (*this->in == Ch('"') || *this->in == Ch('\\')))
+					{
+						*out++ = *this->in++;
+					} else {
+						*out++ = c;
+					}
+				} else if (isSpace(c)) {
+					break;
+				} else {
+					++this->in;
+					if (c == Ch('\'') || c == Ch('"')) {
+						quote = c;
+					} else if (c == Ch('\\')) {
+						if (this->in == this->last) {
+							this->error = "unterminated escape";
+							return false;
+						}
+						*out++ = *this->in++;
+					} else {
+						*out++ = c;
+					}
+				}
+			}
+			if (quote != Ch('\0')) {
+				this->error = "unterminated quote";
+				return false;
+			}
+			token = StringView(start, static_cast< size_t >(out - start));
+			return true;
+		}
+
+		/**
+		 * Returns the explanation about a syntax error.
+		 *
+		 * @return
+		 *     Explanation about the syntax error which stopped `next`.
+		 *     0 if there is no error.
+		 */
+		inline const char* getError() const {
+			return this->error;
+		}
+
+		/** Returns whether a given character is whitespace. */
+		static inline bool isSpace(Ch c) {
+			return c == Ch(' ')
+				|| c == Ch('\t')
+				|| c == Ch('\n')
+				|| c == Ch('\r')
+				|| c == Ch('\v')
+				|| c == Ch('\f');
+		}
+	};
+
+}
+
+#endif
@@ -1,19 +1,41 @@
 #ifndef _OPTPARSE_OPTPARSE_DEFAULT_FORMATTER_H
 #define _OPTPARSE_OPTPARSE_DEFAULT_FORMATTER_H
 
+#include "optparse/EnumFormatter.h"
 #include "optparse/OptionParserException.h"
+#include "optparse/StringView.h"
+#include "optparse/UnitFormatter.h"
 
 #include <cerrno>
+#include <chrono>
 #include <cstdlib>
 #include <cwchar>
+#include <limits>
 #include <string>
+#include <type_traits>
 
 namespace optparse {
 
 	/**
 	 * Default value formatter for `OptionParserBase`.
 	 *
-	 * Must be specialized.
+	 * Must be specialized unless `T` is an enumeration.
+	 * An enumeration is converted by `EnumFormatter`, which needs
+	 * a specialization of `EnumTraits< T >` instead.
+	 * Specializations for `std::chrono::duration` and `ByteSize` are
+	 * `DurationFormatter` and `ByteSizeFormatter` respectively.
+	 *
+	 * A type other than an enumeration may specialize only the function
+	 * call operator which takes `const std::basic_string< Ch >&`.
+	 *
+	 *     namespace optparse {
+	 *         template <>
+	 *         Point DefaultFormatter< Point, char >::operator ()(
+	 *             const std::string& valueStr) const
+	 *         {
+	 *             // converts valueStr into a Point
+	 *         }
+	 *     }
 	 *
 	 * @tparam T
 	 *     Type which represents a value.
@@ -26,7 +48,8 @@ namespace optparse {
 		/**
 		 * Converts a given string into a value of the type `T`.
 		 *
-		 * This function must be specialized for `T` and `Ch`.
+		 * This function must be specialized for `T` and `Ch` unless `T`
+		 * is an enumeration.
 		 *
 		 * @param valueStr
 		 *     String to be converted into a `T` value.
@@ -35,12 +58,153 @@ namespace optparse {
 		 * @throws BadValue< char >
 		 *     If `valueStr` is invalid.
 		 */
-		T operator ()(const std::basic_string< Ch >& valueStr) const;
+		T operator ()(const std::basic_string< Ch >& valueStr) const {
+			return EnumFormatter< T, Ch >()(valueStr);
+		}
+
+		/**
+		 * Converts a given view of a string into a value of the type `T`.
+		 *
+		 * Converts an enumeration by `EnumFormatter` without copying
+		 * `valueStr`.
+		 * Otherwise, copies `valueStr` into a string and passes it to
+		 * the above function, so that a specialization of it handles views
+		 * as well.
+		 *
+		 * @param valueStr
+		 *     String to be converted into a `T` value.
+		 * @return
+		 *     `T` value equivalent to `valueStr`.
+		 * @throws BadValue< char >
+		 *     If `valueStr` is invalid.
+		 */
+		inline T operator ()(const StringView< Ch >& valueStr) const {
+			return this->format(valueStr, std::is_enum< T >());
+		}
+
+		/**
+		 * Converts a given null-terminated string into a value of the type
+		 * `T`.
+		 *
+		 * Equivalent to `(*this)(StringView< Ch >(valueStr))`.
+		 */
+		inline T operator ()(const Ch* valueStr) const {
+			return (*this)(StringView< Ch >(valueStr));
+		}
+
+		/**
+		 * Converts a given string into a value of the type `T` without
+		 * throwing an exception.
+		 *
+		 * Available only if `T` is an enumeration.
+		 *
+		 * @param valueStr
+		 *     String to be converted into a `T` value.
+		 * @param[out] value
+		 *     Set to the `T` value equivalent to `valueStr` if succeeded.
+		 * @param[out] message
+		 *     Set to a brief explanation if failed.
+		 * @return
+		 *     Whether `valueStr` is valid.
+		 */
+		template < typename U >
+		inline typename std::enable_if<
+			std::is_enum< U >::value && std::is_same< U, T >::value,
+			bool >::type tryFormat(const StringView< Ch >& valueStr,
+								   U& value,
+								   const char*& message) const
+		{
+			return EnumFormatter< T, Ch >().tryFormat(
+				valueStr, value, message);
+		}
+	private:
+		/** Converts an enumeration. */
+		inline T format(const StringView< Ch >& valueStr,
+						std::true_type) const
+		{
+			return EnumFormatter< T, Ch >()(valueStr);
+		}
+
+		/** Converts the other value by the function taking a string. */
+		inline T format(const StringView< Ch >& valueStr,
+						std::false_type) const
+		{
+			return (*this)(valueStr.str());
+		}
 	};
 
+	/** `DefaultFormatter` which converts a string into a duration. */
+	template < typename Rep, typename Period, typename Ch >
+	class DefaultFormatter< std::chrono::duration< Rep, Period >, Ch >
+		: public DurationFormatter< Rep, Period, Ch > {};
+
+	/** `DefaultFormatter` which converts a string into `ByteSize`. */
+	template < typename Ch >
+	class DefaultFormatter< ByteSize, Ch > : public ByteSizeFormatter< Ch > {};
+
 	/** Helper utilities for `DefaultFormatter`. */
 	class DefaultFormatterHelper {
 	public:
+		/**
+		 * Null-terminated copy of a string view.
+		 *
+		 * Characters are copied into a buffer inside this object if they fit
+		 * in it, so that a short value does not cause memory allocation.
+		 * Longer values are copied into a string.
+		 *
+		 * @tparam Ch
+		 *     Type which represents a character.
+		 */
+		template < typename Ch >
+		class CString {
+		private:
+			/** Size of the internal buffer including a null character. */
+			static const size_t BUFFER_SIZE = 64;
+
+			/** Internal buffer. */
+			Ch buffer[BUFFER_SIZE];
+
+			/** String used if the internal buffer is too short. */
+			std::basic_string< Ch > overflow;
+
+			/** Pointer to the null-terminated copy. */
+			const Ch* ptr;
+		public:
+			/**
+			 * Copies a given string view.
+			 *
+			 * @param str
+			 *     String view to be copied.
+			 */
+			explicit CString(const StringView< Ch >& str) {
+				if (str.size() < BUFFER_SIZE) {
+					std::char_traits< Ch >::copy(
+						this->buffer, str.data(), str.size());
+					this->buffer[str.size()] = Ch('\0');
+					this->ptr = this->buffer;
+				} else {
+					this->overflow.assign(str.data(), str.size());
+					this->ptr = this->overflow.c_str();
+				}
+			}
+
+			/**
+			 * Returns the null-terminated copy.
+			 *
+			 * @return
+			 *     Null-terminated copy of the string view.
+			 */
+			inline const Ch* c_str() const {
+				return this->ptr;
+			}
+		private:
+			/** Copy is not allowed. */
+			CString(const CString&);
+
+			/** Assignment is not allowed. */
+			void operator =(const CString&);
+		};
+
 		/**
 		 * Converts a given `char` string into a `long long` value.
 		 *
@@ -195,26 +359,60 @@ namespace optparse {
 		 *     or if `valueStr` is out of the range representable by `S`.
 		 */
 		template < typename S, typename Ch >
-		static S toSigned(const std::basic_string< Ch >& valueStr) {
+		static S toSigned(const StringView< Ch >& valueStr) {
+			S x = 0;
+			const char* message = "";
+			if (!tryToSigned(valueStr, x, message)) {
+				OPTPARSE_THROW(BadValue< Ch >(message, valueStr.str()));
+			}
+			return x;
+		}
+
+		/**
+		 * Converts a given string into a value of a signed integer type `S`
+		 * without throwing an exception.
+		 *
+		 * @tparam S
+		 *     Type which represents a value.
+		 *     Must be a signed integer type.
+		 * @tparam Ch
+		 *     Type which represents a character.
+		 * @param valueStr
+		 *     String to be converted.
+		 * @param[out] value
+		 *     Set to the `S` value equivalent to `valueStr` if succeeded.
+		 * @param[out] message
+		 *     Set to the message of the `BadValue` which `toSigned` would
+		 *     throw if failed.
+		 * @return
+		 *     Whether `valueStr` is a valid `S` value.
+		 */
+		template < typename S, typename Ch >
+		static bool tryToSigned(const StringView< Ch >& valueStr,
+								S& value,
+								const char*& message)
+		{
 			if (valueStr.empty()) {
-				throw BadValue< Ch >("invalid integer", valueStr);
+				message = "invalid integer";
+				return false;
 			}
+			const CString< Ch > cstr(valueStr);
 			Ch* end = 0;
 			errno = 0;
-			long long x = strtoll(valueStr.c_str(), &end);
-			if (*end != Ch('\0')) {
-				throw BadValue< Ch >("invalid integer", valueStr);
-			}
-			if (errno == ERANGE) {
-				throw BadValue< Ch >("out of range", valueStr);
-			}
-			if (x > std::numeric_limits< S >::max()) {
-				throw BadValue< Ch >("out of range", valueStr);
+			long long x = strtoll(cstr.c_str(), &end);
+			if (end != cstr.c_str() + valueStr.size()) {
+				message = "invalid integer";
+				return false;
 			}
-			if (x < std::numeric_limits< S >::min()) {
-				throw BadValue< Ch >("out of range", valueStr);
+			if (errno == ERANGE
+				|| x > std::numeric_limits< S >::max()
+				|| x < std::numeric_limits< S >::min())
+			{
+				message = "out of range";
+				return false;
 			}
-			return static_cast< S >(x);
+			value = static_cast< S >(x);
+			return true;
 		}
 
 		/**
@@ -238,26 +436,60 @@ namespace optparse {
 		 *     or if `valueStr` is out of the range representable by `U`.
 		 */
 		template < typename U, typename Ch >
-		static U toUnsigned(const std::basic_string< Ch >& valueStr) {
+		static U toUnsigned(const StringView< Ch >& valueStr) {
+			U x = 0;
+			const char* message = "";
+			if (!tryToUnsigned(valueStr, x, message)) {
+				OPTPARSE_THROW(BadValue< Ch >(message, valueStr.str()));
+			}
+			return x;
+		}
+
+		/**
+		 * Converts a given string into a value of an unsigned integer type `U`
+		 * without throwing an exception.
+		 *
+		 * @tparam U
+		 *     Type which represents a value.
+		 *     Must be an unsigned integer type.
+		 * @tparam Ch
+		 *     Type which represents a character.
+		 * @param valueStr
+		 *     String to be converted.
+		 * @param[out] value
+		 *     Set to the `U` value equivalent to `valueStr` if succeeded.
+		 * @param[out] message
+		 *     Set to the message of the `BadValue` which `toUnsigned` would
+		 *     throw if failed.
+		 * @return
+		 *     Whether `valueStr` is a valid `U` value.
+		 */
+		template < typename U, typename Ch >
+		static bool tryToUnsigned(const StringView< Ch >& valueStr,
+								  U& value,
+								  const char*& message)
+		{
 			if (valueStr.empty()) {
-				throw BadValue< Ch >("invalid integer", valueStr);
+				message = "invalid integer";
+				return false;
 			}
+			const CString< Ch > cstr(valueStr);
 			Ch* end = 0;
 			errno = 0;
-			unsigned long long x = strtoull(valueStr.c_str(), &end);
-			if (*end != Ch('\0')) {
-				throw BadValue< Ch >("invalid integer", valueStr);
+			unsigned long long x = strtoull(cstr.c_str(), &end);
+			if (end != cstr.c_str() + valueStr.size()) {
+				message = "invalid integer";
+				return false;
 			}
-			if (errno == ERANGE) {
-				throw BadValue< Ch >("out of range", valueStr);
+			if (errno == ERANGE
+				|| x > std::numeric_limits< U >::max()
+				|| valueStr[0] == Ch('-'))
+			{
+				message = "out of range";
+				return false;
 			}
-			if (x > std::numeric_limits< U >::max()) {
-				throw BadValue< Ch >("out of range", valueStr);
-			}
-			if (valueStr[0] == Ch('-')) {
-				throw BadValue< Ch >("out of range", valueStr);
-			}
-			return static_cast< U >(x);
+			value = static_cast< U >(x);
+			return true;
 		}
 
 		/**
@@ -279,26 +511,61 @@ namespace optparse {
 		 *     or if `valueStr` is out of the range representable by `F`.
 		 */
 		template < typename F, typename Ch >
-		static F toFloat(const std::basic_string< Ch >& valueStr) {
+		static F toFloat(const StringView< Ch >& valueStr) {
+			F x = 0;
+			const char* message = "";
+			if (!tryToFloat(valueStr, x, message)) {
+				OPTPARSE_THROW(BadValue< Ch >(message, valueStr.str()));
+			}
+			return x;
+		}
+
+		/**
+		 * Converts a given string into a floating point number without
+		 * throwing an exception.
+		 *
+		 * Undefined if `valueStr` causes underflow.
+		 *
+		 * @tparam F
+		 *     Type which represents a floating point number.
+		 * @tparam Ch
+		 *     Type which represents a character.
+		 * @param valueStr
+		 *     String to be converted.
+		 * @param[out] value
+		 *     Set to the `F` value equivalent to `valueStr` if succeeded.
+		 * @param[out] message
+		 *     Set to the message of the `BadValue` which `toFloat` would
+		 *     throw if failed.
+		 * @return
+		 *     Whether `valueStr` is a valid `F` value.
+		 */
+		template < typename F, typename Ch >
+		static bool tryToFloat(const StringView< Ch >& valueStr,
+							   F& value,
+							   const char*& message)
+		{
 			if (valueStr.empty()) {
-				throw BadValue< Ch >("invalid number", valueStr);
+				message = "invalid number";
+				return false;
 			}
+			const CString< Ch > cstr(valueStr);
 			Ch* end = 0;
 			errno = 0;
-			double x = strtod(valueStr.c_str(), &end);
-			if (*end != Ch('\0')) {
-				throw BadValue< Ch >("invalid number", valueStr);
-			}
-			if (errno == ERANGE) {
-				throw BadValue< Ch >("out of range", valueStr);
+			double x = strtod(cstr.c_str(), &end);
+			if (end != cstr.c_str() + valueStr.size()) {
+				message = "invalid number";
+				return false;
 			}
-			if (x > std::numeric_limits< F >::max()) {
-				throw BadValue< Ch >("out of range", valueStr);
+			if (errno == ERANGE
+				|| x > std::numeric_limits< F >::max()
+				|| x < std::numeric_limits< F >::lowest())
+			{
+				message = "out of range";
+				return false;
 			}
-			if (x < std::numeric_limits< F >::lowest()) {
-				throw BadValue< Ch >("out of range", valueStr);
-			}
-			return static_cast< F >(x);
+			value = static_cast< F >(x);
+			return true;
 		}
 	};
 
@@ -318,9 +585,22 @@ namespace optparse {
 		 *     or if `valueStr` is not an integer,
 		 *     or if `valueStr` is out of the range representable by `int`.
 		 */
-		int operator ()(const std::string& valueStr) const {
+		int operator ()(const StringView< char >& valueStr) const {
 			return DefaultFormatterHelper::toSigned< int >(valueStr);
 		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * See `DefaultFormatterHelper::tryToSigned`.
+		 */
+		bool tryFormat(const StringView< char >& valueStr,
+					   int& value,
+					   const char*& message) const
+		{
+			return DefaultFormatterHelper
+				::tryToSigned(valueStr, value, message);
+		}
 	};
 
 	/**
@@ -342,9 +622,22 @@ namespace optparse {
 		 *     or if `valueStr` is out of the range representable by
 		 *     `unsigned int`.
 		 */
-		unsigned int operator ()(const std::string& valueStr) const {
+		unsigned int operator ()(const StringView< char >& valueStr) const {
 			return DefaultFormatterHelper::toUnsigned< unsigned int >(valueStr);
 		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * See `DefaultFormatterHelper::tryToUnsigned`.
+		 */
+		bool tryFormat(const StringView< char >& valueStr,
+					   unsigned int& value,
+					   const char*& message) const
+		{
+			return DefaultFormatterHelper
+				::tryToUnsigned(valueStr, value, message);
+		}
 	};
 
 	/** `DefaultFormatter` which converts an `std::string` into `short`. */
@@ -363,9 +656,22 @@ namespace optparse {
 		 *     or if `valueStr` is not an integer,
 		 *     or if `valueStr` is out of the range representable by `short`.
 		 */
-		short operator ()(const std::string& valueStr) const {
+		short operator ()(const StringView< char >& valueStr) const {
 			return DefaultFormatterHelper::toSigned< short >(valueStr);
 		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * See `DefaultFormatterHelper::tryToSigned`.
+		 */
+		bool tryFormat(const StringView< char >& valueStr,
+					   short& value,
+					   const char*& message) const
+		{
+			return DefaultFormatterHelper
+				::tryToSigned(valueStr, value, message);
+		}
 	};
 
 	/**
@@ -387,10 +693,25 @@ namespace optparse {
 		 *     or if `valueStr` is out of the range representable by
 		 *     `unsigned short`.
 		 */
-		unsigned short operator ()(const std::string& valueStr) const {
+		unsigned short operator ()(
+			const StringView< char >& valueStr) const
+		{
 			return DefaultFormatterHelper
 				::toUnsigned< unsigned short >(valueStr);
 		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * See `DefaultFormatterHelper::tryToUnsigned`.
+		 */
+		bool tryFormat(const StringView< char >& valueStr,
+					   unsigned short& value,
+					   const char*& message) const
+		{
+			return DefaultFormatterHelper
+				::tryToUnsigned(valueStr, value, message);
+		}
 	};
 
 	/** `DefaultFormatter` which converts an `std::string` into `long`. */
@@ -409,9 +730,22 @@ namespace optparse {
 		 *     or if `valueStr` is not an integer,
 		 *     or if `valueStr` is out of the range representable by `long`.
 		 */
-		long operator ()(const std::string& valueStr) const {
+		long operator ()(const StringView< char >& valueStr) const {
 			return DefaultFormatterHelper::toSigned< long >(valueStr);
 		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * See `DefaultFormatterHelper::tryToSigned`.
+		 */
+		bool tryFormat(const StringView< char >& valueStr,
+					   long& value,
+					   const char*& message) const
+		{
+			return DefaultFormatterHelper
+				::tryToSigned(valueStr, value, message);
+		}
 	};
 
 	/**
@@ -433,10 +767,23 @@ namespace optparse {
 		 *     or if `valueStr` is out of the range representable by
 		 *     `unsigned long`.
 		 */
-		unsigned long operator ()(const std::string& valueStr) const {
+		unsigned long operator ()(const StringView< char >& valueStr) const {
 			return DefaultFormatterHelper
 				::toUnsigned< unsigned long >(valueStr);
 		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * See `DefaultFormatterHelper::tryToUnsigned`.
+		 */
+		bool tryFormat(const StringView< char >& valueStr,
+					   unsigned long& value,
+					   const char*& message) const
+		{
+			return DefaultFormatterHelper
+				::tryToUnsigned(valueStr, value, message);
+		}
 	};
 
 	/** `DefaultFormatter` which converts an `std::string` into `long long`. */
@@ -456,9 +803,22 @@ namespace optparse {
 		 *     or if `valueStr` is out of the range representable by
 		 *     `long long`.
 		 */
-		long long operator ()(const std::string& valueStr) const {
+		long long operator ()(const StringView< char >& valueStr) const {
 			return DefaultFormatterHelper::toSigned< long long >(valueStr);
 		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * See `DefaultFormatterHelper::tryToSigned`.
+		 */
+		bool tryFormat(const StringView< char >& valueStr,
+					   long long& value,
+					   const char*& message) const
+		{
+			return DefaultFormatterHelper
+				::tryToSigned(valueStr, value, message);
+		}
 	};
 
 	/**
@@ -481,10 +841,25 @@ namespace optparse {
 		 *     or if `valueStr` is out of the range representable by
 		 *     `unsigned long long`.
 		 */
-		unsigned long long operator ()(const std::string& valueStr) const {
+		unsigned long long operator ()(
+			const StringView< char >& valueStr) const
+		{
 			return DefaultFormatterHelper
 				::toUnsigned< unsigned long long >(valueStr);
 		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * See `DefaultFormatterHelper::tryToUnsigned`.
+		 */
+		bool tryFormat(const StringView< char >& valueStr,
+					   unsigned long long& value,
+					   const char*& message) const
+		{
+			return DefaultFormatterHelper
+				::tryToUnsigned(valueStr, value, message);
+		}
 	};
 
 	/** `DefaultFormatter` which converts an `std::string` into `double`. */
@@ -505,9 +880,22 @@ namespace optparse {
 		 *     or if `valueStr` is not a number,
 		 *     or if `valueStr` is out of the range representable by `double`.
 		 */
-		double operator ()(const std::string& valueStr) const {
+		double operator ()(const StringView< char >& valueStr) const {
 			return DefaultFormatterHelper::toFloat< double >(valueStr);
 		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * See `DefaultFormatterHelper::tryToFloat`.
+		 */
+		bool tryFormat(const StringView< char >& valueStr,
+					   double& value,
+					   const char*& message) const
+		{
+			return DefaultFormatterHelper
+				::tryToFloat(valueStr, value, message);
+		}
 	};
 
 	/** `DefaultFormatter` which converts an `std::string` into `float`. */
@@ -526,18 +914,42 @@ namespace optparse {
 		 *     or if `valueStr` is not a number,
 		 *     or if `valueStr` is out of the range representable by `float`.
 		 */
-		float operator ()(const std::string& valueStr) const {
+		float operator ()(const StringView< char >& valueStr) const {
 			return DefaultFormatterHelper::toFloat< float >(valueStr);
 		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * See `DefaultFormatterHelper::tryToFloat`.
+		 */
+		bool tryFormat(const StringView< char >& valueStr,
+					   float& value,
+					   const char*& message) const
+		{
+			return DefaultFormatterHelper
+				::tryToFloat(valueStr, value, message);
+		}
 	};
 
 	/** `DefaultFormatter` from `std::string` to `std::string`. */
 	template <>
 	class DefaultFormatter< std::string, char > {
 	public:
-		/** Just returns a given string. */
-		inline std::string operator ()(const std::string& valueStr) const {
-			return valueStr;
+		/** Just returns a copy of a given string. */
+		inline std::string operator ()(
+			const StringView< char >& valueStr) const
+		{
+			return valueStr.str();
+		}
+
+		/** Just copies a given string. Never fails. */
+		inline bool tryFormat(const StringView< char >& valueStr,
+							  std::string& value,
+							  const char*&) const
+		{
+			value.assign(valueStr.data(), valueStr.size());
+			return true;
 		}
 	};
 
@@ -557,9 +969,22 @@ namespace optparse {
 		 *     or if `valueStr` is not an integer,
 		 *     or if `valueStr` is out of the range representable by `int`.
 		 */
-		int operator ()(const std::wstring& valueStr) const {
+		int operator ()(const StringView< wchar_t >& valueStr) const {
 			return DefaultFormatterHelper::toSigned< int >(valueStr);
 		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * See `DefaultFormatterHelper::tryToSigned`.
+		 */
+		bool tryFormat(const StringView< wchar_t >& valueStr,
+					   int& value,
+					   const char*& message) const
+		{
+			return DefaultFormatterHelper
+				::tryToSigned(valueStr, value, message);
+		}
 	};
 
 	/**
@@ -581,9 +1006,22 @@ namespace optparse {
 		 *     or if `valueStr` is out of the range representable by
 		 *     `unsigned int`.
 		 */
-		unsigned int operator ()(const std::wstring& valueStr) const {
+		unsigned int operator ()(const StringView< wchar_t >& valueStr) const {
 			return DefaultFormatterHelper::toUnsigned< unsigned int >(valueStr);
 		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * See `DefaultFormatterHelper::tryToUnsigned`.
+		 */
+		bool tryFormat(const StringView< wchar_t >& valueStr,
+					   unsigned int& value,
+					   const char*& message) const
+		{
+			return DefaultFormatterHelper
+				::tryToUnsigned(valueStr, value, message);
+		}
 	};
 
 	/** `DefaultFormatter` which converts an `std::wstring` into `short`. */
@@ -602,9 +1040,22 @@ namespace optparse {
 		 *     or if `valueStr` is not an integer,
 		 *     or if `valueStr` is out of the range representable by `short`.
 		 */
-		short operator ()(const std::wstring& valueStr) const {
+		short operator ()(const StringView< wchar_t >& valueStr) const {
 			return DefaultFormatterHelper::toSigned< short >(valueStr);
 		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * See `DefaultFormatterHelper::tryToSigned`.
+		 */
+		bool tryFormat(const StringView< wchar_t >& valueStr,
+					   short& value,
+					   const char*& message) const
+		{
+			return DefaultFormatterHelper
+				::tryToSigned(valueStr, value, message);
+		}
 	};
 
 	/**
@@ -627,10 +1078,25 @@ namespace optparse {
 		 *     or if `valueStr` is out of the range representable by
 		 *     `unsigned short`.
 		 */
-		unsigned short operator ()(const std::wstring& valueStr) const {
+		unsigned short operator ()(
+			const StringView< wchar_t >& valueStr) const
+		{
 			return DefaultFormatterHelper
 				::toUnsigned< unsigned short >(valueStr);
 		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * See `DefaultFormatterHelper::tryToUnsigned`.
+		 */
+		bool tryFormat(const StringView< wchar_t >& valueStr,
+					   unsigned short& value,
+					   const char*& message) const
+		{
+			return DefaultFormatterHelper
+				::tryToUnsigned(valueStr, value, message);
+		}
 	};
 
 	/** `DefaultFormatter` which converts an `std::wstring` into `long`. */
@@ -649,9 +1115,22 @@ namespace optparse {
 		 *     or if `valueStr` is not an integer,
 		 *     or if `valueStr` is out of the range representable by `long`.
 		 */
-		long operator ()(const std::wstring& valueStr) const {
+		long operator ()(const StringView< wchar_t >& valueStr) const {
 			return DefaultFormatterHelper::toSigned< long >(valueStr);
 		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * See `DefaultFormatterHelper::tryToSigned`.
+		 */
+		bool tryFormat(const StringView< wchar_t >& valueStr,
+					   long& value,
+					   const char*& message) const
+		{
+			return DefaultFormatterHelper
+				::tryToSigned(valueStr, value, message);
+		}
 	};
 
 	/**
@@ -673,10 +1152,23 @@ namespace optparse {
 		 *     or if `valueStr` is out of the range representable by
 		 *     `unsigned long`.
 		 */
-		unsigned long operator ()(const std::wstring& valueStr) const {
+		unsigned long operator ()(const StringView< wchar_t >& valueStr) const {
 			return DefaultFormatterHelper
 				::toUnsigned< unsigned long >(valueStr);
 		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * See `DefaultFormatterHelper::tryToUnsigned`.
+		 */
+		bool tryFormat(const StringView< wchar_t >& valueStr,
+					   unsigned long& value,
+					   const char*& message) const
+		{
+			return DefaultFormatterHelper
+				::tryToUnsigned(valueStr, value, message);
+		}
 	};
 
 	/** `DefaultFormatter` which converts an `std::wstring` into `long long`. */
@@ -696,9 +1188,22 @@ namespace optparse {
 		 *     or if `valueStr` is out of the range representable by
 		 *     `long long`.
 		 */
-		long long operator ()(const std::wstring& valueStr) const {
+		long long operator ()(const StringView< wchar_t >& valueStr) const {
 			return DefaultFormatterHelper::toSigned< long long >(valueStr);
 		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * See `DefaultFormatterHelper::tryToSigned`.
+		 */
+		bool tryFormat(const StringView< wchar_t >& valueStr,
+					   long long& value,
+					   const char*& message) const
+		{
+			return DefaultFormatterHelper
+				::tryToSigned(valueStr, value, message);
+		}
 	};
 
 	/**
@@ -721,10 +1226,25 @@ namespace optparse {
 		 *     or if `valueStr` is out of the range representable by
 		 *     `unsigned long long`.
 		 */
-		unsigned long long operator ()(const std::wstring& valueStr) const {
+		unsigned long long operator ()(
+			const StringView< wchar_t >& valueStr) const
+		{
 			return DefaultFormatterHelper
 				::toUnsigned< unsigned long long >(valueStr);
 		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * See `DefaultFormatterHelper::tryToUnsigned`.
+		 */
+		bool tryFormat(const StringView< wchar_t >& valueStr,
+					   unsigned long long& value,
+					   const char*& message) const
+		{
+			return DefaultFormatterHelper
+				::tryToUnsigned(valueStr, value, message);
+		}
 	};
 
 	/** `DefaultFormatter` which converts an `std::wstring` into `double`. */
@@ -745,9 +1265,22 @@ namespace optparse {
 		 *     or if `valueStr` is not a number,
 		 *     or if `valueStr` is out of the range representable by `double`.
 		 */
-		double operator ()(const std::wstring& valueStr) const {
+		double operator ()(const StringView< wchar_t >& valueStr) const {
 			return DefaultFormatterHelper::toFloat< double >(valueStr);
 		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * See `DefaultFormatterHelper::tryToFloat`.
+		 */
+		bool tryFormat(const StringView< wchar_t >& valueStr,
+					   double& value,
+					   const char*& message) const
+		{
+			return DefaultFormatterHelper
+				::tryToFloat(valueStr, value, message);
+		}
 	};
 
 	/** `DefaultFormatter` which converts an `std::wstring` into `float`. */
@@ -766,18 +1299,42 @@ namespace optparse {
 		 *     or if `valueStr` is not a number,
 		 *     or if `valueStr` is out of the range representable by `float`.
 		 */
-		float operator ()(const std::wstring& valueStr) const {
+		float operator ()(const StringView< wchar_t >& valueStr) const {
 			return DefaultFormatterHelper::toFloat< float >(valueStr);
 		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * See `DefaultFormatterHelper::tryToFloat`.
+		 */
+		bool tryFormat(const StringView< wchar_t >& valueStr,
+					   float& value,
+					   const char*& message) const
+		{
+			return DefaultFormatterHelper
+				::tryToFloat(valueStr, value, message);
+		}
 	};
 
 	/** `DefaultFormatter` from `std::wstring` to `std::wstring`. */
 	template <>
 	class DefaultFormatter< std::wstring, wchar_t > {
 	public:
-		/** Just returns a given string. */
-		inline std::wstring operator ()(const std::wstring& valueStr) const {
-			return valueStr;
+		/** Just returns a copy of a given string. */
+		inline std::wstring operator ()(
+			const StringView< wchar_t >& valueStr) const
+		{
+			return valueStr.str();
+		}
+
+		/** Just copies a given string. Never fails. */
+		inline bool tryFormat(const StringView< wchar_t >& valueStr,
+							  std::wstring& value,
+							  const char*&) const
+		{
+			value.assign(valueStr.data(), valueStr.size());
+			return true;
 		}
 	};
 
@@ -3,10 +3,40 @@
 
 #include "optparse/OptionParserBase.h"
 
+#include <algorithm>
 #include <iostream>
+#include <string>
+#include <type_traits>
+#include <utility>
 
 namespace optparse {
 
+	/** Literals in a usage rendered by `DefaultUsagePrinter`. */
+	enum UsageLiteral {
+		/** "usage: " */
+		USAGE_HEADING,
+		/** "positional arguments:" */
+		USAGE_POSITIONAL,
+		/** "optional arguments:" */
+		USAGE_OPTIONAL,
+		/** "commands:" */
+		USAGE_COMMANDS,
+		/** " COMMAND ..." */
+		USAGE_COMMAND,
+		/** " [" */
+		USAGE_OPEN_BRACKET,
+		/** "]" */
+		USAGE_CLOSE_BRACKET,
+		/** " ...]" */
+		USAGE_VARIADIC,
+		/** " " */
+		USAGE_SPACE,
+		/** "  " */
+		USAGE_INDENT,
+		/** "\n" */
+		USAGE_NEWLINE
+	};
+
 	/**
 	 * Traits of `DefaultUsagePrinter`.
 	 *
@@ -38,7 +68,7 @@ namespace optparse {
 		 * @return
 		 *     `Ch` value equivalent to `ch`.
 		 */
-		static char fromChar(char ch);
+		static Ch fromChar(char ch);
 
 		/**
 		 * Converts a given `char` string into an equivalent `Ch` string.
@@ -51,6 +81,21 @@ namespace optparse {
 		 *     `Ch` string equivalent to `str`.
 		 */
 		static std::basic_string< Ch > fromChar(const char* str);
+
+		/**
+		 * Returns a given literal as a `Ch` string.
+		 *
+		 * A literal is a constant of `Ch` so that no literal is converted
+		 * whenever a usage is rendered.
+		 *
+		 * This function must be specialized.
+		 *
+		 * @param literal
+		 *     Literal to be returned.
+		 * @return
+		 *     Null-terminated `Ch` string of `literal`.
+		 */
+		static const Ch* getLiteral(UsageLiteral literal);
 	};
 
 	/** Specialization of `DefaultUsagePrinterTraits` for `char`. */
@@ -71,6 +116,16 @@ namespace optparse {
 		inline static const char* fromChar(const char* str) {
 			return str;
 		}
+
+		/** Returns a given literal. */
+		inline static const char* getLiteral(UsageLiteral literal) {
+			static const char* const LITERALS[] = {
+				"usage: ", "positional arguments:", "optional arguments:",
+				"commands:", " COMMAND ...", " [", "]", " ...]", " ", "  ",
+				"\n"
+			};
+			return LITERALS[literal];
+		}
 	};
 
 	/** Specialization of `DefaultUsagePrinterTraits` for `wchar_t`. */
@@ -90,7 +145,7 @@ namespace optparse {
 		 * @return
 		 *     `wchar_t` character equivalent to `ch`.
 		 */
-		inline static char fromChar(char ch) {
+		inline static wchar_t fromChar(char ch) {
 			return static_cast< wchar_t >(ch);
 		}
 
@@ -108,6 +163,16 @@ namespace optparse {
 		static std::wstring fromChar(const std::string& str) {
 			return std::wstring(str.begin(), str.end());
 		}
+
+		/** Returns a given literal as a wide string literal. */
+		inline static const wchar_t* getLiteral(UsageLiteral literal) {
+			static const wchar_t* const LITERALS[] = {
+				L"usage: ", L"positional arguments:", L"optional arguments:",
+				L"commands:", L" COMMAND ...", L" [", L"]", L" ...]", L" ",
+				L"  ", L"\n"
+			};
+			return LITERALS[literal];
+		}
 	};
 
 	/**
@@ -142,174 +207,302 @@ namespace optparse {
 		/**
 		 * Prints the usage of a given option parser.
 		 *
-		 * @tparam Opt
-		 *     See `OptionParserBase`.
-		 * @tparam MetaFormat
-		 *     See `OptionParserBase`.
+		 * The whole usage is rendered by `renderUsage` and written to the
+		 * output stream at once, and the stream is flushed only at the end.
+		 *
+		 * @tparam Parser
+		 *     Type of the option parser.
+		 *     `OptionParserBase`, `StaticOptionParser`, or any type which
+		 *     has the same `getProgramName`, `getDescription`,
+		 *     `getOptionCount`, `getOption`, `getArgumentCount` and
+		 *     `getArgument`.
+		 *     Sub-commands are printed if it also has `getCommandCount`
+		 *     and `getCommand`.
+		 */
+		template < typename Parser >
+		void printUsage(const Parser& parser) {
+			String usage;
+			renderUsage(parser, usage);
+			this->out.write(
+				usage.data(), static_cast< std::streamsize >(usage.size()));
+			this->out.flush();
+		}
+
+		/**
+		 * Renders the usage of a given option parser into a given string.
+		 *
+		 * The width of every row is measured in a single pass, `out` is
+		 * grown once to the exact size, and then the rows are appended
+		 * without intermediate strings.
+		 *
+		 * @tparam Parser
+		 *     See `printUsage`.
+		 * @param parser
+		 *     Parser of which the usage is to be rendered.
+		 * @param[in,out] out
+		 *     String to which the usage is appended.
 		 */
-		template < typename Opt,
-				   template < typename, typename > class MetaFormat >
-		void printUsage(const OptionParserBase< Opt, Ch, MetaFormat >& parser) {
-			this->out << "usage: " << parser.getProgramName();
-			// appends optional arguments if exist
-			if (parser.getOptionCount() > 0) {
-				const size_t N = parser.getOptionCount();
-				for (size_t i = 0; i < N; ++i) {
-					const OptionSpec< Ch >& spec = parser.getOption(i);
-					this->out << Traits::fromChar(" [") << spec.getLabel();
-					if (spec.needsValue()) {
-						this->out
-							<< Traits::fromChar(" ") << spec.getValueName();
-					}
-					this->out << Traits::fromChar("]");
+		template < typename Parser >
+		static void renderUsage(const Parser& parser, String& out) {
+			typedef decltype(testCommands< Parser >(0)) HasCommands;
+			const size_t optionCount = parser.getOptionCount();
+			const size_t argumentCount = parser.getArgumentCount();
+			// measures the widths and the total size
+			size_t maxArgumentLen = 0;
+			size_t argumentsSize = 0;
+			for (size_t i = 0; i < argumentCount; ++i) {
+				const ArgumentSpec< Ch >& arg = parser.getArgument(i);
+				const size_t len = arg.getValueName().size();
+				maxArgumentLen = std::max(len, maxArgumentLen);
+				// " NAME" in the usage line and "  DESCRIPTION\n" in a row
+				argumentsSize += 1 + len + 2 + arg.getDescription().size() + 1;
+				if (arg.isVariadic()) {
+					// " [NAME ...]" in the usage line
+					argumentsSize += 6;
 				}
 			}
-			// appends positional arguments if exist
-			if (parser.getArgumentCount() > 0) {
-				const size_t N = parser.getArgumentCount();
-				for (size_t i = 0; i < N; ++i) {
-					const ArgumentSpec< Ch >& spec = parser.getArgument(i);
-					this->out << Traits::fromChar(" ") << spec.getValueName();
+			size_t maxOptionLen = 0;
+			size_t optionsSize = 0;
+			for (size_t i = 0; i < optionCount; ++i) {
+				const OptionSpec< Ch >& option = parser.getOption(i);
+				const size_t len = measureOption(option);
+				maxOptionLen = std::max(len, maxOptionLen);
+				// " [OPTION]" in the usage line and "  DESCRIPTION\n" in a row
+				optionsSize +=
+					3 + len + 2 + option.getDescription().size() + 1;
+			}
+			size_t size = measureLiteral(USAGE_HEADING)
+				+ parser.getProgramName().size()
+				+ 2 + parser.getDescription().size() + 1
+				+ 1;
+			if (argumentCount > 0) {
+				size += 1 + measureLiteral(USAGE_POSITIONAL) + 1
+					+ argumentsSize + argumentCount * (2 + maxArgumentLen);
+			}
+			if (optionCount > 0) {
+				size += 1 + measureLiteral(USAGE_OPTIONAL) + 1
+					+ optionsSize + optionCount * (2 + maxOptionLen);
+			}
+			size += measureCommands(parser, HasCommands());
+			out.reserve(out.size() + size);
+			// usage line
+			appendLiteral(out, USAGE_HEADING);
+			out += parser.getProgramName();
+			for (size_t i = 0; i < optionCount; ++i) {
+				appendLiteral(out, USAGE_OPEN_BRACKET);
+				appendOption(out, parser.getOption(i));
+				appendLiteral(out, USAGE_CLOSE_BRACKET);
+			}
+			for (size_t i = 0; i < argumentCount; ++i) {
+				const ArgumentSpec< Ch >& arg = parser.getArgument(i);
+				if (arg.isVariadic()) {
+					appendLiteral(out, USAGE_OPEN_BRACKET);
+					out += arg.getValueName();
+					appendLiteral(out, USAGE_VARIADIC);
+				} else {
+					appendLiteral(out, USAGE_SPACE);
+					out += arg.getValueName();
 				}
 			}
-			this->out << std::endl;
-			this->out << std::endl;
-			this->out << parser.getDescription() << std::endl;
-			// prints descriptions of positional arguments if exist
-			if (parser.getArgumentCount() > 0) {
-				// measures the maximum length of arguments
-				size_t maxLen = measureMaximumArgumentLength(parser);
-				this->out << std::endl;
-				this->out
-					<< Traits::fromChar("positional arguments:")
-					<< std::endl;
-				const size_t N = parser.getArgumentCount();
-				for (size_t i = 0; i < N; ++i) {
+			appendCommandUsage(out, parser, HasCommands());
+			appendLiteral(out, USAGE_NEWLINE);
+			appendLiteral(out, USAGE_NEWLINE);
+			out += parser.getDescription();
+			appendLiteral(out, USAGE_NEWLINE);
+			// descriptions of positional arguments
+			if (argumentCount > 0) {
+				appendLiteral(out, USAGE_NEWLINE);
+				appendLiteral(out, USAGE_POSITIONAL);
+				appendLiteral(out, USAGE_NEWLINE);
+				for (size_t i = 0; i < argumentCount; ++i) {
 					const ArgumentSpec< Ch >& arg = parser.getArgument(i);
-					this->out
-						<< Traits::fromChar("  ")
-						<< padString(arg.getValueName(), maxLen)
-						<< Traits::fromChar("  ")
-						<< arg.getDescription()
-						<< std::endl;
+					const size_t start = out.size();
+					appendLiteral(out, USAGE_INDENT);
+					out += arg.getValueName();
+					pad(out, start + 2 + maxArgumentLen);
+					appendLiteral(out, USAGE_INDENT);
+					out += arg.getDescription();
+					appendLiteral(out, USAGE_NEWLINE);
 				}
 			}
-			// prints descriptions of optional arguments if exist
-			if (parser.getOptionCount() > 0) {
-				// measures the maximum length of options
-				size_t maxLen = measureMaximumOptionLength(parser);
-				this->out << std::endl;
-				this->out
-					<< Traits::fromChar("optional arguments:") << std::endl;
-				const size_t N = parser.getOptionCount();
-				for (size_t i = 0; i < N; ++i) {
+			// descriptions of sub-commands
+			appendCommands(out, parser, HasCommands());
+			// descriptions of optional arguments
+			if (optionCount > 0) {
+				appendLiteral(out, USAGE_NEWLINE);
+				appendLiteral(out, USAGE_OPTIONAL);
+				appendLiteral(out, USAGE_NEWLINE);
+				for (size_t i = 0; i < optionCount; ++i) {
 					const OptionSpec< Ch >& option = parser.getOption(i);
-					this->out
-						<< Traits::fromChar("  ")
-						<< padString(toString(option), maxLen)
-						<< Traits::fromChar("  ")
-						<< option.getDescription()
-						<< std::endl;
+					const size_t start = out.size();
+					appendLiteral(out, USAGE_INDENT);
+					appendOption(out, option);
+					pad(out, start + 2 + maxOptionLen);
+					appendLiteral(out, USAGE_INDENT);
+					out += option.getDescription();
+					appendLiteral(out, USAGE_NEWLINE);
 				}
 			}
-			this->out << std::endl;
+			appendLiteral(out, USAGE_NEWLINE);
 		}
-	private:
+
 		/**
-		 * Measures the maximum length of the positional arguments which
-		 * a given parser takes.
+		 * Renders the usage of a given option parser.
 		 *
-		 * @tparam Opt
-		 *     See `OptionParserBase`.
-		 * @tparam MetaFormat
-		 *     See `OptionParserBase`.
+		 * Equivalent to `renderUsage(parser, out)` with an empty `out`.
+		 *
+		 * @tparam Parser
+		 *     See `printUsage`.
 		 * @param parser
-		 *     Parser of which the maximum argument length is to be measured.
+		 *     Parser of which the usage is to be rendered.
 		 * @return
-		 *     Maximum length of the positional arguments.
-		 *     0 if `parser` takes no positional arguments.
+		 *     Usage of `parser`.
 		 */
-		template < typename Opt,
-				   template < typename, typename > class MetaFormat >
-		static size_t measureMaximumArgumentLength(
-			const OptionParserBase< Opt, Ch, MetaFormat >& parser)
-		{
+		template < typename Parser >
+		static String renderUsage(const Parser& parser) {
+			String usage;
+			renderUsage(parser, usage);
+			return usage;
+		}
+	private:
+		/** Tests if `P` has `getCommandCount`. */
+		template < typename P >
+		static auto testCommands(int) -> decltype(
+			std::declval< const P& >().getCommandCount(),
+			std::true_type());
+
+		/** Fallback of `testCommands`. */
+		template < typename >
+		static std::false_type testCommands(...);
+
+		/** Returns the length of the longest name of sub-commands. */
+		template < typename Parser >
+		static size_t measureCommandName(const Parser& parser) {
 			size_t maxLen = 0;
-			const size_t N = parser.getArgumentCount();
-			for (size_t i = 0; i < N; ++i) {
-				const ArgumentSpec< Ch >& spec = parser.getArgument(i);
-				maxLen = std::max(spec.getValueName().size(), maxLen);
+			for (size_t i = 0; i < parser.getCommandCount(); ++i) {
+				maxLen =
+					std::max(maxLen, parser.getCommand(i).getName().size());
 			}
 			return maxLen;
 		}
 
 		/**
-		 * Measures the maximum length of the optional arguments which
-		 * a given parser takes.
-		 *
-		 * @tparam Opt
-		 *     See `OptionParserBase`.
-		 * @tparam MetaFormat
-		 *     See `OptionParserBase`.
-		 * @param parser
-		 *     Parser of which the maximum option length is to be measured.
-		 * @return
-		 *     Maximum length of the optional arguments.
-		 *     0 if `parser` takes no optional arguments.
+		 * Returns the size of the usage and descriptions of sub-commands.
 		 */
-		template < typename Opt,
-				   template < typename, typename > class MetaFormat >
-		static size_t measureMaximumOptionLength(
-			const OptionParserBase< Opt, Ch, MetaFormat >& parser)
+		template < typename Parser >
+		static size_t measureCommands(const Parser& parser, std::true_type) {
+			const size_t count = parser.getCommandCount();
+			if (count == 0) {
+				return 0;
+			}
+			const size_t maxLen = measureCommandName(parser);
+			size_t size = measureLiteral(USAGE_COMMAND)
+				+ 1 + measureLiteral(USAGE_COMMANDS) + 1;
+			for (size_t i = 0; i < count; ++i) {
+				// "  NAME  DESCRIPTION\n"
+				size += 2 + maxLen + 2
+					+ parser.getCommand(i).getDescription().size() + 1;
+			}
+			return size;
+		}
+
+		/** A parser without sub-commands needs no size. */
+		template < typename Parser >
+		static inline size_t measureCommands(const Parser&, std::false_type) {
+			return 0;
+		}
+
+		/** Appends the usage of sub-commands in the usage line. */
+		template < typename Parser >
+		static void appendCommandUsage(String& out,
+									   const Parser& parser,
+									   std::true_type)
 		{
-			size_t maxLen = 0;
-			const size_t N = parser.getOptionCount();
-			for (size_t i = 0; i < N; ++i) {
-				const OptionSpec< Ch >& option = parser.getOption(i);
-				maxLen = std::max(toString(option).size(), maxLen);
+			if (parser.getCommandCount() > 0) {
+				appendLiteral(out, USAGE_COMMAND);
+			}
+		}
+
+		/** A parser without sub-commands appends nothing. */
+		template < typename Parser >
+		static inline void appendCommandUsage(String&,
+											  const Parser&,
+											  std::false_type) {}
+
+		/** Appends the descriptions of sub-commands. */
+		template < typename Parser >
+		static void appendCommands(String& out,
+								   const Parser& parser,
+								   std::true_type)
+		{
+			const size_t count = parser.getCommandCount();
+			if (count == 0) {
+				return;
+			}
+			const size_t maxLen = measureCommandName(parser);
+			appendLiteral(out, USAGE_NEWLINE);
+			appendLiteral(out, USAGE_COMMANDS);
+			appendLiteral(out, USAGE_NEWLINE);
+			for (size_t i = 0; i < count; ++i) {
+				const CommandSpec< Ch >& command = parser.getCommand(i);
+				const size_t start = out.size();
+				appendLiteral(out, USAGE_INDENT);
+				out += command.getName();
+				pad(out, start + 2 + maxLen);
+				appendLiteral(out, USAGE_INDENT);
+				out += command.getDescription();
+				appendLiteral(out, USAGE_NEWLINE);
 			}
-			return maxLen;
 		}
 
+		/** A parser without sub-commands appends nothing. */
+		template < typename Parser >
+		static inline void appendCommands(String&,
+										  const Parser&,
+										  std::false_type) {}
+
 		/**
-		 * Returns the string form of a given option.
+		 * Returns the length of the string form of a given option.
 		 *
-		 * @param option
-		 *     Option to be formatted as a string.
-		 * @return
-		 *     String form of `option`.
+		 * The string form is the label followed by a space and the value
+		 * name if the option needs a value.
 		 */
-		static String toString(const OptionSpec< Ch >& option) {
-			String str(option.getLabel());
+		static size_t measureOption(const OptionSpec< Ch >& option) {
+			size_t len = option.getLabel().size();
 			if (option.needsValue()) {
-				str += Traits::fromChar(" ") + option.getValueName();
+				len += 1 + option.getValueName().size();
 			}
-			return str;
+			return len;
+		}
+
+		/** Appends the string form of a given option. */
+		static void appendOption(String& out, const OptionSpec< Ch >& option) {
+			out += option.getLabel();
+			if (option.needsValue()) {
+				appendLiteral(out, USAGE_SPACE);
+				out += option.getValueName();
+			}
+		}
+
+		/** Appends a given literal. */
+		static inline void appendLiteral(String& out, UsageLiteral literal) {
+			out += Traits::getLiteral(literal);
+		}
+
+		/** Returns the length of a given literal. */
+		static inline size_t measureLiteral(UsageLiteral literal) {
+			return std::char_traits< Ch >::length(Traits::getLiteral(literal));
 		}
 
 		/**
-		 * Pads a given string with whitespace so that it will have the fixed
-		 * length.
-		 *
-		 * Just returns `str` if `str.size() >= len`.
+		 * Pads a given string with whitespace up to a given size.
 		 *
-		 * @param str
-		 *     String to be padded.
-		 * @param len
-		 *     Target length.
-		 * @return
-		 *     Padded string.
+		 * Does nothing if `out.size() >= size`.
 		 */
-		static String padString(const String& str, size_t len) {
-			// immediately returns `str`
-			// if its length is longer than or equal to `len`
-			if (str.size() >= len) {
-				return str;
+		static void pad(String& out, size_t size) {
+			if (out.size() < size) {
+				out.append(size - out.size(), static_cast< Ch >(' '));
 			}
-			size_t n = len - str.size();
-			String padded(str);
-			padded.insert(str.size(), n, Traits::fromChar(' '));
-			return padded;
 		}
 
 		/** Assignment is not allowed. */
@@ -0,0 +1,207 @@
+#ifndef _OPTPARSE_OPTPARSE_ENUM_FORMATTER_H
+#define _OPTPARSE_OPTPARSE_ENUM_FORMATTER_H
+
+#include "optparse/LabelTable.h"
+#include "optparse/OptionParserException.h"
+#include "optparse/StringView.h"
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace optparse {
+
+	/**
+	 * Name of a value of an enumeration.
+	 *
+	 * @tparam T
+	 *     Type of the enumeration.
+	 */
+	template < typename T >
+	struct EnumName {
+		/** Name of the value. Must consist of ASCII characters. */
+		const char* name;
+
+		/** Value associated with the name. */
+		T value;
+	};
+
+	/**
+	 * Traits of an enumeration `T` which `DefaultFormatter` converts.
+	 *
+	 * Must be specialized for `T` with the following function,
+	 *
+	 *     static size_t getNames(const EnumName< T >*& names)
+	 *
+	 * which sets `names` to the accepted names in static storage and
+	 * returns the number of them.
+	 * Names must be unique, though several names may share a value.
+	 *
+	 *     namespace optparse {
+	 *         template <>
+	 *         struct EnumTraits< Mode > {
+	 *             static size_t getNames(const EnumName< Mode >*& names) {
+	 *                 static const EnumName< Mode > NAMES[] = {
+	 *                     { "fast", Mode::FAST }, { "safe", Mode::SAFE }
+	 *                 };
+	 *                 names = NAMES;
+	 *                 return sizeof(NAMES) / sizeof(NAMES[0]);
+	 *             }
+	 *         };
+	 *     }
+	 *
+	 * @tparam T
+	 *     Type of the enumeration.
+	 */
+	template < typename T >
+	struct EnumTraits;
+
+	/**
+	 * Value formatter which converts a name into a value of an enumeration
+	 * `T`.
+	 *
+	 * Names given by `EnumTraits< T >` are compiled into a `LabelTable`
+	 * when the first value is converted, so that a conversion costs one
+	 * hash and one comparison and never allocates memory.
+	 * The table is shared by every formatter of `T` and `Ch`, and built
+	 * safely even if threads convert the first values at the same time.
+	 *
+	 * `DefaultFormatter` uses this formatter for an enumeration.
+	 *
+	 * @tparam T
+	 *     Type of the enumeration.
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename T, typename Ch >
+	class EnumFormatter {
+		static_assert(std::is_enum< T >::value,
+					  "DefaultFormatter must be specialized for T");
+	private:
+		/** Table of the names. */
+		class Table {
+		private:
+			/** Names given by `EnumTraits`. */
+			const EnumName< T >* names;
+
+			/** Number of the names. */
+			size_t count;
+
+			/** Indices of the names. */
+			LabelTable< Ch > labels;
+		public:
+			/** Compiles the names given by `EnumTraits`. */
+			Table() : names(0) {
+				this->count = EnumTraits< T >::getNames(this->names);
+				std::vector< std::basic_string< Ch > > storage;
+				storage.reserve(this->count);
+				for (size_t i = 0; i < this->count; ++i) {
+					const char* name = this->names[i].name;
+					storage.push_back(std::basic_string< Ch >(
+						name, name + std::strlen(name)));
+				}
+				std::vector< typename LabelTable< Ch >::Entry > entries;
+				entries.reserve(this->count);
+				for (size_t i = 0; i < this->count; ++i) {
+					entries.push_back(typename LabelTable< Ch >::Entry(
+						storage[i], static_cast< int >(i)));
+				}
+				this->labels.build(entries);
+			}
+
+			/**
+			 * Returns the index of a given name.
+			 *
+			 * @return
+			 *     Index of `name`. -1 if `name` is not found.
+			 */
+			inline int find(const StringView< Ch >& name) const {
+				return this->labels.find(name);
+			}
+
+			/** Returns the name at a given index. */
+			inline const EnumName< T >& operator [](size_t i) const {
+				return this->names[i];
+			}
+
+			/** Returns the number of the names. */
+			inline size_t size() const {
+				return this->count;
+			}
+		};
+	public:
+		/**
+		 * Converts a given name into a value of `T`.
+		 *
+		 * @param valueStr
+		 *     Name to be converted.
+		 * @return
+		 *     Value associated with `valueStr`.
+		 * @throws BadValue< Ch >
+		 *     If `valueStr` is not a name given by `EnumTraits< T >`.
+		 */
+		T operator ()(const StringView< Ch >& valueStr) const {
+			T value = T();
+			const char* message = "";
+			if (!this->tryFormat(valueStr, value, message)) {
+				OPTPARSE_THROW(BadValue< Ch >(message, valueStr.str()));
+			}
+			return value;
+		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * @param valueStr
+		 *     Name to be converted.
+		 * @param[out] value
+		 *     Set to the value associated with `valueStr` if succeeded.
+		 * @param[out] message
+		 *     Set to "unknown name" if failed.
+		 * @return
+		 *     Whether `valueStr` is a name given by `EnumTraits< T >`.
+		 */
+		bool tryFormat(const StringView< Ch >& valueStr,
+					   T& value,
+					   const char*& message) const
+		{
+			const Table& table = getTable();
+			const int i = table.find(valueStr);
+			if (i < 0) {
+				message = "unknown name";
+				return false;
+			}
+			value = table[i].value;
+			return true;
+		}
+
+		/**
+		 * Returns the first name of a given value.
+		 *
+		 * @param value
+		 *     Value of which the name is to be obtained.
+		 * @return
+		 *     First name associated with `value`.
+		 *     0 if `value` has no name.
+		 */
+		static const char* findName(T value) {
+			const Table& table = getTable();
+			for (size_t i = 0; i < table.size(); ++i) {
+				if (table[i].value == value) {
+					return table[i].name;
+				}
+			}
+			return 0;
+		}
+	private:
+		/** Returns the table shared by every formatter. */
+		static const Table& getTable() {
+			static const Table table;
+			return table;
+		}
+	};
+
+}
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef _OPTPARSE_OPTPARSE_EXECUTOR_H
+#define _OPTPARSE_OPTPARSE_EXECUTOR_H
+
+#include "optparse/OptionParserException.h"
+
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace optparse {
+
+	/**
+	 * Executor which runs tasks one by one on the calling thread.
+	 *
+	 * An executor is a function object which supports the following call,
+	 *
+	 *     void operator ()(size_t n, F task) const
+	 *
+	 * It must call `task(i)` exactly once for each `i` in [0, `n`), and
+	 * return after all of the calls have finished.
+	 * The calls may run concurrently.
+	 */
+	class SerialExecutor {
+	public:
+		/**
+		 * Runs given tasks.
+		 *
+		 * @param n
+		 *     Number of the tasks.
+		 * @param task
+		 *     Function which runs the `i`-th task given `i`.
+		 */
+		template < typename F >
+		void operator ()(size_t n, F task) const {
+			for (size_t i = 0; i < n; ++i) {
+				task(i);
+			}
+		}
+	};
+
+	/**
+	 * Executor which distributes tasks over threads.
+	 *
+	 * Splits tasks into as many contiguous chunks as threads, and runs each
+	 * chunk on its own thread.
+	 * The calling thread runs the first chunk.
+	 * Threads are started for every call, so this executor pays off only if
+	 * there are plenty of tasks.
+	 *
+	 * If a task throws an exception, the rest of the chunk is skipped, and
+	 * the exception is rethrown after all of the threads have finished.
+	 */
+	class ThreadExecutor {
+	private:
+		/** Number of the threads. */
+		size_t threadCount;
+	public:
+		/**
+		 * Initializes with the number of threads.
+		 *
+		 * @param threadCount
+		 *     Number of the threads including the calling thread.
+		 *     0 means the number of the hardware threads.
+		 */
+		inline explicit ThreadExecutor(size_t threadCount = 0)
+			: threadCount(threadCount)
+		{
+			if (this->threadCount == 0) {
+				this->threadCount = std::thread::hardware_concurrency();
+			}
+			if (this->threadCount == 0) {
+				this->threadCount = 1;
+			}
+		}
+
+		/** Returns the number of the threads. */
+		inline size_t getThreadCount() const {
+			return this->threadCount;
+		}
+
+		/**
+		 * Runs given tasks.
+		 *
+		 * @param n
+		 *     Number of the tasks.
+		 * @param task
+		 *     Function which runs the `i`-th task given `i`.
+		 *     Must be safe to be called concurrently.
+		 */
+		template < typename F >
+		void operator ()(size_t n, F task) const {
+			const size_t chunkCount =
+				this->threadCount < n ? this->threadCount : n;
+			if (chunkCount <= 1) {
+				SerialExecutor()(n, task);
+				return;
+			}
+			const size_t chunkSize = (n + chunkCount - 1) / chunkCount;
+#if OPTPARSE_EXCEPTIONS
+			std::vector< std::exception_ptr > errors(chunkCount);
+			auto runChunk = [&](size_t c) {
+				try {
+					runRange(task, c * chunkSize, n, chunkSize);
+				} catch (...) {
+					errors[c] = std::current_exception();
+				}
+			};
+#else
+			auto runChunk = [&](size_t c) {
+				runRange(task, c * chunkSize, n, chunkSize);
+			};
+#endif
+			std::vector< std::thread > workers;
+			workers.reserve(chunkCount - 1);
+#if OPTPARSE_EXCEPTIONS
+			try {
+				for (size_t c = 1; c < chunkCount; ++c) {
+					workers.push_back(std::thread(runChunk, c));
+				}
+			} catch (...) {
+				// no more threads; the calling thread runs the rest
+				for (size_t c = workers.size() + 1; c < chunkCount; ++c) {
+					runChunk(c);
+				}
+			}
+#else
+			for (size_t c = 1; c < chunkCount; ++c) {
+				workers.push_back(std::thread(runChunk, c));
+			}
+#endif
+			runChunk(0);
+			for (size_t i = 0; i < workers.size(); ++i) {
+				workers[i].join();
+			}
+#if OPTPARSE_EXCEPTIONS
+			for (size_t c = 0; c < chunkCount; ++c) {
+				if (errors[c]) {
+					std::rethrow_exception(errors[c]);
+				}
+			}
+#endif
+		}
+	private:
+		/**
+		 * Runs tasks in [`first`, min(`first` + `size`, `n`)).
+		 */
+		template < typename F >
+		static void runRange(F& task, size_t first, size_t n, size_t size) {
+			const size_t last = first + size < n ? first + size : n;
+			for (size_t i = first; i < last; ++i) {
+				task(i);
+			}
+		}
+	};
+
+}
+
+#endif
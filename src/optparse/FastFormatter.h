@@ -0,0 +1,548 @@
+#ifndef _OPTPARSE_OPTPARSE_FAST_FORMATTER_H
+#define _OPTPARSE_OPTPARSE_FAST_FORMATTER_H
+
+#include "optparse/DefaultFormatter.h"
+#include "optparse/FormatInvoker.h"
+#include "optparse/OptionParserException.h"
+#include "optparse/StringView.h"
+
+#include <limits>
+#include <string>
+#include <type_traits>
+
+namespace optparse {
+
+	/** Helper utilities for `FastFormatter`. */
+	class FastFormatterHelper {
+	public:
+		/**
+		 * Returns whether a given character is a white space.
+		 *
+		 * Same as `isspace` in the "C" locale.
+		 *
+		 * @param c
+		 *     Character to be tested.
+		 * @return
+		 *     Whether `c` is a white space.
+		 */
+		template < typename Ch >
+		static inline bool isSpace(Ch c) {
+			return c == Ch(' ')
+				|| (c >= Ch('\t') && c <= Ch('\r'));
+		}
+
+		/**
+		 * Returns the value of a given decimal digit.
+		 *
+		 * @param c
+		 *     Character to be converted.
+		 * @return
+		 *     Value of `c`. 10 or greater if `c` is not a decimal digit.
+		 */
+		template < typename Ch >
+		static inline unsigned digitValue(Ch c) {
+			return static_cast< unsigned >(c - Ch('0'));
+		}
+
+		/**
+		 * Converts a given string into a value of a signed integer type `S`.
+		 *
+		 * Accepts the same strings as `DefaultFormatterHelper::toSigned`
+		 * and throws the same `BadValue`, but neither consults the locale
+		 * nor touches `errno`.
+		 *
+		 * @tparam S
+		 *     Type which represents a value.
+		 *     Must be a signed integer type.
+		 * @tparam Ch
+		 *     Type which represents a character.
+		 * @param valueStr
+		 *     String to be converted.
+		 * @return
+		 *     `S` value equivalent to `valueStr`.
+		 * @throws BadValue< Ch >
+		 *     If `valueStr` is empty,
+		 *     or if `valueStr` is not an integer,
+		 *     or if `valueStr` is out of the range representable by `S`.
+		 */
+		template < typename S, typename Ch >
+		static S toSigned(const StringView< Ch >& valueStr) {
+			S x = 0;
+			const char* message = "";
+			if (!tryToSigned(valueStr, x, message)) {
+				OPTPARSE_THROW(BadValue< Ch >(message, valueStr.str()));
+			}
+			return x;
+		}
+
+		/**
+		 * Non-throwing version of `toSigned`.
+		 *
+		 * @param valueStr
+		 *     String to be converted.
+		 * @param[out] value
+		 *     Set to the `S` value equivalent to `valueStr` if succeeded.
+		 * @param[out] message
+		 *     Set to the message of the `BadValue` which `toSigned` would
+		 *     throw if failed.
+		 * @return
+		 *     Whether `valueStr` is a valid `S` value.
+		 */
+		template < typename S, typename Ch >
+		static bool tryToSigned(const StringView< Ch >& valueStr,
+								S& value,
+								const char*& message)
+		{
+			typedef typename std::make_unsigned< S >::type U;
+			const Ch* p = valueStr.begin();
+			const Ch* const end = valueStr.end();
+			while (p != end && isSpace(*p)) {
+				++p;
+			}
+			bool negative = false;
+			if (p != end && (*p == Ch('+') || *p == Ch('-'))) {
+				negative = *p == Ch('-');
+				++p;
+			}
+			const U limit = negative
+				? static_cast< U >(std::numeric_limits< S >::max()) + 1U
+				: static_cast< U >(std::numeric_limits< S >::max());
+			U x = 0;
+			bool overflow = false;
+			const Ch* const first = p;
+			for (; p != end; ++p) {
+				const unsigned d = digitValue(*p);
+				if (d >= 10) {
+					break;
+				}
+				if (x > (limit - d) / 10U) {
+					overflow = true;
+				} else {
+					x = x * 10U + d;
+				}
+			}
+			if (p == first || p != end) {
+				message = "invalid integer";
+				return false;
+			}
+			if (overflow) {
+				message = "out of range";
+				return false;
+			}
+			// negates in the unsigned domain to handle the minimum
+			value = negative
+				? static_cast< S >(-static_cast< S >((x - 1U)) - 1)
+				: static_cast< S >(x);
+			return true;
+		}
+
+		/**
+		 * Converts a given string into a value of an unsigned integer type `U`.
+		 *
+		 * Accepts the same strings as `DefaultFormatterHelper::toUnsigned`
+		 * and throws the same `BadValue`, but neither consults the locale
+		 * nor touches `errno`.
+		 *
+		 * @tparam U
+		 *     Type which represents a value.
+		 *     Must be an unsigned integer type.
+		 * @tparam Ch
+		 *     Type which represents a character.
+		 * @param valueStr
+		 *     String to be converted.
+		 * @return
+		 *     `U` value equivalent to `valueStr`.
+		 * @throws BadValue< Ch >
+		 *     If `valueStr` is empty,
+		 *     or if `valueStr` is not an integer,
+		 *     or if `valueStr` is negative,
+		 *     or if `valueStr` is out of the range representable by `U`.
+		 */
+		template < typename U, typename Ch >
+		static U toUnsigned(const StringView< Ch >& valueStr) {
+			U x = 0;
+			const char* message = "";
+			if (!tryToUnsigned(valueStr, x, message)) {
+				OPTPARSE_THROW(BadValue< Ch >(message, valueStr.str()));
+			}
+			return x;
+		}
+
+		/**
+		 * Non-throwing version of `toUnsigned`.
+		 *
+		 * @param valueStr
+		 *     String to be converted.
+		 * @param[out] value
+		 *     Set to the `U` value equivalent to `valueStr` if succeeded.
+		 * @param[out] message
+		 *     Set to the message of the `BadValue` which `toUnsigned` would
+		 *     throw if failed.
+		 * @return
+		 *     Whether `valueStr` is a valid `U` value.
+		 */
+		template < typename U, typename Ch >
+		static bool tryToUnsigned(const StringView< Ch >& valueStr,
+								  U& value,
+								  const char*& message)
+		{
+			const Ch* p = valueStr.begin();
+			const Ch* const end = valueStr.end();
+			while (p != end && isSpace(*p)) {
+				++p;
+			}
+			bool negative = false;
+			if (p != end && (*p == Ch('+') || *p == Ch('-'))) {
+				negative = *p == Ch('-');
+				++p;
+			}
+			const U limit = std::numeric_limits< U >::max();
+			U x = 0;
+			bool overflow = false;
+			const Ch* const first = p;
+			for (; p != end; ++p) {
+				const unsigned d = digitValue(*p);
+				if (d >= 10) {
+					break;
+				}
+				if (x > (limit - d) / 10U) {
+					overflow = true;
+				} else {
+					x = static_cast< U >(x * 10U + d);
+				}
+			}
+			if (p == first || p != end) {
+				message = "invalid integer";
+				return false;
+			}
+			if (overflow || negative) {
+				message = "out of range";
+				return false;
+			}
+			value = x;
+			return true;
+		}
+
+		/**
+		 * Converts a given string into a floating point number.
+		 *
+		 * A plain decimal number which has at most 19 significant digits
+		 * and a small exponent is converted without `strtod`.
+		 * The result is exact in that case, because both of the mantissa and
+		 * the power of 10 are exactly representable by `double`.
+		 * Any other string, including an invalid one, is passed to
+		 * `DefaultFormatterHelper::toFloat`.
+		 *
+		 * @tparam F
+		 *     Type which represents a floating point number.
+		 * @tparam Ch
+		 *     Type which represents a character.
+		 * @param valueStr
+		 *     String to be converted.
+		 * @return
+		 *     `F` value equivalent to `valueStr`.
+		 * @throws BadValue< Ch >
+		 *     If `valueStr` is empty,
+		 *     or if `valueStr` is not a number,
+		 *     or if `valueStr` is out of the range representable by `F`.
+		 */
+		template < typename F, typename Ch >
+		static F toFloat(const StringView< Ch >& valueStr) {
+			F x = 0;
+			const char* message = "";
+			if (!tryToFloat(valueStr, x, message)) {
+				OPTPARSE_THROW(BadValue< Ch >(message, valueStr.str()));
+			}
+			return x;
+		}
+
+		/**
+		 * Non-throwing version of `toFloat`.
+		 *
+		 * @param valueStr
+		 *     String to be converted.
+		 * @param[out] value
+		 *     Set to the `F` value equivalent to `valueStr` if succeeded.
+		 * @param[out] message
+		 *     Set to the message of the `BadValue` which `toFloat` would
+		 *     throw if failed.
+		 * @return
+		 *     Whether `valueStr` is a valid `F` value.
+		 */
+		template < typename F, typename Ch >
+		static bool tryToFloat(const StringView< Ch >& valueStr,
+							   F& value,
+							   const char*& message)
+		{
+			double x;
+			if (!fastToDouble(valueStr, x)) {
+				return DefaultFormatterHelper::tryToFloat(
+					valueStr, value, message);
+			}
+			if (x > std::numeric_limits< F >::max()
+				|| x < std::numeric_limits< F >::lowest())
+			{
+				message = "out of range";
+				return false;
+			}
+			value = static_cast< F >(x);
+			return true;
+		}
+
+		/**
+		 * Converts a given string into a `double` value if it is simple.
+		 *
+		 * @param valueStr
+		 *     String to be converted.
+		 * @param[out] x
+		 *     Set to the value equivalent to `valueStr` if this function
+		 *     returns `true`. Unspecified otherwise.
+		 * @return
+		 *     Whether `valueStr` is simple enough to be converted exactly.
+		 */
+		template < typename Ch >
+		static bool fastToDouble(const StringView< Ch >& valueStr, double& x) {
+			// 10^n exactly representable by double
+			static const double POWERS_OF_10[] = {
+				1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+				1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+				1e21, 1e22
+			};
+			static const int MAX_EXPONENT = 22;
+			static const int MAX_DIGITS = 19;
+			// 2^53
+			static const unsigned long long MAX_EXACT_MANTISSA =
+				9007199254740992ULL;
+			const Ch* p = valueStr.begin();
+			const Ch* const end = valueStr.end();
+			while (p != end && isSpace(*p)) {
+				++p;
+			}
+			bool negative = false;
+			if (p != end && (*p == Ch('+') || *p == Ch('-'))) {
+				negative = *p == Ch('-');
+				++p;
+			}
+			unsigned long long mantissa = 0;
+			int digits = 0;
+			int exponent = 0;
+			bool hasDigit = false;
+			// integer part
+			for (; p != end && digitValue(*p) < 10; ++p) {
+				hasDigit = true;
+				if (mantissa != 0 || *p != Ch('0')) {
+					if (++digits > MAX_DIGITS) {
+						return false;
+					}
+					mantissa = mantissa * 10U + digitValue(*p);
+				}
+			}
+			// fraction part
+			if (p != end && *p == Ch('.')) {
+				for (++p; p != end && digitValue(*p) < 10; ++p) {
+					hasDigit = true;
+					if (mantissa != 0 || *p != Ch('0')) {
+						if (++digits > MAX_DIGITS) {
+							return false;
+						}
+						mantissa = mantissa * 10U + digitValue(*p);
+					}
+					--exponent;
+				}
+			}
+			if (!hasDigit) {
+				return false;
+			}
+			// exponent part
+			if (p != end && (*p == Ch('e') || *p == Ch('E'))) {
+				++p;
+				bool negativeExponent = false;
+				if (p != end && (*p == Ch('+') || *p == Ch('-'))) {
+					negativeExponent = *p == Ch('-');
+					++p;
+				}
+				if (p == end) {
+					return false;
+				}
+				int e = 0;
+				for (; p != end && digitValue(*p) < 10; ++p) {
+					if (e > 1000) {
+						return false;
+					}
+					e = e * 10 + static_cast< int >(digitValue(*p));
+				}
+				exponent += negativeExponent ? -e : e;
+			}
+			if (p != end) {
+				return false;
+			}
+			if (mantissa > MAX_EXACT_MANTISSA) {
+				return false;
+			}
+			if (mantissa == 0) {
+				x = negative ? -0.0 : 0.0;
+				return true;
+			}
+			if (exponent < -MAX_EXPONENT || exponent > MAX_EXPONENT) {
+				return false;
+			}
+			x = static_cast< double >(mantissa);
+			if (exponent < 0) {
+				x /= POWERS_OF_10[-exponent];
+			} else {
+				x *= POWERS_OF_10[exponent];
+			}
+			if (negative) {
+				x = -x;
+			}
+			return true;
+		}
+	};
+
+	/**
+	 * Value formatter which converts numbers without the C library.
+	 *
+	 * A drop-in replacement of `DefaultFormatter` as `MetaFormat` of
+	 * `OptionParserBase`.
+	 *
+	 *     OptionParserBase< Options, char, FastFormatter >
+	 *
+	 * Integers are parsed by hand instead of `strtoll` and `strtoull`.
+	 * Simple decimal floating point numbers are parsed by hand instead of
+	 * `strtod`, and the others are still parsed by `strtod`.
+	 * Accepted strings, results and `BadValue` messages are the same as
+	 * `DefaultFormatter` as long as the "C" locale is in effect.
+	 * Values of non-numerical types are converted by `DefaultFormatter`.
+	 *
+	 * @tparam T
+	 *     Type which represents a value.
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename T, typename Ch >
+	class FastFormatter {
+	private:
+		/** Tag for signed integers. */
+		typedef std::integral_constant< int, 0 > SignedTag;
+
+		/** Tag for unsigned integers. */
+		typedef std::integral_constant< int, 1 > UnsignedTag;
+
+		/** Tag for floating point numbers. */
+		typedef std::integral_constant< int, 2 > FloatTag;
+
+		/** Tag for the other types. */
+		typedef std::integral_constant< int, 3 > OtherTag;
+
+		/** Tag for `T`. */
+		typedef std::integral_constant<
+			int,
+			std::is_integral< T >::value && !std::is_same< T, bool >::value
+				? (std::is_signed< T >::value ? 0 : 1)
+				: (std::is_floating_point< T >::value ? 2 : 3) > Tag;
+	public:
+		/**
+		 * Converts a given string into a value of the type `T`.
+		 *
+		 * @param valueStr
+		 *     String to be converted into a `T` value.
+		 * @return
+		 *     `T` value equivalent to `valueStr`.
+		 * @throws BadValue< Ch >
+		 *     If `valueStr` is invalid.
+		 */
+		inline T operator ()(const StringView< Ch >& valueStr) const {
+			return format(valueStr, Tag());
+		}
+
+		/**
+		 * Converts a given string into a value of the type `T` without
+		 * throwing an exception.
+		 *
+		 * Unavailable if `T` is not a number and `DefaultFormatter` of `T`
+		 * has no `tryFormat`.
+		 *
+		 * @param valueStr
+		 *     String to be converted into a `T` value.
+		 * @param[out] value
+		 *     Set to the `T` value equivalent to `valueStr` if succeeded.
+		 * @param[out] message
+		 *     Set to a brief explanation if failed.
+		 * @return
+		 *     Whether `valueStr` is valid.
+		 */
+		template < typename U >
+		inline typename std::enable_if<
+			std::is_same< U, T >::value
+				&& (Tag::value != OtherTag::value
+					|| FormatInvoker< DefaultFormatter< U, Ch >, Ch >
+						::template HasTryFormat< U >::value),
+			bool >::type tryFormat(const StringView< Ch >& valueStr,
+								   U& value,
+								   const char*& message) const
+		{
+			return tryFormat(valueStr, value, message, Tag());
+		}
+	private:
+		/** Converts a signed integer. */
+		static inline T format(const StringView< Ch >& valueStr, SignedTag) {
+			return FastFormatterHelper::toSigned< T >(valueStr);
+		}
+
+		/** Converts an unsigned integer. */
+		static inline T format(const StringView< Ch >& valueStr, UnsignedTag) {
+			return FastFormatterHelper::toUnsigned< T >(valueStr);
+		}
+
+		/** Converts a floating point number. */
+		static inline T format(const StringView< Ch >& valueStr, FloatTag) {
+			return FastFormatterHelper::toFloat< T >(valueStr);
+		}
+
+		/** Converts the other value. */
+		static inline T format(const StringView< Ch >& valueStr, OtherTag) {
+			return DefaultFormatter< T, Ch >()(valueStr);
+		}
+
+		/** Converts a signed integer without throwing. */
+		static inline bool tryFormat(const StringView< Ch >& valueStr,
+									 T& value,
+									 const char*& message,
+									 SignedTag)
+		{
+			return FastFormatterHelper::tryToSigned(valueStr, value, message);
+		}
+
+		/** Converts an unsigned integer without throwing. */
+		static inline bool tryFormat(const StringView< Ch >& valueStr,
+									 T& value,
+									 const char*& message,
+									 UnsignedTag)
+		{
+			return FastFormatterHelper::tryToUnsigned(
+				valueStr, value, message);
+		}
+
+		/** Converts a floating point number without throwing. */
+		static inline bool tryFormat(const StringView< Ch >& valueStr,
+									 T& value,
+									 const char*& message,
+									 FloatTag)
+		{
+			return FastFormatterHelper::tryToFloat(valueStr, value, message);
+		}
+
+		/** Converts the other value without throwing. */
+		static inline bool tryFormat(const StringView< Ch >& valueStr,
+									 T& value,
+									 const char*& message,
+									 OtherTag)
+		{
+			return DefaultFormatter< T, Ch >().tryFormat(
+				valueStr, value, message);
+		}
+	};
+
+}
+
+#endif
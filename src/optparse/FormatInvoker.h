@@ -0,0 +1,223 @@
+#ifndef _OPTPARSE_OPTPARSE_FORMAT_INVOKER_H
+#define _OPTPARSE_OPTPARSE_FORMAT_INVOKER_H
+
+#include "optparse/OptionParserException.h"
+#include "optparse/StringView.h"
+
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace optparse {
+
+	/**
+	 * Calls a formatter with a view of a value string.
+	 *
+	 * If `Format` accepts `StringView< Ch >`, the view is passed as it is.
+	 * Otherwise, the view is copied into a `std::basic_string< Ch >`, which
+	 * is passed to `Format`.
+	 *
+	 * `Format` may also have the following member function, which reports
+	 * a failure without throwing an exception.
+	 *
+	 *     bool tryFormat(const StringView< Ch >& str,
+	 *                    T& value,
+	 *                    const char*& message) const
+	 *
+	 * It must set `value` and return `true` if `str` is valid.
+	 * Otherwise, it must set `message` to a brief explanation in static
+	 * storage, return `false`, and leave `value` untouched.
+	 * `tryInvoke` uses it if it exists.
+	 *
+	 * @tparam Format
+	 *     Type of a formatter.
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename Format, typename Ch >
+	class FormatInvoker {
+	private:
+		/** Tests if `F` accepts `StringView< Ch >`. */
+		template < typename F >
+		static auto test(int) -> decltype(
+			std::declval< const F& >()(
+				std::declval< const StringView< Ch >& >()),
+			std::true_type());
+
+		/** Fallback of `test`. */
+		template < typename >
+		static std::false_type test(...);
+
+		/** Tests if `F` has `tryFormat` which outputs `T`. */
+		template < typename F, typename T >
+		static auto testTry(int) -> decltype(
+			std::declval< const F& >().tryFormat(
+				std::declval< const StringView< Ch >& >(),
+				std::declval< T& >(),
+				std::declval< const char*& >()),
+			std::true_type());
+
+		/** Fallback of `testTry`. */
+		template < typename, typename >
+		static std::false_type testTry(...);
+
+		/** Passes a view if `F` accepts it. */
+		template < typename F >
+		static inline auto dispatch(const F& format,
+									const StringView< Ch >& value,
+									std::true_type)
+			-> decltype(format(value))
+		{
+			return format(value);
+		}
+
+		/** Passes a string copied from a view otherwise. */
+		template < typename F >
+		static inline auto dispatch(const F& format,
+									const StringView< Ch >& value,
+									std::false_type)
+			-> decltype(format(value.str()))
+		{
+			return format(value.str());
+		}
+	public:
+		/** Whether `Format` accepts `StringView< Ch >`. */
+		typedef decltype(test< Format >(0)) AcceptsView;
+
+		/** Whether `Format` has `tryFormat` which outputs `T`. */
+		template < typename T >
+		struct HasTryFormat : public decltype(testTry< Format, T >(0)) {};
+
+		/**
+		 * Calls a given formatter with a given value.
+		 *
+		 * @param format
+		 *     Formatter to be called.
+		 * @param value
+		 *     Value string to be formatted.
+		 * @return
+		 *     Value returned by `format`.
+		 */
+		static inline auto invoke(const Format& format,
+								  const StringView< Ch >& value)
+			-> decltype(dispatch(format, value, AcceptsView()))
+		{
+			return dispatch(format, value, AcceptsView());
+		}
+
+		/**
+		 * Calls a given formatter with a given value without throwing
+		 * `BadValue`.
+		 *
+		 * Calls `tryFormat` of `format` if it exists.
+		 * Otherwise, calls `format` and catches `BadValue` if exceptions are
+		 * available.
+		 *
+		 * @tparam T
+		 *     Type of the formatted value.
+		 * @param format
+		 *     Formatter to be called.
+		 * @param value
+		 *     Value string to be formatted.
+		 * @param label
+		 *     Label or name of the option which takes `value`.
+		 * @param[out] out
+		 *     Set to the formatted value if formatting succeeds.
+		 *     Left untouched otherwise.
+		 * @param[out] result
+		 *     Set to a `BAD_VALUE` result if formatting fails.
+		 * @return
+		 *     Whether formatting has succeeded.
+		 */
+		template < typename T >
+		static bool tryInvoke(const Format& format,
+							  const StringView< Ch >& value,
+							  const StringView< Ch >& label,
+							  T& out,
+							  ParseResult< Ch >& result)
+		{
+			return tryDispatch(format, value, label, out, result,
+							   decltype(testTry< Format, T >(0))());
+		}
+	private:
+		/** Calls `tryFormat` if `F` has it. */
+		template < typename F, typename T >
+		static inline bool tryDispatch(const F& format,
+									   const StringView< Ch >& value,
+									   const StringView< Ch >& label,
+									   T& out,
+									   ParseResult< Ch >& result,
+									   std::true_type)
+		{
+			const char* message = "";
+			if (!format.tryFormat(value, out, message)) {
+				result = ParseResult< Ch >(
+					ParseResult< Ch >::BAD_VALUE, message, label, value);
+				return false;
+			}
+			return true;
+		}
+
+		/** Calls `F` and catches `BadValue` otherwise. */
+		template < typename F, typename T >
+		static inline bool tryDispatch(const F& format,
+									   const StringView< Ch >& value,
+									   const StringView< Ch >& label,
+									   T& out,
+									   ParseResult< Ch >& result,
+									   std::false_type)
+		{
+#if OPTPARSE_EXCEPTIONS
+			try {
+				out = invoke(format, value);
+			} catch (BadValue< Ch >& ex) {
+				result = ParseResult< Ch >(ParseResult< Ch >::BAD_VALUE,
+										   ex.getMessage(),
+										   label,
+										   value);
+				return false;
+			}
+#else
+			(void)label;
+			(void)result;
+			out = invoke(format, value);
+#endif
+			return true;
+		}
+	};
+
+	/**
+	 * Calls a given formatter with a given value.
+	 *
+	 * Equivalent to `FormatInvoker< Format, Ch >::invoke(format, value)`.
+	 */
+	template < typename Format, typename Ch >
+	inline auto invokeFormat(const Format& format,
+							 const StringView< Ch >& value)
+		-> decltype(FormatInvoker< Format, Ch >::invoke(format, value))
+	{
+		return FormatInvoker< Format, Ch >::invoke(format, value);
+	}
+
+	/**
+	 * Calls a given formatter with a given value without throwing `BadValue`.
+	 *
+	 * Equivalent to the following call,
+	 *
+	 *     FormatInvoker< Format, Ch >::tryInvoke(
+	 *         format, value, label, out, result)
+	 */
+	template < typename Format, typename Ch, typename T >
+	inline bool tryInvokeFormat(const Format& format,
+								const StringView< Ch >& value,
+								const StringView< Ch >& label,
+								T& out,
+								ParseResult< Ch >& result)
+	{
+		return FormatInvoker< Format, Ch >::tryInvoke(
+			format, value, label, out, result);
+	}
+
+}
+
+#endif
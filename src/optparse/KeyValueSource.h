@@ -0,0 +1,334 @@
+#ifndef _OPTPARSE_OPTPARSE_KEY_VALUE_SOURCE_H
+#define _OPTPARSE_OPTPARSE_KEY_VALUE_SOURCE_H
+
+#include "optparse/ResponseFile.h"
+#include "optparse/StringView.h"
+
+#include <cstddef>
+#include <string>
+
+namespace optparse {
+
+	/**
+	 * Source of option values other than the command line; e.g.,
+	 * environment variables or a configuration file.
+	 *
+	 * A source yields pairs of an option label and a value.
+	 * `OptionParserBase::tryParseWithSources` looks up the labels
+	 * and formats the values in the same way as the command line.
+	 *
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename Ch >
+	class KeyValueSource {
+	public:
+		/** Non-owning view of a string of `Ch`. */
+		typedef optparse::StringView< Ch > StringView;
+	public:
+		/** Releases resources. */
+		virtual ~KeyValueSource() {}
+
+		/**
+		 * Reads the next pair of a label and a value.
+		 *
+		 * @param[out] label
+		 *     Set to the label of an option; e.g., "--jobs".
+		 *     Valid until this function is called again.
+		 * @param[out] value
+		 *     Set to the value. Empty if no value is given.
+		 *     Valid as long as this source lives.
+		 * @return
+		 *     Whether a pair has been read. `false` at the end.
+		 */
+		virtual bool next(StringView& label, StringView& value) = 0;
+
+		/**
+		 * Returns whether a label which no option has is skipped instead of
+		 * being reported as `UNKNOWN_OPTION`. `false` by default.
+		 */
+		virtual bool ignoresUnknownLabels() const {
+			return false;
+		}
+
+		/**
+		 * Returns whether a given value turns off an option which takes no
+		 * value.
+		 *
+		 * "0", "false", "no" and "off" in any case turn off an option.
+		 *
+		 * @param value
+		 *     Value given to an option which takes no value.
+		 * @return
+		 *     Whether `value` is one of the values above.
+		 */
+		static bool isOff(const StringView& value) {
+			static const char* const OFF[] = { "0", "false", "no", "off" };
+			for (size_t i = 0; i < sizeof(OFF) / sizeof(OFF[0]); ++i) {
+				if (equalsIgnoringCase(value, OFF[i])) {
+					return true;
+				}
+			}
+			return false;
+		}
+	protected:
+		/**
+		 * Makes a label from a given key.
+		 *
+		 * A key which starts with a dash is a label as it is.
+		 * Otherwise, the label is "--" followed by the key of which
+		 * letters are lowered and underscores (`_`) are replaced with
+		 * dashes; e.g., "MAX_JOBS" becomes "--max-jobs".
+		 *
+		 * @param key
+		 *     Key to be converted.
+		 * @param[out] label
+		 *     Set to the label. Reused to avoid allocations.
+		 */
+		static void makeLabel(const StringView& key,
+							  std::basic_string< Ch >& label)
+		{
+			if (!key.empty() && key[0] == Ch('-')) {
+				label.assign(key.data(), key.size());
+				return;
+			}
+			label.assign(2, Ch('-'));
+			for (size_t i = 0; i < key.size(); ++i) {
+				Ch c = key[i];
+				if (c == Ch('_')) {
+					c = Ch('-');
+				} else if (c >= Ch('A') && c <= Ch('Z')) {
+					c = static_cast< Ch >(c - Ch('A') + Ch('a'));
+				}
+				label += c;
+			}
+		}
+	private:
+		/** Compares a given value with an ASCII string ignoring case. */
+		static bool equalsIgnoringCase(const StringView& value,
+									   const char* str)
+		{
+			size_t i = 0;
+			for (; i < value.size() && str[i] != '\0'; ++i) {
+				Ch c = value[i];
+				if (c >= Ch('A') && c <= Ch('Z')) {
+					c = static_cast< Ch >(c - Ch('A') + Ch('a'));
+				}
+				if (c != static_cast< Ch >(str[i])) {
+					return false;
+				}
+			}
+			return i == value.size() && str[i] == '\0';
+		}
+	};
+
+	/**
+	 * Environment variables as a source of option values.
+	 *
+	 * Only the variables whose names start with a given prefix are read.
+	 * The rest of a name makes a label (see `KeyValueSource::makeLabel`);
+	 * e.g., `APP_MAX_JOBS=4` with the prefix "APP_" gives "4" to
+	 * "--max-jobs".
+	 * Variables which no option corresponds to are skipped.
+	 *
+	 * The environment block is read in place, and only the label is built
+	 * in a buffer reused for every variable.
+	 *
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename Ch >
+	class EnvironmentSource : public KeyValueSource< Ch > {
+	public:
+		/** Non-owning view of a string of `Ch`. */
+		typedef optparse::StringView< Ch > StringView;
+
+		/** String of `Ch`. */
+		typedef std::basic_string< Ch > String;
+	private:
+		/** Next variable. */
+		const Ch* const* env;
+
+		/** Prefix of the names of the variables to be read. */
+		String prefix;
+
+		/** Buffer of a label. */
+		String label;
+	public:
+		/**
+		 * Initializes with an environment block and a prefix.
+		 *
+		 * @param env
+		 *     Environment block; i.e., a null-terminated array of
+		 *     `NAME=VALUE`. Usually `environ` or the third argument of
+		 *     `main`. Must outlive this source.
+		 * @param prefix
+		 *     Prefix of the names of the variables to be read.
+		 */
+		EnvironmentSource(const Ch* const* env, const String& prefix)
+			: env(env), prefix(prefix) {}
+
+		/** Reads the next variable which has the prefix. */
+		virtual bool next(StringView& label, StringView& value) {
+			for (; this->env != 0 && *this->env != 0; ++this->env) {
+				const StringView entry(*this->env);
+				const size_t eqPos = entry.find(Ch('='));
+				if (eqPos == StringView::npos
+					|| eqPos <= this->prefix.size()
+					|| !(entry.substr(0, this->prefix.size())
+						 == StringView(this->prefix)))
+				{
+					continue;
+				}
+				this->makeLabel(
+					entry.substr(this->prefix.size(),
+								 eqPos - this->prefix.size()),
+					this->label);
+				label = StringView(this->label);
+				value = entry.substr(eqPos + 1);
+				++this->env;
+				return true;
+			}
+			return false;
+		}
+
+		/** Returns `true`; unrelated variables may have the prefix. */
+		virtual bool ignoresUnknownLabels() const {
+			return true;
+		}
+	};
+
+	/**
+	 * Configuration of `key=value` lines as a source of option values.
+	 *
+	 * Each line is one of the followings,
+	 *  - `key=value`: gives `value` to the option of `key`
+	 *    (see `KeyValueSource::makeLabel`)
+	 *  - `key`: specifies the option of `key` without a value
+	 *  - empty, or a comment starting with `#` or `;`
+	 *  - `[section]`, which is ignored
+	 *
+	 * Whitespace around keys and values is ignored.
+	 * The contents are read in place, and may be a file mapped into memory
+	 * by `open`.
+	 * An unknown key is reported as `UNKNOWN_OPTION`.
+	 *
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename Ch >
+	class ConfigSource : public KeyValueSource< Ch > {
+	public:
+		/** Non-owning view of a string of `Ch`. */
+		typedef optparse::StringView< Ch > StringView;
+
+		/** String of `Ch`. */
+		typedef std::basic_string< Ch > String;
+	private:
+		/** File opened by `open`. */
+		ResponseFile< Ch > file;
+
+		/** Next character to be read. */
+		const Ch* in;
+
+		/** End of the contents. */
+		const Ch* last;
+
+		/** Buffer of a label. */
+		String label;
+	public:
+		/** Initializes with no contents. */
+		inline ConfigSource() : in(0), last(0) {}
+
+		/**
+		 * Initializes with given contents.
+		 *
+		 * @param first
+		 *     Beginning of the contents. Must outlive this source.
+		 * @param last
+		 *     End of the contents.
+		 */
+		inline ConfigSource(const Ch* first, const Ch* last)
+			: in(first), last(last) {}
+
+		/**
+		 * Reads a given file as the contents.
+		 *
+		 * The file is read by `ResponseFile`, so it is mapped into memory
+		 * where possible.
+		 *
+		 * @param path
+		 *     Path to the file.
+		 * @return
+		 *     Whether the file has been opened.
+		 */
+		template < typename PathCh >
+		bool open(const PathCh* path) {
+			if (!this->file.open(path)) {
+				this->in = this->last = 0;
+				return false;
+			}
+			this->in = this->file.begin();
+			this->last = this->file.end();
+			return true;
+		}
+
+		/** Reads the next `key=value` or `key` line. */
+		virtual bool next(StringView& label, StringView& value) {
+			while (this->in != this->last) {
+				const Ch* first = this->in;
+				const Ch* end = first;
+				while (end != this->last && *end != Ch('\n')) {
+					++end;
+				}
+				this->in = end != this->last ? end + 1 : end;
+				const StringView line = trim(first, end);
+				if (line.empty() || line[0] == Ch('#') || line[0] == Ch(';')
+					|| line[0] == Ch('['))
+				{
+					continue;
+				}
+				const size_t eqPos = line.find(Ch('='));
+				if (eqPos == StringView::npos) {
+					this->makeLabel(line, this->label);
+					value = StringView();
+				} else {
+					const StringView key = line.substr(0, eqPos);
+					this->makeLabel(
+						trim(key.data(), key.data() + key.size()),
+						this->label);
+					const StringView rest = line.substr(eqPos + 1);
+					value = trim(rest.data(), rest.data() + rest.size());
+				}
+				label = StringView(this->label);
+				return true;
+			}
+			return false;
+		}
+	private:
+		/** Returns whether a given character is whitespace. */
+		static inline bool isSpace(Ch c) {
+			return c == Ch(' ') || c == Ch('\t') || c == Ch('\r');
+		}
+
+		/** Returns a view of [`first`, `last`) without whitespace around. */
+		static StringView trim(const Ch* first, const Ch* last) {
+			while (first != last && isSpace(*first)) {
+				++first;
+			}
+			while (last != first && isSpace(last[-1])) {
+				--last;
+			}
+			return StringView(first, static_cast< size_t >(last - first));
+		}
+
+		/** Copy is not allowed. */
+		ConfigSource(const ConfigSource&) = delete;
+
+		/** Assignment is not allowed. */
+		void operator =(const ConfigSource&) = delete;
+	};
+
+}
+
+#endif
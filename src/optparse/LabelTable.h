@@ -0,0 +1,302 @@
+#ifndef _OPTPARSE_OPTPARSE_LABEL_TABLE_H
+#define _OPTPARSE_OPTPARSE_LABEL_TABLE_H
+
+#include "optparse/StringView.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace optparse {
+
+	/**
+	 * Immutable hash table which maps a label to an integer.
+	 *
+	 * All of the labels are copied into a single contiguous pool, and
+	 * the slots are stored in a single contiguous array.
+	 * A table is built at once by `build` and never changes afterward,
+	 * so concurrent lookups are safe.
+	 *
+	 * The number of the slots is the smallest power of two which keeps
+	 * the load factor at most 1/2.
+	 * `build` searches for a hash seed which places as many labels as
+	 * possible in their own slots, so that a lookup usually costs one hash
+	 * and one comparison.
+	 * Colliding labels are resolved by linear probing.
+	 *
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename Ch >
+	class LabelTable {
+	public:
+		/** String of `Ch`. */
+		typedef std::basic_string< Ch > String;
+
+		/** View of a string of `Ch`. */
+		typedef optparse::StringView< Ch > StringView;
+
+		/** Pair of a label and a value. */
+		typedef std::pair< StringView, int > Entry;
+	private:
+		/** Slot of the table. */
+		struct Slot {
+			/** Hash value of the label. */
+			size_t hash;
+
+			/** Offset of the label in the pool. */
+			size_t offset;
+
+			/** Length of the label. */
+			size_t size;
+
+			/** Value associated with the label. -1 if the slot is empty. */
+			int value;
+		};
+
+		/** Maximum number of seeds tried. */
+		static const unsigned MAX_SEED_TRIALS = 8;
+
+		/** Pool of the labels. */
+		String pool;
+
+		/** Slots. The size is always a power of two or zero. */
+		std::vector< Slot > slots;
+
+		/** Seed of the hash function. */
+		size_t seed;
+
+		/** Number of the entries. */
+		size_t count;
+	public:
+		/** Initializes an empty table. */
+		inline LabelTable() : seed(0), count(0) {}
+
+		/**
+		 * Builds this table from given entries.
+		 *
+		 * Previous contents of this table are discarded.
+		 * Labels must be unique.
+		 * The views in `entries` are not referenced after this call.
+		 *
+		 * @param entries
+		 *     Pairs of a label and a value.
+		 *     Every value must be non-negative.
+		 */
+		void build(const std::vector< Entry >& entries) {
+			// copies the labels into the pool
+			std::vector< size_t > offsets;
+			offsets.reserve(entries.size());
+			size_t poolSize = 0;
+			for (size_t i = 0; i < entries.size(); ++i) {
+				poolSize += entries[i].first.size();
+			}
+			this->pool.clear();
+			this->pool.reserve(poolSize);
+			for (size_t i = 0; i < entries.size(); ++i) {
+				offsets.push_back(this->pool.size());
+				this->pool.append(
+					entries[i].first.data(), entries[i].first.size());
+			}
+			this->count = entries.size();
+			this->slots.clear();
+			if (entries.empty()) {
+				return;
+			}
+			// keeps the load factor at most 1/2
+			size_t tableSize = 1;
+			while (tableSize < entries.size() * 2) {
+				tableSize <<= 1;
+			}
+			// searches for the seed which causes the fewest collisions
+			// and stops at a collision-free one
+			std::vector< char > occupied;
+			size_t bestCollisions = entries.size();
+			size_t bestSeed = 0;
+			for (unsigned trial = 0;
+				 bestCollisions > 0 && trial < MAX_SEED_TRIALS;
+				 ++trial)
+			{
+				occupied.assign(tableSize, 0);
+				size_t collisions = 0;
+				for (size_t i = 0;
+					 collisions < bestCollisions && i < entries.size();
+					 ++i)
+				{
+					const size_t j =
+						hash(entries[i].first, trial) & (tableSize - 1);
+					if (occupied[j]) {
+						++collisions;
+					}
+					occupied[j] = 1;
+				}
+				if (collisions < bestCollisions) {
+					bestCollisions = collisions;
+					bestSeed = trial;
+				}
+			}
+			// colliding labels are resolved by linear probing
+			this->seed = bestSeed;
+			this->fill(entries, offsets, tableSize);
+		}
+
+		/** Removes all of the entries. */
+		void clear() {
+			this->pool.clear();
+			this->slots.clear();
+			this->seed = 0;
+			this->count = 0;
+		}
+
+		/**
+		 * Returns the number of the entries.
+		 *
+		 * @return
+		 *     Number of the entries.
+		 */
+		inline size_t size() const {
+			return this->count;
+		}
+
+		/**
+		 * Returns whether this table has no entries.
+		 *
+		 * @return
+		 *     Whether this table has no entries.
+		 */
+		inline bool empty() const {
+			return this->count == 0;
+		}
+
+		/**
+		 * Returns the seed of the hash function.
+		 *
+		 * @return
+		 *     Seed passed to `hash` for the labels in this table.
+		 */
+		inline size_t getSeed() const {
+			return this->seed;
+		}
+
+		/**
+		 * Returns the number of the slots.
+		 *
+		 * @return
+		 *     Number of the slots. A power of two or zero.
+		 */
+		inline size_t getSlotCount() const {
+			return this->slots.size();
+		}
+
+		/**
+		 * Returns the value in the slot at a given index.
+		 *
+		 * The label in the slot `j` has the hash value whose lower bits
+		 * are `j`, or it is placed in the next empty slot.
+		 * Together with `getSeed`, this reproduces the table elsewhere;
+		 * e.g., in a `ParserSnapshot`.
+		 *
+		 * @param j
+		 *     Index of the slot. Must be less than `getSlotCount()`.
+		 * @return
+		 *     Value in the slot at `j`. -1 if the slot is empty.
+		 */
+		inline int getSlotValue(size_t j) const {
+			return this->slots[j].value;
+		}
+
+		/**
+		 * Finds the value associated with a given label.
+		 *
+		 * Never allocates memory.
+		 *
+		 * @param label
+		 *     Label to be searched.
+		 * @return
+		 *     Value associated with `label`. -1 if `label` is not found.
+		 */
+		int find(const StringView& label) const {
+			if (this->slots.empty()) {
+				return -1;
+			}
+			const size_t h = hash(label, this->seed);
+			const size_t mask = this->slots.size() - 1;
+			for (size_t j = h & mask; ; j = (j + 1) & mask) {
+				const Slot& slot = this->slots[j];
+				if (slot.value < 0) {
+					return -1;
+				}
+				if (slot.hash == h
+					&& slot.size == label.size()
+					&& (slot.size == 0
+						|| StringView::Traits::compare(
+							this->pool.data() + slot.offset,
+							label.data(),
+							slot.size) == 0))
+				{
+					return slot.value;
+				}
+			}
+		}
+
+		/**
+		 * Computes the hash value of a given label.
+		 *
+		 * FNV-1a applied to the characters of `label`.
+		 *
+		 * @param label
+		 *     Label of which the hash value is to be computed.
+		 * @param seed
+		 *     Seed of the hash function.
+		 * @return
+		 *     Hash value of `label`.
+		 */
+		static size_t hash(const StringView& label, size_t seed) {
+			size_t h =
+				static_cast< size_t >(2166136261U) ^ (seed * 0x9E3779B9U);
+			for (size_t i = 0; i < label.size(); ++i) {
+				h ^= static_cast< size_t >(label[i]);
+				h *= static_cast< size_t >(16777619U);
+			}
+			// mixes the upper bits into the lower bits used for indexing
+			return h ^ (h >> 15);
+		}
+	private:
+		/**
+		 * Fills the slots with given entries.
+		 *
+		 * @param entries
+		 *     Pairs of a label and a value.
+		 * @param offsets
+		 *     Offsets of the labels in the pool.
+		 * @param tableSize
+		 *     Number of the slots. Must be a power of two.
+		 */
+		void fill(const std::vector< Entry >& entries,
+				  const std::vector< size_t >& offsets,
+				  size_t tableSize)
+		{
+			Slot empty = { 0, 0, 0, -1 };
+			this->slots.assign(tableSize, empty);
+			const size_t mask = tableSize - 1;
+			for (size_t i = 0; i < entries.size(); ++i) {
+				const size_t h = hash(entries[i].first, this->seed);
+				size_t j = h & mask;
+				while (this->slots[j].value >= 0) {
+					j = (j + 1) & mask;
+				}
+				Slot& slot = this->slots[j];
+				slot.hash = h;
+				slot.offset = offsets[i];
+				slot.size = entries[i].first.size();
+				slot.value = entries[i].second;
+			}
+		}
+	};
+
+	template < typename Ch >
+	const unsigned LabelTable< Ch >::MAX_SEED_TRIALS;
+
+}
+
+#endif
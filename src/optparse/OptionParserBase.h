@@ -1,14 +1,28 @@
 #ifndef _OPTPARSE_OPTPARSE_OPTION_PARSER_BASE_H
 #define _OPTPARSE_OPTPARSE_OPTION_PARSER_BASE_H
 
+#include "optparse/Arena.h"
+#include "optparse/ArgvSpan.h"
+#include "optparse/CommandLineTokenizer.h"
+#include "optparse/FormatInvoker.h"
+#include "optparse/KeyValueSource.h"
+#include "optparse/LabelTable.h"
 #include "optparse/OptionParserException.h"
 #include "optparse/OptionSpec.h"
+#include "optparse/ParseObserver.h"
+#include "optparse/ResponseFile.h"
+#include "optparse/StringPool.h"
+#include "optparse/StringView.h"
+#include "optparse/SuggestionIndex.h"
+#include "optparse/Transcoder.h"
 
 #include <algorithm>
-#include <map>
+#include <deque>
+#include <istream>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace optparse {
@@ -24,13 +38,34 @@ namespace optparse {
 	 *  2. Type which represents a character; i.e., `Ch`
 	 *
 	 * `MetaFormat` must support a default constructor, and an instance of
-	 * `MetaFormat` must support a function call similar to the following,
+	 * `MetaFormat` must support a function call similar to either of the
+	 * following,
 	 *
+	 *     T operator ()(const StringView< Ch >& str) const
 	 *     T operator ()(const std::basic_string< Ch >& str) const
 	 *
 	 * It must take a string representation of the value `str` and return the
 	 * formatted value.
 	 * If formatting fails, it must throw `BadValue< Ch >`.
+	 * It may also have `tryFormat` which reports a failure without
+	 * throwing (see `FormatInvoker`), which `tryParseInto` prefers.
+	 *
+	 * A `MetaFormat` which accepts `StringView< Ch >` receives a view of
+	 * the command line argument, and no string is built for the value.
+	 * The view is valid only during the call.
+	 * Otherwise, the value is copied into a `std::basic_string< Ch >` before
+	 * the call.
+	 *
+	 * ## Command Line Syntax
+	 *
+	 * An argument which is equal to the label of an option specifies
+	 * the option, and the next argument is its value if the option needs
+	 * a value.
+	 * If no option has the label, the following forms are also accepted,
+	 *  - `--label=value` gives `value` to the option `--label`
+	 *  - `-abc` specifies the single character options `-a`, `-b` and `-c`;
+	 *    if one of them needs a value, the rest of the argument is the
+	 *    value, or the next argument if the option is the last one
 	 *
 	 * ## Other Type Parameters
 	 *
@@ -55,42 +90,94 @@ namespace optparse {
 	 * a value of the type `T`.
 	 * A specialization of `MetaFormat` by default.
 	 * `Format` must support a copy constructor and an instance of `Format`
-	 * must support a function call similar to the following,
+	 * must support a function call similar to either of the following,
 	 *
+	 *     T operator ()(const StringView< Ch >& str) const
 	 *     T operator ()(const std::basic_string< Ch >& str) const
 	 *
 	 * It must take a string representation of a value and return the formatted
 	 * value.
 	 * If formatting fails, it must throw `BadValue< Ch >`.
+	 * `tryFormat` is used if `Format` has it as well as `MetaFormat`.
+	 * A view is passed if `Format` accepts it as well as `MetaFormat`.
 	 *
 	 * @tparam Opt
 	 *     Type of a container for option values.
-	 *     Must support a default constructor.
+	 *     Must support a default constructor to use `parse`.
+	 *     `parseInto` does not need a default constructor.
 	 * @tparam Ch
 	 *     Type which represents a character.
 	 * @tparam MetaFormat
 	 *     Template type which converts a string into a typed value.
+	 * @tparam Observer
+	 *     Type which observes parsing; e.g., `StatisticsObserver`.
+	 *     See `NullObserver` for the requirements.
+	 *     `NullObserver`, which observes nothing at no cost, by default.
 	 */
 	template < typename Opt,
 			   typename Ch,
-			   template < typename, typename > class MetaFormat >
+			   template < typename, typename > class MetaFormat,
+			   typename Observer = NullObserver >
 	class OptionParserBase {
 	public:
 		/** String of `Ch`. */
 		typedef std::basic_string< Ch > String;
+
+		/** Non-owning view of a string of `Ch`. */
+		typedef optparse::StringView< Ch > StringView;
+
+		/** Result of parsing. */
+		typedef optparse::ParseResult< Ch > ParseResult;
 	protected:
+		/**
+		 * Value of an option formatted apart from an options container.
+		 *
+		 * Made by `Option::tryConvert` and applied by
+		 * `Option::tryApplyConverted`.
+		 */
+		class Conversion {
+		public:
+			/** Releases resources. */
+			virtual ~Conversion() {}
+		};
+
+		/** Pointer to a conversion. */
+		typedef std::unique_ptr< Conversion > ConversionPtr;
+
+		/**
+		 * `Conversion` which holds a value of `V`.
+		 *
+		 * @tparam V
+		 *     Type of the value.
+		 */
+		template < typename V >
+		struct ConvertedValue : public Conversion {
+			/** Value. */
+			V value;
+
+			/** Initializes with a default value. */
+			inline ConvertedValue() : value() {}
+
+			/** Initializes with a given value. */
+			inline explicit ConvertedValue(const V& value) : value(value) {}
+		};
+
 		/** Processor for an optional argument. */
 		class Option : public OptionSpec< Ch > {
 		protected:
-			/** Label of this option. */
-			String label;
+			/** Label of this option. Pooled by the parser. */
+			const String& label;
 
-			/** Description of this option. */
-			String description;
+			/** Description of this option. Pooled by the parser. */
+			const String& description;
 		public:
 			/**
 			 * Initializes an option with a given description.
 			 *
+			 * The strings are referenced, not copied.
+			 * A parser passes the copies in its pools (see `labelPool` and
+			 * `textPool`), which outlive the option.
+			 *
 			 * @param label
 			 *     Label of the option.
 			 * @param description
@@ -147,7 +234,7 @@ namespace optparse {
 			 * @throws ValueNeeded
 			 *     If this option needs a value.
 			 */
-			virtual void operator ()(Opt& options) = 0;
+			virtual void operator ()(Opt& options) const = 0;
 
 			/**
 			 * Applies this option with a given value.
@@ -160,21 +247,150 @@ namespace optparse {
 			 *     If this option does not take a value,
 			 *     or if `value` is invalid.
 			 */
-			virtual void operator ()(Opt& options, const String& value) = 0;
+			virtual void operator ()(Opt& options,
+									 const StringView& value) const = 0;
+
+			/**
+			 * Applies this option without a value and without throwing
+			 * a parsing exception.
+			 *
+			 * Calls the function call operator and translates a parsing
+			 * exception into `result` by default.
+			 *
+			 * @param options
+			 *     Options container to which this option is to be applied.
+			 * @param[out] result
+			 *     Set to the error if this option cannot be applied.
+			 * @return
+			 *     Whether this option has been applied.
+			 */
+			virtual bool tryApply(Opt& options, ParseResult& result) const {
+				return catchParsingError(
+					[&]() { (*this)(options); },
+					this->label, StringView(), result);
+			}
+
+			/**
+			 * Applies this option with a given value and without throwing
+			 * a parsing exception.
+			 *
+			 * Calls the function call operator and translates a parsing
+			 * exception into `result` by default.
+			 *
+			 * @param options
+			 *     Options container to which this option is to be applied.
+			 * @param value
+			 *     Value given to this option.
+			 * @param[out] result
+			 *     Set to the error if this option cannot be applied.
+			 * @return
+			 *     Whether this option has been applied.
+			 */
+			virtual bool tryApply(Opt& options,
+								  const StringView& value,
+								  ParseResult& result) const
+			{
+				return catchParsingError(
+					[&]() { (*this)(options, value); },
+					this->label, value, result);
+			}
+
+			/**
+			 * Resets the field of an options container associated with this
+			 * option to the field of another options container.
+			 *
+			 * Does nothing by default; i.e., for an option which is not
+			 * associated with a field.
+			 */
+			virtual void reset(Opt&, const Opt&) const {}
+
+			/**
+			 * Prepares the field of an options container associated with
+			 * this option for a given number of values.
+			 *
+			 * Does nothing by default; i.e., for an option which does not
+			 * accumulate values.
+			 */
+			virtual void reserve(Opt&, size_t) const {}
+
+			/**
+			 * Returns whether this option can format a value apart from
+			 * an options container by `tryConvert`.
+			 *
+			 * `false` by default.
+			 */
+			virtual bool canConvert() const {
+				return false;
+			}
+
+			/**
+			 * Formats a given value without modifying an options container.
+			 *
+			 * Must be safe to be called concurrently for the same options
+			 * container as long as nothing modifies it.
+			 * Fails by default.
+			 *
+			 * @param options
+			 *     Options container which has the current fields.
+			 *     Never modified.
+			 * @param value
+			 *     Value given to this option.
+			 * @param[out] conversion
+			 *     Set to the formatted value to be applied by
+			 *     `tryApplyConverted`. May be set even if this function
+			 *     fails, in which case the partially formatted value should
+			 *     be applied before the error is reported.
+			 * @param[out] result
+			 *     Set to the error if `value` cannot be formatted.
+			 * @return
+			 *     Whether `value` has been formatted.
+			 */
+			virtual bool tryConvert(const Opt&,
+									const StringView&,
+									ConversionPtr&,
+									ParseResult&) const
+			{
+				return false;
+			}
+
+			/**
+			 * Applies a value formatted by `tryConvert`.
+			 *
+			 * @param[in,out] options
+			 *     Options container to which the value is applied.
+			 * @param value
+			 *     Value given to `tryConvert`.
+			 * @param conversion
+			 *     Formatted value made by `tryConvert` of this option.
+			 *     May be moved.
+			 * @param[out] result
+			 *     Set to the error if the value cannot be applied.
+			 * @return
+			 *     Whether the value has been applied.
+			 */
+			virtual bool tryApplyConverted(Opt&,
+										   const StringView&,
+										   Conversion&,
+										   ParseResult&) const
+			{
+				return false;
+			}
 		};
 
 		/** Processor for a positional argument. */
 		class Argument : public ArgumentSpec< Ch > {
 		protected:
-			/** Name of this argument. */
-			String name;
+			/** Name of this argument. Pooled by the parser. */
+			const String& name;
 
-			/** Description of this argument. */
-			String description;
+			/** Description of this argument. Pooled by the parser. */
+			const String& description;
 		public:
 			/**
 			 * Initializes with a description and a value name.
 			 *
+			 * The strings are referenced as in `Option`.
+			 *
 			 * @param name
 			 *     Name of this argument.
 			 * @param description
@@ -214,14 +430,49 @@ namespace optparse {
 			 *     If this argument does not take a value,
 			 *     or if `value` is invalid.
 			 */
-			virtual void operator ()(Opt& options, const String& value) = 0;
+			virtual void operator ()(Opt& options,
+									 const StringView& value) const = 0;
+
+			/**
+			 * Applies this argument with a given value and without throwing
+			 * a parsing exception.
+			 *
+			 * Calls the function call operator and translates a parsing
+			 * exception into `result` by default.
+			 *
+			 * @param options
+			 *     Options container to which this argument is to be applied.
+			 * @param value
+			 *     Value given to this argument.
+			 * @param[out] result
+			 *     Set to the error if this argument cannot be applied.
+			 * @return
+			 *     Whether this argument has been applied.
+			 */
+			virtual bool tryApply(Opt& options,
+								  const StringView& value,
+								  ParseResult& result) const
+			{
+				return catchParsingError(
+					[&]() { (*this)(options, value); },
+					this->name, value, result);
+			}
+
+			/**
+			 * Resets the field of an options container associated with this
+			 * argument to the field of another options container.
+			 *
+			 * Does nothing by default; i.e., for an argument which is not
+			 * associated with a field.
+			 */
+			virtual void reset(Opt&, const Opt&) const {}
 		};
 
 		/** `Option` which takes a value. */
 		class ValueOption : public Option {
 		protected:
-			/** Name of the option value. */
-			String valueName;
+			/** Name of the option value. Pooled by the parser. */
+			const String& valueName;
 		public:
 			/**
 			 * Initializes an option that takes a value with a given name.
@@ -249,9 +500,18 @@ namespace optparse {
 			}
 
 			/** Needs a value; i.e., throws `ValueNeeded`. */
-			virtual void operator ()(Opt&) {
-				throw ValueNeeded< Ch >(this->label);
+			virtual void operator ()(Opt&) const {
+				OPTPARSE_THROW(ValueNeeded< Ch >(this->label));
+			}
+
+			/** Needs a value; i.e., fails with `VALUE_NEEDED`. */
+			virtual bool tryApply(Opt&, ParseResult& result) const {
+				result = ParseResult(
+					ParseResult::VALUE_NEEDED, "needs value", this->label);
+				return false;
 			}
+
+			using Option::tryApply;
 		};
 
 		/** `Option` which does not take values. */
@@ -280,9 +540,23 @@ namespace optparse {
 			}
 
 			/** Does not take values; i.e., throws `BadValue`. */
-			virtual void operator ()(Opt&, const String&) {
-				throw BadValue< Ch >("no value needed", this->label);
+			virtual void operator ()(Opt&, const StringView&) const {
+				OPTPARSE_THROW(BadValue< Ch >("no value needed", this->label));
+			}
+
+			/** Does not take values; i.e., fails with `BAD_VALUE`. */
+			virtual bool tryApply(Opt&,
+								  const StringView& value,
+								  ParseResult& result) const
+			{
+				result = ParseResult(ParseResult::BAD_VALUE,
+									 "no value needed",
+									 this->label,
+									 value);
+				return false;
 			}
+
+			using Option::tryApply;
 		};
 
 		/**
@@ -332,13 +606,240 @@ namespace optparse {
 			 * Formats a given string and sets the field of a given options
 			 * container to the formatted value.
 			 */
-			virtual void operator ()(Opt& options, const String& value) {
-				try {
-					options.*(this->field) = this->format(value);
-				} catch (BadValue< Ch >& ex) {
-					// augments the exception with the label
-					throw BadValue< Ch >(ex.getMessage(), this->label, value);
+			virtual void operator ()(Opt& options,
+									 const StringView& value) const {
+				ParseResult result;
+				if (!this->tryApply(options, value, result)) {
+					result.raise();
+				}
+			}
+
+			/**
+			 * Formats a given string and sets the field of a given options
+			 * container to the formatted value without throwing `BadValue`.
+			 *
+			 * The field is left untouched if formatting fails.
+			 */
+			virtual bool tryApply(Opt& options,
+								  const StringView& value,
+								  ParseResult& result) const
+			{
+				return tryInvokeFormat(this->format,
+									   value,
+									   StringView(this->label),
+									   options.*(this->field),
+									   result);
+			}
+
+			using ValueOption::tryApply;
+
+			/** Copies the field of `defaults` into the field of `options`. */
+			virtual void reset(Opt& options, const Opt& defaults) const {
+				options.*(this->field) = defaults.*(this->field);
+			}
+
+			/** Formats in advance; i.e., returns `true`. */
+			virtual bool canConvert() const {
+				return true;
+			}
+
+			/** Formats a given string into a copy of the field. */
+			virtual bool tryConvert(const Opt& options,
+									const StringView& value,
+									ConversionPtr& conversion,
+									ParseResult& result) const
+			{
+				std::unique_ptr< ConvertedValue< T > > pValue(
+					new ConvertedValue< T >(options.*(this->field)));
+				if (!tryInvokeFormat(this->format,
+									 value,
+									 StringView(this->label),
+									 pValue->value,
+									 result))
+				{
+					return false;
+				}
+				conversion = std::move(pValue);
+				return true;
+			}
+
+			/** Sets the field to a formatted value. */
+			virtual bool tryApplyConverted(Opt& options,
+										   const StringView&,
+										   Conversion& conversion,
+										   ParseResult&) const
+			{
+				options.*(this->field) = std::move(
+					static_cast< ConvertedValue< T >& >(conversion).value);
+				return true;
+			}
+		};
+
+		/**
+		 * `Option` which appends values to a member vector.
+		 *
+		 * If a separator is given, a value is split by the separator and
+		 * each piece is formatted as a view of the value.
+		 *
+		 * @tparam T
+		 *     See `OptionParserBase`
+		 * @tparam SupOpt
+		 *     See `OptionParserBase`
+		 * @tparam Format
+		 *     See `OptionParserBase`
+		 */
+		template < typename T, typename SupOpt, typename Format >
+		class ListOption : public ValueOption {
+		private:
+			/** Field to which values are appended. */
+			std::vector< T > SupOpt::*field;
+
+			/** Separator of values. `Ch('\0')` if values are not split. */
+			Ch separator;
+
+			/** Formats a string as a value of `T`. */
+			Format format;
+		public:
+			/**
+			 * Initializes an option which appends values to a given field.
+			 *
+			 * @param label
+			 *     Label of the option.
+			 * @param name
+			 *     Name of the value which the option takes.
+			 * @param description
+			 *     Description of the option.
+			 * @param field
+			 *     Pointer to the field to which values are appended.
+			 * @param separator
+			 *     Separator of values. `Ch('\0')` if values are not split.
+			 * @param format
+			 *     Formatter for each value.
+			 */
+			inline ListOption(const String& label,
+							  const String& name,
+							  const String& description,
+							  std::vector< T > (SupOpt::*field),
+							  Ch separator,
+							  const Format& format)
+				: ValueOption(label, name, description),
+				  field(field),
+				  separator(separator),
+				  format(format) {}
+
+			/** Returns the separator of values. */
+			inline Ch getSeparator() const {
+				return this->separator;
+			}
+
+			/** Formats and appends a given value. */
+			virtual void operator ()(Opt& options,
+									 const StringView& value) const {
+				ParseResult result;
+				if (!this->tryApply(options, value, result)) {
+					result.raise();
+				}
+			}
+
+			/**
+			 * Formats and appends a given value without throwing
+			 * `BadValue`.
+			 *
+			 * Stops at the first piece which cannot be formatted; the pieces
+			 * before it have been appended.
+			 */
+			virtual bool tryApply(Opt& options,
+								  const StringView& value,
+								  ParseResult& result) const
+			{
+				std::vector< T >& values = options.*(this->field);
+				StringView rest(value);
+				for (;;) {
+					const size_t end = this->separator != Ch('\0')
+						? rest.find(this->separator) : StringView::npos;
+					T x;
+					if (!tryInvokeFormat(this->format,
+										 rest.substr(0, end),
+										 StringView(this->label),
+										 x,
+										 result))
+					{
+						return false;
+					}
+					values.push_back(std::move(x));
+					if (end == StringView::npos) {
+						return true;
+					}
+					rest = rest.substr(end + 1);
+				}
+			}
+
+			using ValueOption::tryApply;
+
+			/** Copies the field of `defaults` into the field of `options`. */
+			virtual void reset(Opt& options, const Opt& defaults) const {
+				options.*(this->field) = defaults.*(this->field);
+			}
+
+			/** Reserves the field for `n` more values. */
+			virtual void reserve(Opt& options, size_t n) const {
+				std::vector< T >& values = options.*(this->field);
+				values.reserve(values.size() + n);
+			}
+
+			/** Formats in advance; i.e., returns `true`. */
+			virtual bool canConvert() const {
+				return true;
+			}
+
+			/**
+			 * Formats the pieces of a given string.
+			 *
+			 * The pieces before the first bad piece are kept in
+			 * `conversion` even if this function fails.
+			 */
+			virtual bool tryConvert(const Opt&,
+									const StringView& value,
+									ConversionPtr& conversion,
+									ParseResult& result) const
+			{
+				ConvertedValue< std::vector< T > >* pValues =
+					new ConvertedValue< std::vector< T > >();
+				conversion.reset(pValues);
+				StringView rest(value);
+				for (;;) {
+					const size_t end = this->separator != Ch('\0')
+						? rest.find(this->separator) : StringView::npos;
+					T x;
+					if (!tryInvokeFormat(this->format,
+										 rest.substr(0, end),
+										 StringView(this->label),
+										 x,
+										 result))
+					{
+						return false;
+					}
+					pValues->value.push_back(std::move(x));
+					if (end == StringView::npos) {
+						return true;
+					}
+					rest = rest.substr(end + 1);
+				}
+			}
+
+			/** Appends formatted pieces. */
+			virtual bool tryApplyConverted(Opt& options,
+										   const StringView&,
+										   Conversion& conversion,
+										   ParseResult&) const
+			{
+				std::vector< T >& pieces = static_cast<
+					ConvertedValue< std::vector< T > >& >(conversion).value;
+				std::vector< T >& values = options.*(this->field);
+				for (size_t i = 0; i < pieces.size(); ++i) {
+					values.push_back(std::move(pieces[i]));
 				}
+				return true;
 			}
 		};
 
@@ -380,8 +881,21 @@ namespace optparse {
 				  constant(constant) {}
 
 			/** Applies this option without a value. */
-			virtual void operator ()(Opt& options) {
+			virtual void operator ()(Opt& options) const {
+				options.*(this->field) = this->constant;
+			}
+
+			/** Applies this option without a value. Never fails. */
+			virtual bool tryApply(Opt& options, ParseResult&) const {
 				options.*(this->field) = this->constant;
+				return true;
+			}
+
+			using NoValueOption::tryApply;
+
+			/** Copies the field of `defaults` into the field of `options`. */
+			virtual void reset(Opt& options, const Opt& defaults) const {
+				options.*(this->field) = defaults.*(this->field);
 			}
 		};
 
@@ -432,13 +946,71 @@ namespace optparse {
 			 * Formats a given string and passes the formatted value to the
 			 * function specified at the construction.
 			 */
-			virtual void operator ()(Opt& options, const String& value) {
-				try {
-					this->f(options, this->format(value));
-				} catch (BadValue< Ch >& ex) {
-					// augments the exception with the label
-					throw BadValue< Ch >(ex.getMessage(), this->label, value);
+			virtual void operator ()(Opt& options,
+									 const StringView& value) const {
+				ParseResult result;
+				if (!this->tryApply(options, value, result)) {
+					result.raise();
+				}
+			}
+
+			/**
+			 * Formats a given string and passes the formatted value to the
+			 * function specified at the construction without throwing
+			 * a parsing exception.
+			 */
+			virtual bool tryApply(Opt& options,
+								  const StringView& value,
+								  ParseResult& result) const
+			{
+				const StringView label(this->label);
+				T x;
+				if (!tryInvokeFormat(this->format, value, label, x, result)) {
+					return false;
+				}
+				return catchParsingError(
+					[&]() { this->f(options, x); }, label, value, result);
+			}
+
+			using ValueOption::tryApply;
+
+			/** Formats in advance; i.e., returns `true`. */
+			virtual bool canConvert() const {
+				return true;
+			}
+
+			/** Formats a given string; the function is not called. */
+			virtual bool tryConvert(const Opt&,
+									const StringView& value,
+									ConversionPtr& conversion,
+									ParseResult& result) const
+			{
+				std::unique_ptr< ConvertedValue< T > > pValue(
+					new ConvertedValue< T >());
+				if (!tryInvokeFormat(this->format,
+									 value,
+									 StringView(this->label),
+									 pValue->value,
+									 result))
+				{
+					return false;
 				}
+				conversion = std::move(pValue);
+				return true;
+			}
+
+			/** Passes a formatted value to the function. */
+			virtual bool tryApplyConverted(Opt& options,
+										   const StringView& value,
+										   Conversion& conversion,
+										   ParseResult& result) const
+			{
+				const T& x =
+					static_cast< ConvertedValue< T >& >(conversion).value;
+				return catchParsingError([&]() { this->f(options, x); },
+										 StringView(this->label),
+										 value,
+										 result);
 			}
 		};
 
@@ -470,7 +1042,7 @@ namespace optparse {
 				: NoValueOption(label, description), f(f) {}
 
 			/** Calls the function given at the construction. */
-			virtual void operator ()(Opt& options) {
+			virtual void operator ()(Opt& options) const {
 				this->f(options);
 			}
 		};
@@ -519,14 +1091,35 @@ namespace optparse {
 			 * Formats a given string and sets the field of a given options
 			 * container to the formatted value.
 			 */
-			virtual void operator ()(Opt& options, const String& value) {
-				try {
-					options.*(this->field) = this->format(value);
-				} catch (BadValue< Ch >& ex) {
-					// augments the exception with the name
-					throw BadValue< Ch >(ex.getMessage(), this->name, value);
+			virtual void operator ()(Opt& options,
+									 const StringView& value) const {
+				ParseResult result;
+				if (!this->tryApply(options, value, result)) {
+					result.raise();
 				}
 			}
+
+			/**
+			 * Formats a given string and sets the field of a given options
+			 * container to the formatted value without throwing `BadValue`.
+			 *
+			 * The field is left untouched if formatting fails.
+			 */
+			virtual bool tryApply(Opt& options,
+								  const StringView& value,
+								  ParseResult& result) const
+			{
+				return tryInvokeFormat(this->format,
+									   value,
+									   StringView(this->name),
+									   options.*(this->field),
+									   result);
+			}
+
+			/** Copies the field of `defaults` into the field of `options`. */
+			virtual void reset(Opt& options, const Opt& defaults) const {
+				options.*(this->field) = defaults.*(this->field);
+			}
 		};
 
 		/**
@@ -572,35 +1165,292 @@ namespace optparse {
 			 * Formats a given string and calls the function specified
 			 * at the construction with the formatted value.
 			 */
-			virtual void operator ()(SupOpt& options, const String& value) {
-				try {
-					this->f(options, this->format(value));
-				} catch (BadValue< Ch >& ex) {
-					throw BadValue< Ch >(ex.getMessage(), this->name, value);
+			virtual void operator ()(Opt& options,
+									 const StringView& value) const {
+				ParseResult result;
+				if (!this->tryApply(options, value, result)) {
+					result.raise();
+				}
+			}
+
+			/**
+			 * Formats a given string and calls the function specified
+			 * at the construction with the formatted value without throwing
+			 * a parsing exception.
+			 */
+			virtual bool tryApply(Opt& options,
+								  const StringView& value,
+								  ParseResult& result) const
+			{
+				const StringView name(this->name);
+				T x;
+				if (!tryInvokeFormat(this->format, value, name, x, result)) {
+					return false;
 				}
+				return catchParsingError(
+					[&]() { this->f(options, x); }, name, value, result);
 			}
 		};
-	private:
-		/** Pointer to an option definition. */
-		typedef std::shared_ptr< Option > OptionPtr;
 
-		/** Pointer to an argument. */
-		typedef std::shared_ptr< Argument > ArgumentPtr;
+		/**
+		 * Argument which takes all of the remaining positional values and
+		 * calls a function for each of them.
+		 *
+		 * @tparam T
+		 *     See `OptionParserBase`.
+		 * @tparam SupOpt
+		 *     See `OptionParserBase`.
+		 * @tparam Format
+		 *     See `OptionParserBase`.
+		 */
+		template < typename T, typename SupOpt, typename Format >
+		class VariadicFunctionArgument
+			: public FunctionArgument< T, SupOpt, Format >
+		{
+		public:
+			/** Initializes in the same way as `FunctionArgument`. */
+			VariadicFunctionArgument(const String& name,
+									 const String& description,
+									 void (*f)(SupOpt&, const T&),
+									 const Format& format = Format())
+				: FunctionArgument< T, SupOpt, Format >(
+					name, description, f, format) {}
 
-		/** Index and option. */
-		typedef std::pair< int, OptionPtr > IndexedOptionPtr;
+			/** Returns `true`. */
+			virtual bool isVariadic() const {
+				return true;
+			}
+		};
 
-		/** Type of an option map. */
-		typedef std::map< String, IndexedOptionPtr > OptionMap;
+		/** Sub-command which configures its own parser when selected. */
+		class Command : public CommandSpec< Ch > {
+		protected:
+			/** Name of this command. Pooled by the parser. */
+			const String& name;
 
-		/** Value type of `OptionMap`. */
-		typedef typename OptionMap::value_type OptionMapValue;
+			/** Description of this command. Pooled by the parser. */
+			const String& description;
+		public:
+			/**
+			 * Initializes with a name and a description.
+			 *
+			 * The strings are referenced, not copied.
+			 * A parser passes the copies in `textPool`, which outlive
+			 * the command.
+			 *
+			 * @param name
+			 *     Name of the command on the command line.
+			 * @param description
+			 *     Description of the command.
+			 */
+			inline Command(const String& name, const String& description)
+				: name(name), description(description) {}
 
-		/** Iterator type of `OptionMap`. */
-		typedef typename OptionMap::iterator OptionMapItr;
+			/** Returns the name of this command. */
+			virtual const String& getName() const {
+				return this->name;
+			}
 
-		/** Description of the program. */
-		String description;
+			/** Returns the description of this command. */
+			virtual const String& getDescription() const {
+				return this->description;
+			}
+
+			/**
+			 * Records this command in a given options container.
+			 *
+			 * @param options
+			 *     Options container in which this command is selected.
+			 */
+			virtual void select(Opt& options) const = 0;
+
+			/**
+			 * Configures the parser of this command.
+			 *
+			 * @param parser
+			 *     Empty parser to be configured.
+			 */
+			virtual void configure(OptionParserBase& parser) const = 0;
+		};
+
+		/**
+		 * `Command` which substitutes a member field with a constant when
+		 * selected.
+		 *
+		 * @tparam T
+		 *     See `OptionParserBase`.
+		 * @tparam SupOpt
+		 *     See `OptionParserBase`.
+		 * @tparam Configure
+		 *     Type of a function which configures the parser of
+		 *     the command. Called as `configure(parser)`.
+		 */
+		template < typename T, typename SupOpt, typename Configure >
+		class ConstMemberCommand : public Command {
+		private:
+			/** Field to be substituted. */
+			T SupOpt::*field;
+
+			/** Constant which substitutes the field. */
+			T constant;
+
+			/** Configures the parser of the command. */
+			Configure configureParser;
+		public:
+			/**
+			 * Initializes a command.
+			 *
+			 * @param name
+			 *     Name of the command on the command line.
+			 * @param description
+			 *     Description of the command.
+			 * @param field
+			 *     Pointer to the field to be substituted.
+			 * @param constant
+			 *     Constant which substitutes the field.
+			 * @param configure
+			 *     Function which configures the parser of the command.
+			 */
+			inline ConstMemberCommand(const String& name,
+									  const String& description,
+									  T (SupOpt::*field),
+									  const T& constant,
+									  const Configure& configure)
+				: Command(name, description),
+				  field(field),
+				  constant(constant),
+				  configureParser(configure) {}
+
+			/** Substitutes the field with the constant. */
+			virtual void select(Opt& options) const {
+				options.*(this->field) = this->constant;
+			}
+
+			/** Calls the configuring function. */
+			virtual void configure(OptionParserBase& parser) const {
+				this->configureParser(parser);
+			}
+		};
+	private:
+		/** State of parsing between tokens. */
+		struct ApplyState {
+			/** Index of the next positional argument. */
+			size_t nextPos;
+
+			/**
+			 * Index of the option which waits for its value.
+			 * -1 if no option waits.
+			 */
+			int pendingOption;
+
+			/** Index of the token of `pendingOption`. */
+			int pendingIndex;
+
+			/**
+			 * Index of the selected command.
+			 * -1 if no command has been selected.
+			 */
+			int command;
+
+			/** Initializes the state before the first token. */
+			inline ApplyState()
+				: nextPos(0), pendingOption(-1), pendingIndex(-1), command(-1)
+			{}
+		};
+
+		/**
+		 * Sink which applies tokens to an options container.
+		 *
+		 * `tryApplyTokens` tells a sink which option or argument each token
+		 * gives a value to. `RecordSink` is the other sink.
+		 */
+		class OptionsSink {
+		private:
+			/** Parser which owns the options and arguments. */
+			const OptionParserBase& parser;
+
+			/** Options container to which tokens are applied. */
+			Opt& options;
+		public:
+			/** Initializes with a parser and an options container. */
+			inline OptionsSink(const OptionParserBase& parser, Opt& options)
+				: parser(parser), options(options) {}
+
+			/** Returns the options container. */
+			inline Opt& getOptions() {
+				return this->options;
+			}
+
+			/** Does nothing; a token is not referred to after applied. */
+			inline void beginToken(int, bool) {}
+
+			/**
+			 * Applies the option at a given index without a value.
+			 *
+			 * A flag is applied from the table without calling a virtual
+			 * function (see `addFlag`).
+			 */
+			inline bool tryApply(int optionI, ParseResult& result) {
+				const OptionSlot& slot = this->parser.optionSlots[optionI];
+				if (slot.kind == FLAG_OPTION) {
+					const Flag& flag = this->parser.flags[slot.handler];
+					this->options.*(flag.field) = flag.value;
+					this->parser.observer.observeOption(optionI, true);
+					return true;
+				}
+				const bool applied = this->parser.optionList[optionI]->tryApply(
+					this->options, result);
+				this->parser.observer.observeOption(optionI, applied);
+				return applied;
+			}
+
+			/** Applies the option at a given index with a given value. */
+			inline bool tryApply(int optionI,
+								 const StringView& value,
+								 ParseResult& result)
+			{
+				const bool applied = this->parser.optionList[optionI]->tryApply(
+					this->options, value, result);
+				this->parser.observer.observeOption(optionI, applied);
+				return applied;
+			}
+
+			/** Applies a given value to the argument at a given position. */
+			inline bool tryApplyArgument(size_t pos,
+										 const StringView& value,
+										 ParseResult& result)
+			{
+				const bool applied = this->parser.arguments[pos]->tryApply(
+					this->options, value, result);
+				this->parser.observer.observeArgument(pos, applied);
+				return applied;
+			}
+		};
+
+		/**
+		 * Pointer to an option definition.
+		 *
+		 * Uniquely owns the option, which is either in the arena or
+		 * allocated by the standard new operator.
+		 */
+		typedef std::unique_ptr< Option, ArenaDeleter< Option > > OptionPtr;
+
+		/** Pointer to an argument. Owns the argument as `OptionPtr` does. */
+		typedef std::unique_ptr< Argument, ArenaDeleter< Argument > >
+			ArgumentPtr;
+
+		/** Pointer to a command. Owns the command as `OptionPtr` does. */
+		typedef std::unique_ptr< Command, ArenaDeleter< Command > >
+			CommandPtr;
+
+		/**
+		 * Arena where options and arguments are allocated.
+		 * 0 if they are allocated by the standard new operator.
+		 */
+		Arena* pArena;
+
+		/** Description of the program. */
+		String description;
 
 		/** Name of the program. Empty by default. */
 		String programName;
@@ -608,584 +1458,3882 @@ namespace optparse {
 		/** List of options. */
 		std::vector< OptionPtr > optionList;
 
-		/** Maps an option label to the corresponding `Option`. */
-		OptionMap optionMap;
+		/** Flag which substitutes a `bool` field with a constant. */
+		struct Flag {
+			/** Field to be substituted. */
+			bool Opt::*field;
+
+			/** Constant which substitutes the field. */
+			bool value;
+
+			/** Initializes with a field and a constant. */
+			inline Flag(bool (Opt::*field), bool value)
+				: field(field), value(value) {}
+		};
+
+		/** Table of the flags added by `addFlag`. */
+		std::vector< Flag > flags;
+
+		/** Option added by `addListOption`. */
+		struct List {
+			/**
+			 * Index of the option in `optionList`.
+			 * -1 if the option has been replaced.
+			 */
+			int optionIndex;
+
+			/** Label owned by the option. */
+			StringView label;
+
+			/** Separator of values. `Ch('\0')` if values are not split. */
+			Ch separator;
+
+			/** Initializes with an option index, a label and a separator. */
+			inline List(int optionIndex, const StringView& label, Ch separator)
+				: optionIndex(optionIndex),
+				  label(label),
+				  separator(separator) {}
+		};
+
+		/** List options counted by `reserveLists`. */
+		std::vector< List > lists;
+
+		/** Kind of an option, which tells what `OptionSlot::handler` is. */
+		enum OptionKind {
+			/** Option applied only through its `Option`. */
+			PLAIN_OPTION,
+
+			/** Flag applied from `flags` (see `addFlag`). */
+			FLAG_OPTION,
+
+			/** List option counted through `lists` (see `addListOption`). */
+			LIST_OPTION
+		};
 
-		/** List of positional arguments. */
-		std::vector< ArgumentPtr > arguments;
-	public:
 		/**
-		 * Initializes with the description of the program.
+		 * Metadata of an option which parsing reads.
 		 *
-		 * @param description
-		 *     Description of the program.
+		 * Slots are packed apart from the `Option`s in the order of
+		 * `optionList`, so that recognizing a token and reporting an error
+		 * never touch an `Option` but the one applied, and no virtual
+		 * function is called to know whether an option needs a value.
+		 * The description and value name are cold; they are reached only
+		 * through the `Option`, which refers to `textPool`.
 		 */
-		explicit OptionParserBase(const String& description)
-			: description(description)
-		{
-			this->optionList.reserve(10);
-		}
+		struct OptionSlot {
+			/** Label of the option, which views the copy in `labelPool`. */
+			StringView label;
 
-		/** Releases resources. */
-		virtual ~OptionParserBase() {}
+			/**
+			 * Index of the corresponding flag in `flags` or list option in
+			 * `lists`, according to `kind`.
+			 * -1 if the option is a `PLAIN_OPTION`.
+			 */
+			int handler;
+
+			/** Kind of the option. One of `OptionKind`. */
+			unsigned char kind;
+
+			/** Whether the option needs a value. */
+			bool valueNeeded;
+
+			/**
+			 * Whether the option is formatted in advance by the overload of
+			 * `Matches::validate` with an executor. See `setIndependent`.
+			 */
+			bool independent;
+
+			/** Initializes the slot of a `PLAIN_OPTION`. */
+			inline OptionSlot(const StringView& label, bool valueNeeded)
+				: label(label),
+				  handler(-1),
+				  kind(PLAIN_OPTION),
+				  valueNeeded(valueNeeded),
+				  independent(false) {}
+		};
+
+		/** Slots of the options in the order of `optionList`. */
+		std::vector< OptionSlot > optionSlots;
 
 		/**
-		 * Returns the description of the program.
+		 * Pool of the option labels.
 		 *
-		 * @return
-		 *     Description of the program.
+		 * Every label is stored only here; `Option`s and `OptionSlot`s
+		 * refer to it.
+		 * Also indexes the labels while the options are not compiled
+		 * (see `labelOptions`).
 		 */
-		inline const String& getDescription() const {
-			return this->description;
-		}
+		StringPool< Ch > labelPool;
 
 		/**
-		 * Returns the program name.
-		 *
-		 * @return
-		 *     Name of the program.
-		 *     An empty string if `parse` has not yet been called.
+		 * Index of the option in `optionList` which has the label at each
+		 * index in `labelPool`.
+		 * -1 if no option has the label; e.g., the option has failed to be
+		 * created.
 		 */
-		inline const String& getProgramName() const {
-			return this->programName;
-		}
+		std::vector< int > labelOptions;
 
 		/**
-		 * Returns the number of the registered options.
+		 * Pool of the descriptions and value names of the options and
+		 * arguments, and the names and descriptions of the commands.
 		 *
-		 * @return
-		 *     Number of the registered options.
+		 * Kept apart from `labelPool` because parsing seldom reads them.
+		 * Equal texts, such as a value name given to many options, are
+		 * stored once.
+		 * A text stays in the pool after its option or command is replaced.
 		 */
-		inline size_t getOptionCount() const {
-			return this->optionList.size();
-		}
+		StringPool< Ch > textPool;
 
 		/**
-		 * Returns the specification of the option at a given index.
-		 *
-		 * Undefined if `i >= this->getOptionCount()`.
+		 * Compiled table which maps an option label to the index of
+		 * the option in `optionList`.
 		 *
-		 * @param i
-		 *     Index of the option of which the specification is to be obtained.
-		 * @return
-		 *     Specification of the option at `i`.
+		 * Empty unless `compile` has been called since the last change of
+		 * the options.
 		 */
-		const OptionSpec< Ch >& getOption(size_t i) const {
-			return *this->optionList[i];
-		}
+		LabelTable< Ch > compiledOptions;
+
+		/** Whether `compiledOptions` is up to date. */
+		bool compiled;
 
 		/**
-		 * Adds an option which substitutes a given field.
-		 *
-		 * Equivalent to the following call,
-		 *
-		 *     this->addOption(label, name, description, field, MetaFormat< T, Ch >())
+		 * Index of the option labels for suggestions.
 		 *
-		 * @tparam T
-		 *     See `OptionParserBase`.
-		 * @tparam SupOpt
-		 *     See `OptionParserBase`.
-		 * @param label
-		 *     Option label on the command line.
-		 * @param name
-		 *     Name of the value which the option takes.
-		 *     Used to explain what should be specified to the option.
-		 * @param description
-		 *     Description of the option.
-		 * @param field
-		 *     Pointer to the field of `SupOpt` to be substituted.
-		 * @throws ConfigException
-		 *     If `label` cannot be an option label
-		 *     (see `OptionParserBase::isLabel`).
+		 * Built by `compile` along with `compiledOptions`.
 		 */
-		template < typename T, typename SupOpt >
-		inline void addOption(const String& label,
-							  const String& name,
-							  const String& description,
-							  T (SupOpt::*field))
-		{
-			this->addOption(
-				label, name, description, field, MetaFormat< T, Ch >());
-		}
+		SuggestionIndex< Ch > suggestionIndex;
 
 		/**
-		 * Adds an option which substitutes a given field with a value
-		 * formatted by a given function.
+		 * Pairs of a label and the index of an option in the lexicographical
+		 * order of the labels.
 		 *
-		 * If an option associated with `label` already exists in this parser,
-		 * it will be replaced with the new option.
-		 *
-		 * @tparam T
-		 *     See `OptionParserBase`.
-		 * @tparam SupOpt
-		 *     See `OptionParserBase`.
-		 * @tparam Format
-		 *     See `OptionParserBase`.
-		 * @param label
-		 *     Option label on the command line.
-		 * @param name
-		 *     Name of the value which the option takes.
-		 *     Used to explain what should be specified to the option.
-		 * @param description
-		 *     Description of the option.
-		 * @param field
-		 *     Pointer to the field of `SupOpt` to be substituted.
-		 * @param format
-		 *     Function object which converts a string into a value of the
-		 *     type `T`.
-		 * @throws ConfigException
-		 *     If `label` cannot be an option label
-		 *     (see `OptionParserBase::isLabel`).
+		 * The labels which start with a prefix form a contiguous range.
+		 * Built by `compile` along with `compiledOptions`.
 		 */
-		template < typename T, typename SupOpt, typename Format >
-		void addOption(const String& label,
-					   const String& name,
-					   const String& description,
-					   T (SupOpt::*field),
-					   const Format& format)
-		{
-			OptionPtr pOption(new MemberOption< T, SupOpt, Format >(
-				label, name, description, field, format));
-			this->addOption(label, pOption);
-		}
+		std::vector< typename LabelTable< Ch >::Entry > prefixIndex;
+
+		/** List of positional arguments. */
+		std::vector< ArgumentPtr > arguments;
+
+		/** List of sub-commands. */
+		std::vector< CommandPtr > commands;
 
 		/**
-		 * Adds an option which substitutes a given field with a given constant.
-		 *
-		 * If an option corresponding to `label` already exists in this parser,
-		 * it will be replaced with the new option.
+		 * Generation of this parser.
 		 *
-		 * @tparam T
-		 *     See `OptionParserBase`.
-		 * @tparam SupOpt
-		 *     See `OptionParserBase`.
-		 * @param label
-		 *     Option label on the command line.
-		 * @param description
-		 *     Description of the option.
-		 * @param field
-		 *     Pointer to the field of `SupOpt` to be substituted.
-		 * @param constant
-		 *     Constant that substitutes the field.
-		 * @throws ConfigException
-		 *     If `label` cannot be an option label
-		 *     (see `OptionParserBase::isLabel`).
+		 * Incremented whenever what `DefaultUsagePrinter` prints changes.
 		 */
-		template < typename T, typename SupOpt >
-		void addOption(const String& label,
-					   const String& description,
-					   T (SupOpt::*field),
-					   const T& constant)
-		{
-			OptionPtr pOption(new ConstMemberOption
-				< T, SupOpt >(label, description, field, constant));
-			this->addOption(label, pOption);
-		}
+		size_t generation;
+
+		/** Whether `@path` arguments are expanded. `false` by default. */
+		bool responseFiles;
 
 		/**
-		 * Adds an option which calls a given function.
+		 * Whether a unique prefix of a long option label is accepted.
+		 * `false` by default.
+		 */
+		bool abbreviations;
+
+		/** Observer of parsing. */
+		Observer observer;
+	public:
+		/**
+		 * Incremental parsing of command line arguments fed one by one.
 		 *
-		 * Equivalent to the following call,
+		 * Tokens are processed in the same way as `parseInto` as soon as
+		 * they are fed, and no token is kept, so that a session can parse
+		 * any number of arguments in memory proportional to the number of
+		 * options; combine with `appendVariadicArgument` to consume a huge
+		 * list of positional values.
+		 * Unlike `argv`, the first token is not the program name.
 		 *
-		 *     this->addOption(label, name, description, f, MetaFormat< T, Ch >())
+		 * Once an error occurs, the rest of the tokens are ignored.
+		 * The label and value of an error are copied into the session, so
+		 * a result refers to the session and the parser.
 		 *
-		 * @tparam T
-		 *     See `OptionParserBase`.
+		 * A session refers to the parser and the options container given at
+		 * the construction, which must outlive the session.
+		 * Sessions of the same parser can run concurrently in the same way as
+		 * the `const` overload of `parse`.
+		 */
+		class Session {
+		private:
+			/** Parser which processes tokens. */
+			const OptionParserBase& parser;
+
+			/** Sink which applies tokens to the options container. */
+			OptionsSink sink;
+
+			/** State of parsing. */
+			ApplyState state;
+
+			/** Number of the tokens fed so far. */
+			int tokenCount;
+
+			/** Result of parsing. */
+			ParseResult result;
+
+			/** Buffer of a line read by `feedStream`. */
+			String line;
+
+			/** Parser of the selected command. 0 until it is selected. */
+			std::unique_ptr< OptionParserBase > pCommandParser;
+
+			/**
+			 * Session of the selected command, which takes the rest of
+			 * the tokens. 0 until a command is selected.
+			 */
+			std::unique_ptr< Session > pCommand;
+		public:
+			/**
+			 * Starts a session.
+			 *
+			 * @param parser
+			 *     Parser which processes tokens.
+			 * @param[in,out] options
+			 *     Options container to which tokens are applied.
+			 */
+			Session(const OptionParserBase& parser, Opt& options)
+				: parser(parser), sink(parser, options), tokenCount(0) {}
+
+			/**
+			 * Feeds a given token.
+			 *
+			 * @param token
+			 *     Token to be processed.
+			 *     Not referred to after this function returns.
+			 * @return
+			 *     Whether no error has occurred so far.
+			 */
+			bool feed(const StringView& token) {
+				if (!this->result.isSuccess()) {
+					return false;
+				}
+				if (this->pCommand) {
+					++this->tokenCount;
+					if (!this->pCommand->feed(token)) {
+						this->result = this->pCommand->getResult();
+						return false;
+					}
+					return true;
+				}
+				if (!this->parser.tryApplyToken(this->sink,
+												this->state,
+												token,
+												this->tokenCount++,
+												this->result))
+				{
+					// the token may be released after this call
+					this->result.pin();
+					return false;
+				}
+				if (this->state.command >= 0) {
+					this->startCommand();
+				}
+				return true;
+			}
+
+			/**
+			 * Feeds tokens in a given command line string.
+			 *
+			 * The string is split by `CommandLineTokenizer` in place.
+			 *
+			 * @param first
+			 *     Beginning of the command line string.
+			 *     Overwritten while quotes and escapes are removed.
+			 * @param last
+			 *     End of the command line string.
+			 * @return
+			 *     Whether no error has occurred so far.
+			 */
+			bool feedLine(Ch* first, Ch* last) {
+				CommandLineTokenizer< Ch > tokenizer(first, last);
+				StringView token;
+				while (tokenizer.next(token)) {
+					if (!this->feed(token)) {
+						return false;
+					}
+				}
+				if (tokenizer.getError() != 0 && this->result.isSuccess()) {
+					this->result = ParseResult(
+						ParseResult::BAD_SYNTAX, tokenizer.getError());
+					this->result.setArgIndex(this->tokenCount);
+				}
+				return this->result.isSuccess();
+			}
+
+			/**
+			 * Feeds tokens in a given response file.
+			 *
+			 * The file is read by `ResponseFile` and split by
+			 * `CommandLineTokenizer`.
+			 *
+			 * @param path
+			 *     Path to the response file.
+			 * @return
+			 *     Whether no error has occurred so far.
+			 */
+			bool feedFile(const Ch* path) {
+				if (!this->result.isSuccess()) {
+					return false;
+				}
+				ResponseFile< Ch > file;
+				if (!file.open(path)) {
+					this->result = ParseResult(ParseResult::BAD_VALUE,
+											   "cannot read response file",
+											   StringView(),
+											   StringView(path));
+					this->result.setArgIndex(this->tokenCount);
+					this->result.pin();
+					return false;
+				}
+				return this->feedLine(file.begin(), file.end());
+			}
+
+			/**
+			 * Feeds tokens read from a given input stream.
+			 *
+			 * Reads one line at a time and splits it by
+			 * `CommandLineTokenizer`, so a quote cannot span lines.
+			 * Only the longest line is held in memory.
+			 *
+			 * @param in
+			 *     Input stream from which tokens are read.
+			 * @return
+			 *     Whether no error has occurred so far.
+			 */
+			bool feedStream(std::basic_istream< Ch >& in) {
+				while (this->result.isSuccess()
+					&& std::getline(in, this->line))
+				{
+					Ch* first = this->line.empty() ? 0 : &this->line[0];
+					this->feedLine(first, first + this->line.size());
+				}
+				return this->result.isSuccess();
+			}
+
+			/**
+			 * Finishes this session.
+			 *
+			 * Checks whether an option waits for its value and whether all of
+			 * the positional arguments have been substituted.
+			 * No token should be fed after this function is called.
+			 *
+			 * @return
+			 *     Result of parsing.
+			 *     The argument index of an error is the index of the token
+			 *     starting from 0.
+			 */
+			const ParseResult& finish() {
+				if (this->result.isSuccess()) {
+					if (this->pCommand) {
+						this->result = this->pCommand->finish();
+					} else {
+						this->result = this->parser.tryFinishTokens(
+							this->state, this->tokenCount);
+					}
+				}
+				return this->result;
+			}
+
+			/** Returns the result of parsing so far. */
+			inline const ParseResult& getResult() const {
+				return this->result;
+			}
+
+			/** Returns the number of the tokens fed so far. */
+			inline int getTokenCount() const {
+				return this->tokenCount;
+			}
+		private:
+			/**
+			 * Builds the parser of the selected command and starts
+			 * the session of it.
+			 */
+			void startCommand() {
+				const Command& command =
+					*this->parser.commands[this->state.command];
+				command.select(this->sink.getOptions());
+				this->pCommandParser.reset(
+					new OptionParserBase(command.getDescription()));
+				this->parser.configureCommand(
+					*this->pCommandParser, this->state.command);
+				this->pCommand.reset(new Session(
+					*this->pCommandParser, this->sink.getOptions()));
+				this->pCommand->tokenCount = this->tokenCount;
+			}
+
+			/** Assignment is not allowed. */
+			void operator =(const Session&) = delete;
+		};
+
+		/**
+		 * Options and arguments recorded by `tryParseLazy` without being
+		 * applied.
+		 *
+		 * Each match is a pair of an option or argument and a view of its
+		 * value, so that no value is formatted until it is accessed by
+		 * `tryGet`, `tryApply` or `validate`.
+		 * A value is a view of `argv` unless it comes from a response file,
+		 * in which case it is copied into the matches.
+		 * Matches refer to the parser and `argv` given to `tryParseLazy`,
+		 * which must outlive the matches.
+		 */
+		class Matches {
+			friend class OptionParserBase;
+		private:
+			/** Match of an option or argument. */
+			struct Match {
+				/**
+				 * Index of the option in `optionList` if not negative.
+				 * Otherwise, `-1 - i` where `i` is the position of
+				 * the argument.
+				 */
+				int index;
+
+				/** Index of the token. */
+				int argIndex;
+
+				/** Value. Empty if the option takes no value. */
+				StringView value;
+
+				/** Initializes with an index, a token index and a value. */
+				inline Match(int index, int argIndex, const StringView& value)
+					: index(index), argIndex(argIndex), value(value) {}
+			};
+
+			/** Parser which has recorded the matches. 0 if none. */
+			const OptionParserBase* pParser;
+
+			/** Matches in the order of the command line. */
+			std::vector< Match > matches;
+
+			/**
+			 * Copies of the values which come from response files.
+			 * A deque does not move its elements as it grows.
+			 */
+			std::deque< String > storage;
+		public:
+			/** Initializes empty matches. */
+			inline Matches() : pParser(0) {}
+
+			/** Removes all of the matches. */
+			void clear() {
+				this->pParser = 0;
+				this->matches.clear();
+				this->storage.clear();
+			}
+
+			/** Returns the number of the matches. */
+			inline size_t size() const {
+				return this->matches.size();
+			}
+
+			/**
+			 * Returns how many times a given option is specified.
+			 *
+			 * @param label
+			 *     Label of the option.
+			 * @return
+			 *     Number of the matches of the option.
+			 *     0 if `label` is unknown.
+			 */
+			size_t count(const StringView& label) const {
+				const int optionI = this->findOptionIndex(label);
+				if (optionI < 0) {
+					return 0;
+				}
+				size_t n = 0;
+				for (size_t i = 0; i < this->matches.size(); ++i) {
+					if (this->matches[i].index == optionI) {
+						++n;
+					}
+				}
+				return n;
+			}
+
+			/** Returns whether a given option is specified. */
+			inline bool contains(const StringView& label) const {
+				return this->findLast(label) != 0;
+			}
+
+			/**
+			 * Formats the last value given to a given option.
+			 *
+			 * The value is formatted by `MetaFormat< T, Ch >` regardless of
+			 * the format associated with the option.
+			 * The value is formatted every time this function is called.
+			 *
+			 * @tparam T
+			 *     Type of the formatted value.
+			 * @param label
+			 *     Label of the option.
+			 * @param[out] value
+			 *     Set to the formatted value.
+			 *     Left untouched unless this function succeeds.
+			 * @param[out] result
+			 *     Set to the error if the value is bad.
+			 *     Left untouched unless the value is bad.
+			 * @return
+			 *     Whether `value` has been set.
+			 *     `false` if the option is not specified.
+			 */
+			template < typename T >
+			bool tryGet(const StringView& label,
+						T& value,
+						ParseResult& result) const
+			{
+				const Match* pMatch = this->findLast(label);
+				if (pMatch == 0) {
+					return false;
+				}
+				if (!tryInvokeFormat(MetaFormat< T, Ch >(),
+									 pMatch->value,
+									 this->pParser->optionSlots[
+										 pMatch->index].label,
+									 value,
+									 result))
+				{
+					result.setArgIndex(pMatch->argIndex);
+					return false;
+				}
+				return true;
+			}
+
+			/**
+			 * Formats the last value given to a given option.
+			 *
+			 * @tparam T
+			 *     Type of the formatted value.
+			 * @param label
+			 *     Label of the option.
+			 * @param defaultValue
+			 *     Value returned if the option is not specified.
+			 * @return
+			 *     Formatted value. `defaultValue` if the option is not
+			 *     specified.
+			 * @throws BadValue
+			 *     If the value is bad.
+			 */
+			template < typename T >
+			T get(const StringView& label, const T& defaultValue) const {
+				T value(defaultValue);
+				ParseResult result;
+				if (!this->tryGet(label, value, result)) {
+					result.raise();
+				}
+				return value;
+			}
+
+			/**
+			 * Applies the matches of a given option to a given options
+			 * container.
+			 *
+			 * The values are formatted by the format associated with
+			 * the option.
+			 *
+			 * @param[in,out] options
+			 *     Options container to which the option is applied.
+			 * @param label
+			 *     Label of the option.
+			 * @return
+			 *     Result of applying the option.
+			 *     Success if the option is not specified.
+			 */
+			ParseResult tryApply(Opt& options, const StringView& label) const {
+				const int optionI = this->findOptionIndex(label);
+				ParseResult result;
+				if (optionI < 0) {
+					return result;
+				}
+				OptionsSink sink(*this->pParser, options);
+				for (size_t i = 0; i < this->matches.size(); ++i) {
+					if (this->matches[i].index == optionI
+						&& !this->tryApply(sink, this->matches[i], result))
+					{
+						break;
+					}
+				}
+				return result;
+			}
+
+			/**
+			 * Applies all of the matches to a given options container.
+			 *
+			 * Equivalent to `tryParseInto` with the arguments given to
+			 * `tryParseLazy`.
+			 *
+			 * @param[in,out] options
+			 *     Options container to which the matches are applied.
+			 * @return
+			 *     Result of applying the matches.
+			 */
+			ParseResult validate(Opt& options) const {
+				ParseResult result;
+				if (this->pParser == 0) {
+					return result;
+				}
+				OptionsSink sink(*this->pParser, options);
+				for (size_t i = 0; i < this->matches.size(); ++i) {
+					if (!this->tryApply(sink, this->matches[i], result)) {
+						break;
+					}
+				}
+				return result;
+			}
+
+			/**
+			 * Applies all of the matches to a given options container,
+			 * formatting the values of independent options with a given
+			 * executor.
+			 *
+			 * The values of the options marked by `setIndependent` are
+			 * formatted by tasks run by `executor` without modifying
+			 * `options`, and then every match is applied in the order of
+			 * the command line, so that the last value of an option wins as
+			 * `validate` does.
+			 * The error first in the order of the command line is reported
+			 * even if another independent value is bad.
+			 * Every independent value is formatted even if an earlier value
+			 * is bad.
+			 *
+			 * @tparam Executor
+			 *     Type of the executor. See `SerialExecutor`.
+			 * @param[in,out] options
+			 *     Options container to which the matches are applied.
+			 *     Read by the tasks.
+			 * @param executor
+			 *     Executor which runs the formatting of each independent
+			 *     value.
+			 * @return
+			 *     Result of applying the matches.
+			 */
+			template < typename Executor >
+			ParseResult validate(Opt& options, const Executor& executor) const
+			{
+				ParseResult result;
+				if (this->pParser == 0) {
+					return result;
+				}
+				const OptionParserBase& parser = *this->pParser;
+				// indices of the matches formatted in advance
+				std::vector< size_t > tasks;
+				for (size_t i = 0; i < this->matches.size(); ++i) {
+					const int optionI = this->matches[i].index;
+					if (optionI >= 0
+						&& parser.optionSlots[optionI].independent
+						&& parser.optionList[optionI]->canConvert())
+					{
+						tasks.push_back(i);
+					}
+				}
+				std::vector< ConversionPtr > conversions(tasks.size());
+				std::vector< ParseResult > results(tasks.size());
+				std::vector< char > converted(tasks.size(), 0);
+				const Opt& current = options;
+				executor(tasks.size(), [&](size_t j) {
+					const Match& match = this->matches[tasks[j]];
+					converted[j] = parser.optionList[match.index]->tryConvert(
+						current, match.value, conversions[j], results[j]);
+				});
+				OptionsSink sink(parser, options);
+				size_t j = 0;
+				for (size_t i = 0; i < this->matches.size(); ++i) {
+					const Match& match = this->matches[i];
+					if (j == tasks.size() || tasks[j] != i) {
+						if (!this->tryApply(sink, match, result)) {
+							break;
+						}
+						continue;
+					}
+					bool applied = !conversions[j]
+						|| parser.optionList[match.index]->tryApplyConverted(
+							options, match.value, *conversions[j], result);
+					if (applied && !converted[j]) {
+						result = results[j];
+						applied = false;
+					}
+					parser.observer.observeOption(match.index, applied);
+					if (!applied) {
+						result.setArgIndex(match.argIndex);
+						break;
+					}
+					++j;
+				}
+				return result;
+			}
+		private:
+			/** Appends a given match. Copies the value if `transient`. */
+			void add(int index,
+					 int argIndex,
+					 const StringView& value,
+					 bool transient)
+			{
+				if (transient && !value.empty()) {
+					this->storage.push_back(value.str());
+					this->matches.push_back(Match(
+						index, argIndex, StringView(this->storage.back())));
+				} else {
+					this->matches.push_back(Match(index, argIndex, value));
+				}
+			}
+
+			/** Returns the index of a given option. -1 if unknown. */
+			inline int findOptionIndex(const StringView& label) const {
+				return this->pParser != 0
+					? this->pParser->findOptionIndex(label) : -1;
+			}
+
+			/** Returns the last match of a given option. 0 if none. */
+			const Match* findLast(const StringView& label) const {
+				const int optionI = this->findOptionIndex(label);
+				if (optionI < 0) {
+					return 0;
+				}
+				for (size_t i = this->matches.size(); i > 0; --i) {
+					if (this->matches[i - 1].index == optionI) {
+						return &this->matches[i - 1];
+					}
+				}
+				return 0;
+			}
+
+			/** Applies a given match to a given sink. */
+			bool tryApply(OptionsSink& sink,
+						  const Match& match,
+						  ParseResult& result) const
+			{
+				bool applied;
+				if (match.index < 0) {
+					applied = sink.tryApplyArgument(
+						static_cast< size_t >(-1 - match.index),
+						match.value,
+						result);
+				} else if (this->pParser->needsValue(match.index)) {
+					applied = sink.tryApply(match.index, match.value, result);
+				} else {
+					applied = sink.tryApply(match.index, result);
+				}
+				if (!applied) {
+					result.setArgIndex(match.argIndex);
+				}
+				return applied;
+			}
+
+			/** Copy is not allowed. */
+			Matches(const Matches&) = delete;
+
+			/** Assignment is not allowed. */
+			void operator =(const Matches&) = delete;
+		};
+	private:
+		/**
+		 * Sink which records tokens in `Matches` instead of applying them.
+		 */
+		class RecordSink {
+		private:
+			/** Matches to which tokens are recorded. */
+			Matches& matches;
+
+			/** Token index of the current token. */
+			int argIndex;
+
+			/** Whether the current token is released after it is applied. */
+			bool transient;
+		public:
+			/** Initializes with matches to which tokens are recorded. */
+			inline explicit RecordSink(Matches& matches)
+				: matches(matches), argIndex(0), transient(false) {}
+
+			/**
+			 * Starts a given token.
+			 *
+			 * @param argIndex
+			 *     Index of the token.
+			 * @param transient
+			 *     Whether the token is released after it is applied.
+			 */
+			inline void beginToken(int argIndex, bool transient) {
+				this->argIndex = argIndex;
+				this->transient = transient;
+			}
+
+			/** Records the option at a given index without a value. */
+			inline bool tryApply(int optionI, ParseResult&) {
+				this->matches.add(optionI, this->argIndex, StringView(), false);
+				return true;
+			}
+
+			/** Records the option at a given index with a given value. */
+			inline bool tryApply(int optionI,
+								 const StringView& value,
+								 ParseResult&)
+			{
+				this->matches.add(
+					optionI, this->argIndex, value, this->transient);
+				return true;
+			}
+
+			/** Records a given value of the argument at a given position. */
+			inline bool tryApplyArgument(size_t pos,
+										 const StringView& value,
+										 ParseResult&)
+			{
+				this->matches.add(-1 - static_cast< int >(pos),
+								  this->argIndex,
+								  value,
+								  this->transient);
+				return true;
+			}
+		};
+
+		/** Sink which applies nothing; e.g., to walk tokens for `complete`. */
+		class NullSink {
+		public:
+			/** Accepts the option at a given index without a value. */
+			inline bool tryApply(int, ParseResult&) {
+				return true;
+			}
+
+			/** Accepts the option at a given index with a given value. */
+			inline bool tryApply(int, const StringView&, ParseResult&) {
+				return true;
+			}
+
+			/** Accepts a given value of the argument at a given position. */
+			inline bool tryApplyArgument(size_t,
+										 const StringView&,
+										 ParseResult&)
+			{
+				return true;
+			}
+		};
+	public:
+		/** Candidate listed by `complete`. */
+		struct Completion {
+			/** Kind of a candidate. */
+			enum Kind {
+				/** Label of an option. */
+				OPTION,
+				/** Value name of the option which waits for its value. */
+				VALUE,
+				/** Value name of the next positional argument. */
+				ARGUMENT,
+				/** Name of a command. */
+				COMMAND
+			};
+
+			/** Kind of this candidate. */
+			Kind kind;
+
+			/** Label, value name or name of a command. */
+			String text;
+
+			/** Description of the option, argument or command. */
+			String description;
+
+			/** Initializes with a kind, text and description. */
+			inline Completion(Kind kind,
+							  const String& text,
+							  const String& description)
+				: kind(kind), text(text), description(description) {}
+		};
+
+		/**
+		 * Initializes with the description of the program.
+		 *
+		 * @param description
+		 *     Description of the program.
+		 */
+		explicit OptionParserBase(const String& description)
+			: pArena(0),
+			  description(description),
+			  compiled(false),
+			  generation(0),
+			  responseFiles(false),
+			  abbreviations(false)
+		{
+			this->optionList.reserve(10);
+			this->optionSlots.reserve(10);
+		}
+
+		/**
+		 * Initializes with the description of the program and an arena
+		 * which backs options and arguments.
+		 *
+		 * Options and arguments are allocated in `arena` instead of by
+		 * the standard new operator, so that configuring a parser needs
+		 * fewer allocations.
+		 * The pooled labels, descriptions and value names are not in
+		 * `arena`.
+		 *
+		 * @param description
+		 *     Description of the program.
+		 * @param arena
+		 *     Arena which backs options and arguments.
+		 *     Must outlive this parser.
+		 */
+		OptionParserBase(const String& description, Arena& arena)
+			: pArena(&arena),
+			  description(description),
+			  compiled(false),
+			  generation(0),
+			  responseFiles(false),
+			  abbreviations(false)
+		{
+			this->optionList.reserve(10);
+			this->optionSlots.reserve(10);
+		}
+
+		/** Releases resources. */
+		virtual ~OptionParserBase() {}
+
+		/**
+		 * Returns the description of the program.
+		 *
+		 * @return
+		 *     Description of the program.
+		 */
+		inline const String& getDescription() const {
+			return this->description;
+		}
+
+		/**
+		 * Returns the program name.
+		 *
+		 * @return
+		 *     Name of the program.
+		 *     An empty string if `parse` has not yet been called.
+		 */
+		inline const String& getProgramName() const {
+			return this->programName;
+		}
+
+		/**
+		 * Returns the generation of this parser.
+		 *
+		 * The generation changes whenever an option or argument is added,
+		 * or the program name changes, so that a rendered usage can be
+		 * reused while the generation stays the same
+		 * (see `CachedUsagePrinter`).
+		 *
+		 * @return
+		 *     Generation of this parser.
+		 */
+		inline size_t getGeneration() const {
+			return this->generation;
+		}
+
+		/**
+		 * Returns the number of the registered options.
+		 *
+		 * @return
+		 *     Number of the registered options.
+		 */
+		inline size_t getOptionCount() const {
+			return this->optionList.size();
+		}
+
+		/**
+		 * Returns the specification of the option at a given index.
+		 *
+		 * Undefined if `i >= this->getOptionCount()`.
+		 *
+		 * @param i
+		 *     Index of the option of which the specification is to be obtained.
+		 * @return
+		 *     Specification of the option at `i`.
+		 */
+		const OptionSpec< Ch >& getOption(size_t i) const {
+			return *this->optionList[i];
+		}
+
+		/**
+		 * Compiles the registered options into an immutable lookup table.
+		 *
+		 * `parse` looks up option labels in the compiled table instead of
+		 * the index of `labelPool` maintained while options are added.
+		 * The compiled table is discarded when an option is added, and
+		 * `parse` falls back to the pool until this function is called
+		 * again.
+		 * Also builds the indices of the labels for `suggestLabels` and
+		 * `findOptionsWithPrefix`.
+		 * Call this function after the configuration completes.
+		 */
+		void compile() {
+			typedef typename LabelTable< Ch >::Entry Entry;
+			std::vector< Entry > entries;
+			entries.reserve(this->optionSlots.size());
+			for (size_t i = 0; i < this->optionSlots.size(); ++i) {
+				entries.push_back(
+					Entry(this->optionSlots[i].label, static_cast< int >(i)));
+			}
+			std::sort(entries.begin(), entries.end(),
+					  [](const Entry& lhs, const Entry& rhs) {
+						  return lhs.first < rhs.first;
+					  });
+			this->compiledOptions.build(entries);
+			this->suggestionIndex.build(entries);
+			this->prefixIndex.swap(entries);
+			this->compiled = true;
+		}
+
+		/**
+		 * Returns whether the options have been compiled.
+		 *
+		 * @return
+		 *     Whether `compile` has been called since the last change of
+		 *     the options.
+		 */
+		inline bool isCompiled() const {
+			return this->compiled;
+		}
+
+		/**
+		 * Sets whether `@path` arguments are expanded.
+		 *
+		 * If enabled, an argument `@path` given to `parse`, `parseInto`,
+		 * `tryParseInto` or `tryParseBatch` is replaced with the arguments in
+		 * the file at `path` (see `ResponseFile`), which are split by
+		 * `CommandLineTokenizer`.
+		 * `@` in a response file is not expanded.
+		 * An error in a response file has the index of the `@path` argument.
+		 * A single `@` is not a response file.
+		 *
+		 * @param enabled
+		 *     Whether response files are expanded.
+		 */
+		inline void setResponseFilesEnabled(bool enabled) {
+			this->responseFiles = enabled;
+		}
+
+		/**
+		 * Finds the option labels similar to a given label; e.g., to tell
+		 * "did you mean" for an unknown option.
+		 *
+		 * A label is similar if the Levenshtein distance is at most a third
+		 * of the length of `label`, or 1 for a shorter label.
+		 * Searches the index built by `compile`, which measures the distance
+		 * to only a small part of the labels; otherwise, measures
+		 * the distance to every label.
+		 * `parse` and the other functions which throw `UnknownOption` call
+		 * this function only when they throw it, and `tryParseInto` never
+		 * calls it except for an unknown option of a command, whose parser
+		 * gives the suggestions to the result before it is released.
+		 *
+		 * @param label
+		 *     Label to be compared.
+		 * @param[out] suggestions
+		 *     Appended with the similar labels from the most similar.
+		 *     Labels as similar as each other are in the order of the
+		 *     options.
+		 * @param maxCount
+		 *     Maximum number of the labels to be appended. 3 by default.
+		 * @return
+		 *     Number of the labels appended.
+		 */
+		size_t suggestLabels(const StringView& label,
+							 std::vector< String >& suggestions,
+							 size_t maxCount = 3) const
+		{
+			typedef typename SuggestionIndex< Ch >::Match Match;
+			const size_t maxDistance = std::max< size_t >(1, label.size() / 3);
+			std::vector< Match > matches;
+			if (this->compiled) {
+				this->suggestionIndex.find(label, maxDistance, matches);
+			} else {
+				std::vector< size_t > row;
+				for (size_t i = 0; i < this->optionSlots.size(); ++i) {
+					const StringView& other = this->optionSlots[i].label;
+					if (other.size() > label.size() + maxDistance
+						|| label.size() > other.size() + maxDistance)
+					{
+						continue;
+					}
+					const size_t d =
+						SuggestionIndex< Ch >::distance(other, label, row);
+					if (d <= maxDistance) {
+						matches.push_back(Match(d, static_cast< int >(i)));
+					}
+				}
+				std::sort(matches.begin(), matches.end());
+			}
+			const size_t count = std::min(maxCount, matches.size());
+			for (size_t i = 0; i < count; ++i) {
+				suggestions.push_back(
+					this->optionList[matches[i].second]->getLabel());
+			}
+			return count;
+		}
+
+		/** Returns whether `@path` arguments are expanded. */
+		inline bool isResponseFilesEnabled() const {
+			return this->responseFiles;
+		}
+
+		/**
+		 * Sets whether a unique prefix of a long option label is accepted.
+		 *
+		 * If enabled, a token which starts with `--` but is not a label is
+		 * the option whose label is the only one that starts with
+		 * the token; e.g., `--thr` is `--threads` unless another label
+		 * starts with `--thr`.
+		 * `--prefix=value` is also accepted.
+		 * An exact label always precedes an abbreviation, and an ambiguous
+		 * abbreviation is an unknown option.
+		 * Labels are looked up in the index built by `compile` if any.
+		 *
+		 * @param enabled
+		 *     Whether abbreviations are accepted.
+		 */
+		inline void setAbbreviationsEnabled(bool enabled) {
+			this->abbreviations = enabled;
+		}
+
+		/** Returns whether abbreviations of labels are accepted. */
+		inline bool isAbbreviationsEnabled() const {
+			return this->abbreviations;
+		}
+
+		/**
+		 * Sets the observer of parsing.
+		 *
+		 * The observer is told every option and argument applied and
+		 * the start and end of the tokens applied by this parser, and
+		 * gives the observer of the parser of a selected command.
+		 * Must not be called while parsing.
+		 *
+		 * @param observer
+		 *     Observer of parsing.
+		 */
+		inline void setObserver(const Observer& observer) {
+			this->observer = observer;
+		}
+
+		/** Returns the observer of parsing. */
+		inline const Observer& getObserver() const {
+			return this->observer;
+		}
+
+		/**
+		 * Sets whether a given option is independent.
+		 *
+		 * The values of an independent option are formatted in advance,
+		 * possibly concurrently, by `tryParseParallel` and the overload of
+		 * `Matches::validate` with an executor; e.g., mark an option whose
+		 * formatter resolves a host name or reads a file.
+		 * The formatter of an independent option must be safe to be called
+		 * concurrently, and must not depend on the other options.
+		 * The function of an option added with a function is still called
+		 * in the order of the command line.
+		 * An option added by `addOption` with a field or function and one
+		 * added by `addListOption` can be independent; marking the other
+		 * options has no effect.
+		 * Replacing an option clears the mark.
+		 *
+		 * @param label
+		 *     Label of the option.
+		 * @param independent
+		 *     Whether the option is independent.
+		 * @return
+		 *     Whether `label` is known.
+		 */
+		bool setIndependent(const StringView& label, bool independent = true) {
+			const int optionI = this->findOptionIndex(label);
+			if (optionI < 0) {
+				return false;
+			}
+			this->optionSlots[optionI].independent = independent;
+			return true;
+		}
+
+		/** Returns whether a given option is independent. */
+		bool isIndependent(const StringView& label) const {
+			const int optionI = this->findOptionIndex(label);
+			return optionI >= 0 && this->optionSlots[optionI].independent;
+		}
+
+		/**
+		 * Finds the options whose labels start with a given prefix.
+		 *
+		 * Searches the sorted labels built by `compile` by a binary search,
+		 * which visits only the labels which start with `prefix`;
+		 * otherwise, scans every label.
+		 *
+		 * @param prefix
+		 *     Prefix of the labels. Every option matches an empty prefix.
+		 * @param[out] indices
+		 *     Appended with the indices of the options in
+		 *     the lexicographical order of the labels.
+		 * @param maxCount
+		 *     Maximum number of the indices to be appended.
+		 *     Unlimited by default.
+		 * @return
+		 *     Number of the indices appended.
+		 */
+		size_t findOptionsWithPrefix(const StringView& prefix,
+									 std::vector< int >& indices,
+									 size_t maxCount = size_t(-1)) const
+		{
+			size_t count = 0;
+			this->visitOptionsWithPrefix(prefix, [&](int optionI) {
+				if (count == maxCount) {
+					return false;
+				}
+				indices.push_back(optionI);
+				++count;
+				return true;
+			});
+			return count;
+		}
+
+		/**
+		 * Lists the candidates for the last word of a partial command line;
+		 * e.g., for shell completion.
+		 *
+		 * The words before the last one are walked as `parse` does without
+		 * applying any values, and errors in them are ignored.
+		 * Response files are not expanded.
+		 * The candidates depend on the state after those words,
+		 *  - if an option waits for its value, or the last word is
+		 *    `--label=...` of an option which needs a value: the value name
+		 *    of the option (`Completion::VALUE`).
+		 *  - if the last word does not start with a dash: the value name of
+		 *    the next positional argument (`Completion::ARGUMENT`), or
+		 *    the commands whose names start with the last word
+		 *    (`Completion::COMMAND`) after all of the arguments.
+		 *  - if the last word is empty or starts with a dash: the options
+		 *    whose labels start with the last word (`Completion::OPTION`)
+		 *    in the lexicographical order of the labels.
+		 *
+		 * If a command has been selected, the parser of the command is
+		 * built and completes the rest of the words.
+		 *
+		 * @param argc
+		 *     Number of the words including the program name.
+		 *     The last word is completed. Only the program name means
+		 *     an empty word.
+		 * @param argv
+		 *     Words. `argv[0]` is the program name.
+		 * @param[out] completions
+		 *     Appended with the candidates.
+		 * @return
+		 *     Number of the candidates appended.
+		 */
+		size_t complete(int argc,
+						const Ch* const argv[],
+						std::vector< Completion >& completions) const
+		{
+			const size_t first = completions.size();
+			ApplyState state;
+			NullSink sink;
+			for (int argI = 1; argI + 1 < argc; ++argI) {
+				ParseResult result;
+				this->tryApplyToken(
+					sink, state, StringView(argv[argI]), argI, result);
+				if (state.command >= 0) {
+					// the command name is the program name of the command
+					OptionParserBase parser(
+						this->commands[state.command]->getDescription());
+					this->configureCommand(parser, state.command);
+					return parser.complete(
+						argc - argI, argv + argI, completions);
+				}
+			}
+			const StringView word =
+				argc > 1 ? StringView(argv[argc - 1]) : StringView();
+			int valueOptionI = state.pendingOption;
+			if (valueOptionI < 0 && isLabel(word)) {
+				const size_t eqPos = word.find(Ch('='));
+				if (eqPos != StringView::npos && eqPos > 1) {
+					const int optionI =
+						this->findOptionIndex(word.substr(0, eqPos));
+					if (optionI >= 0 && this->needsValue(optionI)) {
+						valueOptionI = optionI;
+					}
+				}
+			}
+			if (valueOptionI >= 0) {
+				const Option& option = *this->optionList[valueOptionI];
+				completions.push_back(Completion(Completion::VALUE,
+												 option.getValueName(),
+												 option.getDescription()));
+				return completions.size() - first;
+			}
+			if (word.empty() || word[0] != Ch('-')) {
+				if (state.nextPos < this->arguments.size()) {
+					const Argument& argument = *this->arguments[state.nextPos];
+					completions.push_back(
+						Completion(Completion::ARGUMENT,
+								   argument.getValueName(),
+								   argument.getDescription()));
+				} else {
+					for (size_t i = 0; i < this->commands.size(); ++i) {
+						const Command& command = *this->commands[i];
+						if (StringView(command.getName()).startsWith(word)) {
+							completions.push_back(
+								Completion(Completion::COMMAND,
+										   command.getName(),
+										   command.getDescription()));
+						}
+					}
+				}
+			}
+			if (word.empty() || word[0] == Ch('-')) {
+				this->visitOptionsWithPrefix(word, [&](int optionI) {
+					const Option& option = *this->optionList[optionI];
+					completions.push_back(Completion(Completion::OPTION,
+													 option.getLabel(),
+													 option.getDescription()));
+					return true;
+				});
+			}
+			return completions.size() - first;
+		}
+
+		/**
+		 * Adds an option which substitutes a given field.
+		 *
+		 * Equivalent to the following call,
+		 *
+		 *     this->addOption(label, name, description, field, MetaFormat< T, Ch >())
+		 *
+		 * @tparam T
+		 *     See `OptionParserBase`.
+		 * @tparam SupOpt
+		 *     See `OptionParserBase`.
+		 * @param label
+		 *     Option label on the command line.
+		 * @param name
+		 *     Name of the value which the option takes.
+		 *     Used to explain what should be specified to the option.
+		 * @param description
+		 *     Description of the option.
+		 * @param field
+		 *     Pointer to the field of `SupOpt` to be substituted.
+		 * @throws ConfigException
+		 *     If `label` cannot be an option label
+		 *     (see `OptionParserBase::isLabel`).
+		 */
+		template < typename T, typename SupOpt >
+		inline void addOption(const String& label,
+							  const String& name,
+							  const String& description,
+							  T (SupOpt::*field))
+		{
+			this->addOption(
+				label, name, description, field, MetaFormat< T, Ch >());
+		}
+
+		/**
+		 * Adds an option which substitutes a given field with a value
+		 * formatted by a given function.
+		 *
+		 * If an option associated with `label` already exists in this parser,
+		 * it will be replaced with the new option.
+		 *
+		 * @tparam T
+		 *     See `OptionParserBase`.
+		 * @tparam SupOpt
+		 *     See `OptionParserBase`.
+		 * @tparam Format
+		 *     See `OptionParserBase`.
+		 * @param label
+		 *     Option label on the command line.
+		 * @param name
+		 *     Name of the value which the option takes.
+		 *     Used to explain what should be specified to the option.
+		 * @param description
+		 *     Description of the option.
+		 * @param field
+		 *     Pointer to the field of `SupOpt` to be substituted.
+		 * @param format
+		 *     Function object which converts a string into a value of the
+		 *     type `T`.
+		 * @throws ConfigException
+		 *     If `label` cannot be an option label
+		 *     (see `OptionParserBase::isLabel`).
+		 */
+		template < typename T, typename SupOpt, typename Format >
+		void addOption(const String& label,
+					   const String& name,
+					   const String& description,
+					   T (SupOpt::*field),
+					   const Format& format)
+		{
+			this->addOption(label, this->template create<
+				Option, MemberOption< T, SupOpt, Format > >(
+					this->internLabel(label),
+					this->textPool.intern(name),
+					this->textPool.intern(description),
+					field,
+					format));
+		}
+
+		/**
+		 * Adds an option which substitutes a given field with a given constant.
+		 *
+		 * If an option corresponding to `label` already exists in this parser,
+		 * it will be replaced with the new option.
+		 *
+		 * @tparam T
+		 *     See `OptionParserBase`.
+		 * @tparam SupOpt
+		 *     See `OptionParserBase`.
+		 * @param label
+		 *     Option label on the command line.
+		 * @param description
+		 *     Description of the option.
+		 * @param field
+		 *     Pointer to the field of `SupOpt` to be substituted.
+		 * @param constant
+		 *     Constant that substitutes the field.
+		 * @throws ConfigException
+		 *     If `label` cannot be an option label
+		 *     (see `OptionParserBase::isLabel`).
+		 */
+		template < typename T, typename SupOpt >
+		void addOption(const String& label,
+					   const String& description,
+					   T (SupOpt::*field),
+					   const T& constant)
+		{
+			this->addOption(label, this->template create<
+				Option, ConstMemberOption< T, SupOpt > >(
+					this->internLabel(label),
+					this->textPool.intern(description),
+					field,
+					constant));
+		}
+
+		/**
+		 * Adds a flag which substitutes a given `bool` field with a given
+		 * constant.
+		 *
+		 * Behaves as the equivalent `addOption` call but the parser
+		 * applies a flag from a compact table without calling a virtual
+		 * function; the option is still listed by `getOption` and
+		 * reset by `resetFields`.
+		 * Parsing a flag costs as much as parsing the equivalent option,
+		 * because looking up the label outweighs applying it.
+		 *
+		 * If an option corresponding to `label` already exists in this parser,
+		 * it will be replaced with the new flag.
+		 *
+		 * @tparam SupOpt
+		 *     See `OptionParserBase`.
+		 * @param label
+		 *     Option label on the command line.
+		 * @param description
+		 *     Description of the flag.
+		 * @param field
+		 *     Pointer to the field of `SupOpt` to be substituted.
+		 * @param value
+		 *     Constant that substitutes the field. `true` by default.
+		 * @throws ConfigException
+		 *     If `label` cannot be an option label
+		 *     (see `OptionParserBase::isLabel`).
+		 */
+		template < typename SupOpt >
+		void addFlag(const String& label,
+					 const String& description,
+					 bool (SupOpt::*field),
+					 bool value = true)
+		{
+			const int i = this->addOption(label, this->template create<
+				Option, ConstMemberOption< bool, SupOpt > >(
+					this->internLabel(label),
+					this->textPool.intern(description),
+					field,
+					value));
+			this->optionSlots[i].kind = FLAG_OPTION;
+			this->optionSlots[i].handler =
+				static_cast< int >(this->flags.size());
+			this->optionSlots[i].valueNeeded = false;
+			this->flags.push_back(Flag(field, value));
+		}
+
+		/**
+		 * Adds an option which appends values to a given vector.
+		 *
+		 * Equivalent to the following call,
+		 *
+		 *     this->addListOption(label, name, description, field, separator,
+		 *                         MetaFormat< T, Ch >())
+		 *
+		 */
+		template < typename T, typename SupOpt >
+		inline void addListOption(const String& label,
+								  const String& name,
+								  const String& description,
+								  std::vector< T > (SupOpt::*field),
+								  Ch separator = Ch('\0'))
+		{
+			this->addListOption(label, name, description, field, separator,
+								MetaFormat< T, Ch >());
+		}
+
+		/**
+		 * Adds an option which appends values formatted by a given function
+		 * to a given vector.
+		 *
+		 * Every occurrence of the option appends its value; e.g.,
+		 * `-I a -I b`.
+		 * If `separator` is not `Ch('\0')`, a value is split by
+		 * `separator` and each piece is appended; e.g., `-I a,b`.
+		 * Before parsing `argv`, a parser counts the values given to each
+		 * list option and reserves the vector once, so that appending
+		 * hardly reallocates it; values in response files are not counted.
+		 *
+		 * If an option associated with `label` already exists in this parser,
+		 * it will be replaced with the new option.
+		 *
+		 * @tparam T
+		 *     See `OptionParserBase`.
+		 * @tparam SupOpt
+		 *     See `OptionParserBase`.
+		 * @tparam Format
+		 *     See `OptionParserBase`.
+		 * @param label
+		 *     Option label on the command line.
+		 * @param name
+		 *     Name of the value which the option takes.
+		 *     Used to explain what should be specified to the option.
+		 * @param description
+		 *     Description of the option.
+		 * @param field
+		 *     Pointer to the field of `SupOpt` to which values are appended.
+		 * @param separator
+		 *     Separator of values in a single argument.
+		 *     `Ch('\0')` if values are not split.
+		 * @param format
+		 *     Function object which converts a string into a value of the
+		 *     type `T`.
+		 * @throws ConfigException
+		 *     If `label` cannot be an option label
+		 *     (see `OptionParserBase::isLabel`).
+		 */
+		template < typename T, typename SupOpt, typename Format >
+		void addListOption(const String& label,
+						   const String& name,
+						   const String& description,
+						   std::vector< T > (SupOpt::*field),
+						   Ch separator,
+						   Format format)
+		{
+			const int i = this->addOption(label, this->template create<
+				Option, ListOption< T, SupOpt, Format > >(
+					this->internLabel(label),
+					this->textPool.intern(name),
+					this->textPool.intern(description),
+					field,
+					separator,
+					format));
+			this->optionSlots[i].kind = LIST_OPTION;
+			this->optionSlots[i].handler =
+				static_cast< int >(this->lists.size());
+			this->lists.push_back(
+				List(i, this->optionSlots[i].label, separator));
+		}
+
+		/**
+		 * Adds an option which calls a given function.
+		 *
+		 * Equivalent to the following call,
+		 *
+		 *     this->addOption(label, name, description, f, MetaFormat< T, Ch >())
+		 *
+		 * @tparam T
+		 *     See `OptionParserBase`.
+		 * @tparam SupOpt
+		 *     See `OptionParserBase`.
+		 * @param label
+		 *     Option label on the command line.
+		 * @param name
+		 *     Name of the value which the option takes.
+		 *     Used to explain what should be specified to the option.
+		 * @param description
+		 *     Description of the option.
+		 * @param f
+		 *     Function to be called when the option is specified.
+		 * @throws ConfigException
+		 *     If `label` cannot be an option label
+		 *     (see `OptionParserBase::isLabel`).
+		 */
+		template < typename T, typename SupOpt >
+		inline void addOption(const String& label,
+							  const String& name,
+							  const String& description,
+							  void (*f)(SupOpt&, const T&))
+		{
+			this->addOption(label, name, description, f, MetaFormat< T, Ch >());
+		}
+
+		/**
+		 * Adds an option which calls a given function with a value formatted
+		 * by a given formatter function.
+		 *
+		 * If an option corresponding to `label` already exists in the parser,
+		 * it will be replaced with the new option.
+		 *
+		 * @tparam T
+		 *     See `OptionParserBase`.
+		 * @tparam SupOpt
+		 *     See `OptionParserBase`.
+		 * @tparam Format
+		 *     See `OptionParserBase`.
+		 * @param label
+		 *     Option label on the command line.
+		 * @param name
+		 *     Name of the value which the option takes.
+		 *     Used to explain what should be specified to the option.
+		 * @param description
+		 *     Description of the option.
+		 * @param f
+		 *     Function to be called when the option is specified.
+		 * @param format
+		 *     Function object which converts a string into a value of the
+		 *     type `T`.
+		 * @throws ConfigException
+		 *     If `label` cannot be an option label
+		 *     (see `OptionParserBase::isLabel`).
+		 */
+		template < typename T, typename SupOpt, typename Format >
+		void addOption(const String& label,
+					   const String& name,
+					   const String& description,
+					   void (*f)(SupOpt&, const T&),
+					   const Format& format)
+		{
+			this->addOption(label, this->template create<
+				Option, FunctionOption< T, SupOpt, Format > >(
+					this->internLabel(label),
+					this->textPool.intern(name),
+					this->textPool.intern(description),
+					f,
+					format));
+		}
+
+		/**
+		 * Adds an option which calls a given function without argument.
+		 *
+		 * If an option corresponding to `label` already exists in this parser,
+		 * it will be replaced with the new option.
+		 *
+		 * @tparam SupOpt
+		 *     See `OptionParserBase`.
+		 * @param label
+		 *     Option label on the command line.
+		 * @param description
+		 *     Description of the option.
+		 * @param f
+		 *     Function to be called when the option is specified.
+		 * @throws ConfigException
+		 *     If `label` cannot be an option label
+		 *     (see `OptionParserBase::isLabel`).
+		 */
+		template < typename SupOpt >
+		void addOption(const String& label,
+					   const String& description,
+					   void (*f)(SupOpt&))
+		{
+			this->addOption(label, this->template create<
+				Option, ConstFunctionOption< SupOpt > >(
+					this->internLabel(label),
+					this->textPool.intern(description),
+					f));
+		}
+
+		/**
+		 * Returns the number of the registered arguments.
+		 *
+		 * @return
+		 *     Number of the registered arguments.
+		 */
+		inline size_t getArgumentCount() const {
+			return this->arguments.size();
+		}
+
+		/**
+		 * Returns the specification of the argument at a given index.
+		 *
+		 * Undefined if `i >= this->getArgumentCount()`.
+		 *
+		 * @param i
+		 *     Index of the argument of which the specification is to be
+		 *     obtained.
+		 * @return
+		 *     Specification of the argument at the index `i`.
+		 */
+		inline const ArgumentSpec< Ch >& getArgument(size_t i) const {
+			return *this->arguments[i];
+		}
+
+		/**
+		 * Returns the number of the registered sub-commands.
+		 *
+		 * @return
+		 *     Number of the registered sub-commands.
+		 */
+		inline size_t getCommandCount() const {
+			return this->commands.size();
+		}
+
+		/**
+		 * Returns the specification of the sub-command at a given index.
+		 *
+		 * Undefined if `i >= this->getCommandCount()`.
+		 *
+		 * @param i
+		 *     Index of the sub-command of which the specification is to be
+		 *     obtained.
+		 * @return
+		 *     Specification of the sub-command at the index `i`.
+		 */
+		inline const CommandSpec< Ch >& getCommand(size_t i) const {
+			return *this->commands[i];
+		}
+
+		/**
+		 * Adds a sub-command which substitutes a given field with a given
+		 * constant when selected.
+		 *
+		 * The first positional token after the arguments of this parser
+		 * selects a command by its name; e.g., `tool -v build -j 4` selects
+		 * `build`.
+		 * Then a parser of the command is constructed and configured by
+		 * `configure`, and the rest of the tokens are applied to the same
+		 * options container by that parser.
+		 * So only the parser of the selected command is ever built.
+		 * The parser of a command is built every time the command is
+		 * selected and released after parsing, so that parsing stays
+		 * `const`.
+		 *
+		 * If a parser has commands, a command must be selected; otherwise
+		 * `TOO_FEW_ARGUMENTS` is reported.
+		 * An unknown command is reported as `BAD_VALUE`.
+		 * Commands are not supported by `tryParseLazy`.
+		 *
+		 * If a command named `name` already exists in this parser, it will
+		 * be replaced with the new command.
+		 *
+		 * @tparam T
+		 *     See `OptionParserBase`.
+		 * @tparam SupOpt
+		 *     See `OptionParserBase`.
+		 * @tparam Configure
+		 *     Type of a function which configures the parser of
+		 *     the command. Called as `configure(parser)` with an empty
+		 *     `OptionParserBase` of which the description is `description`.
+		 * @param name
+		 *     Name of the command on the command line.
+		 * @param description
+		 *     Description of the command.
+		 * @param field
+		 *     Pointer to the field of `SupOpt` to be substituted.
+		 * @param constant
+		 *     Constant that substitutes the field.
+		 * @param configure
+		 *     Function which configures the parser of the command.
+		 * @throws ConfigException
+		 *     If the last argument of this parser is variadic.
+		 */
+		template < typename T, typename SupOpt, typename Configure >
+		void addCommand(const String& name,
+						const String& description,
+						T (SupOpt::*field),
+						const T& constant,
+						Configure configure)
+		{
+			this->addCommand(this->template create<
+				Command, ConstMemberCommand< T, SupOpt, Configure > >(
+					this->textPool.intern(name),
+					this->textPool.intern(description),
+					field,
+					constant,
+					configure));
+		}
+
+		/**
+		 * Appends an argument which subsitutes a given field.
+		 *
+		 * @tparam T
+		 *     See `OptionParserBase`.
+		 * @tparam SupOpt
+		 *     See `OptionParserBase`.
+		 * @param name
+		 *     Name of the argument.
+		 *     Used to explain what should be specified to the argument.
+		 * @param description
+		 *     Description of the argument.
+		 * @param field
+		 *     Pointer to the field of `SupOpt` to be substituted.
+		 */
+		template < typename T, typename SupOpt >
+		void appendArgument(const String& name,
+							const String& description,
+							T (SupOpt::*field))
+		{
+			this->appendArgument(
+				name, description, field, MetaFormat< T, Ch >());
+		}
+
+		/**
+		 * Appends an argument which substitutes a given field with a value
+		 * formatted by a given formatter.
+		 *
+		 * @tparam T
+		 *     See `OptionParserBase`.
+		 * @tparam SupOpt
+		 *     See `OptionParserBase`.
+		 * @tparam Format
+		 *     See `OptionParserBase`.
+		 * @param name
+		 *     Name of the argument.
+		 *     Used to explain what should be specified to the argument.
+		 * @param description
+		 *     Description of the argument.
+		 * @param field
+		 *     Pointer to the field of `SupOpt` to be substituted.
+		 * @param format
+		 *     Function object which converts a string into a value of the
+		 *     type `T`.
+		 */
+		template < typename T, typename SupOpt, typename Format >
+		void appendArgument(const String& name,
+							const String& description,
+							T (SupOpt::*field),
+							const Format& format)
+		{
+			this->appendArgument(this->template create<
+				Argument, MemberArgument< T, SupOpt, Format > >(
+					this->textPool.intern(name),
+					this->textPool.intern(description),
+					field,
+					format));
+		}
+
+		/**
+		 * Appends an argument which calls a given function.
+		 *
+		 * Equivalent to the following call,
+		 *
+		 *     this->appendArgument(name, description, f, MetaFormat< T, Ch >())
+		 *
+		 * @tparam T
+		 *     See `OptionParserBase`.
+		 * @tparam SupOpt
+		 *     See `OptionParserBase`.
+		 * @param name
+		 *     Name of the argument.
+		 *     Used to explain what should be specified to the argument.
+		 * @param description
+		 *     Description of the argument.
+		 * @param f
+		 *     Function to be called when the argument is specified.
+		 */
+		template < typename T, typename SupOpt >
+		void appendArgument(const String& name,
+							const String& description,
+							void (*f)(SupOpt&, const T&))
+		{
+			this->appendArgument(name, description, f, MetaFormat< T, Ch >());
+		}
+
+		/**
+		 * Appends an argument which calls a given function with a value
+		 * formatted by a given formatter.
+		 *
+		 * @tparam T
+		 *     See `OptionParserBase`.
+		 * @tparam SupOpt
+		 *     See `OptionParserBase`.
+		 * @tparam Format
+		 *     See `OptionParserBase`.
+		 * @param name
+		 *     Name of the argument.
+		 *     Used to explain what should be specified to the argument.
+		 * @param description
+		 *     Description of the argument.
+		 * @param f
+		 *     Function to be called when the argument is specified.
+		 * @param format
+		 *     Function object which converts a string into a value of the
+		 *     type `T`.
+		 */
+		template < typename T, typename SupOpt, typename Format >
+		void appendArgument(const String& name,
+							const String& description,
+							void (*f)(SupOpt&, const T&),
+							const Format& format)
+		{
+			this->appendArgument(this->template create<
+				Argument, FunctionArgument< T, SupOpt, Format > >(
+					this->textPool.intern(name),
+					this->textPool.intern(description),
+					f,
+					format));
+		}
+
+		/**
+		 * Appends a variadic argument which calls a given function for each
+		 * of the remaining positional values.
+		 *
+		 * Equivalent to the following call,
+		 *
+		 *     this->appendVariadicArgument(
+		 *         name, description, f, MetaFormat< T, Ch >())
+		 *
+		 * @tparam T
+		 *     See `OptionParserBase`.
+		 * @tparam SupOpt
+		 *     See `OptionParserBase`.
+		 * @param name
+		 *     Name of the argument.
+		 *     Used to explain what should be specified to the argument.
+		 * @param description
+		 *     Description of the argument.
+		 * @param f
+		 *     Function to be called for each value.
+		 * @throws ConfigException
+		 *     If this parser already has a variadic argument.
+		 */
+		template < typename T, typename SupOpt >
+		void appendVariadicArgument(const String& name,
+									const String& description,
+									void (*f)(SupOpt&, const T&))
+		{
+			this->appendVariadicArgument(
+				name, description, f, MetaFormat< T, Ch >());
+		}
+
+		/**
+		 * Appends a variadic argument which calls a given function for each
+		 * of the remaining positional values formatted by a given formatter.
+		 *
+		 * A variadic argument takes zero or more values after the other
+		 * positional arguments have been substituted.
+		 * The values are not stored; `f` is called as each value arrives,
+		 * so parsing any number of values needs no extra memory.
+		 * No argument can be appended after a variadic argument.
+		 *
+		 * @tparam T
+		 *     See `OptionParserBase`.
 		 * @tparam SupOpt
 		 *     See `OptionParserBase`.
+		 * @tparam Format
+		 *     See `OptionParserBase`.
+		 * @param name
+		 *     Name of the argument.
+		 *     Used to explain what should be specified to the argument.
+		 * @param description
+		 *     Description of the argument.
+		 * @param f
+		 *     Function to be called for each value.
+		 * @param format
+		 *     Function object which converts a string into a value of the
+		 *     type `T`.
+		 * @throws ConfigException
+		 *     If this parser already has a variadic argument.
+		 */
+		template < typename T, typename SupOpt, typename Format >
+		void appendVariadicArgument(const String& name,
+									const String& description,
+									void (*f)(SupOpt&, const T&),
+									const Format& format)
+		{
+			this->appendArgument(this->template create<
+				Argument, VariadicFunctionArgument< T, SupOpt, Format > >(
+					this->textPool.intern(name),
+					this->textPool.intern(description),
+					f,
+					format));
+		}
+
+		/**
+		 * Parses given command line arguments.
+		 *
+		 * Updates the program name of this parser with `argv[0]`.
+		 * Use the `const` overload to parse command lines in multiple threads.
+		 *
+		 * @param argc
+		 *     Number of the command line arguments including the program name.
+		 * @param argv
+		 *     Command line arguments. First element must be the program name.
+		 * @return
+		 *     Parsed option values.
+		 * @throws TooFewArguments
+		 *     Thrown when too few arguments are given.
+		 * @throws TooManyArguments
+		 *     Thrown when too many arguments are given.
+		 * @throws ValueNeeded
+		 *     Thrown when no value is given to some option which needs a value.
+		 * @throws BadValue
+		 *     Thrown when a bad value is given to some option.
+		 * @throws UnknownOption
+		 *     Thrown when an unknown option is given.
+		 */
+		Opt parse(int argc, const Ch* const* argv) {
+			Opt options;
+			this->parseInto(options, argc, argv);
+			return options;
+		}
+
+		/**
+		 * Parses given command line arguments without modifying this parser.
+		 *
+		 * Unlike the non-`const` overload, the program name of this parser is
+		 * not updated; it is stored in `programName` instead.
+		 *
+		 * Once the configuration of this parser completes, concurrent calls of
+		 * this function on the same parser are safe, provided that formatters
+		 * and functions associated with options and arguments can be safely
+		 * called concurrently.
+		 * `DefaultFormatter` satisfies this requirement.
+		 * Adding an option or argument, calling `compile`, or calling
+		 * the non-`const` overload concurrently with this function is
+		 * a data race.
+		 *
+		 * @param argc
+		 *     Number of the command line arguments including the program name.
+		 * @param argv
+		 *     Command line arguments. First element must be the program name.
+		 * @param[out] programName
+		 *     Set to the program name; i.e., `argv[0]`.
+		 * @return
+		 *     Parsed option values.
+		 * @throws TooFewArguments
+		 *     Thrown when too few arguments are given.
+		 * @throws TooManyArguments
+		 *     Thrown when too many arguments are given.
+		 * @throws ValueNeeded
+		 *     Thrown when no value is given to some option which needs a value.
+		 * @throws BadValue
+		 *     Thrown when a bad value is given to some option.
+		 * @throws UnknownOption
+		 *     Thrown when an unknown option is given.
+		 */
+		Opt parse(int argc, const Ch* const* argv, String& programName) const {
+			Opt options;
+			this->parseInto(options, argc, argv, programName);
+			return options;
+		}
+
+		/**
+		 * Parses given command line arguments into a given options container.
+		 *
+		 * Fields of `options` which are not specified on the command line
+		 * keep their values, so that an options container and its containers
+		 * can be reused.
+		 * Combine with `resetFields` to clear the fields associated with this
+		 * parser beforehand.
+		 * Unlike `parse`, `Opt` does not have to support a default
+		 * constructor.
+		 *
+		 * Updates the program name of this parser with `argv[0]`.
+		 *
+		 * @param[in,out] options
+		 *     Options container to which the command line arguments are
+		 *     applied.
+		 * @param argc
+		 *     Number of the command line arguments including the program name.
+		 * @param argv
+		 *     Command line arguments. First element must be the program name.
+		 * @throws TooFewArguments
+		 *     Thrown when too few arguments are given.
+		 * @throws TooManyArguments
+		 *     Thrown when too many arguments are given.
+		 * @throws ValueNeeded
+		 *     Thrown when no value is given to some option which needs a value.
+		 * @throws BadValue
+		 *     Thrown when a bad value is given to some option.
+		 * @throws UnknownOption
+		 *     Thrown when an unknown option is given.
+		 */
+		void parseInto(Opt& options, int argc, const Ch* const* argv) {
+			this->raise(this->tryParseInto(options, argc, argv));
+		}
+
+		/**
+		 * Parses given command line arguments into a given options container
+		 * without modifying this parser.
+		 *
+		 * Equivalent to the non-`const` overload except that the program name
+		 * is stored in `programName` instead of this parser.
+		 * Safe to be called concurrently in the same way as the `const`
+		 * overload of `parse`.
+		 *
+		 * @param[in,out] options
+		 *     Options container to which the command line arguments are
+		 *     applied.
+		 * @param argc
+		 *     Number of the command line arguments including the program name.
+		 * @param argv
+		 *     Command line arguments. First element must be the program name.
+		 * @param[out] programName
+		 *     Set to the program name; i.e., `argv[0]`.
+		 * @throws TooFewArguments
+		 *     Thrown when too few arguments are given.
+		 * @throws TooManyArguments
+		 *     Thrown when too many arguments are given.
+		 * @throws ValueNeeded
+		 *     Thrown when no value is given to some option which needs a value.
+		 * @throws BadValue
+		 *     Thrown when a bad value is given to some option.
+		 * @throws UnknownOption
+		 *     Thrown when an unknown option is given.
+		 */
+		void parseInto(Opt& options,
+					   int argc,
+					   const Ch* const* argv,
+					   String& programName) const
+		{
+			this->raise(this->tryParseInto(options, argc, argv, programName));
+		}
+
+		/**
+		 * Parses given command line arguments into a given options container
+		 * without throwing a parsing exception.
+		 *
+		 * Equivalent to `parseInto` except that an error is returned instead
+		 * of being thrown.
+		 * An error may leave `options` partially updated.
+		 * No exception is thrown during parsing as long as formatters have
+		 * `tryFormat` (see `FormatInvoker`); `DefaultFormatter` and
+		 * `FastFormatter` do.
+		 * A parsing exception thrown by a formatter without `tryFormat` or by
+		 * a function associated with an option is caught and returned.
+		 *
+		 * Updates the program name of this parser with `argv[0]`.
+		 *
+		 * @param[in,out] options
+		 *     Options container to which the command line arguments are
+		 *     applied.
+		 * @param argc
+		 *     Number of the command line arguments including the program name.
+		 * @param argv
+		 *     Command line arguments. First element must be the program name.
+		 * @return
+		 *     Result of parsing.
+		 *     Refers to `argv` and this parser.
+		 */
+		ParseResult tryParseInto(Opt& options,
+								 int argc,
+								 const Ch* const* argv)
+		{
+			if (argc <= 0) {
+				return tooFewArguments(0);
+			}
+			// updates the program name
+			if (this->programName != argv[0]) {
+				this->programName = argv[0];
+				++this->generation;
+			}
+			return this->tryApplyArguments(options, argc, argv);
+		}
+
+		/**
+		 * Parses given command line arguments into a given options container
+		 * without modifying this parser and without throwing a parsing
+		 * exception.
+		 *
+		 * Equivalent to the non-`const` overload except that the program name
+		 * is stored in `programName` instead of this parser.
+		 * Safe to be called concurrently in the same way as the `const`
+		 * overload of `parse`.
+		 *
+		 * @param[in,out] options
+		 *     Options container to which the command line arguments are
+		 *     applied.
+		 * @param argc
+		 *     Number of the command line arguments including the program name.
+		 * @param argv
+		 *     Command line arguments. First element must be the program name.
+		 * @param[out] programName
+		 *     Set to the program name; i.e., `argv[0]`.
+		 * @return
+		 *     Result of parsing.
+		 *     Refers to `argv` and this parser.
+		 */
+		ParseResult tryParseInto(Opt& options,
+								 int argc,
+								 const Ch* const* argv,
+								 String& programName) const
+		{
+			if (argc <= 0) {
+				return tooFewArguments(0);
+			}
+			programName = argv[0];
+			return this->tryApplyArguments(options, argc, argv);
+		}
+
+		/**
+		 * Parses given command line arguments of another character type.
+		 *
+		 * Equivalent to `parse` except that `argv` is not of `Ch`; e.g.,
+		 * a `wchar_t` parser parses UTF-8 arguments.
+		 * Each argument is transcoded by `Transcoder` just before it is
+		 * applied, into a buffer reused for every argument, so that
+		 * the arguments are never converted as a whole and no memory is
+		 * allocated for an argument shorter than 256 characters.
+		 * Response files are not expanded.
+		 *
+		 * Updates the program name of this parser with `argv[0]`.
+		 *
+		 * @tparam OtherCh
+		 *     Type which represents a character of the arguments.
+		 *     `Transcoder< OtherCh, Ch >` must be specialized.
+		 * @param argc
+		 *     Number of the command line arguments including the program name.
+		 * @param argv
+		 *     Command line arguments. First element must be the program name.
+		 * @return
+		 *     Options given by the command line arguments.
+		 * @throws ParsingException
+		 *     See `parse`.
+		 */
+		template < typename OtherCh >
+		Opt parseTranscoded(int argc, const OtherCh* const* argv) {
+			String programName;
+			Opt options;
+			const ParseResult result =
+				this->tryParseTranscoded(options, argc, argv, programName);
+			if (argc > 0 && this->programName != programName) {
+				this->programName = programName;
+				++this->generation;
+			}
+			this->raise(result);
+			return options;
+		}
+
+		/**
+		 * Parses given command line arguments of another character type
+		 * into a given options container without modifying this parser and
+		 * without throwing a parsing exception.
+		 *
+		 * Equivalent to `tryParseInto` except for the arguments, which are
+		 * transcoded as `parseTranscoded` does.
+		 *
+		 * @tparam OtherCh
+		 *     See `parseTranscoded`.
+		 * @param[in,out] options
+		 *     Options container to which the command line arguments are
+		 *     applied.
+		 * @param argc
+		 *     Number of the command line arguments including the program name.
+		 * @param argv
+		 *     Command line arguments. First element must be the program name.
+		 * @param[out] programName
+		 *     Set to the transcoded program name.
+		 * @return
+		 *     Result of parsing.
+		 *     Refers to this parser but not to `argv`.
+		 */
+		template < typename OtherCh >
+		ParseResult tryParseTranscoded(Opt& options,
+									   int argc,
+									   const OtherCh* const* argv,
+									   String& programName) const
+		{
+			typedef Transcoder< OtherCh, Ch > Codec;
+			if (argc <= 0) {
+				return tooFewArguments(0);
+			}
+			const OtherCh* const first = argv[0];
+			const OtherCh* const last =
+				first + std::char_traits< OtherCh >::length(first);
+			programName.resize(Codec::getMaxSize(last - first) + 1);
+			programName.resize(
+				Codec::transcode(first, last, &programName[0]));
+			TranscodingReader< OtherCh > reader(argc, argv);
+			OptionsSink sink(*this, options);
+			return this->tryApplyTokens(sink, reader);
+		}
+
+		/**
+		 * Parses a command line given as a single string into a given options
+		 * container.
+		 *
+		 * The string is split into arguments by `CommandLineTokenizer` in
+		 * place, and the arguments are processed in the same way as
+		 * `parseInto`.
+		 * Unlike `argv`, the string must not start with the program name.
+		 * Never modifies this parser, and is safe to be called concurrently
+		 * in the same way as the `const` overload of `parse`.
+		 *
+		 * @param[in,out] options
+		 *     Options container to which the arguments are applied.
+		 * @param first
+		 *     Beginning of the command line string.
+		 *     Overwritten while quotes and escapes are removed.
+		 * @param last
+		 *     End of the command line string.
+		 * @throws BadSyntax
+		 *     Thrown when the string has an unterminated quote or escape.
+		 * @throws TooFewArguments
+		 *     Thrown when too few arguments are given.
+		 * @throws TooManyArguments
+		 *     Thrown when too many arguments are given.
+		 * @throws ValueNeeded
+		 *     Thrown when no value is given to some option which needs a value.
+		 * @throws BadValue
+		 *     Thrown when a bad value is given to some option.
+		 * @throws UnknownOption
+		 *     Thrown when an unknown option is given.
+		 */
+		void parseLine(Opt& options, Ch* first, Ch* last) const {
+			this->raise(this->tryParseLine(options, first, last));
+		}
+
+		/**
+		 * Parses a command line given as a single string into a given options
+		 * container.
+		 *
+		 * Equivalent to `parseLine(options, first, last)` where [`first`,
+		 * `last`) is the content of `line`.
+		 */
+		void parseLine(Opt& options, String& line) const {
+			this->raise(this->tryParseLine(options, line));
+		}
+
+		/**
+		 * Parses a command line given as a single string into a given options
+		 * container without throwing a parsing exception.
+		 *
+		 * Equivalent to `parseLine` except that an error is returned instead
+		 * of being thrown.
+		 * The argument index of an error is the index of the token in
+		 * the string, which starts from 0.
+		 *
+		 * @param[in,out] options
+		 *     Options container to which the arguments are applied.
+		 * @param first
+		 *     Beginning of the command line string.
+		 *     Overwritten while quotes and escapes are removed.
+		 * @param last
+		 *     End of the command line string.
+		 * @return
+		 *     Result of parsing.
+		 *     Refers to the string and this parser.
+		 */
+		ParseResult tryParseLine(Opt& options, Ch* first, Ch* last) const {
+			LineReader reader(first, last);
+			OptionsSink sink(*this, options);
+			return this->tryApplyTokens(sink, reader);
+		}
+
+		/**
+		 * Parses a command line given as a single string into a given options
+		 * container without throwing a parsing exception.
+		 *
+		 * Equivalent to `tryParseLine(options, first, last)` where [`first`,
+		 * `last`) is the content of `line`.
+		 * `line` keeps its size even though its content is overwritten.
+		 */
+		ParseResult tryParseLine(Opt& options, String& line) const {
+			Ch* first = line.empty() ? 0 : &line[0];
+			return this->tryParseLine(options, first, first + line.size());
+		}
+
+		/**
+		 * Records given command line arguments without applying them.
+		 *
+		 * Options and arguments are recognized in the same way as
+		 * `tryParseInto`, but no value is formatted and no function is
+		 * called; `matches` remembers which option or argument each value
+		 * is given to.
+		 * A bad value is therefore reported when it is accessed through
+		 * `matches`, or by `Matches::validate`, rather than by this
+		 * function.
+		 * Never modifies this parser, and is safe to be called concurrently
+		 * in the same way as the `const` overload of `parse`.
+		 *
+		 * @param argc
+		 *     Number of the command line arguments including the program name.
+		 * @param argv
+		 *     Command line arguments. First element must be the program name.
+		 *     Must outlive `matches`.
+		 * @param[out] matches
+		 *     Cleared and set to the recorded options and arguments.
+		 *     Refers to this parser.
+		 * @return
+		 *     Result of recognizing the arguments; i.e., `UNKNOWN_OPTION`,
+		 *     `VALUE_NEEDED`, `TOO_MANY_ARGUMENTS`, `TOO_FEW_ARGUMENTS`,
+		 *     `BAD_SYNTAX` or a `BAD_VALUE` for a response file.
+		 */
+		ParseResult tryParseLazy(int argc,
+								 const Ch* const* argv,
+								 Matches& matches) const
+		{
+			matches.clear();
+			matches.pParser = this;
+			if (argc <= 0) {
+				return tooFewArguments(0);
+			}
+			ArgvReader reader(argc, argv, this->responseFiles);
+			RecordSink sink(matches);
+			return this->tryApplyTokens(sink, reader);
+		}
+
+		/**
+		 * Parses given command line arguments into a given options
+		 * container, formatting the values of independent options with
+		 * a given executor.
+		 *
+		 * Equivalent to `tryParseParallel` except that an error is thrown.
+		 *
+		 * @see tryParseParallel
+		 */
+		template < typename Executor >
+		void parseParallel(Opt& options,
+						   int argc,
+						   const Ch* const* argv,
+						   const Executor& executor) const
+		{
+			this->raise(
+				this->tryParseParallel(options, argc, argv, executor));
+		}
+
+		/**
+		 * Parses given command line arguments into a given options
+		 * container, formatting the values of independent options with
+		 * a given executor, without throwing a parsing exception.
+		 *
+		 * The command line is read by `tryParseLazy`, and then applied by
+		 * the overload of `Matches::validate` with `executor`; e.g.,
+		 * `ThreadExecutor` formats the values of options marked by
+		 * `setIndependent` in multiple threads, and the results are applied
+		 * in the order of the command line.
+		 * Sub-commands are not supported.
+		 * Never modifies this parser, and is safe to be called concurrently
+		 * in the same way as the `const` overload of `parse`.
+		 *
+		 * @tparam Executor
+		 *     Type of the executor. See `SerialExecutor`.
+		 * @param[in,out] options
+		 *     Options container to which the values are applied.
+		 * @param argc
+		 *     Number of the command line arguments including the program name.
+		 * @param argv
+		 *     Command line arguments. First element must be the program name.
+		 * @param executor
+		 *     Executor which runs the formatting of each independent value.
+		 * @return
+		 *     Result of parsing.
+		 *     Refers to `argv` and this parser.
+		 */
+		template < typename Executor >
+		ParseResult tryParseParallel(Opt& options,
+									 int argc,
+									 const Ch* const* argv,
+									 const Executor& executor) const
+		{
+			Matches matches;
+			const ParseResult result = this->tryParseLazy(argc, argv, matches);
+			if (!result.isSuccess()) {
+				return result;
+			}
+			return matches.validate(options, executor);
+		}
+
+		/**
+		 * Parses given command line arguments and sources of option values
+		 * into a given options container.
+		 *
+		 * Equivalent to `tryParseWithSources` except that an error is thrown.
+		 *
+		 * @throws UnknownOption
+		 *     Thrown when a source which does not ignore unknown labels
+		 *     has an unknown label.
+		 * @see tryParseWithSources
+		 */
+		void parseWithSources(Opt& options,
+							  int argc,
+							  const Ch* const* argv,
+							  KeyValueSource< Ch >* const* sources,
+							  size_t sourceCount) const
+		{
+			this->raise(this->tryParseWithSources(
+				options, argc, argv, sources, sourceCount));
+		}
+
+		/**
+		 * Parses given command line arguments and sources of option values
+		 * into a given options container without throwing a parsing
+		 * exception.
+		 *
+		 * A later source overrides an earlier one, and the command line
+		 * overrides every source; e.g., give a configuration file and then
+		 * environment variables.
+		 * A list option (see `addListOption`) given more than once in
+		 * a source takes all of the values in the order of the source, as
+		 * repeated labels on the command line do; the values of a later
+		 * source or the command line replace them as a whole.
+		 * All of the sources and the command line are read first, and then
+		 * each option is applied only with the winning value, so a value
+		 * overridden by another is never formatted.
+		 * The labels of sources are looked up in the same way as
+		 * the command line.
+		 * An option which takes no value is applied unless the value turns
+		 * it off (see `KeyValueSource::isOff`).
+		 * The values of the sources are applied in the order of the options
+		 * before the command line is applied.
+		 *
+		 * The command line is read by `tryParseLazy`, so sub-commands are
+		 * not supported.
+		 * The argument index of an error in a source is -1.
+		 * Never modifies this parser, and is safe to be called concurrently
+		 * in the same way as the `const` overload of `parse`.
+		 *
+		 * @param[in,out] options
+		 *     Options container to which the values are applied.
+		 * @param argc
+		 *     Number of the command line arguments including the program name.
+		 * @param argv
+		 *     Command line arguments. First element must be the program name.
+		 * @param sources
+		 *     Sources of option values from the lowest precedence.
+		 * @param sourceCount
+		 *     Number of `sources`.
+		 * @return
+		 *     Result of parsing.
+		 *     Refers to `argv`, `sources` and this parser.
+		 */
+		ParseResult tryParseWithSources(Opt& options,
+										int argc,
+										const Ch* const* argv,
+										KeyValueSource< Ch >* const* sources,
+										size_t sourceCount) const
+		{
+			Matches matches;
+			ParseResult result = this->tryParseLazy(argc, argv, matches);
+			if (!result.isSuccess()) {
+				return result;
+			}
+			// the winning value of each option in the sources
+			// the options on the command line need no value
+			enum { NO_VALUE, HAS_VALUE, ON_COMMAND_LINE };
+			std::vector< StringView > values(this->optionList.size());
+			std::vector< char > states(this->optionList.size(), NO_VALUE);
+			// the values of each list option in the last source which
+			// has the option
+			typedef std::pair< int, StringView > ListValue;
+			std::vector< ListValue > listValues;
+			std::vector< size_t > listSources(this->optionList.size());
+			for (size_t i = 0; i < matches.matches.size(); ++i) {
+				if (matches.matches[i].index >= 0) {
+					states[matches.matches[i].index] = ON_COMMAND_LINE;
+				}
+			}
+			for (size_t i = 0; i < sourceCount; ++i) {
+				StringView label;
+				StringView value;
+				while (sources[i]->next(label, value)) {
+					const int optionI = this->findOptionIndex(label);
+					if (optionI < 0) {
+						if (sources[i]->ignoresUnknownLabels()) {
+							continue;
+						}
+						// the label may be overwritten by the source
+						result = ParseResult(ParseResult::UNKNOWN_OPTION,
+											 "unknown option",
+											 label,
+											 value);
+						result.pin();
+						return result;
+					}
+					if (states[optionI] == ON_COMMAND_LINE) {
+						continue;
+					}
+					if (this->optionSlots[optionI].kind == LIST_OPTION) {
+						if (states[optionI] == HAS_VALUE
+							&& listSources[optionI] != i)
+						{
+							// replaces the values of an earlier source
+							listValues.erase(std::remove_if(
+								listValues.begin(),
+								listValues.end(),
+								[optionI](const ListValue& v) {
+									return v.first == optionI;
+								}), listValues.end());
+						}
+						listSources[optionI] = i;
+						listValues.push_back(ListValue(optionI, value));
+					}
+					states[optionI] = HAS_VALUE;
+					values[optionI] = value;
+				}
+			}
+			std::stable_sort(listValues.begin(), listValues.end(),
+							 [](const ListValue& lhs, const ListValue& rhs) {
+								 return lhs.first < rhs.first;
+							 });
+			OptionsSink sink(*this, options);
+			size_t listI = 0;
+			for (size_t i = 0; i < values.size(); ++i) {
+				if (states[i] != HAS_VALUE) {
+					continue;
+				}
+				const int optionI = static_cast< int >(i);
+				bool applied = true;
+				if (this->optionSlots[optionI].kind == LIST_OPTION) {
+					for (; applied
+							 && listI < listValues.size()
+							 && listValues[listI].first == optionI;
+						 ++listI)
+					{
+						applied = sink.tryApply(
+							optionI, listValues[listI].second, result);
+					}
+				} else if (this->needsValue(optionI)) {
+					applied = sink.tryApply(optionI, values[i], result);
+				} else if (!KeyValueSource< Ch >::isOff(values[i])) {
+					applied = sink.tryApply(optionI, result);
+				}
+				if (!applied) {
+					return result;
+				}
+			}
+			return matches.validate(options);
+		}
+
+		/**
+		 * Parses a sequence of command lines without modifying this parser.
+		 *
+		 * The `i`-th command line is applied to the `i`-th options container,
+		 * and its result is stored in the `i`-th result.
+		 * Program names are ignored.
+		 * Each command line is parsed in the same way as the `const` overload
+		 * of `tryParseInto`; a failure of one command line does not affect
+		 * the others.
+		 *
+		 * @tparam SpanItr
+		 *     Input iterator of command lines.
+		 *     A command line must have `argc` and `argv` members like
+		 *     `ArgvSpan`.
+		 * @tparam OptItr
+		 *     Forward iterator of options containers.
+		 * @tparam ResultItr
+		 *     Output iterator of `ParseResult`.
+		 * @param first
+		 *     Beginning of the command lines.
+		 * @param last
+		 *     End of the command lines.
+		 * @param[in,out] options
+		 *     Beginning of the options containers.
+		 *     Must have as many containers as the command lines.
+		 * @param[out] results
+		 *     Beginning of the results.
+		 *     Must have room for as many results as the command lines.
+		 *     A result refers to the corresponding command line.
+		 */
+		template < typename SpanItr, typename OptItr, typename ResultItr >
+		void tryParseBatch(SpanItr first,
+						   SpanItr last,
+						   OptItr options,
+						   ResultItr results) const
+		{
+			for (; first != last; ++first, ++options, ++results) {
+				*results = this->tryParseArgv(
+					*options, first->argc, first->argv);
+			}
+		}
+
+		/**
+		 * Parses a sequence of command lines with a given executor.
+		 *
+		 * Equivalent to the other overload except that command lines are
+		 * parsed by tasks run by `executor`; e.g., `ThreadExecutor` parses
+		 * them in multiple threads.
+		 * Formatters and functions associated with options and arguments
+		 * must be safe to be called concurrently if `executor` runs tasks
+		 * concurrently (see the `const` overload of `parse`).
+		 *
+		 * @tparam SpanItr
+		 *     Random access iterator of command lines.
+		 * @tparam OptItr
+		 *     Random access iterator of options containers.
+		 * @tparam ResultItr
+		 *     Random access iterator of `ParseResult`.
+		 * @tparam Executor
+		 *     Type of the executor. See `SerialExecutor`.
+		 * @param first
+		 *     Beginning of the command lines.
+		 * @param last
+		 *     End of the command lines.
+		 * @param[in,out] options
+		 *     Beginning of the options containers.
+		 * @param[out] results
+		 *     Beginning of the results.
+		 * @param executor
+		 *     Executor which runs the parsing of each command line.
+		 */
+		template < typename SpanItr,
+				   typename OptItr,
+				   typename ResultItr,
+				   typename Executor >
+		void tryParseBatch(SpanItr first,
+						   SpanItr last,
+						   OptItr options,
+						   ResultItr results,
+						   const Executor& executor) const
+		{
+			const size_t n = static_cast< size_t >(last - first);
+			executor(n, [this, first, options, results](size_t i) {
+				results[i] = this->tryParseArgv(
+					options[i], first[i].argc, first[i].argv);
+			});
+		}
+
+		/**
+		 * Resets the fields of a given options container which options and
+		 * arguments of this parser substitute.
+		 *
+		 * Each field is copy-assigned from the corresponding field of
+		 * `defaults`, so that a container field can reuse its storage.
+		 * Other fields of `options` are left untouched.
+		 * Fields modified only through functions cannot be reset.
+		 *
+		 * @param[in,out] options
+		 *     Options container to be reset.
+		 * @param defaults
+		 *     Options container which has default values.
+		 */
+		void resetFields(Opt& options, const Opt& defaults) const {
+			for (size_t i = 0; i < this->optionList.size(); ++i) {
+				this->optionList[i]->reset(options, defaults);
+			}
+			for (size_t i = 0; i < this->arguments.size(); ++i) {
+				this->arguments[i]->reset(options, defaults);
+			}
+		}
+
+		/**
+		 * Returns whehter a given string is an option label.
+		 *
+		 * An option label satisfies all of the following conditions,
+		 *  - Starts with a dash (`-`)
+		 *  - The first dash is not followed by digits (`0-9`) or a dot (`.`)
+		 *
+		 * @param label
+		 *     String to be tested.
+		 * @return
+		 *     Whether `label` is an option label.
+		 */
+		static bool isLabel(const StringView& label) {
+			if (label.empty()) {
+				return false;
+			}
+			if (label[0] != Ch('-')) {
+				return false;
+			}
+			if (label.size() == 1) {
+				return true;
+			}
+			const Ch c = label[1];
+			return c != Ch('.') && !(Ch('0') <= c && c <= Ch('9'));
+		}
+
+		/**
+		 * Returns whehter a given string is an option label.
+		 *
+		 * Equivalent to `isLabel(StringView(label))`.
+		 */
+		static inline bool isLabel(const String& label) {
+			return isLabel(StringView(label));
+		}
+
+		/**
+		 * Returns whehter a given null-terminated string is an option label.
+		 *
+		 * Equivalent to `isLabel(StringView(label))`.
+		 * Never allocates memory.
+		 */
+		static inline bool isLabel(const Ch* label) {
+			// only the first two characters matter
+			if (label[0] == Ch('\0')) {
+				return false;
+			}
+			return isLabel(StringView(label, label[1] == Ch('\0') ? 1 : 2));
+		}
+	protected:
+		/**
+		 * Adds a given option to this parser.
+		 *
+		 * If an option corresponding to `label` already exists in this parser,
+		 * it will be replaced with `pOption`.
+		 *
 		 * @param label
 		 *     Option label on the command line.
-		 * @param name
-		 *     Name of the value which the option takes.
-		 *     Used to explain what should be specified to the option.
-		 * @param description
-		 *     Description of the option.
-		 * @param f
-		 *     Function to be called when the option is specified.
+		 *     Must start with a dash (`-`); e.g., "-o", "--option".
+		 *     Must be equal to the label of `pOption`.
+		 * @param pOption
+		 *     Pointer to the option to be added.
+		 *     Made by `create` with the label returned by `internLabel`.
+		 * @return
+		 *     Index of the option in this parser.
 		 * @throws ConfigException
-		 *     If `label` cannot be an option label
-		 *     (see `OptionParserBase::isLabel`).
+		 *     If `label` does not start with a dash.
 		 */
-		template < typename T, typename SupOpt >
-		inline void addOption(const String& label,
-							  const String& name,
-							  const String& description,
-							  void (*f)(SupOpt&, const T&))
-		{
-			this->addOption(label, name, description, f, MetaFormat< T, Ch >());
+		int addOption(const String& label, OptionPtr pOption) {
+			verifyLabel(label);
+			++this->generation;
+			// the compiled table no longer reflects the options
+			this->compiled = false;
+			this->compiledOptions.clear();
+			this->suggestionIndex.clear();
+			this->prefixIndex.clear();
+			// the label is in `labelPool`, and stays there after
+			// the option is replaced
+			const StringView key(pOption->getLabel());
+			const int labelI = this->labelPool.indexOf(key);
+			if (this->labelOptions[labelI] >= 0) {
+				// replaces an existing option
+				const int i = this->labelOptions[labelI];
+				this->optionList[i] = std::move(pOption);
+				const OptionSlot& slot = this->optionSlots[i];
+				if (slot.kind == LIST_OPTION) {
+					this->lists[slot.handler].optionIndex = -1;
+				}
+				this->optionSlots[i] =
+					OptionSlot(key, this->optionList[i]->needsValue());
+				return i;
+			} else {
+				// new otpion
+				const int i = static_cast< int >(this->optionList.size());
+				this->optionList.push_back(std::move(pOption));
+				this->optionSlots.push_back(
+					OptionSlot(key, this->optionList[i]->needsValue()));
+				this->labelOptions[labelI] = i;
+				return i;
+			}
 		}
 
 		/**
-		 * Adds an option which calls a given function with a value formatted
-		 * by a given formatter function.
+		 * Returns the copy of a given option label in the pool of labels.
 		 *
-		 * If an option corresponding to `label` already exists in the parser,
-		 * it will be replaced with the new option.
+		 * Pass the returned label to the option given to `addOption`.
 		 *
-		 * @tparam T
-		 *     See `OptionParserBase`.
-		 * @tparam SupOpt
-		 *     See `OptionParserBase`.
-		 * @tparam Format
-		 *     See `OptionParserBase`.
 		 * @param label
 		 *     Option label on the command line.
-		 * @param name
-		 *     Name of the value which the option takes.
-		 *     Used to explain what should be specified to the option.
-		 * @param description
-		 *     Description of the option.
-		 * @param f
-		 *     Function to be called when the option is specified.
-		 * @param format
-		 *     Function object which converts a string into a value of the
-		 *     type `T`.
+		 * @return
+		 *     Label in the pool, which lives as long as this parser.
 		 * @throws ConfigException
-		 *     If `label` cannot be an option label
-		 *     (see `OptionParserBase::isLabel`).
+		 *     If `label` cannot be an option label.
 		 */
-		template < typename T, typename SupOpt, typename Format >
-		void addOption(const String& label,
-					   const String& name,
-					   const String& description,
-					   void (*f)(SupOpt&, const T&),
-					   const Format& format)
+		const String& internLabel(const String& label) {
+			verifyLabel(label);
+			const String& pooled = this->labelPool.intern(label);
+			this->labelOptions.resize(this->labelPool.size(), -1);
+			return pooled;
+		}
+
+		/**
+		 * Appends a given argument to this parser.
+		 *
+		 * @param pArgument
+		 *     Pointer to the argument to be appended.
+		 *     Made by `create`.
+		 * @throws ConfigException
+		 *     If the last argument of this parser is variadic.
+		 */
+		void appendArgument(ArgumentPtr pArgument) {
+			if (this->hasVariadicArgument()) {
+				OPTPARSE_THROW(ConfigException(
+					"no argument can follow variadic argument"));
+			}
+			++this->generation;
+			this->arguments.push_back(std::move(pArgument));
+		}
+
+		/**
+		 * Adds a given sub-command to this parser.
+		 *
+		 * If a command with the same name already exists in this parser,
+		 * it will be replaced with `pCommand`.
+		 *
+		 * @param pCommand
+		 *     Pointer to the command to be added.
+		 *     Made by `create`.
+		 * @throws ConfigException
+		 *     If the last argument of this parser is variadic.
+		 */
+		void addCommand(CommandPtr pCommand) {
+			if (this->hasVariadicArgument()) {
+				OPTPARSE_THROW(ConfigException(
+					"no command can follow variadic argument"));
+			}
+			++this->generation;
+			const int i = this->findCommandIndex(pCommand->getName());
+			if (i >= 0) {
+				this->commands[i] = std::move(pCommand);
+			} else {
+				this->commands.push_back(std::move(pCommand));
+			}
+		}
+
+		/** Returns whether the last argument of this parser is variadic. */
+		inline bool hasVariadicArgument() const {
+			return !this->arguments.empty()
+				&& this->arguments.back()->isVariadic();
+		}
+
+		/**
+		 * Creates an option or argument.
+		 *
+		 * The object is created in the arena if this parser has one.
+		 * Otherwise, it is allocated by the standard new operator.
+		 *
+		 * @tparam Base
+		 *     `Option` or `Argument`.
+		 * @tparam T
+		 *     Type of the object. Must be a subclass of `Base`.
+		 * @param args
+		 *     Arguments given to the constructor of `T`.
+		 * @return
+		 *     Pointer which owns the created object.
+		 */
+		template < typename Base, typename T, typename... Args >
+		std::unique_ptr< Base, ArenaDeleter< Base > > create(Args&&... args) {
+			typedef std::unique_ptr< Base, ArenaDeleter< Base > > Ptr;
+			if (this->pArena != 0) {
+				return Ptr(
+					this->pArena->template create< T >(
+						std::forward< Args >(args)...),
+					ArenaDeleter< Base >(true));
+			}
+			return Ptr(new T(std::forward< Args >(args)...));
+		}
+
+		/**
+		 * Finds the option that has to a given label.
+		 *
+		 * Never allocates memory.
+		 *
+		 * @param label
+		 *     Label of the option to be searched.
+		 * @return
+		 *     Option that has `label`. 0 if no option has `label`.
+		 */
+		const Option* findOption(const StringView& label) const {
+			const int i = this->findOptionIndex(label);
+			return i >= 0 ? this->optionList[i].get() : 0;
+		}
+
+		/**
+		 * Finds the index of the option that has a given label.
+		 *
+		 * Looks up the compiled table if the options have been compiled.
+		 * Never allocates memory.
+		 *
+		 * @param label
+		 *     Label of the option to be searched.
+		 * @return
+		 *     Index of the option that has `label` in the option list.
+		 *     -1 if no option has `label`.
+		 */
+		int findOptionIndex(const StringView& label) const {
+			if (this->compiled) {
+				return this->compiledOptions.find(label);
+			}
+			const int labelI = this->labelPool.indexOf(label);
+			return labelI >= 0 ? this->labelOptions[labelI] : -1;
+		}
+
+		/**
+		 * Calls a given function with the index of every option whose
+		 * label starts with a given prefix, in the order of the labels.
+		 *
+		 * Scans every label unless the options have been compiled.
+		 * Stops when `visitor` returns `false`.
+		 */
+		template < typename Visitor >
+		void visitOptionsWithPrefix(const StringView& prefix,
+									Visitor visitor) const
+		{
+			if (this->compiled) {
+				typedef typename LabelTable< Ch >::Entry Entry;
+				typename std::vector< Entry >::const_iterator entryItr =
+					std::lower_bound(this->prefixIndex.begin(),
+									 this->prefixIndex.end(),
+									 Entry(prefix, -1),
+									 [](const Entry& lhs, const Entry& rhs) {
+										 return lhs.first < rhs.first;
+									 });
+				for (; entryItr != this->prefixIndex.end()
+						 && entryItr->first.startsWith(prefix);
+					 ++entryItr)
+				{
+					if (!visitor(entryItr->second)) {
+						return;
+					}
+				}
+				return;
+			}
+			// sorts the matching labels unless compiled
+			typedef typename LabelTable< Ch >::Entry Entry;
+			std::vector< Entry > entries;
+			for (size_t i = 0; i < this->optionSlots.size(); ++i) {
+				const StringView& label = this->optionSlots[i].label;
+				if (label.startsWith(prefix)) {
+					entries.push_back(Entry(label, static_cast< int >(i)));
+				}
+			}
+			std::sort(entries.begin(), entries.end(),
+					  [](const Entry& lhs, const Entry& rhs) {
+						  return lhs.first < rhs.first;
+					  });
+			for (size_t i = 0; i < entries.size(); ++i) {
+				if (!visitor(entries[i].second)) {
+					return;
+				}
+			}
+		}
+
+		/**
+		 * Finds the only option whose label starts with a given
+		 * abbreviation of a long label.
+		 *
+		 * @param prefix
+		 *     Abbreviation which starts with `--`.
+		 * @param[out] ambiguous
+		 *     Set to whether more than one label starts with `prefix`.
+		 * @return
+		 *     Index of the option. -1 if abbreviations are disabled, or no
+		 *     or more than one label starts with `prefix`.
+		 */
+		int findAbbreviatedOption(const StringView& prefix,
+								  bool& ambiguous) const
 		{
-			OptionPtr pOption(new FunctionOption< T, SupOpt, Format >(
-				label, name, description, f, format));
-			this->addOption(label, pOption);
+			ambiguous = false;
+			if (!this->abbreviations
+				|| prefix.size() <= 2
+				|| prefix[0] != Ch('-')
+				|| prefix[1] != Ch('-'))
+			{
+				return -1;
+			}
+			int found = -1;
+			this->visitOptionsWithPrefix(prefix, [&](int optionI) {
+				if (found >= 0) {
+					ambiguous = true;
+					return false;
+				}
+				found = optionI;
+				return true;
+			});
+			return ambiguous ? -1 : found;
 		}
 
 		/**
-		 * Adds an option which calls a given function without argument.
+		 * Checks whether a given option label is valid.
 		 *
-		 * If an option corresponding to `label` already exists in this parser,
-		 * it will be replaced with the new option.
+		 * `label` is tested by the `OptionParserBase::isLabel` function.
 		 *
-		 * @tparam SupOpt
-		 *     See `OptionParserBase`.
 		 * @param label
-		 *     Option label on the command line.
-		 * @param description
-		 *     Description of the option.
-		 * @param f
-		 *     Function to be called when the option is specified.
+		 *     Label to be tested.
 		 * @throws ConfigException
-		 *     If `label` cannot be an option label
-		 *     (see `OptionParserBase::isLabel`).
+		 *     If `label` cannot be an option label.
+		 * @see  isLabel
 		 */
-		template < typename SupOpt >
-		void addOption(const String& label,
-					   const String& description,
-					   void (*f)(SupOpt&))
+		static void verifyLabel(const String& label) {
+			if (!isLabel(label)) {
+				OPTPARSE_THROW(
+					ConfigException("option label must start with dash (-)"));
+			}
+		}
+	private:
+		/**
+		 * Parses given command line arguments ignoring the program name.
+		 *
+		 * Never modifies this parser.
+		 */
+		ParseResult tryParseArgv(Opt& options,
+								 int argc,
+								 const Ch* const* argv) const
+		{
+			if (argc <= 0) {
+				return tooFewArguments(0);
+			}
+			return this->tryApplyArguments(options, argc, argv);
+		}
+
+		/**
+		 * Applies given command line arguments to a given options container.
+		 *
+		 * Never modifies this parser.
+		 *
+		 * @param options
+		 *     Options container to which the arguments are applied.
+		 * @param argc
+		 *     Number of the command line arguments including the program name.
+		 *     Must be positive.
+		 * @param argv
+		 *     Command line arguments. First element is ignored.
+		 * @return
+		 *     Result of parsing.
+		 */
+		ParseResult tryApplyArguments(Opt& options,
+									  int argc,
+									  const Ch* const* argv) const
 		{
-			OptionPtr pOption(
-				new ConstFunctionOption< SupOpt >(label, description, f));
-			this->addOption(label, pOption);
+			if (!this->lists.empty()) {
+				this->reserveLists(options, argc, argv);
+			}
+			ArgvReader reader(argc, argv, this->responseFiles);
+			OptionsSink sink(*this, options);
+			return this->tryApplyTokens(sink, reader);
+		}
+
+		/**
+		 * Counts the values given to each list option in given command
+		 * line arguments, and reserves the fields for them.
+		 *
+		 * Recognizes `-I value`, `-I=value`, `--include=value` and
+		 * `-Ivalue`, and counts the separators in a value.
+		 * Labels of the list options are compared with the arguments
+		 * directly instead of looking up every argument.
+		 * The counts only have to be close, because they are merely
+		 * reserved.
+		 *
+		 * @param options
+		 *     Options container of which the fields are reserved.
+		 * @param argc
+		 *     Number of the command line arguments including the program name.
+		 * @param argv
+		 *     Command line arguments. First element is ignored.
+		 */
+		void reserveLists(Opt& options, int argc, const Ch* const* argv) const {
+			std::vector< size_t > counts(this->lists.size(), 0);
+			for (int i = 1; i < argc; ++i) {
+				const Ch* token = argv[i];
+				if (token[0] != Ch('-')) {
+					continue;
+				}
+				for (size_t listI = 0; listI < this->lists.size(); ++listI) {
+					const List& list = this->lists[listI];
+					if (list.optionIndex < 0) {
+						continue;
+					}
+					// a null character never matches the label
+					size_t n = 0;
+					while (n < list.label.size() && token[n] == list.label[n]) {
+						++n;
+					}
+					if (n < list.label.size()) {
+						continue;
+					}
+					const Ch* rest = token + n;
+					StringView value;
+					if (*rest == Ch('\0')) {
+						// skips the value
+						if (++i < argc) {
+							value = StringView(argv[i]);
+						}
+					} else if (*rest == Ch('=')) {
+						value = StringView(rest + 1);
+					} else if (n == 2 && token[1] != Ch('-')) {
+						value = StringView(rest);
+					} else {
+						continue;
+					}
+					++counts[listI];
+					if (list.separator != Ch('\0')) {
+						for (size_t j = 0; j < value.size(); ++j) {
+							if (value[j] == list.separator) {
+								++counts[listI];
+							}
+						}
+					}
+					break;
+				}
+			}
+			for (size_t i = 0; i < counts.size(); ++i) {
+				if (counts[i] > 0) {
+					this->optionList[this->lists[i].optionIndex]->reserve(
+						options, counts[i]);
+				}
+			}
 		}
 
 		/**
-		 * Returns the number of the registered arguments.
+		 * Reader of tokens from `argv`.
+		 *
+		 * A reader must have the following functions,
+		 *  - `bool next(StringView& token, ParseResult& result)`:
+		 *    reads the next token. Returns `false` at the end, or sets
+		 *    `result` to an error and returns `false` on an error.
+		 *  - `int getIndex() const`: returns the index of the next token.
+		 *  - `bool ownsToken() const`: returns whether the last token is
+		 *    released with the reader.
+		 */
+		class ArgvReader {
+		private:
+			/** Number of the arguments. */
+			int argc;
+
+			/** Arguments. */
+			const Ch* const* argv;
+
+			/** Index of the next argument. */
+			int i;
+
+			/** Whether `@path` arguments are expanded. */
+			bool expands;
+
+			/** Response file being read. */
+			ResponseFile< Ch > file;
+
+			/** Tokenizer of `file`. */
+			CommandLineTokenizer< Ch > tokenizer;
+
+			/** Whether tokens are read from `file`. */
+			bool inFile;
+		public:
+			/** Initializes with arguments. Skips the program name. */
+			inline ArgvReader(int argc, const Ch* const* argv, bool expands)
+				: argc(argc),
+				  argv(argv),
+				  i(1),
+				  expands(expands),
+				  tokenizer(0, 0),
+				  inFile(false) {}
+
+			/** Reads the next argument or token in a response file. */
+			bool next(StringView& token, ParseResult& result) {
+				for (;;) {
+					if (this->inFile) {
+						if (this->tokenizer.next(token)) {
+							return true;
+						}
+						this->inFile = false;
+						if (this->tokenizer.getError() != 0) {
+							result = ParseResult(ParseResult::BAD_SYNTAX,
+												 this->tokenizer.getError());
+							result.setArgIndex(this->i - 1);
+							return false;
+						}
+					}
+					if (this->i >= this->argc) {
+						return false;
+					}
+					const Ch* arg = this->argv[this->i++];
+					if (!this->expands
+						|| arg[0] != Ch('@')
+						|| arg[1] == Ch('\0'))
+					{
+						token = StringView(arg);
+						return true;
+					}
+					if (!this->file.open(arg + 1)) {
+						result = ParseResult(ParseResult::BAD_VALUE,
+											 "cannot read response file",
+											 StringView(),
+											 StringView(arg + 1));
+						result.setArgIndex(this->i - 1);
+						return false;
+					}
+					this->tokenizer = CommandLineTokenizer< Ch >(
+						this->file.begin(), this->file.end());
+					this->inFile = true;
+				}
+			}
+
+			/**
+			 * Returns the index of the next argument.
+			 *
+			 * The index of the `@path` argument plus one while its tokens
+			 * are read.
+			 */
+			inline int getIndex() const {
+				return this->i;
+			}
+
+			/** Returns whether the last token is in a response file. */
+			inline bool ownsToken() const {
+				return this->inFile;
+			}
+		};
+
+		/** Reader of tokens from a `CommandLineTokenizer`. */
+		class LineReader {
+		private:
+			/** Tokenizer of the command line. */
+			CommandLineTokenizer< Ch > tokenizer;
+
+			/** Index of the next token. */
+			int i;
+		public:
+			/** Initializes with a command line. */
+			inline LineReader(Ch* first, Ch* last)
+				: tokenizer(first, last), i(0) {}
+
+			/** Reads the next token. */
+			bool next(StringView& token, ParseResult& result) {
+				if (this->tokenizer.next(token)) {
+					++this->i;
+					return true;
+				}
+				if (this->tokenizer.getError() != 0) {
+					result = ParseResult(
+						ParseResult::BAD_SYNTAX, this->tokenizer.getError());
+					result.setArgIndex(this->i);
+				}
+				return false;
+			}
+
+			/** Returns the index of the next token. */
+			inline int getIndex() const {
+				return this->i;
+			}
+
+			/** Returns `false`; tokens are in the buffer of the caller. */
+			inline bool ownsToken() const {
+				return false;
+			}
+		};
+
+		/**
+		 * Reader of arguments of another character type.
+		 *
+		 * Each argument is transcoded by `Transcoder` into a buffer on
+		 * the stack, or into a string grown only for a longer argument,
+		 * which is reused for the next argument.
+		 * `@path` arguments are not expanded.
+		 *
+		 * @tparam OtherCh
+		 *     Type which represents a character of the arguments.
+		 */
+		template < typename OtherCh >
+		class TranscodingReader {
+		private:
+			/** Transcoder of the arguments. */
+			typedef Transcoder< OtherCh, Ch > Codec;
+
+			/** Number of the characters in the buffer on the stack. */
+			static const size_t BUFFER_SIZE = 256;
+
+			/** Number of the arguments. */
+			int argc;
+
+			/** Arguments. */
+			const OtherCh* const* argv;
+
+			/** Index of the next argument. */
+			int i;
+
+			/** Buffer of a short argument. */
+			Ch buffer[BUFFER_SIZE];
+
+			/** Buffer of a long argument. */
+			String longBuffer;
+		public:
+			/** Initializes with arguments. Skips the program name. */
+			inline TranscodingReader(int argc, const OtherCh* const* argv)
+				: argc(argc), argv(argv), i(1) {}
+
+			/** Reads and transcodes the next argument. */
+			bool next(StringView& token, ParseResult&) {
+				if (this->i >= this->argc) {
+					return false;
+				}
+				const OtherCh* arg = this->argv[this->i++];
+				const OtherCh* last =
+					arg + std::char_traits< OtherCh >::length(arg);
+				const size_t maxSize = Codec::getMaxSize(last - arg);
+				Ch* out = this->buffer;
+				if (maxSize > BUFFER_SIZE) {
+					this->longBuffer.resize(maxSize);
+					out = &this->longBuffer[0];
+				}
+				token = StringView(out, Codec::transcode(arg, last, out));
+				return true;
+			}
+
+			/** Returns the index of the next argument. */
+			inline int getIndex() const {
+				return this->i;
+			}
+
+			/** Returns `true`; the buffer is reused for the next token. */
+			inline bool ownsToken() const {
+				return true;
+			}
+		};
+
+		/**
+		 * Applies tokens read from a given reader to a given sink.
 		 *
+		 * Never modifies this parser.
+		 *
+		 * @tparam Sink
+		 *     Type of the sink. See `OptionsSink`.
+		 * @tparam Reader
+		 *     Type of the reader. See `ArgvReader`.
+		 * @param sink
+		 *     Sink to which the tokens are applied.
+		 * @param reader
+		 *     Reader of the tokens.
 		 * @return
-		 *     Number of the registered arguments.
+		 *     Result of parsing.
 		 */
-		inline size_t getArgumentCount() const {
-			return this->arguments.size();
+		template < typename Sink, typename Reader >
+		ParseResult tryApplyTokens(Sink& sink, Reader& reader) const {
+			const typename Observer::Timer timer = this->observer.startParse();
+			ParseResult result = this->tryApplyEachToken(sink, reader);
+			this->observer.finishParse(timer, result);
+			return result;
+		}
+
+		/** Applies tokens as `tryApplyTokens` does without observing. */
+		template < typename Sink, typename Reader >
+		ParseResult tryApplyEachToken(Sink& sink, Reader& reader) const {
+			ApplyState state;
+			ParseResult result;
+			StringView token;
+			while (reader.next(token, result)) {
+				sink.beginToken(reader.getIndex() - 1, reader.ownsToken());
+				if (!this->tryApplyToken(
+						sink, state, token, reader.getIndex() - 1, result))
+				{
+					// the token is released with the reader
+					if (reader.ownsToken()) {
+						result.pin();
+					}
+					return result;
+				}
+				if (state.command >= 0) {
+					return this->tryApplyCommand(sink, state.command, reader);
+				}
+			}
+			if (!result.isSuccess()) {
+				return result;
+			}
+			return this->tryFinishTokens(state, reader.getIndex());
 		}
 
 		/**
-		 * Returns the specification of the argument at a given index.
+		 * Applies a given token to a given sink.
 		 *
-		 * Undefined if `i >= this->getArgumentCount()`.
+		 * Never modifies this parser.
 		 *
-		 * @param i
-		 *     Index of the argument of which the specification is to be
-		 *     obtained.
+		 * @param sink
+		 *     Sink to which the token is applied.
+		 * @param[in,out] state
+		 *     State of parsing updated by the token.
+		 * @param token
+		 *     Token to be applied.
+		 *     Not referred to after this function returns.
+		 * @param argI
+		 *     Index of the token.
+		 * @param[out] result
+		 *     Set to the error if the token cannot be applied.
 		 * @return
-		 *     Specification of the argument at the index `i`.
+		 *     Whether the token has been applied.
 		 */
-		inline const ArgumentSpec< Ch >& getArgument(size_t i) const {
-			return *this->arguments[i];
+		template < typename Sink >
+		bool tryApplyToken(Sink& sink,
+						   ApplyState& state,
+						   const StringView& token,
+						   int argI,
+						   ParseResult& result) const
+		{
+			if (state.pendingOption >= 0) {
+				// applies the value of the previous option
+				const int optionI = state.pendingOption;
+				state.pendingOption = -1;
+				if (!sink.tryApply(optionI, token, result)) {
+					result.setArgIndex(argI);
+					return false;
+				}
+				return true;
+			}
+			// checks if `token` is an option label
+			if (isLabel(token)) {
+				// processes an option
+				// an exact label precedes `--label=value` and clusters
+				const int optionI = this->findOptionIndex(token);
+				if (optionI < 0) {
+					return this->tryApplyCompoundOption(
+						sink, state, token, argI, result);
+				}
+				return this->tryApplyOption(
+					sink, state, optionI, argI, result);
+			}
+			// selects a command after the positional arguments
+			if (state.nextPos == this->arguments.size()
+				&& !this->commands.empty())
+			{
+				state.command = this->findCommandIndex(token);
+				if (state.command < 0) {
+					result = ParseResult(ParseResult::BAD_VALUE,
+										 "unknown command",
+										 StringView(),
+										 token);
+					result.setArgIndex(argI);
+					return false;
+				}
+				return true;
+			}
+			// processes the next positional argument
+			// aborts if too many arguments are given
+			if (state.nextPos == this->arguments.size()) {
+				result = ParseResult(ParseResult::TOO_MANY_ARGUMENTS,
+									 "too many arguments");
+				result.setArgIndex(argI);
+				return false;
+			}
+			const size_t pos = state.nextPos;
+			// a variadic argument takes all of the remaining values
+			if (!this->arguments[pos]->isVariadic()) {
+				++state.nextPos;
+			}
+			if (!sink.tryApplyArgument(pos, token, result)) {
+				result.setArgIndex(argI);
+				return false;
+			}
+			return true;
 		}
 
 		/**
-		 * Appends an argument which subsitutes a given field.
-		 *
-		 * @tparam T
-		 *     See `OptionParserBase`.
-		 * @tparam SupOpt
-		 *     See `OptionParserBase`.
-		 * @param name
-		 *     Name of the argument.
-		 *     Used to explain what should be specified to the argument.
-		 * @param description
-		 *     Description of the argument.
-		 * @param field
-		 *     Pointer to the field of `SupOpt` to be substituted.
+		 * Applies the option at a given index, or makes it wait for its
+		 * value.
 		 */
-		template < typename T, typename SupOpt >
-		void appendArgument(const String& name,
-							const String& description,
-							T (SupOpt::*field))
+		template < typename Sink >
+		bool tryApplyOption(Sink& sink,
+							ApplyState& state,
+							int optionI,
+							int argI,
+							ParseResult& result) const
 		{
-			this->appendArgument(
-				name, description, field, MetaFormat< T, Ch >());
+			if (this->needsValue(optionI)) {
+				// waits for the value
+				state.pendingOption = optionI;
+				state.pendingIndex = argI;
+			} else if (!sink.tryApply(optionI, result)) {
+				// applies the option without a value
+				result.setArgIndex(argI);
+				return false;
+			}
+			return true;
 		}
 
 		/**
-		 * Appends an argument which substitutes a given field with a value
-		 * formatted by a given formatter.
+		 * Returns whether the option at a given index needs a value.
 		 *
-		 * @tparam T
-		 *     See `OptionParserBase`.
-		 * @tparam SupOpt
-		 *     See `OptionParserBase`.
-		 * @tparam Format
-		 *     See `OptionParserBase`.
-		 * @param name
-		 *     Name of the argument.
-		 *     Used to explain what should be specified to the argument.
-		 * @param description
-		 *     Description of the argument.
-		 * @param field
-		 *     Pointer to the field of `SupOpt` to be substituted.
-		 * @param format
-		 *     Function object which converts a string into a value of the
-		 *     type `T`.
+		 * Read from the slot without calling a virtual function.
 		 */
-		template < typename T, typename SupOpt, typename Format >
-		void appendArgument(const String& name,
-							const String& description,
-							T (SupOpt::*field),
-							const Format& format)
-		{
-			ArgumentPtr pArg(new MemberArgument
-				< T, SupOpt, Format >(name, description, field, format));
-			this->arguments.push_back(pArg);
+		inline bool needsValue(int optionI) const {
+			return this->optionSlots[optionI].valueNeeded;
 		}
 
 		/**
-		 * Appends an argument which calls a given function.
+		 * Applies a token which is not an option label as a whole.
 		 *
-		 * Equivalent to the following call,
+		 * The following forms are accepted,
+		 *  - `--label=value`: `value` is given to the option `--label`.
+		 *    Any label followed by `=` is accepted; e.g., `-o=value`.
+		 *  - `--abbreviation`: a unique prefix of a long label if enabled
+		 *    (see `setAbbreviationsEnabled`); also `--abbreviation=value`.
+		 *  - `-abc`: a cluster of the single character options `-a`, `-b`
+		 *    and `-c`. If an option in a cluster needs a value, the rest of
+		 *    the cluster is the value, or the next token if the option is
+		 *    the last one; e.g., `-vofile` is equivalent to `-v -o file`.
 		 *
-		 *     this->appendArgument(name, description, f, MetaFormat< T, Ch >())
+		 * Labels are looked up as views of `token` or of a buffer on
+		 * the stack, and a value is a view of `token`, so that no string is
+		 * built.
+		 * Options before an unknown option in a cluster have been applied
+		 * when an error is reported.
 		 *
-		 * @tparam T
-		 *     See `OptionParserBase`.
-		 * @tparam SupOpt
-		 *     See `OptionParserBase`.
-		 * @param name
-		 *     Name of the argument.
-		 *     Used to explain what should be specified to the argument.
-		 * @param description
-		 *     Description of the argument.
-		 * @param f
-		 *     Function to be called when the argument is specified.
+		 * @param sink
+		 *     Sink to which the token is applied.
+		 * @param[in,out] state
+		 *     State of parsing.
+		 * @param token
+		 *     Token which starts with a dash but is not a known label.
+		 * @param argI
+		 *     Index of the token.
+		 * @param[out] result
+		 *     Set to the error if the token cannot be applied.
+		 * @return
+		 *     Whether the token has been applied.
 		 */
-		template < typename T, typename SupOpt >
-		void appendArgument(const String& name,
-							const String& description,
-							void (*f)(SupOpt&, const T&))
+		template < typename Sink >
+		bool tryApplyCompoundOption(Sink& sink,
+									ApplyState& state,
+									const StringView& token,
+									int argI,
+									ParseResult& result) const
 		{
-			this->appendArgument(name, description, f, MetaFormat< T, Ch >());
+			// --label=value
+			bool ambiguous = false;
+			const size_t eqPos = token.find(Ch('='));
+			if (eqPos != StringView::npos && eqPos > 1) {
+				const StringView label = token.substr(0, eqPos);
+				int optionI = this->findOptionIndex(label);
+				if (optionI < 0) {
+					optionI = this->findAbbreviatedOption(label, ambiguous);
+				}
+				if (optionI >= 0) {
+					const StringView value = token.substr(eqPos + 1);
+					if (!this->needsValue(optionI)) {
+						result = ParseResult(
+							ParseResult::BAD_VALUE,
+							"option takes no value",
+							this->optionSlots[optionI].label,
+							value);
+						result.setArgIndex(argI);
+						return false;
+					}
+					if (!sink.tryApply(optionI, value, result)) {
+						result.setArgIndex(argI);
+						return false;
+					}
+					return true;
+				}
+			}
+			// --abbreviation
+			if (eqPos == StringView::npos) {
+				const int optionI =
+					this->findAbbreviatedOption(token, ambiguous);
+				if (optionI >= 0) {
+					return this->tryApplyOption(
+						sink, state, optionI, argI, result);
+				}
+			}
+			// -abc
+			if (token.size() > 2 && token[1] != Ch('-')) {
+				Ch label[2] = { Ch('-'), Ch('\0') };
+				size_t i = 1;
+				for (; i < token.size(); ++i) {
+					label[1] = token[i];
+					const int optionI =
+						this->findOptionIndex(StringView(label, 2));
+					if (optionI < 0) {
+						break;
+					}
+					if (!this->needsValue(optionI)) {
+						if (!sink.tryApply(optionI, result)) {
+							result.setArgIndex(argI);
+							return false;
+						}
+						continue;
+					}
+					const StringView value = token.substr(i + 1);
+					if (value.empty()) {
+						// the next token is the value
+						state.pendingOption = optionI;
+						state.pendingIndex = argI;
+						return true;
+					}
+					if (!sink.tryApply(optionI, value, result)) {
+						result.setArgIndex(argI);
+						return false;
+					}
+					return true;
+				}
+				if (i == token.size()) {
+					// all of the options are flags
+					return true;
+				}
+			}
+			// an ambiguous abbreviation followed by a value is reported
+			// without the value, so that the candidates can be found
+			result = ParseResult(ParseResult::UNKNOWN_OPTION,
+								 ambiguous ? "ambiguous option"
+										   : "unknown option",
+								 ambiguous && eqPos != StringView::npos
+									 ? token.substr(0, eqPos) : token);
+			result.setArgIndex(argI);
+			return false;
 		}
 
 		/**
-		 * Appends an argument which calls a given function with a value
-		 * formatted by a given formatter.
+		 * Checks whether a given state of parsing can end.
 		 *
-		 * @tparam T
-		 *     See `OptionParserBase`.
-		 * @tparam SupOpt
-		 *     See `OptionParserBase`.
-		 * @tparam Format
-		 *     See `OptionParserBase`.
-		 * @param name
-		 *     Name of the argument.
-		 *     Used to explain what should be specified to the argument.
-		 * @param description
-		 *     Description of the argument.
-		 * @param f
-		 *     Function to be called when the argument is specified.
-		 * @param format
-		 *     Function object which converts a string into a value of the
-		 *     type `T`.
+		 * @param state
+		 *     State of parsing after the last token.
+		 * @param argc
+		 *     Number of the tokens including the program name if any.
+		 * @return
+		 *     Result of parsing.
 		 */
-		template < typename T, typename SupOpt, typename Format >
-		void appendArgument(const String& name,
-							const String& description,
-							void (*f)(SupOpt&, const T&),
-							const Format& format)
-		{
-			ArgumentPtr pArg(new FunctionArgument
-				< T, SupOpt, Format >(name, description, f, format));
-			this->arguments.push_back(pArg);
+		ParseResult tryFinishTokens(const ApplyState& state, int argc) const {
+			if (state.pendingOption >= 0) {
+				ParseResult result(
+					ParseResult::VALUE_NEEDED,
+					"needs value",
+					this->optionSlots[state.pendingOption].label);
+				result.setArgIndex(state.pendingIndex);
+				return result;
+			}
+			// makes sure that all of the positional arguments were substituted
+			const size_t required = this->hasVariadicArgument()
+				? this->arguments.size() - 1 : this->arguments.size();
+			if (state.nextPos < required) {
+				return tooFewArguments(argc);
+			}
+			// a command must be selected
+			if (!this->commands.empty() && state.command < 0) {
+				return tooFewArguments(argc);
+			}
+			return ParseResult();
 		}
 
 		/**
-		 * Parses given command line arguments.
+		 * Returns the index of the command which has a given name.
 		 *
-		 * @param argc
-		 *     Number of the command line arguments including the program name.
-		 * @param argv
-		 *     Command line arguments. First element must be the program name.
+		 * @param name
+		 *     Name of the command.
 		 * @return
-		 *     Parsed option values.
-		 * @throws TooFewArguments
-		 *     Thrown when too few arguments are given.
-		 * @throws TooManyArguments
-		 *     Thrown when too many arguments are given.
-		 * @throws ValueNeeded
-		 *     Thrown when no value is given to some option which needs a value.
-		 * @throws BadValue
-		 *     Thrown when a bad value is given to some option.
-		 * @throws UnknownOption
-		 *     Thrown when an unknown option is given.
+		 *     Index of the command. -1 if no command has `name`.
 		 */
-		Opt parse(int argc, const Ch* const* argv) {
-			Opt options;
-			// aborts if no arguments are specified
-			if (argc <= 0) {
-				throw TooFewArguments();
-			}
-			// updates the program name
-			this->programName = argv[0];
-			// processes rest of arguments
-			int argI = 1;
-			size_t nextPos = 0;  // index of the next positional argument
-			while (argI < argc) {
-				// checks if `argv[argI]` is an option label
-				if (isLabel(argv[argI])) {
-					// processes an option
-					const Ch* label = argv[argI];
-					OptionPtr pOption = this->findOption(label);
-					if (pOption) {
-						// processes a value if necessary
-						if (pOption->needsValue()) {
-							// applies the option value
-							if (argI + 1 < argc) {
-								++argI;
-								const Ch* value = argv[argI];
-								(*pOption)(options, value);
-							} else {
-								throw ValueNeeded< Ch >(label);
-							}
-						} else {
-							// applies the option without a value
-							(*pOption)(options);
-						}
-					} else {
-						throw UnknownOption< Ch >(label);
-					}
-				} else {
-					// processes the next positional argument
-					// aborts if too many arguments are given
-					if (nextPos == this->arguments.size()) {
-						throw TooManyArguments();
-					}
-					Argument& posArg = *this->arguments[nextPos++];
-					posArg(options, argv[argI]);
+		int findCommandIndex(const StringView& name) const {
+			for (size_t i = 0; i < this->commands.size(); ++i) {
+				if (name == StringView(this->commands[i]->getName())) {
+					return static_cast< int >(i);
 				}
-				++argI;
-			}
-			// makes sure that all of the positional arguments were substituted
-			if (nextPos != this->arguments.size()) {
-				throw TooFewArguments();
 			}
-			return options;
+			return -1;
 		}
 
 		/**
-		 * Returns whehter a given string is an option label.
-		 *
-		 * An option label satisfies all of the following conditions,
-		 *  - Starts with a dash (`-`)
-		 *  - The first dash is not followed by digits (`0-9`) or a dot (`.`)
+		 * Configures a given parser for the command at a given index.
 		 *
-		 * @param label
-		 *     String to be tested.
-		 * @return
-		 *     Whether `label` is an option label.
+		 * The program name of `parser` is the program name of this parser
+		 * followed by the name of the command.
+		 * The observer of `parser` is given by the observer of this parser.
 		 */
-		static bool isLabel(const String& label) {
-			if (label.empty()) {
-				return false;
-			}
-			if (label[0] != Ch('-')) {
-				return false;
-			}
-			if (label.size() == 1) {
-				return true;
+		void configureCommand(OptionParserBase& parser, int commandI) const {
+			const Command& command = *this->commands[commandI];
+			if (!this->programName.empty()) {
+				parser.programName = this->programName;
+				parser.programName += Ch(' ');
 			}
-			const Ch c = label[1];
-			return c != Ch('.') && !(Ch('0') <= c && c <= Ch('9'));
+			parser.programName += command.getName();
+			command.configure(parser);
+			parser.observer = this->observer.observeCommand(commandI, parser);
 		}
-	protected:
+
 		/**
-		 * Adds a given option to this parser.
-		 *
-		 * If an option corresponding to `label` already exists in this parser,
-		 * it will be replaced with `pOption`.
+		 * Applies the rest of the tokens read from a given reader by
+		 * the parser of the command at a given index.
 		 *
-		 * @param label
-		 *     Option label on the command line.
-		 *     Must start with a dash (`-`); e.g., "-o", "--option".
-		 * @param pOption
-		 *     Pointer to the option to be added.
-		 *     Must be allocated by the standard new operator.
-		 * @throws ConfigException
-		 *     If `label` does not start with a dash.
+		 * @param sink
+		 *     Sink to which the current tokens have been applied.
+		 * @param commandI
+		 *     Index of the selected command.
+		 * @param reader
+		 *     Reader of the tokens. The token which selected the command has
+		 *     been read.
+		 * @return
+		 *     Result of parsing.
+		 *     Does not refer to the parser of the command.
 		 */
-		void addOption(const String& label, OptionPtr pOption) {
-			verifyLabel(label);
-			std::pair< OptionMapItr, bool > insertion = this->optionMap.insert(
-				OptionMapValue(label, IndexedOptionPtr(-1, pOption)));
-			if (!insertion.second) {
-				// replaces an existing option
-				int i = insertion.first->second.first;
-				insertion.first->second.second = pOption;
-				this->optionList[i] = pOption;
-			} else {
-				// new otpion
-				insertion.first->second.first =
-					static_cast< int >(this->optionList.size());
-				this->optionList.push_back(pOption);
+		template < typename Reader >
+		ParseResult tryApplyCommand(OptionsSink& sink,
+									int commandI,
+									Reader& reader) const
+		{
+			const Command& command = *this->commands[commandI];
+			command.select(sink.getOptions());
+			OptionParserBase parser(command.getDescription());
+			this->configureCommand(parser, commandI);
+			OptionsSink commandSink(parser, sink.getOptions());
+			ParseResult result = parser.tryApplyTokens(commandSink, reader);
+			// the parser of the command is gone when the result is raised
+			if (result.getKind() == ParseResult::UNKNOWN_OPTION
+				&& !result.hasSuggestions())
+			{
+				std::vector< String > suggestions;
+				parser.suggest(result.getLabel(), suggestions);
+				result.setSuggestions(suggestions);
 			}
+			// the label may be owned by the parser of the command
+			result.pin();
+			return result;
+		}
+
+		/** Commands are not recorded; i.e., fails with `BAD_VALUE`. */
+		template < typename Reader >
+		ParseResult tryApplyCommand(RecordSink&, int commandI, Reader& reader)
+			const
+		{
+			ParseResult result(ParseResult::BAD_VALUE,
+							   "command cannot be parsed lazily",
+							   StringView(),
+							   this->commands[commandI]->getName());
+			result.setArgIndex(reader.getIndex() - 1);
+			result.pin();
+			return result;
 		}
 
 		/**
-		 * Finds the option that has to a given label.
+		 * Returns a `TOO_FEW_ARGUMENTS` result.
 		 *
-		 * @param label
-		 *     Label of the option to be searched.
+		 * @param argIndex
+		 *     Index of the missing argument.
 		 * @return
-		 *     Option that has `label`. 0 if no option has `label`.
+		 *     `TOO_FEW_ARGUMENTS` result.
 		 */
-		OptionPtr findOption(const String& label) {
-			OptionMapItr optionItr = this->optionMap.find(label);
-			return optionItr != this->optionMap.end()
-				? optionItr->second.second : 0;
+		static ParseResult tooFewArguments(int argIndex) {
+			ParseResult result(
+				ParseResult::TOO_FEW_ARGUMENTS, "too few arguments");
+			result.setArgIndex(argIndex);
+			return result;
 		}
 
 		/**
-		 * Checks whether a given option label is valid.
+		 * Throws the exception equivalent to a given result.
 		 *
-		 * `label` is tested by the `OptionParserBase::isLabel` function.
+		 * Gives the suggestions for an unknown option, or the candidates
+		 * for an ambiguous abbreviation, unless the result already has
+		 * the suggestions given by the parser of a command.
+		 *
+		 * @param result
+		 *     Result of parsing. Nothing is thrown if it is `SUCCESS`.
+		 * @throws ParsingException
+		 *     See `ParseResult::raise`.
+		 */
+		void raise(const ParseResult& result) const {
+			if (result.getKind() == ParseResult::UNKNOWN_OPTION
+				&& !result.hasSuggestions())
+			{
+				std::vector< String > suggestions;
+				this->suggest(result.getLabel(), suggestions);
+				OPTPARSE_THROW(UnknownOption< Ch >(
+					result.getLabel().str(), suggestions));
+			}
+			result.raise();
+		}
+
+		/**
+		 * Collects the labels suggested for an unknown option.
+		 *
+		 * The candidates if `label` is an ambiguous abbreviation.
+		 * Otherwise, the similar labels given by `suggestLabels`.
 		 *
 		 * @param label
-		 *     Label to be tested.
-		 * @throws ConfigException
-		 *     If `label` cannot be an option label.
-		 * @see  isLabel
+		 *     Unknown label.
+		 * @param[out] suggestions
+		 *     Appended with the suggested labels.
 		 */
-		static void verifyLabel(const String& label) {
-			if (!isLabel(label)) {
-				throw ConfigException("option label must start with dash (-)");
+		void suggest(const StringView& label,
+					 std::vector< String >& suggestions) const
+		{
+			std::vector< int > candidates;
+			if (this->abbreviations
+				&& this->findOptionsWithPrefix(label, candidates, 3) > 1)
+			{
+				for (size_t i = 0; i < candidates.size(); ++i) {
+					suggestions.push_back(
+						this->optionList[candidates[i]]->getLabel());
+				}
+			} else {
+				this->suggestLabels(label, suggestions);
 			}
 		}
-	private:
 	};
 
 }
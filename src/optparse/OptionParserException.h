@@ -1,7 +1,41 @@
 #ifndef _OPTPARSE_OPTPARSE_OPTION_PARSER_EXCEPTION_H
 #define _OPTPARSE_OPTPARSE_OPTION_PARSER_EXCEPTION_H
 
+#include "optparse/StringView.h"
+
+#include <cstdio>
+#include <cstdlib>
 #include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Whether exceptions are available.
+ *
+ * Detected from the compiler unless defined beforehand.
+ * 0 if exceptions are disabled; e.g., by `-fno-exceptions`.
+ * In that case, every function which would throw an exception prints
+ * the message of the exception and aborts the program instead.
+ * Use `OptionParserBase::tryParseInto` to handle errors gracefully.
+ */
+#ifndef OPTPARSE_EXCEPTIONS
+#	if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#		define OPTPARSE_EXCEPTIONS 1
+#	else
+#		define OPTPARSE_EXCEPTIONS 0
+#	endif
+#endif
+
+/**
+ * Throws a given exception.
+ *
+ * Aborts with the message of the exception if `OPTPARSE_EXCEPTIONS` is 0.
+ */
+#if OPTPARSE_EXCEPTIONS
+#	define OPTPARSE_THROW(ex)  throw ex
+#else
+#	define OPTPARSE_THROW(ex)  ::optparse::abortWith(ex)
+#endif
 
 namespace optparse {
 
@@ -71,6 +105,19 @@ namespace optparse {
 		inline TooManyArguments() : ParsingException("too many arguments") {}
 	};
 
+	/** Exception thrown when a command line string is malformed. */
+	class BadSyntax : public ParsingException {
+	public:
+		/**
+		 * Initializes with a brief explanation.
+		 *
+		 * @param message
+		 *     Brief explanation about the exception.
+		 */
+		inline explicit BadSyntax(const std::string& message)
+			: ParsingException(message) {}
+	};
+
 	/**
 	 * Exception thrown when parsing of an option fails.
 	 *
@@ -177,6 +224,9 @@ namespace optparse {
 	/**
 	 * Exception thrown when an unknown option is specified.
 	 *
+	 * `OptionParserBase` gives the labels similar to the unknown label as
+	 * suggestions (see `OptionParserBase::suggestLabels`).
+	 *
 	 * @tparam Ch
 	 *     See `OptionParsingException`.
 	 */
@@ -185,6 +235,9 @@ namespace optparse {
 	private:
 		/** String of `Ch`. */
 		typedef std::basic_string< Ch > String;
+
+		/** Labels similar to the unknown label. */
+		std::vector< String > suggestions;
 	public:
 		/**
 		 * Initializes with an option label.
@@ -194,6 +247,29 @@ namespace optparse {
 		 */
 		inline explicit UnknownOption(const String& label)
 			: OptionParsingException< Ch >("unknown option", label) {}
+
+		/**
+		 * Initializes with an option label and suggestions.
+		 *
+		 * @param label
+		 *     Label of the unknown option.
+		 * @param suggestions
+		 *     Labels similar to `label` from the most similar.
+		 */
+		inline UnknownOption(const String& label,
+							 const std::vector< String >& suggestions)
+			: OptionParsingException< Ch >("unknown option", label),
+			  suggestions(suggestions) {}
+
+		/**
+		 * Returns the labels similar to the unknown label.
+		 *
+		 * @return
+		 *     Labels from the most similar. Empty if there are none.
+		 */
+		inline const std::vector< String >& getSuggestions() const {
+			return this->suggestions;
+		}
 	};
 
 	/** Exception thrown when a help is needed. */
@@ -203,6 +279,473 @@ namespace optparse {
 		inline HelpNeeded() : ParsingException("help needed") {}
 	};
 
+	/**
+	 * Prints the message of a given exception and aborts the program.
+	 *
+	 * Used instead of `throw` if `OPTPARSE_EXCEPTIONS` is 0.
+	 *
+	 * @param ex
+	 *     Exception which would be thrown.
+	 */
+	[[noreturn]] inline void abortWith(const Exception& ex) {
+		std::fprintf(stderr, "optparse: %s\n", ex.getMessage().c_str());
+		std::abort();
+	}
+
+	/**
+	 * Result of parsing, which describes an error without throwing it.
+	 *
+	 * Each kind of error corresponds to one of the exceptions thrown by
+	 * `OptionParserBase::parse`, and `raise` throws the equivalent
+	 * exception.
+	 *
+	 * The label and value are views of the command line arguments or
+	 * the labels owned by the parser, so a result must not outlive them
+	 * unless `pin` has been called.
+	 *
+	 * @tparam Ch
+	 *     Type which represents an input character.
+	 *     See `OptionParserBase`.
+	 */
+	template < typename Ch >
+	class ParseResult {
+	public:
+		/** Kind of a result. */
+		enum Kind {
+			/** No error. */
+			SUCCESS,
+
+			/** Corresponds to `TooFewArguments`. */
+			TOO_FEW_ARGUMENTS,
+
+			/** Corresponds to `TooManyArguments`. */
+			TOO_MANY_ARGUMENTS,
+
+			/** Corresponds to `ValueNeeded`. */
+			VALUE_NEEDED,
+
+			/** Corresponds to `BadValue`. */
+			BAD_VALUE,
+
+			/** Corresponds to `UnknownOption`. */
+			UNKNOWN_OPTION,
+
+			/** Corresponds to `HelpNeeded`. */
+			HELP_NEEDED,
+
+			/** Corresponds to `BadSyntax`. */
+			BAD_SYNTAX
+		};
+
+		/** View of a string of `Ch`. */
+		typedef optparse::StringView< Ch > StringView;
+	private:
+		/** Kind of this result. */
+		Kind kind;
+
+		/** Index of the command line argument which has an error. */
+		int argIndex;
+
+		/** Brief explanation about the error. 0 if `messageCopy` is used. */
+		const char* message;
+
+		/** Brief explanation about the error not in static storage. */
+		std::string messageCopy;
+
+		/** Label or name of the option which has an error. */
+		StringView label;
+
+		/** Invalid value given to the option. */
+		StringView value;
+
+		/**
+		 * Copy of the label followed by the value.
+		 * Empty unless `pin` has been called.
+		 */
+		std::basic_string< Ch > pinnedText;
+
+		/** Whether `label` and `value` refer to `pinnedText`. */
+		bool pinned;
+
+		/** Labels suggested for an unknown option. */
+		std::vector< std::basic_string< Ch > > suggestions;
+
+		/** Whether `suggestions` has been given. */
+		bool suggested;
+	public:
+		/** Initializes a successful result. */
+		inline ParseResult()
+			: kind(SUCCESS),
+			  argIndex(-1),
+			  message(""),
+			  pinned(false),
+			  suggested(false) {}
+
+		/**
+		 * Copies a given result.
+		 *
+		 * The copy of a pinned result refers to its own copy of the label
+		 * and value.
+		 */
+		inline ParseResult(const ParseResult& other)
+			: kind(other.kind),
+			  argIndex(other.argIndex),
+			  message(other.message),
+			  messageCopy(other.messageCopy),
+			  label(other.label),
+			  value(other.value),
+			  pinnedText(other.pinnedText),
+			  pinned(other.pinned),
+			  suggestions(other.suggestions),
+			  suggested(other.suggested)
+		{
+			this->repoint();
+		}
+
+		/** Copies a given result. See the copy constructor. */
+		ParseResult& operator =(const ParseResult& other) {
+			this->kind = other.kind;
+			this->argIndex = other.argIndex;
+			this->message = other.message;
+			this->messageCopy = other.messageCopy;
+			this->label = other.label;
+			this->value = other.value;
+			this->pinnedText = other.pinnedText;
+			this->pinned = other.pinned;
+			this->suggestions = other.suggestions;
+			this->suggested = other.suggested;
+			this->repoint();
+			return *this;
+		}
+
+		/**
+		 * Moves a given result.
+		 *
+		 * A pinned result hands its copy of the label and value over
+		 * without copying them, and the views are re-pointed to the moved
+		 * copy.
+		 * `other` is left with an empty label and value.
+		 */
+		inline ParseResult(ParseResult&& other)
+			: kind(other.kind),
+			  argIndex(other.argIndex),
+			  message(other.message),
+			  messageCopy(std::move(other.messageCopy)),
+			  label(other.label),
+			  value(other.value),
+			  pinnedText(std::move(other.pinnedText)),
+			  pinned(other.pinned),
+			  suggestions(std::move(other.suggestions)),
+			  suggested(other.suggested)
+		{
+			this->repoint();
+			other.unpin();
+		}
+
+		/** Moves a given result. See the move constructor. */
+		ParseResult& operator =(ParseResult&& other) {
+			if (this != &other) {
+				this->kind = other.kind;
+				this->argIndex = other.argIndex;
+				this->message = other.message;
+				this->messageCopy = std::move(other.messageCopy);
+				this->label = other.label;
+				this->value = other.value;
+				this->pinnedText = std::move(other.pinnedText);
+				this->pinned = other.pinned;
+				this->suggestions = std::move(other.suggestions);
+				this->suggested = other.suggested;
+				this->repoint();
+				other.unpin();
+			}
+			return *this;
+		}
+
+		/**
+		 * Initializes with an error.
+		 *
+		 * @param kind
+		 *     Kind of the error.
+		 * @param message
+		 *     Brief explanation about the error.
+		 *     Must be in static storage; e.g., a string literal.
+		 * @param label
+		 *     Label or name of the option which has the error.
+		 * @param value
+		 *     Invalid value given to the option.
+		 */
+		inline ParseResult(Kind kind,
+						   const char* message,
+						   const StringView& label = StringView(),
+						   const StringView& value = StringView())
+			: kind(kind),
+			  argIndex(-1),
+			  message(message),
+			  label(label),
+			  value(value),
+			  pinned(false),
+			  suggested(false) {}
+
+		/**
+		 * Initializes with an error which has a copied explanation.
+		 *
+		 * @param kind
+		 *     Kind of the error.
+		 * @param message
+		 *     Brief explanation about the error. Copied.
+		 * @param label
+		 *     Label or name of the option which has the error.
+		 * @param value
+		 *     Invalid value given to the option.
+		 */
+		inline ParseResult(Kind kind,
+						   const std::string& message,
+						   const StringView& label = StringView(),
+						   const StringView& value = StringView())
+			: kind(kind),
+			  argIndex(-1),
+			  message(0),
+			  messageCopy(message),
+			  label(label),
+			  value(value),
+			  pinned(false),
+			  suggested(false) {}
+
+		/** Returns whether parsing has succeeded. */
+		inline bool isSuccess() const {
+			return this->kind == SUCCESS;
+		}
+
+		/** Returns the kind of this result. */
+		inline Kind getKind() const {
+			return this->kind;
+		}
+
+		/**
+		 * Returns the index of the command line argument which has an error.
+		 *
+		 * @return
+		 *     Index in `argv` of the offending argument.
+		 *     `argc` if arguments are missing at the end.
+		 *     -1 if parsing has succeeded.
+		 */
+		inline int getArgIndex() const {
+			return this->argIndex;
+		}
+
+		/**
+		 * Sets the index of the command line argument which has an error.
+		 *
+		 * @param argIndex
+		 *     Index in `argv` of the offending argument.
+		 */
+		inline void setArgIndex(int argIndex) {
+			this->argIndex = argIndex;
+		}
+
+		/**
+		 * Returns the brief explanation about the error.
+		 *
+		 * Same as the message of the corresponding exception.
+		 * An empty string if parsing has succeeded.
+		 */
+		inline const char* getMessage() const {
+			return this->message != 0
+				? this->message : this->messageCopy.c_str();
+		}
+
+		/**
+		 * Returns the label or name of the option which has an error.
+		 *
+		 * Empty unless the kind is `VALUE_NEEDED`, `BAD_VALUE` or
+		 * `UNKNOWN_OPTION`.
+		 */
+		inline const StringView& getLabel() const {
+			return this->label;
+		}
+
+		/**
+		 * Returns the invalid value given to the option.
+		 *
+		 * Empty unless the kind is `BAD_VALUE`.
+		 */
+		inline const StringView& getValue() const {
+			return this->value;
+		}
+
+		/**
+		 * Returns the labels suggested for an unknown option.
+		 *
+		 * Empty unless `setSuggestions` has been called.
+		 */
+		inline const std::vector< std::basic_string< Ch > >&
+			getSuggestions() const
+		{
+			return this->suggestions;
+		}
+
+		/**
+		 * Returns whether the suggestions have been given.
+		 *
+		 * The parser of a command gives the suggestions for an unknown
+		 * option before it is released, even if no label is similar.
+		 */
+		inline bool hasSuggestions() const {
+			return this->suggested;
+		}
+
+		/**
+		 * Sets the labels suggested for an unknown option.
+		 *
+		 * @param suggestions
+		 *     Labels to be suggested. May be empty.
+		 */
+		void setSuggestions(
+			const std::vector< std::basic_string< Ch > >& suggestions)
+		{
+			this->suggestions = suggestions;
+			this->suggested = true;
+		}
+
+		/**
+		 * Copies the label and value into this result.
+		 *
+		 * Called before the command line arguments which the label and value
+		 * refer to are released.
+		 * Does nothing if this result has already been pinned.
+		 */
+		void pin() {
+			if (this->pinned) {
+				return;
+			}
+			this->pinnedText.reserve(this->label.size() + this->value.size());
+			this->pinnedText.assign(this->label.begin(), this->label.end());
+			this->pinnedText.append(this->value.begin(), this->value.end());
+			this->pinned = true;
+			this->repoint();
+		}
+
+		/**
+		 * Throws the exception equivalent to this result.
+		 *
+		 * Does nothing if parsing has succeeded.
+		 * Aborts instead if `OPTPARSE_EXCEPTIONS` is 0.
+		 *
+		 * @throws TooFewArguments
+		 *     If the kind is `TOO_FEW_ARGUMENTS`.
+		 * @throws TooManyArguments
+		 *     If the kind is `TOO_MANY_ARGUMENTS`.
+		 * @throws ValueNeeded< Ch >
+		 *     If the kind is `VALUE_NEEDED`.
+		 * @throws BadValue< Ch >
+		 *     If the kind is `BAD_VALUE`.
+		 * @throws UnknownOption< Ch >
+		 *     If the kind is `UNKNOWN_OPTION`.
+		 * @throws HelpNeeded
+		 *     If the kind is `HELP_NEEDED`.
+		 * @throws BadSyntax
+		 *     If the kind is `BAD_SYNTAX`.
+		 */
+		void raise() const {
+			switch (this->kind) {
+			case SUCCESS:
+				break;
+			case TOO_FEW_ARGUMENTS:
+				OPTPARSE_THROW(TooFewArguments());
+			case TOO_MANY_ARGUMENTS:
+				OPTPARSE_THROW(TooManyArguments());
+			case VALUE_NEEDED:
+				OPTPARSE_THROW(ValueNeeded< Ch >(this->label.str()));
+			case BAD_VALUE:
+				OPTPARSE_THROW(BadValue< Ch >(
+					this->getMessage(), this->label.str(), this->value.str()));
+			case UNKNOWN_OPTION:
+				OPTPARSE_THROW(UnknownOption< Ch >(
+					this->label.str(), this->suggestions));
+			case HELP_NEEDED:
+				OPTPARSE_THROW(HelpNeeded());
+			case BAD_SYNTAX:
+				OPTPARSE_THROW(BadSyntax(this->getMessage()));
+			}
+		}
+	private:
+		/**
+		 * Empties the label and value of a result whose copy has been
+		 * moved away.
+		 */
+		void unpin() {
+			if (this->pinned) {
+				this->label = StringView();
+				this->value = StringView();
+				this->pinnedText.clear();
+				this->pinned = false;
+			}
+		}
+
+		/** Makes `label` and `value` refer to `pinnedText` if pinned. */
+		void repoint() {
+			if (this->pinned) {
+				const size_t labelSize = this->label.size();
+				this->label = StringView(this->pinnedText.data(), labelSize);
+				this->value = StringView(
+					this->pinnedText.data() + labelSize, this->value.size());
+			}
+		}
+	};
+
+	/**
+	 * Calls a given function and translates a parsing exception thrown by
+	 * it into a result.
+	 *
+	 * Only calls `f` if `OPTPARSE_EXCEPTIONS` is 0.
+	 *
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 * @tparam F
+	 *     Type of the function. Takes no parameter.
+	 * @param f
+	 *     Function to be called.
+	 * @param label
+	 *     Label or name of the option which calls `f`.
+	 * @param value
+	 *     Value given to the option.
+	 * @param[out] result
+	 *     Set to the translated error if `f` throws `BadValue`,
+	 *     `ValueNeeded` or `HelpNeeded`.
+	 * @return
+	 *     Whether `f` has returned without a parsing exception.
+	 */
+	template < typename Ch, typename F >
+	bool catchParsingError(F f,
+						   const typename ParseResult< Ch >::StringView& label,
+						   const typename ParseResult< Ch >::StringView& value,
+						   ParseResult< Ch >& result)
+	{
+#if OPTPARSE_EXCEPTIONS
+		try {
+			f();
+		} catch (BadValue< Ch >& ex) {
+			result = ParseResult< Ch >(
+				ParseResult< Ch >::BAD_VALUE, ex.getMessage(), label, value);
+			return false;
+		} catch (ValueNeeded< Ch >& ex) {
+			result = ParseResult< Ch >(
+				ParseResult< Ch >::VALUE_NEEDED, ex.getMessage(), label);
+			return false;
+		} catch (HelpNeeded& ex) {
+			result = ParseResult< Ch >(
+				ParseResult< Ch >::HELP_NEEDED, ex.getMessage());
+			return false;
+		}
+#else
+		(void)label;
+		(void)value;
+		(void)result;
+		f();
+#endif
+		return true;
+	}
+
 }
 
 #endif
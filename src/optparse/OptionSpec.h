@@ -90,6 +90,49 @@ namespace optparse {
 		 *     Name of the value which this argument takes.
 		 */
 		virtual const String& getValueName() const = 0;
+
+		/**
+		 * Returns whether this argument takes all of the remaining
+		 * positional values.
+		 *
+		 * @return
+		 *     Whether this argument is variadic. `false` by default.
+		 */
+		virtual bool isVariadic() const {
+			return false;
+		}
+	};
+
+	/**
+	 * Specification of a sub-command.
+	 *
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename Ch >
+	class CommandSpec {
+	public:
+		/** String of `Ch`. */
+		typedef std::basic_string< Ch > String;
+	public:
+		/** Releases resources. */
+		virtual ~CommandSpec() {}
+
+		/**
+		 * Returns the name of this command.
+		 *
+		 * @return
+		 *     Name of this command on the command line.
+		 */
+		virtual const String& getName() const = 0;
+
+		/**
+		 * Returns the description of this command.
+		 *
+		 * @return
+		 *     Description of this command.
+		 */
+		virtual const String& getDescription() const = 0;
 	};
 
 }
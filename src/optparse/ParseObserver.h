@@ -0,0 +1,394 @@
+#ifndef _OPTPARSE_OPTPARSE_PARSE_OBSERVER_H
+#define _OPTPARSE_OPTPARSE_PARSE_OBSERVER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+namespace optparse {
+
+	/**
+	 * Observer which observes nothing.
+	 *
+	 * The default observer of `OptionParserBase`.
+	 * An observer is a copyable type which supports the following calls,
+	 * all of which must be safe to be called concurrently,
+	 *  - `Timer startParse() const`: called before the tokens of a parser
+	 *    are applied. `Timer` is any copyable type.
+	 *  - `void finishParse(const Timer& timer, const ParseResult& result)
+	 *    const`: called after the tokens are applied with the `Timer`
+	 *    returned by `startParse`.
+	 *  - `void observeOption(int optionI, bool accepted) const`: called
+	 *    whenever the option at `optionI` is applied. `accepted` is `false`
+	 *    if its value is rejected by the formatter or function.
+	 *  - `void observeArgument(size_t pos, bool accepted) const`: called
+	 *    whenever a value is applied to the argument at `pos`.
+	 *  - `Observer observeCommand(int commandI, const Parser& parser)
+	 *    const`: returns the observer of the parser of the command at
+	 *    `commandI`, which has been configured.
+	 *
+	 * Every function of this observer is empty and inlined, so that
+	 * observing costs nothing.
+	 */
+	class NullObserver {
+	public:
+		/** Timer which measures nothing. */
+		struct Timer {};
+
+		/** Does nothing. */
+		inline Timer startParse() const {
+			return Timer();
+		}
+
+		/** Does nothing. */
+		template < typename Result >
+		inline void finishParse(const Timer&, const Result&) const {}
+
+		/** Does nothing. */
+		inline void observeOption(int, bool) const {}
+
+		/** Does nothing. */
+		inline void observeArgument(size_t, bool) const {}
+
+		/** Returns this observer. */
+		template < typename Parser >
+		inline NullObserver observeCommand(int, const Parser&) const {
+			return *this;
+		}
+	};
+
+	/**
+	 * Statistics of parsing by a parser and the parsers of its commands,
+	 * recorded by `StatisticsObserver`.
+	 *
+	 * Counters are atomic and updated with relaxed ordering, so that
+	 * concurrent parsing is never blocked.
+	 * The statistics of a command are allocated when the command is
+	 * selected for the first time.
+	 * Options and arguments added after the statistics are made are not
+	 * counted.
+	 */
+	class ParseStatistics {
+	public:
+		/** Number of the buckets of durations. */
+		static const size_t BUCKET_COUNT = 40;
+	private:
+		/** Counter. */
+		typedef std::atomic< unsigned long long > Counter;
+
+		/** Number of the options. */
+		size_t optionCount;
+
+		/** Number of the arguments. */
+		size_t argumentCount;
+
+		/** Number of the commands. */
+		size_t commandCount;
+
+		/**
+		 * Hits of the options followed by rejections of the options, hits
+		 * of the arguments and rejections of the arguments.
+		 */
+		std::unique_ptr< Counter[] > counters;
+
+		/** Buckets of durations. See `getDurationCount`. */
+		Counter buckets[BUCKET_COUNT];
+
+		/** Statistics of the commands. Null until selected. */
+		std::unique_ptr< std::atomic< ParseStatistics* >[] > commands;
+	public:
+		/**
+		 * Initializes with the numbers of the options, arguments and
+		 * commands of a parser.
+		 *
+		 * @param optionCount
+		 *     Number of the options.
+		 * @param argumentCount
+		 *     Number of the arguments.
+		 * @param commandCount
+		 *     Number of the commands.
+		 */
+		ParseStatistics(size_t optionCount,
+						size_t argumentCount,
+						size_t commandCount)
+			: optionCount(optionCount),
+			  argumentCount(argumentCount),
+			  commandCount(commandCount),
+			  counters(new Counter[2 * (optionCount + argumentCount)]),
+			  commands(new std::atomic< ParseStatistics* >[commandCount])
+		{
+			for (size_t i = 0; i < 2 * (optionCount + argumentCount); ++i) {
+				this->counters[i].store(0, std::memory_order_relaxed);
+			}
+			for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+				this->buckets[i].store(0, std::memory_order_relaxed);
+			}
+			for (size_t i = 0; i < commandCount; ++i) {
+				this->commands[i].store(0, std::memory_order_relaxed);
+			}
+		}
+
+		/**
+		 * Initializes for a given parser.
+		 *
+		 * @tparam Parser
+		 *     Type of the parser. `OptionParserBase`.
+		 * @param parser
+		 *     Parser of which the configuration has completed.
+		 */
+		template < typename Parser >
+		explicit ParseStatistics(const Parser& parser)
+			: ParseStatistics(parser.getOptionCount(),
+							  parser.getArgumentCount(),
+							  parser.getCommandCount()) {}
+
+		/** Releases the statistics of the commands. */
+		~ParseStatistics() {
+			for (size_t i = 0; i < this->commandCount; ++i) {
+				delete this->commands[i].load(std::memory_order_relaxed);
+			}
+		}
+
+		/** Returns the number of the options. */
+		inline size_t getOptionCount() const {
+			return this->optionCount;
+		}
+
+		/** Returns the number of the arguments. */
+		inline size_t getArgumentCount() const {
+			return this->argumentCount;
+		}
+
+		/** Returns the number of the commands. */
+		inline size_t getCommandCount() const {
+			return this->commandCount;
+		}
+
+		/**
+		 * Returns how many times the option at a given index has been
+		 * applied, including rejected values.
+		 */
+		inline unsigned long long getOptionHits(size_t i) const {
+			return this->counters[i].load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * Returns how many values of the option at a given index have been
+		 * rejected by its formatter or function.
+		 */
+		inline unsigned long long getOptionRejections(size_t i) const {
+			return this->counters[this->optionCount + i].load(
+				std::memory_order_relaxed);
+		}
+
+		/**
+		 * Returns how many values have been applied to the argument at
+		 * a given position.
+		 */
+		inline unsigned long long getArgumentHits(size_t pos) const {
+			return this->counters[2 * this->optionCount + pos].load(
+				std::memory_order_relaxed);
+		}
+
+		/**
+		 * Returns how many values of the argument at a given position have
+		 * been rejected.
+		 */
+		inline unsigned long long getArgumentRejections(size_t pos) const {
+			return this->counters[
+				2 * this->optionCount + this->argumentCount + pos].load(
+					std::memory_order_relaxed);
+		}
+
+		/**
+		 * Returns how many parses have taken a duration in a given bucket.
+		 *
+		 * The bucket `i` has the durations in [`2^i`, `2^(i+1)`)
+		 * nanoseconds, except that the bucket 0 also has 0 nanoseconds,
+		 * and the last bucket has every longer duration.
+		 */
+		inline unsigned long long getDurationCount(size_t i) const {
+			return this->buckets[i].load(std::memory_order_relaxed);
+		}
+
+		/** Returns the number of the parses. */
+		unsigned long long getParseCount() const {
+			unsigned long long count = 0;
+			for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+				count += this->getDurationCount(i);
+			}
+			return count;
+		}
+
+		/**
+		 * Returns the statistics of the command at a given index.
+		 *
+		 * @return
+		 *     Statistics of the command.
+		 *     0 if the command has never been selected.
+		 */
+		inline const ParseStatistics* getCommand(size_t i) const {
+			return this->commands[i].load(std::memory_order_acquire);
+		}
+
+		/** Counts the option at a given index. */
+		inline void recordOption(size_t i, bool accepted) {
+			if (i < this->optionCount) {
+				increment(this->counters[i]);
+				if (!accepted) {
+					increment(this->counters[this->optionCount + i]);
+				}
+			}
+		}
+
+		/** Counts the argument at a given position. */
+		inline void recordArgument(size_t pos, bool accepted) {
+			if (pos < this->argumentCount) {
+				const size_t first = 2 * this->optionCount;
+				increment(this->counters[first + pos]);
+				if (!accepted) {
+					increment(
+						this->counters[first + this->argumentCount + pos]);
+				}
+			}
+		}
+
+		/** Counts a given duration of parsing in nanoseconds. */
+		inline void recordDuration(unsigned long long nanoseconds) {
+			size_t i = 0;
+			while (i + 1 < BUCKET_COUNT && (nanoseconds >> (i + 1)) != 0) {
+				++i;
+			}
+			increment(this->buckets[i]);
+		}
+
+		/**
+		 * Returns the statistics of the command at a given index,
+		 * allocating them for a given parser if the command has never been
+		 * selected.
+		 *
+		 * Lock-free; if threads select the command at the same time, only
+		 * one of the allocated statistics survives.
+		 *
+		 * @return
+		 *     Statistics of the command.
+		 *     0 if this parser has no command at `i`.
+		 */
+		template < typename Parser >
+		ParseStatistics* getOrMakeCommand(size_t i, const Parser& parser) {
+			if (i >= this->commandCount) {
+				return 0;
+			}
+			ParseStatistics* pCommand =
+				this->commands[i].load(std::memory_order_acquire);
+			if (pCommand != 0) {
+				return pCommand;
+			}
+			std::unique_ptr< ParseStatistics > pNew(
+				new ParseStatistics(parser));
+			if (this->commands[i].compare_exchange_strong(
+					pCommand, pNew.get(), std::memory_order_acq_rel))
+			{
+				return pNew.release();
+			}
+			// another thread has made the statistics
+			return pCommand;
+		}
+	private:
+		/** Increments a given counter. */
+		static inline void increment(Counter& counter) {
+			counter.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		/** Copy is not allowed. */
+		ParseStatistics(const ParseStatistics&) = delete;
+
+		/** Assignment is not allowed. */
+		void operator =(const ParseStatistics&) = delete;
+	};
+
+	/**
+	 * Observer which records statistics of parsing into
+	 * `ParseStatistics`.
+	 *
+	 * The duration of parsing is measured with `std::chrono::steady_clock`;
+	 * the duration of a parser with commands includes the duration of
+	 * the parser of the selected command.
+	 * An observer made by the default constructor records nothing.
+	 */
+	class StatisticsObserver {
+	public:
+		/** Start time of parsing. */
+		typedef std::chrono::steady_clock::time_point Timer;
+	private:
+		/** Statistics to which parsing is recorded. */
+		ParseStatistics* pStatistics;
+	public:
+		/** Initializes an observer which records nothing. */
+		inline StatisticsObserver() : pStatistics(0) {}
+
+		/**
+		 * Initializes with statistics.
+		 *
+		 * @param statistics
+		 *     Statistics to which parsing is recorded.
+		 *     Must outlive this observer and its copies.
+		 */
+		inline explicit StatisticsObserver(ParseStatistics& statistics)
+			: pStatistics(&statistics) {}
+
+		/** Returns the statistics. 0 if nothing is recorded. */
+		inline ParseStatistics* getStatistics() const {
+			return this->pStatistics;
+		}
+
+		/** Returns the current time if statistics are recorded. */
+		inline Timer startParse() const {
+			return this->pStatistics != 0
+				? std::chrono::steady_clock::now() : Timer();
+		}
+
+		/** Records the duration since a given time. */
+		template < typename Result >
+		void finishParse(const Timer& start, const Result&) const {
+			if (this->pStatistics != 0) {
+				const std::chrono::nanoseconds duration =
+					std::chrono::steady_clock::now() - start;
+				this->pStatistics->recordDuration(
+					static_cast< unsigned long long >(duration.count()));
+			}
+		}
+
+		/** Counts the option at a given index. */
+		inline void observeOption(int optionI, bool accepted) const {
+			if (this->pStatistics != 0) {
+				this->pStatistics->recordOption(
+					static_cast< size_t >(optionI), accepted);
+			}
+		}
+
+		/** Counts the argument at a given position. */
+		inline void observeArgument(size_t pos, bool accepted) const {
+			if (this->pStatistics != 0) {
+				this->pStatistics->recordArgument(pos, accepted);
+			}
+		}
+
+		/** Returns the observer which records into the command. */
+		template < typename Parser >
+		StatisticsObserver observeCommand(int commandI,
+										  const Parser& parser) const
+		{
+			StatisticsObserver observer;
+			if (this->pStatistics != 0) {
+				observer.pStatistics = this->pStatistics->getOrMakeCommand(
+					static_cast< size_t >(commandI), parser);
+			}
+			return observer;
+		}
+	};
+
+}
+
+#endif
@@ -0,0 +1,883 @@
+#ifndef _OPTPARSE_OPTPARSE_PARSER_SNAPSHOT_H
+#define _OPTPARSE_OPTPARSE_PARSER_SNAPSHOT_H
+
+#include "optparse/FormatInvoker.h"
+#include "optparse/LabelTable.h"
+#include "optparse/OptionParserBase.h"
+#include "optparse/OptionParserException.h"
+#include "optparse/OptionSpec.h"
+#include "optparse/StringView.h"
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace optparse {
+
+	/** Position of a string in the pool of a `ParserSnapshot`. */
+	struct SnapshotString {
+		/** Offset of the first character in the pool. */
+		size_t offset;
+
+		/** Number of the characters. */
+		size_t size;
+	};
+
+	/** Option in a `ParserSnapshot`. */
+	struct SnapshotOption {
+		/** Label of the option. */
+		SnapshotString label;
+
+		/** Name of the value. Empty if the option takes no value. */
+		SnapshotString valueName;
+
+		/** Description of the option. */
+		SnapshotString description;
+
+		/** Whether the option takes a value. */
+		bool takesValue;
+	};
+
+	/** Positional argument in a `ParserSnapshot`. */
+	struct SnapshotArgument {
+		/** Name of the argument. */
+		SnapshotString name;
+
+		/** Description of the argument. */
+		SnapshotString description;
+
+		/** Whether the argument takes all of the remaining values. */
+		bool variadic;
+	};
+
+	/**
+	 * Static data of a configured parser; i.e., the labels, value names,
+	 * descriptions and lookup index of the options and arguments.
+	 *
+	 * A snapshot is an aggregate of pointers to constant arrays, so
+	 * the source written by `ParserSnapshotBuilder::write` is constant
+	 * initialized and placed in the read-only data of a binary, which is
+	 * shared between processes.
+	 * `SnapshotOptionParser` parses with a snapshot after the fields and
+	 * functions are bound, without copying any strings or building
+	 * any tables at run time.
+	 *
+	 * The lookup index is the open addressing table of `LabelTable`,
+	 * which stores the index of an option in each slot.
+	 *
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename Ch >
+	struct ParserSnapshot {
+		/** Non-owning view of a string of `Ch`. */
+		typedef optparse::StringView< Ch > StringView;
+
+		/** Characters of all of the strings. */
+		const Ch* pool;
+
+		/** Description of the program. */
+		SnapshotString description;
+
+		/** Options. */
+		const SnapshotOption* options;
+
+		/** Number of the options. */
+		size_t optionCount;
+
+		/** Positional arguments. */
+		const SnapshotArgument* arguments;
+
+		/** Number of the positional arguments. */
+		size_t argumentCount;
+
+		/** Index of the option in each slot. -1 if a slot is empty. */
+		const int* slots;
+
+		/** Number of the slots. A power of two or zero. */
+		size_t slotCount;
+
+		/** Seed of `LabelTable::hash`. */
+		size_t seed;
+
+		/** Returns a given string in the pool. */
+		inline StringView getString(const SnapshotString& str) const {
+			return StringView(this->pool + str.offset, str.size);
+		}
+
+		/**
+		 * Finds the option which has a given label.
+		 *
+		 * Never allocates memory.
+		 *
+		 * @param label
+		 *     Label to be searched.
+		 * @return
+		 *     Index of the option which has `label`.
+		 *     -1 if no option has `label`.
+		 */
+		int find(const StringView& label) const {
+			if (this->slotCount == 0) {
+				return -1;
+			}
+			const size_t mask = this->slotCount - 1;
+			for (size_t j = LabelTable< Ch >::hash(label, this->seed) & mask;
+				 ;
+				 j = (j + 1) & mask)
+			{
+				const int optionI = this->slots[j];
+				if (optionI < 0) {
+					return -1;
+				}
+				if (this->getString(this->options[optionI].label) == label) {
+					return optionI;
+				}
+			}
+		}
+	};
+
+	/**
+	 * Takes a `ParserSnapshot` of a configured parser.
+	 *
+	 * The snapshot is usually written into a source file by `write` at
+	 * build time, and the source file is compiled into the program; e.g.,
+	 *
+	 *     optparse::ParserSnapshotBuilder< char > builder(parser);
+	 *     std::ofstream out("ParserSnapshot.cpp");
+	 *     builder.write(out, "PARSER_SNAPSHOT");
+	 *
+	 * Identical strings share the same characters in the pool.
+	 *
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename Ch >
+	class ParserSnapshotBuilder {
+	public:
+		/** String of `Ch`. */
+		typedef std::basic_string< Ch > String;
+
+		/** Non-owning view of a string of `Ch`. */
+		typedef optparse::StringView< Ch > StringView;
+	private:
+		/** Number of the characters of the pool written in a line. */
+		static const size_t POOL_LINE_SIZE = 60;
+
+		/** Number of the slots written in a line. */
+		static const size_t SLOT_LINE_SIZE = 16;
+
+		/** Characters of all of the strings. */
+		String pool;
+
+		/** Description of the program. */
+		SnapshotString description;
+
+		/** Options. */
+		std::vector< SnapshotOption > options;
+
+		/** Positional arguments. */
+		std::vector< SnapshotArgument > arguments;
+
+		/** Slots of the lookup index. */
+		std::vector< int > slots;
+
+		/** Seed of the lookup index. */
+		size_t seed;
+	public:
+		/**
+		 * Takes a snapshot of a given parser.
+		 *
+		 * @tparam Parser
+		 *     Type of the parser; e.g., `OptionParserBase` or
+		 *     `StaticOptionParser`.
+		 * @param parser
+		 *     Parser of which the snapshot is to be taken.
+		 *     Not referenced after this call.
+		 */
+		template < typename Parser >
+		explicit ParserSnapshotBuilder(const Parser& parser) : seed(0) {
+			this->description = this->intern(parser.getDescription());
+			std::vector< typename LabelTable< Ch >::Entry > entries;
+			entries.reserve(parser.getOptionCount());
+			this->options.reserve(parser.getOptionCount());
+			for (size_t i = 0; i < parser.getOptionCount(); ++i) {
+				const OptionSpec< Ch >& option = parser.getOption(i);
+				const SnapshotOption entry = {
+					this->intern(option.getLabel()),
+					this->intern(option.getValueName()),
+					this->intern(option.getDescription()),
+					option.needsValue()
+				};
+				this->options.push_back(entry);
+				entries.push_back(typename LabelTable< Ch >::Entry(
+					StringView(option.getLabel()), static_cast< int >(i)));
+			}
+			this->arguments.reserve(parser.getArgumentCount());
+			for (size_t i = 0; i < parser.getArgumentCount(); ++i) {
+				const ArgumentSpec< Ch >& argument = parser.getArgument(i);
+				const SnapshotArgument entry = {
+					this->intern(argument.getValueName()),
+					this->intern(argument.getDescription()),
+					argument.isVariadic()
+				};
+				this->arguments.push_back(entry);
+			}
+			// reproduces the slots of a label table
+			LabelTable< Ch > table;
+			table.build(entries);
+			this->seed = table.getSeed();
+			this->slots.reserve(table.getSlotCount());
+			for (size_t j = 0; j < table.getSlotCount(); ++j) {
+				this->slots.push_back(table.getSlotValue(j));
+			}
+		}
+
+		/**
+		 * Returns the snapshot.
+		 *
+		 * @return
+		 *     Snapshot which refers to this builder.
+		 *     Valid as long as this builder lives.
+		 */
+		ParserSnapshot< Ch > getSnapshot() const {
+			const ParserSnapshot< Ch > snapshot = {
+				this->pool.c_str(),
+				this->description,
+				this->options.empty() ? 0 : &this->options[0],
+				this->options.size(),
+				this->arguments.empty() ? 0 : &this->arguments[0],
+				this->arguments.size(),
+				this->slots.empty() ? 0 : &this->slots[0],
+				this->slots.size(),
+				this->seed
+			};
+			return snapshot;
+		}
+
+		/**
+		 * Writes the snapshot as a C++ source.
+		 *
+		 * The source defines a constant `ParserSnapshot` of a given name,
+		 * which has external linkage, and the arrays it refers to.
+		 * The lookup index depends on the hash function of `LabelTable`,
+		 * so the source must be written again when the version of
+		 * `optparse` changes.
+		 *
+		 * @param out
+		 *     Stream into which the source is written.
+		 * @param name
+		 *     Name of the snapshot in the source.
+		 *     The arrays are named with suffixes; e.g., `name_POOL`.
+		 */
+		void write(std::ostream& out, const std::string& name) const {
+			const char* type = charType(Ch());
+			out << "// Generated by optparse::ParserSnapshotBuilder."
+				<< " Do not edit.\n"
+				<< "#include \"optparse/ParserSnapshot.h\"\n\n"
+				<< "extern const optparse::ParserSnapshot< " << type << " > "
+				<< name << ";\n\n"
+				<< "static const " << type << ' ' << name << "_POOL[] =";
+			this->writePool(out);
+			out << ";\n\n";
+			if (this->options.empty()) {
+				out << "static const optparse::SnapshotOption* const "
+					<< name << "_OPTIONS = 0;\n\n";
+			} else {
+				out << "static const optparse::SnapshotOption "
+					<< name << "_OPTIONS[] = {\n";
+				for (size_t i = 0; i < this->options.size(); ++i) {
+					const SnapshotOption& option = this->options[i];
+					out << "\t{ ";
+					writeString(out, option.label);
+					out << ", ";
+					writeString(out, option.valueName);
+					out << ", ";
+					writeString(out, option.description);
+					out << ", " << (option.takesValue ? "true" : "false")
+						<< " },\n";
+				}
+				out << "};\n\n";
+			}
+			if (this->arguments.empty()) {
+				out << "static const optparse::SnapshotArgument* const "
+					<< name << "_ARGUMENTS = 0;\n\n";
+			} else {
+				out << "static const optparse::SnapshotArgument "
+					<< name << "_ARGUMENTS[] = {\n";
+				for (size_t i = 0; i < this->arguments.size(); ++i) {
+					const SnapshotArgument& argument = this->arguments[i];
+					out << "\t{ ";
+					writeString(out, argument.name);
+					out << ", ";
+					writeString(out, argument.description);
+					out << ", " << (argument.variadic ? "true" : "false")
+						<< " },\n";
+				}
+				out << "};\n\n";
+			}
+			if (this->slots.empty()) {
+				out << "static const int* const " << name << "_SLOTS = 0;\n\n";
+			} else {
+				out << "static const int " << name << "_SLOTS[] = {";
+				for (size_t j = 0; j < this->slots.size(); ++j) {
+					out << (j % SLOT_LINE_SIZE == 0 ? "\n\t" : " ")
+						<< this->slots[j] << ',';
+				}
+				out << "\n};\n\n";
+			}
+			out << "const optparse::ParserSnapshot< " << type << " > "
+				<< name << " = {\n"
+				<< '\t' << name << "_POOL,\n"
+				<< '\t';
+			writeString(out, this->description);
+			out << ",\n"
+				<< '\t' << name << "_OPTIONS, " << this->options.size()
+				<< ",\n"
+				<< '\t' << name << "_ARGUMENTS, " << this->arguments.size()
+				<< ",\n"
+				<< '\t' << name << "_SLOTS, " << this->slots.size() << ",\n"
+				<< '\t' << this->seed << '\n'
+				<< "};\n";
+		}
+	private:
+		/**
+		 * Adds a given string to the pool.
+		 *
+		 * Reuses the characters of an identical string in the pool.
+		 */
+		SnapshotString intern(const String& str) {
+			size_t offset = str.empty() ? 0 : this->pool.find(str);
+			if (offset == String::npos) {
+				offset = this->pool.size();
+				this->pool += str;
+			}
+			const SnapshotString position = { offset, str.size() };
+			return position;
+		}
+
+		/** Writes the pool as a string literal. */
+		void writePool(std::ostream& out) const {
+			const char* prefix = literalPrefix(Ch());
+			if (this->pool.empty()) {
+				out << ' ' << prefix << "\"\"";
+				return;
+			}
+			for (size_t i = 0; i < this->pool.size(); ++i) {
+				if (i % POOL_LINE_SIZE == 0) {
+					out << (i == 0 ? "\n\t" : "\"\n\t") << prefix << '"';
+				}
+				const Ch c = this->pool[i];
+				switch (c) {
+				case Ch('\\'):
+					out << "\\\\";
+					break;
+				case Ch('"'):
+					out << "\\\"";
+					break;
+				case Ch('?'):
+					// avoids trigraphs
+					out << "\\?";
+					break;
+				case Ch('\n'):
+					out << "\\n";
+					break;
+				case Ch('\t'):
+					out << "\\t";
+					break;
+				default:
+					if (c >= Ch(' ') && c < Ch('\x7F')) {
+						out << static_cast< char >(c);
+					} else {
+						// ends the literal so that a following hex digit is
+						// not a part of the escape sequence
+						out << "\\x" << std::hex
+							<< static_cast< unsigned long >(
+								static_cast<
+									typename std::make_unsigned< Ch >::type >(
+										c))
+							<< std::dec
+							<< "\" " << prefix << '"';
+					}
+					break;
+				}
+			}
+			out << '"';
+		}
+
+		/** Writes a given position of a string as an initializer. */
+		static void writeString(std::ostream& out, const SnapshotString& str) {
+			out << "{ " << str.offset << ", " << str.size << " }";
+		}
+
+		/** Returns the name of `char`. */
+		static inline const char* charType(char) {
+			return "char";
+		}
+
+		/** Returns the name of `wchar_t`. */
+		static inline const char* charType(wchar_t) {
+			return "wchar_t";
+		}
+
+		/** Returns the prefix of a literal of `char`. */
+		static inline const char* literalPrefix(char) {
+			return "";
+		}
+
+		/** Returns the prefix of a literal of `wchar_t`. */
+		static inline const char* literalPrefix(wchar_t) {
+			return "L";
+		}
+	};
+
+	template < typename Ch >
+	const size_t ParserSnapshotBuilder< Ch >::POOL_LINE_SIZE;
+
+	template < typename Ch >
+	const size_t ParserSnapshotBuilder< Ch >::SLOT_LINE_SIZE;
+
+	/**
+	 * Parser for command line options defined by a `ParserSnapshot`.
+	 *
+	 * Behaves in the same way as `StaticOptionParser` with the same options
+	 * and arguments; i.e., `--label=value`, clusters of single character
+	 * options and response files are not supported.
+	 *
+	 * Only the fields and functions of options and arguments are bound at
+	 * run time; the labels, descriptions and lookup index stay in
+	 * the snapshot.
+	 * The bindings are stored in two arrays allocated by the constructor,
+	 * and each binding holds a member or function pointer by value.
+	 * An option which is not bound is accepted and ignored, so that
+	 * a snapshot may be shared by programs which use a part of it.
+	 *
+	 * Parsing never modifies a parser, so concurrent calls are safe.
+	 *
+	 * @tparam Opt
+	 *     See `OptionParserBase`.
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 * @tparam MetaFormat
+	 *     See `OptionParserBase`.
+	 */
+	template < typename Opt,
+			   typename Ch,
+			   template < typename, typename > class MetaFormat >
+	class SnapshotOptionParser {
+	public:
+		/** String of `Ch`. */
+		typedef std::basic_string< Ch > String;
+
+		/** Non-owning view of a string of `Ch`. */
+		typedef optparse::StringView< Ch > StringView;
+
+		/** Result of parsing. */
+		typedef optparse::ParseResult< Ch > ParseResult;
+
+		/** Snapshot of a parser. */
+		typedef optparse::ParserSnapshot< Ch > Snapshot;
+	private:
+		/** Field or function bound to an option or argument. */
+		struct Binding;
+
+		/** Function which applies a binding. */
+		typedef bool (*Apply)(const Binding& binding,
+							  Opt& options,
+							  const StringView& label,
+							  const StringView& value,
+							  ParseResult& result);
+
+		/** Field or function bound to an option or argument. */
+		struct Binding {
+			/** Applies this binding. 0 if nothing is bound. */
+			Apply apply;
+
+			/** Bound member or function pointer. */
+			void* target[2];
+
+			/** Value which a flag sets. */
+			bool value;
+		};
+
+		/** Snapshot. */
+		const Snapshot* pSnapshot;
+
+		/** Bindings of the options. */
+		std::vector< Binding > optionBindings;
+
+		/** Bindings of the arguments. */
+		std::vector< Binding > argumentBindings;
+	public:
+		/**
+		 * Initializes with a given snapshot.
+		 *
+		 * @param snapshot
+		 *     Snapshot of a parser. Must outlive this parser.
+		 */
+		explicit SnapshotOptionParser(const Snapshot& snapshot)
+			: pSnapshot(&snapshot),
+			  optionBindings(snapshot.optionCount),
+			  argumentBindings(snapshot.argumentCount) {}
+
+		/** Returns the snapshot. */
+		inline const Snapshot& getSnapshot() const {
+			return *this->pSnapshot;
+		}
+
+		/**
+		 * Binds a field to an option which takes a value.
+		 *
+		 * The value is formatted by `MetaFormat< T, Ch >`.
+		 *
+		 * @param label
+		 *     Label of the option.
+		 * @param field
+		 *     Pointer to the field of `SupOpt` to be substituted.
+		 * @throws ConfigException
+		 *     If the snapshot has no option of `label`,
+		 *     or if the option takes no value.
+		 */
+		template < typename T, typename SupOpt >
+		void bindOption(const StringView& label, T SupOpt::*field) {
+			bind(this->findBinding(label, true),
+				 &applyField< T, SupOpt >,
+				 field);
+		}
+
+		/**
+		 * Binds a function to an option which takes a value.
+		 *
+		 * The value is formatted by `MetaFormat< T, Ch >`.
+		 *
+		 * @param label
+		 *     Label of the option.
+		 * @param f
+		 *     Function to be called with the formatted value.
+		 * @throws ConfigException
+		 *     If the snapshot has no option of `label`,
+		 *     or if the option takes no value.
+		 */
+		template < typename T, typename SupOpt >
+		void bindOption(const StringView& label, void (*f)(SupOpt&, const T&))
+		{
+			bind(this->findBinding(label, true),
+				 &applyFunction< T, SupOpt >,
+				 f);
+		}
+
+		/**
+		 * Binds a function to an option which takes no value.
+		 *
+		 * @param label
+		 *     Label of the option.
+		 * @param f
+		 *     Function to be called when the option is specified.
+		 * @throws ConfigException
+		 *     If the snapshot has no option of `label`,
+		 *     or if the option takes a value.
+		 */
+		template < typename SupOpt >
+		void bindOption(const StringView& label, void (*f)(SupOpt&)) {
+			bind(this->findBinding(label, false), &applyCall< SupOpt >, f);
+		}
+
+		/**
+		 * Binds a `bool` field to an option which takes no value.
+		 *
+		 * @param label
+		 *     Label of the option.
+		 * @param field
+		 *     Pointer to the field of `SupOpt` to be substituted.
+		 * @param value
+		 *     Value to which the field is set. `true` by default.
+		 * @throws ConfigException
+		 *     If the snapshot has no option of `label`,
+		 *     or if the option takes a value.
+		 */
+		template < typename SupOpt >
+		void bindFlag(const StringView& label,
+					  bool SupOpt::*field,
+					  bool value = true)
+		{
+			Binding& binding = this->findBinding(label, false);
+			bind(binding, &applyFlag< SupOpt >, field);
+			binding.value = value;
+		}
+
+		/**
+		 * Binds a field to a positional argument.
+		 *
+		 * @param i
+		 *     Index of the argument.
+		 * @param field
+		 *     Pointer to the field of `SupOpt` to be substituted.
+		 * @throws ConfigException
+		 *     If the snapshot has no argument at `i`.
+		 */
+		template < typename T, typename SupOpt >
+		void bindArgument(size_t i, T SupOpt::*field) {
+			bind(this->findArgumentBinding(i),
+				 &applyField< T, SupOpt >,
+				 field);
+		}
+
+		/**
+		 * Binds a function to a positional argument.
+		 *
+		 * @param i
+		 *     Index of the argument.
+		 * @param f
+		 *     Function to be called with the formatted value.
+		 * @throws ConfigException
+		 *     If the snapshot has no argument at `i`.
+		 */
+		template < typename T, typename SupOpt >
+		void bindArgument(size_t i, void (*f)(SupOpt&, const T&)) {
+			bind(this->findArgumentBinding(i),
+				 &applyFunction< T, SupOpt >,
+				 f);
+		}
+
+		/**
+		 * Parses given command line arguments.
+		 *
+		 * @throws ParseException
+		 *     See `tryParseInto`.
+		 */
+		Opt parse(int argc, const Ch* const* argv) const {
+			Opt options;
+			this->parseInto(options, argc, argv);
+			return options;
+		}
+
+		/**
+		 * Parses given command line arguments into a given options
+		 * container.
+		 *
+		 * @throws ParseException
+		 *     See `tryParseInto`.
+		 */
+		void parseInto(Opt& options, int argc, const Ch* const* argv) const {
+			this->tryParseInto(options, argc, argv).raise();
+		}
+
+		/**
+		 * Parses given command line arguments into a given options container
+		 * without throwing a parsing exception.
+		 *
+		 * See `StaticOptionParser::tryParseInto`.
+		 * The first argument is the program name and ignored.
+		 */
+		ParseResult tryParseInto(Opt& options,
+								 int argc,
+								 const Ch* const* argv) const
+		{
+			typedef OptionParserBase< Opt, Ch, MetaFormat > Dynamic;
+			const Snapshot& snapshot = *this->pSnapshot;
+			if (argc <= 0) {
+				return tooFewArguments(0);
+			}
+			ParseResult result;
+			int argI = 1;
+			size_t nextPos = 0;  // index of the next positional argument
+			for (; argI < argc; ++argI) {
+				const StringView token(argv[argI]);
+				if (Dynamic::isLabel(token)) {
+					// processes an option
+					const int optionI = snapshot.find(token);
+					if (optionI < 0) {
+						result = ParseResult(ParseResult::UNKNOWN_OPTION,
+											 "unknown option",
+											 token);
+						result.setArgIndex(argI);
+						return result;
+					}
+					StringView value;
+					if (snapshot.options[optionI].takesValue) {
+						if (argI + 1 >= argc) {
+							result = ParseResult(ParseResult::VALUE_NEEDED,
+												 "needs value",
+												 token);
+							result.setArgIndex(argI);
+							return result;
+						}
+						value = StringView(argv[++argI]);
+					}
+					if (!tryApply(this->optionBindings[optionI],
+								  options,
+								  token,
+								  value,
+								  result))
+					{
+						result.setArgIndex(argI);
+						return result;
+					}
+				} else {
+					// processes the next positional argument
+					if (nextPos == snapshot.argumentCount) {
+						result = ParseResult(ParseResult::TOO_MANY_ARGUMENTS,
+											 "too many arguments");
+						result.setArgIndex(argI);
+						return result;
+					}
+					const size_t pos = nextPos;
+					// a variadic argument takes all of the remaining values
+					if (!snapshot.arguments[pos].variadic) {
+						++nextPos;
+					}
+					if (!tryApply(this->argumentBindings[pos],
+								  options,
+								  snapshot.getString(
+									  snapshot.arguments[pos].name),
+								  token,
+								  result))
+					{
+						result.setArgIndex(argI);
+						return result;
+					}
+				}
+			}
+			const size_t required = snapshot.argumentCount > 0
+				&& snapshot.arguments[snapshot.argumentCount - 1].variadic
+				? snapshot.argumentCount - 1 : snapshot.argumentCount;
+			if (nextPos < required) {
+				return tooFewArguments(argc);
+			}
+			return result;
+		}
+	private:
+		/**
+		 * Returns the binding of a given option.
+		 *
+		 * @throws ConfigException
+		 *     If the snapshot has no option of `label`,
+		 *     or if whether the option takes a value differs from
+		 *     `takesValue`.
+		 */
+		Binding& findBinding(const StringView& label, bool takesValue) {
+			const int optionI = this->pSnapshot->find(label);
+			if (optionI < 0) {
+				OPTPARSE_THROW(ConfigException("no such option in snapshot"));
+			}
+			if (this->pSnapshot->options[optionI].takesValue != takesValue) {
+				OPTPARSE_THROW(ConfigException(takesValue
+					? "option takes no value" : "option needs value"));
+			}
+			return this->optionBindings[optionI];
+		}
+
+		/**
+		 * Returns the binding of a given argument.
+		 *
+		 * @throws ConfigException
+		 *     If the snapshot has no argument at `i`.
+		 */
+		Binding& findArgumentBinding(size_t i) {
+			if (i >= this->argumentBindings.size()) {
+				OPTPARSE_THROW(
+					ConfigException("no such argument in snapshot"));
+			}
+			return this->argumentBindings[i];
+		}
+
+		/** Stores a given member or function pointer in a binding. */
+		template < typename Target >
+		static void bind(Binding& binding, Apply apply, Target target) {
+			static_assert(sizeof(Target) <= sizeof(binding.target),
+						  "pointer is too large to be bound");
+			binding.apply = apply;
+			std::memcpy(binding.target, &target, sizeof(Target));
+		}
+
+		/** Loads the member or function pointer in a binding. */
+		template < typename Target >
+		static inline Target getTarget(const Binding& binding) {
+			Target target;
+			std::memcpy(&target, binding.target, sizeof(Target));
+			return target;
+		}
+
+		/** Applies a binding. Ignores an unbound option. */
+		static inline bool tryApply(const Binding& binding,
+									Opt& options,
+									const StringView& label,
+									const StringView& value,
+									ParseResult& result)
+		{
+			return binding.apply == 0
+				|| binding.apply(binding, options, label, value, result);
+		}
+
+		/** Formats a value and substitutes a bound field. */
+		template < typename T, typename SupOpt >
+		static bool applyField(const Binding& binding,
+							   Opt& options,
+							   const StringView& label,
+							   const StringView& value,
+							   ParseResult& result)
+		{
+			T SupOpt::*field = getTarget< T SupOpt::* >(binding);
+			return tryInvokeFormat(
+				MetaFormat< T, Ch >(), value, label, options.*field, result);
+		}
+
+		/** Formats a value and calls a bound function. */
+		template < typename T, typename SupOpt >
+		static bool applyFunction(const Binding& binding,
+								  Opt& options,
+								  const StringView& label,
+								  const StringView& value,
+								  ParseResult& result)
+		{
+			T x;
+			if (!tryInvokeFormat(
+					MetaFormat< T, Ch >(), value, label, x, result))
+			{
+				return false;
+			}
+			void (*f)(SupOpt&, const T&) =
+				getTarget< void (*)(SupOpt&, const T&) >(binding);
+			return catchParsingError(
+				[&]() { f(options, x); }, label, value, result);
+		}
+
+		/** Calls a bound function. */
+		template < typename SupOpt >
+		static bool applyCall(const Binding& binding,
+							  Opt& options,
+							  const StringView& label,
+							  const StringView&,
+							  ParseResult& result)
+		{
+			void (*f)(SupOpt&) = getTarget< void (*)(SupOpt&) >(binding);
+			return catchParsingError(
+				[&]() { f(options); }, label, StringView(), result);
+		}
+
+		/** Sets a bound `bool` field. */
+		template < typename SupOpt >
+		static bool applyFlag(const Binding& binding,
+							  Opt& options,
+							  const StringView&,
+							  const StringView&,
+							  ParseResult&)
+		{
+			options.*getTarget< bool SupOpt::* >(binding) = binding.value;
+			return true;
+		}
+
+		/** Returns a `TOO_FEW_ARGUMENTS` result. */
+		static ParseResult tooFewArguments(int argIndex) {
+			ParseResult result(
+				ParseResult::TOO_FEW_ARGUMENTS, "too few arguments");
+			result.setArgIndex(argIndex);
+			return result;
+		}
+	};
+
+}
+
+#endif
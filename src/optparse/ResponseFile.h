@@ -0,0 +1,278 @@
+#ifndef _OPTPARSE_OPTPARSE_RESPONSE_FILE_H
+#define _OPTPARSE_OPTPARSE_RESPONSE_FILE_H
+
+#include "optparse/Transcoder.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * Whether a response file is memory-mapped.
+ *
+ * 1 on POSIX systems unless defined beforehand.
+ * Otherwise, the whole file is read into a buffer at once.
+ */
+#ifndef OPTPARSE_USE_MMAP
+#	if defined(__unix__) || defined(__APPLE__)
+#		define OPTPARSE_USE_MMAP 1
+#	else
+#		define OPTPARSE_USE_MMAP 0
+#	endif
+#endif
+
+#if OPTPARSE_USE_MMAP
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace optparse {
+
+	/**
+	 * Traits of the path of a response file.
+	 *
+	 * @tparam Ch
+	 *     Type which represents a character of a path.
+	 */
+	template < typename Ch >
+	struct ResponseFilePathTraits;
+
+	/** Traits of a path of `char`, which is passed to the system as is. */
+	template <>
+	struct ResponseFilePathTraits< char > {
+		/** Returns a given path. */
+		static inline std::string toNative(const char* path) {
+			return path;
+		}
+	};
+
+	/**
+	 * Traits of a path of `wchar_t`.
+	 *
+	 * A path is encoded in UTF-8 by `Transcoder`, as the contents of
+	 * a response file are decoded.
+	 */
+	template <>
+	struct ResponseFilePathTraits< wchar_t > {
+		/**
+		 * Encodes a given path in UTF-8.
+		 *
+		 * @return
+		 *     Encoded path.
+		 */
+		static std::string toNative(const wchar_t* path) {
+			typedef Transcoder< wchar_t, char > Encoder;
+			const wchar_t* last =
+				path + std::char_traits< wchar_t >::length(path);
+			std::string native(Encoder::getMaxSize(last - path), '\0');
+			native.resize(native.empty()
+				? 0 : Encoder::transcode(path, last, &native[0]));
+			return native;
+		}
+	};
+
+	/**
+	 * Contents of a response file.
+	 *
+	 * A response file has command line arguments which are given as
+	 * `@path` on the command line.
+	 * The contents are split by `CommandLineTokenizer`.
+	 *
+	 * If `Ch` is `char` and `OPTPARSE_USE_MMAP` is 1, the file is mapped
+	 * into memory privately, so that tokens are views of the mapped pages
+	 * and only the pages modified by removing quotes or escapes are copied.
+	 * Otherwise, the whole file is read into a buffer at once; for other
+	 * character types, the contents are decoded from UTF-8 by
+	 * `Transcoder`, and an invalid sequence becomes U+FFFD.
+	 *
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename Ch >
+	class ResponseFile {
+	private:
+		/** Beginning of the contents. */
+		Ch* first;
+
+		/** End of the contents. */
+		Ch* last;
+
+		/** Mapped region. 0 if the file is not mapped. */
+		void* mapping;
+
+		/** Size of `mapping` in bytes. */
+		size_t mappingSize;
+
+		/** Buffer of the contents if the file is not mapped. */
+		std::vector< Ch > buffer;
+	public:
+		/** Initializes a closed file. */
+		inline ResponseFile() : first(0), last(0), mapping(0), mappingSize(0) {}
+
+		/** Releases the contents. */
+		~ResponseFile() {
+			this->close();
+		}
+
+		/**
+		 * Opens a given file.
+		 *
+		 * Closes the file opened before.
+		 *
+		 * @param path
+		 *     Path to the file.
+		 * @return
+		 *     Whether the file has been opened.
+		 */
+		template < typename PathCh >
+		bool open(const PathCh* path) {
+			this->close();
+			const std::string native =
+				ResponseFilePathTraits< PathCh >::toNative(path);
+			if (native.empty()) {
+				return false;
+			}
+			if (this->map(native)) {
+				return true;
+			}
+			return this->read(native);
+		}
+
+		/** Releases the contents. */
+		void close() {
+#if OPTPARSE_USE_MMAP
+			if (this->mapping != 0) {
+				::munmap(this->mapping, this->mappingSize);
+			}
+#endif
+			this->mapping = 0;
+			this->mappingSize = 0;
+			this->buffer.clear();
+			this->first = 0;
+			this->last = 0;
+		}
+
+		/** Returns whether the file is mapped into memory. */
+		inline bool isMapped() const {
+			return this->mapping != 0;
+		}
+
+		/**
+		 * Returns the beginning of the contents.
+		 *
+		 * Valid until the file is closed.
+		 * May be overwritten by `CommandLineTokenizer`.
+		 */
+		inline Ch* begin() {
+			return this->first;
+		}
+
+		/** Returns the end of the contents. */
+		inline Ch* end() {
+			return this->last;
+		}
+	private:
+		/**
+		 * Maps a given file into memory.
+		 *
+		 * @return
+		 *     Whether the file has been mapped.
+		 *     Always `false` unless `Ch` is `char` and `OPTPARSE_USE_MMAP`
+		 *     is 1.
+		 */
+		bool map(const std::string& path) {
+#if OPTPARSE_USE_MMAP
+			if (sizeof(Ch) != 1) {
+				return false;
+			}
+			const int fd = ::open(path.c_str(), O_RDONLY);
+			if (fd < 0) {
+				return false;
+			}
+			struct stat status;
+			if (::fstat(fd, &status) != 0 || status.st_size <= 0) {
+				// an empty file cannot be mapped
+				::close(fd);
+				return false;
+			}
+			const size_t size = static_cast< size_t >(status.st_size);
+			void* p = ::mmap(
+				0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+			::close(fd);
+			if (p == MAP_FAILED) {
+				return false;
+			}
+			this->mapping = p;
+			this->mappingSize = size;
+			this->first = static_cast< Ch* >(p);
+			this->last = this->first + size;
+			return true;
+#else
+			(void)path;
+			return false;
+#endif
+		}
+
+		/**
+		 * Reads a given file into the buffer at once.
+		 *
+		 * @return
+		 *     Whether the file has been read.
+		 */
+		bool read(const std::string& path) {
+			std::FILE* file = std::fopen(path.c_str(), "rb");
+			if (file == 0) {
+				return false;
+			}
+			std::vector< char > bytes;
+			bool succeeded = std::fseek(file, 0, SEEK_END) == 0;
+			const long size = succeeded ? std::ftell(file) : -1;
+			succeeded = size >= 0 && std::fseek(file, 0, SEEK_SET) == 0;
+			if (succeeded && size > 0) {
+				bytes.resize(static_cast< size_t >(size));
+				succeeded = std::fread(&bytes[0], 1, bytes.size(), file)
+					== bytes.size();
+			}
+			std::fclose(file);
+			if (!succeeded) {
+				return false;
+			}
+			widen(bytes, this->buffer);
+			this->first = this->buffer.empty() ? 0 : &this->buffer[0];
+			this->last = this->first + this->buffer.size();
+			return true;
+		}
+
+		/** Moves given bytes into a given buffer of `char`. */
+		static inline void widen(std::vector< char >& bytes,
+								 std::vector< char >& buffer)
+		{
+			buffer.swap(bytes);
+		}
+
+		/** Decodes given UTF-8 bytes into a given buffer of `Ch2`. */
+		template < typename Ch2 >
+		static void widen(const std::vector< char >& bytes,
+						  std::vector< Ch2 >& buffer)
+		{
+			typedef Transcoder< char, Ch2 > Decoder;
+			buffer.resize(Decoder::getMaxSize(bytes.size()));
+			if (!bytes.empty()) {
+				buffer.resize(Decoder::transcode(
+					&bytes[0], &bytes[0] + bytes.size(), &buffer[0]));
+			}
+		}
+
+		/** Copy is not allowed. */
+		ResponseFile(const ResponseFile&) = delete;
+
+		/** Assignment is not allowed. */
+		void operator =(const ResponseFile&) = delete;
+	};
+
+}
+
+#endif
@@ -0,0 +1,1460 @@
+#ifndef _OPTPARSE_OPTPARSE_STATIC_OPTION_PARSER_H
+#define _OPTPARSE_OPTPARSE_STATIC_OPTION_PARSER_H
+
+#include "optparse/FormatInvoker.h"
+#include "optparse/OptionParserBase.h"
+#include "optparse/OptionParserException.h"
+#include "optparse/OptionSpec.h"
+#include "optparse/StringView.h"
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+namespace optparse {
+
+	/**
+	 * Tag which makes a static option or argument use the `MetaFormat` of
+	 * the `StaticOptionParser` it belongs to.
+	 */
+	struct UseMetaFormat {};
+
+	/**
+	 * Resolves the formatter of a static option or argument.
+	 *
+	 * Just returns a given formatter unless it is `UseMetaFormat`.
+	 *
+	 * @tparam MetaFormat
+	 *     See `OptionParserBase`.
+	 * @tparam T
+	 *     See `OptionParserBase`.
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 * @tparam Format
+	 *     See `OptionParserBase`. May be `UseMetaFormat`.
+	 */
+	template < template < typename, typename > class MetaFormat,
+			   typename T,
+			   typename Ch,
+			   typename Format >
+	struct StaticFormatResolver {
+		/** Returns `format`. */
+		static inline const Format& resolve(const Format& format) {
+			return format;
+		}
+	};
+
+	/** Specialization of `StaticFormatResolver` for `UseMetaFormat`. */
+	template < template < typename, typename > class MetaFormat,
+			   typename T,
+			   typename Ch >
+	struct StaticFormatResolver< MetaFormat, T, Ch, UseMetaFormat > {
+		/** Returns a new instance of `MetaFormat< T, Ch >`. */
+		static inline MetaFormat< T, Ch > resolve(const UseMetaFormat&) {
+			return MetaFormat< T, Ch >();
+		}
+	};
+
+	/**
+	 * Base class of an option of a `StaticOptionParser`.
+	 *
+	 * Implements `OptionSpec` so that `DefaultUsagePrinter` can print it.
+	 * The virtual functions are only for printing; a `StaticOptionParser`
+	 * applies an option through the non-virtual `tryApply` of the concrete
+	 * type.
+	 *
+	 * An option which takes a value must have the following member function,
+	 *
+	 *     template < template < typename, typename > class MetaFormat,
+	 *                typename Opt >
+	 *     bool tryApply(Opt& options,
+	 *                   const StringView< Ch >& value,
+	 *                   ParseResult< Ch >& result) const
+	 *
+	 * and an option which does not take values must have the following,
+	 *
+	 *     template < typename Opt >
+	 *     bool tryApply(Opt& options, ParseResult< Ch >& result) const
+	 *
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 * @tparam VALUE
+	 *     Whether the option takes a value.
+	 */
+	template < typename Ch, bool VALUE >
+	class StaticOption : public OptionSpec< Ch > {
+	public:
+		/** String of `Ch`. */
+		typedef std::basic_string< Ch > String;
+
+		/** View of a string of `Ch`. */
+		typedef optparse::StringView< Ch > StringView;
+
+		/** Result of parsing. */
+		typedef optparse::ParseResult< Ch > ParseResult;
+
+		/** Whether this option takes a value. */
+		static const bool TAKES_VALUE = VALUE;
+
+		/** Options are not positional arguments. */
+		static const bool IS_ARGUMENT = false;
+	protected:
+		/** Label of this option. */
+		String label;
+
+		/** Name of the option value. Empty if no value is taken. */
+		String valueName;
+
+		/** Description of this option. */
+		String description;
+	public:
+		/**
+		 * Initializes an option.
+		 *
+		 * @param label
+		 *     Label of the option.
+		 * @param valueName
+		 *     Name of the value. Empty if the option does not take values.
+		 * @param description
+		 *     Description of the option.
+		 */
+		inline StaticOption(const String& label,
+							const String& valueName,
+							const String& description)
+			: label(label), valueName(valueName), description(description) {}
+
+		/** Returns the label of this option. */
+		virtual const String& getLabel() const {
+			return this->label;
+		}
+
+		/** Returns the description of this option. */
+		virtual const String& getDescription() const {
+			return this->description;
+		}
+
+		/** Returns `TAKES_VALUE`. */
+		virtual bool needsValue() const {
+			return TAKES_VALUE;
+		}
+
+		/** Returns the name of the option value. */
+		virtual const String& getValueName() const {
+			return this->valueName;
+		}
+
+		/**
+		 * Resets the field associated with this option.
+		 *
+		 * Does nothing by default; i.e., for an option which is not
+		 * associated with a field.
+		 */
+		template < typename Opt >
+		inline void reset(Opt&, const Opt&) const {}
+	};
+
+	template < typename Ch, bool VALUE >
+	const bool StaticOption< Ch, VALUE >::TAKES_VALUE;
+
+	template < typename Ch, bool VALUE >
+	const bool StaticOption< Ch, VALUE >::IS_ARGUMENT;
+
+	/**
+	 * Base class of a positional argument of a `StaticOptionParser`.
+	 *
+	 * Implements `ArgumentSpec` so that `DefaultUsagePrinter` can print it.
+	 * An argument must have the same `tryApply` as an option which takes
+	 * a value (see `StaticOption`).
+	 *
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename Ch >
+	class StaticArgument : public ArgumentSpec< Ch > {
+	public:
+		/** String of `Ch`. */
+		typedef std::basic_string< Ch > String;
+
+		/** View of a string of `Ch`. */
+		typedef optparse::StringView< Ch > StringView;
+
+		/** Result of parsing. */
+		typedef optparse::ParseResult< Ch > ParseResult;
+
+		/** Arguments always take a value. */
+		static const bool TAKES_VALUE = true;
+
+		/** Positional argument. */
+		static const bool IS_ARGUMENT = true;
+	protected:
+		/** Name of this argument. */
+		String name;
+
+		/** Description of this argument. */
+		String description;
+	public:
+		/**
+		 * Initializes an argument.
+		 *
+		 * @param name
+		 *     Name of the argument.
+		 * @param description
+		 *     Description of the argument.
+		 */
+		inline StaticArgument(const String& name, const String& description)
+			: name(name), description(description) {}
+
+		/** Returns the name of this argument. */
+		virtual const String& getValueName() const {
+			return this->name;
+		}
+
+		/** Returns the description of this argument. */
+		virtual const String& getDescription() const {
+			return this->description;
+		}
+
+		/**
+		 * Resets the field associated with this argument.
+		 *
+		 * Does nothing by default; i.e., for an argument which is not
+		 * associated with a field.
+		 */
+		template < typename Opt >
+		inline void reset(Opt&, const Opt&) const {}
+	};
+
+	template < typename Ch >
+	const bool StaticArgument< Ch >::TAKES_VALUE;
+
+	template < typename Ch >
+	const bool StaticArgument< Ch >::IS_ARGUMENT;
+
+	/**
+	 * Static option which substitutes a member field.
+	 *
+	 * @tparam T
+	 *     See `OptionParserBase`.
+	 * @tparam SupOpt
+	 *     See `OptionParserBase`.
+	 * @tparam Format
+	 *     See `OptionParserBase`. May be `UseMetaFormat`.
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename T, typename SupOpt, typename Format, typename Ch >
+	class StaticMemberOption : public StaticOption< Ch, true > {
+	private:
+		/** Base class. */
+		typedef StaticOption< Ch, true > Base;
+
+		/** Field to be substituted. */
+		T SupOpt::*field;
+
+		/** Formats a string as a value of `T`. */
+		Format format;
+	public:
+		/** Initializes an option which substitutes a given field. */
+		inline StaticMemberOption(const typename Base::String& label,
+								  const typename Base::String& name,
+								  const typename Base::String& description,
+								  T (SupOpt::*field),
+								  const Format& format)
+			: Base(label, name, description), field(field), format(format) {}
+
+		/**
+		 * Formats a given string and sets the field of a given options
+		 * container to the formatted value.
+		 *
+		 * The field is left untouched if formatting fails.
+		 */
+		template < template < typename, typename > class MetaFormat,
+				   typename Opt >
+		inline bool tryApply(Opt& options,
+							 const typename Base::StringView& value,
+							 typename Base::ParseResult& result) const
+		{
+			return tryInvokeFormat(
+				StaticFormatResolver< MetaFormat, T, Ch, Format >::resolve(
+					this->format),
+				value,
+				typename Base::StringView(this->label),
+				options.*(this->field),
+				result);
+		}
+
+		/** Copies the field of `defaults` into the field of `options`. */
+		template < typename Opt >
+		inline void reset(Opt& options, const Opt& defaults) const {
+			options.*(this->field) = defaults.*(this->field);
+		}
+	};
+
+	/**
+	 * Static option which substitutes a member field with a constant.
+	 *
+	 * @tparam T
+	 *     See `OptionParserBase`.
+	 * @tparam SupOpt
+	 *     See `OptionParserBase`.
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename T, typename SupOpt, typename Ch >
+	class StaticConstMemberOption : public StaticOption< Ch, false > {
+	private:
+		/** Base class. */
+		typedef StaticOption< Ch, false > Base;
+
+		/** Field to be substituted. */
+		T SupOpt::*field;
+
+		/** Constant value to substitute the field. */
+		T constant;
+	public:
+		/** Initializes an option which substitutes a given field. */
+		inline StaticConstMemberOption(
+			const typename Base::String& label,
+			const typename Base::String& description,
+			T (SupOpt::*field),
+			const T& constant)
+			: Base(label, typename Base::String(), description),
+			  field(field),
+			  constant(constant) {}
+
+		/** Substitutes the field with the constant. Never fails. */
+		template < typename Opt >
+		inline bool tryApply(Opt& options, typename Base::ParseResult&) const {
+			options.*(this->field) = this->constant;
+			return true;
+		}
+
+		/** Copies the field of `defaults` into the field of `options`. */
+		template < typename Opt >
+		inline void reset(Opt& options, const Opt& defaults) const {
+			options.*(this->field) = defaults.*(this->field);
+		}
+	};
+
+	/**
+	 * Static option which calls a given function.
+	 *
+	 * @tparam T
+	 *     See `OptionParserBase`.
+	 * @tparam SupOpt
+	 *     See `OptionParserBase`.
+	 * @tparam Format
+	 *     See `OptionParserBase`. May be `UseMetaFormat`.
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename T, typename SupOpt, typename Format, typename Ch >
+	class StaticFunctionOption : public StaticOption< Ch, true > {
+	private:
+		/** Base class. */
+		typedef StaticOption< Ch, true > Base;
+
+		/** Function to be called. */
+		void (*f)(SupOpt&, const T&);
+
+		/** Formats a string as a value of `T`. */
+		Format format;
+	public:
+		/** Initializes an option which calls a given function. */
+		inline StaticFunctionOption(const typename Base::String& label,
+									const typename Base::String& name,
+									const typename Base::String& description,
+									void (*f)(SupOpt&, const T&),
+									const Format& format)
+			: Base(label, name, description), f(f), format(format) {}
+
+		/**
+		 * Formats a given string and passes the formatted value to the
+		 * function.
+		 */
+		template < template < typename, typename > class MetaFormat,
+				   typename Opt >
+		bool tryApply(Opt& options,
+					  const typename Base::StringView& value,
+					  typename Base::ParseResult& result) const
+		{
+			const typename Base::StringView label(this->label);
+			T x;
+			if (!tryInvokeFormat(
+					StaticFormatResolver< MetaFormat, T, Ch, Format >::resolve(
+						this->format),
+					value, label, x, result))
+			{
+				return false;
+			}
+			return catchParsingError(
+				[&]() { this->f(options, x); }, label, value, result);
+		}
+	};
+
+	/**
+	 * Static option which calls a given function without values.
+	 *
+	 * @tparam SupOpt
+	 *     See `OptionParserBase`.
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename SupOpt, typename Ch >
+	class StaticConstFunctionOption : public StaticOption< Ch, false > {
+	private:
+		/** Base class. */
+		typedef StaticOption< Ch, false > Base;
+
+		/** Function to be called. */
+		void (*f)(SupOpt&);
+	public:
+		/** Initializes an option which calls a given function. */
+		inline StaticConstFunctionOption(
+			const typename Base::String& label,
+			const typename Base::String& description,
+			void (*f)(SupOpt&))
+			: Base(label, typename Base::String(), description), f(f) {}
+
+		/** Calls the function. */
+		template < typename Opt >
+		inline bool tryApply(Opt& options,
+							 typename Base::ParseResult& result) const
+		{
+			return catchParsingError(
+				[&]() { this->f(options); },
+				typename Base::StringView(this->label),
+				typename Base::StringView(),
+				result);
+		}
+	};
+
+	/**
+	 * Static argument which substitutes a member field.
+	 *
+	 * @tparam T
+	 *     See `OptionParserBase`.
+	 * @tparam SupOpt
+	 *     See `OptionParserBase`.
+	 * @tparam Format
+	 *     See `OptionParserBase`. May be `UseMetaFormat`.
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename T, typename SupOpt, typename Format, typename Ch >
+	class StaticMemberArgument : public StaticArgument< Ch > {
+	private:
+		/** Base class. */
+		typedef StaticArgument< Ch > Base;
+
+		/** Field to be substituted. */
+		T SupOpt::*field;
+
+		/** Formats a string as a value of `T`. */
+		Format format;
+	public:
+		/** Initializes an argument which substitutes a given field. */
+		inline StaticMemberArgument(const typename Base::String& name,
+									const typename Base::String& description,
+									T (SupOpt::*field),
+									const Format& format)
+			: Base(name, description), field(field), format(format) {}
+
+		/**
+		 * Formats a given string and sets the field of a given options
+		 * container to the formatted value.
+		 *
+		 * The field is left untouched if formatting fails.
+		 */
+		template < template < typename, typename > class MetaFormat,
+				   typename Opt >
+		inline bool tryApply(Opt& options,
+							 const typename Base::StringView& value,
+							 typename Base::ParseResult& result) const
+		{
+			return tryInvokeFormat(
+				StaticFormatResolver< MetaFormat, T, Ch, Format >::resolve(
+					this->format),
+				value,
+				typename Base::StringView(this->name),
+				options.*(this->field),
+				result);
+		}
+
+		/** Copies the field of `defaults` into the field of `options`. */
+		template < typename Opt >
+		inline void reset(Opt& options, const Opt& defaults) const {
+			options.*(this->field) = defaults.*(this->field);
+		}
+	};
+
+	/**
+	 * Static argument which calls a given function.
+	 *
+	 * @tparam T
+	 *     See `OptionParserBase`.
+	 * @tparam SupOpt
+	 *     See `OptionParserBase`.
+	 * @tparam Format
+	 *     See `OptionParserBase`. May be `UseMetaFormat`.
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename T, typename SupOpt, typename Format, typename Ch >
+	class StaticFunctionArgument : public StaticArgument< Ch > {
+	private:
+		/** Base class. */
+		typedef StaticArgument< Ch > Base;
+
+		/** Function to be called. */
+		void (*f)(SupOpt&, const T&);
+
+		/** Formats a string as a value of `T`. */
+		Format format;
+	public:
+		/** Initializes an argument which calls a given function. */
+		inline StaticFunctionArgument(const typename Base::String& name,
+									  const typename Base::String& description,
+									  void (*f)(SupOpt&, const T&),
+									  const Format& format)
+			: Base(name, description), f(f), format(format) {}
+
+		/**
+		 * Formats a given string and passes the formatted value to the
+		 * function.
+		 */
+		template < template < typename, typename > class MetaFormat,
+				   typename Opt >
+		bool tryApply(Opt& options,
+					  const typename Base::StringView& value,
+					  typename Base::ParseResult& result) const
+		{
+			const typename Base::StringView name(this->name);
+			T x;
+			if (!tryInvokeFormat(
+					StaticFormatResolver< MetaFormat, T, Ch, Format >::resolve(
+						this->format),
+					value, name, x, result))
+			{
+				return false;
+			}
+			return catchParsingError(
+				[&]() { this->f(options, x); }, name, value, result);
+		}
+	};
+
+	/**
+	 * Declares an option which substitutes a given field with a value
+	 * formatted by the `MetaFormat` of the parser.
+	 *
+	 * @param label
+	 *     Option label on the command line.
+	 * @param name
+	 *     Name of the value which the option takes.
+	 * @param description
+	 *     Description of the option.
+	 * @param field
+	 *     Pointer to the field of `SupOpt` to be substituted.
+	 */
+	template < typename Ch, typename T, typename SupOpt >
+	inline StaticMemberOption< T, SupOpt, UseMetaFormat, Ch > staticOption(
+		const Ch* label,
+		const Ch* name,
+		const Ch* description,
+		T (SupOpt::*field))
+	{
+		return StaticMemberOption< T, SupOpt, UseMetaFormat, Ch >(
+			label, name, description, field, UseMetaFormat());
+	}
+
+	/**
+	 * Declares an option which substitutes a given field with a value
+	 * formatted by a given formatter.
+	 *
+	 * @param label
+	 *     Option label on the command line.
+	 * @param name
+	 *     Name of the value which the option takes.
+	 * @param description
+	 *     Description of the option.
+	 * @param field
+	 *     Pointer to the field of `SupOpt` to be substituted.
+	 * @param format
+	 *     Function object which converts a string into a value of `T`.
+	 */
+	template < typename Ch, typename T, typename SupOpt, typename Format >
+	inline StaticMemberOption< T, SupOpt, Format, Ch > staticOption(
+		const Ch* label,
+		const Ch* name,
+		const Ch* description,
+		T (SupOpt::*field),
+		const Format& format)
+	{
+		return StaticMemberOption< T, SupOpt, Format, Ch >(
+			label, name, description, field, format);
+	}
+
+	/**
+	 * Declares an option which substitutes a given field with a given
+	 * constant.
+	 *
+	 * @param label
+	 *     Option label on the command line.
+	 * @param description
+	 *     Description of the option.
+	 * @param field
+	 *     Pointer to the field of `SupOpt` to be substituted.
+	 * @param constant
+	 *     Constant that substitutes the field.
+	 */
+	template < typename Ch, typename T, typename SupOpt >
+	inline StaticConstMemberOption< T, SupOpt, Ch > staticOption(
+		const Ch* label,
+		const Ch* description,
+		T (SupOpt::*field),
+		const T& constant)
+	{
+		return StaticConstMemberOption< T, SupOpt, Ch >(
+			label, description, field, constant);
+	}
+
+	/**
+	 * Declares an option which calls a given function with a value
+	 * formatted by the `MetaFormat` of the parser.
+	 *
+	 * @param label
+	 *     Option label on the command line.
+	 * @param name
+	 *     Name of the value which the option takes.
+	 * @param description
+	 *     Description of the option.
+	 * @param f
+	 *     Function to be called when the option is specified.
+	 */
+	template < typename Ch, typename T, typename SupOpt >
+	inline StaticFunctionOption< T, SupOpt, UseMetaFormat, Ch > staticOption(
+		const Ch* label,
+		const Ch* name,
+		const Ch* description,
+		void (*f)(SupOpt&, const T&))
+	{
+		return StaticFunctionOption< T, SupOpt, UseMetaFormat, Ch >(
+			label, name, description, f, UseMetaFormat());
+	}
+
+	/**
+	 * Declares an option which calls a given function with a value
+	 * formatted by a given formatter.
+	 *
+	 * @param label
+	 *     Option label on the command line.
+	 * @param name
+	 *     Name of the value which the option takes.
+	 * @param description
+	 *     Description of the option.
+	 * @param f
+	 *     Function to be called when the option is specified.
+	 * @param format
+	 *     Function object which converts a string into a value of `T`.
+	 */
+	template < typename Ch, typename T, typename SupOpt, typename Format >
+	inline StaticFunctionOption< T, SupOpt, Format, Ch > staticOption(
+		const Ch* label,
+		const Ch* name,
+		const Ch* description,
+		void (*f)(SupOpt&, const T&),
+		const Format& format)
+	{
+		return StaticFunctionOption< T, SupOpt, Format, Ch >(
+			label, name, description, f, format);
+	}
+
+	/**
+	 * Declares an option which calls a given function without values.
+	 *
+	 * @param label
+	 *     Option label on the command line.
+	 * @param description
+	 *     Description of the option.
+	 * @param f
+	 *     Function to be called when the option is specified.
+	 */
+	template < typename Ch, typename SupOpt >
+	inline StaticConstFunctionOption< SupOpt, Ch > staticOption(
+		const Ch* label,
+		const Ch* description,
+		void (*f)(SupOpt&))
+	{
+		return StaticConstFunctionOption< SupOpt, Ch >(label, description, f);
+	}
+
+	/**
+	 * Declares an argument which substitutes a given field with a value
+	 * formatted by the `MetaFormat` of the parser.
+	 *
+	 * @param name
+	 *     Name of the argument.
+	 * @param description
+	 *     Description of the argument.
+	 * @param field
+	 *     Pointer to the field of `SupOpt` to be substituted.
+	 */
+	template < typename Ch, typename T, typename SupOpt >
+	inline StaticMemberArgument< T, SupOpt, UseMetaFormat, Ch >
+	staticArgument(const Ch* name, const Ch* description, T (SupOpt::*field))
+	{
+		return StaticMemberArgument< T, SupOpt, UseMetaFormat, Ch >(
+			name, description, field, UseMetaFormat());
+	}
+
+	/**
+	 * Declares an argument which substitutes a given field with a value
+	 * formatted by a given formatter.
+	 *
+	 * @param name
+	 *     Name of the argument.
+	 * @param description
+	 *     Description of the argument.
+	 * @param field
+	 *     Pointer to the field of `SupOpt` to be substituted.
+	 * @param format
+	 *     Function object which converts a string into a value of `T`.
+	 */
+	template < typename Ch, typename T, typename SupOpt, typename Format >
+	inline StaticMemberArgument< T, SupOpt, Format, Ch > staticArgument(
+		const Ch* name,
+		const Ch* description,
+		T (SupOpt::*field),
+		const Format& format)
+	{
+		return StaticMemberArgument< T, SupOpt, Format, Ch >(
+			name, description, field, format);
+	}
+
+	/**
+	 * Declares an argument which calls a given function with a value
+	 * formatted by the `MetaFormat` of the parser.
+	 *
+	 * @param name
+	 *     Name of the argument.
+	 * @param description
+	 *     Description of the argument.
+	 * @param f
+	 *     Function to be called when the argument is specified.
+	 */
+	template < typename Ch, typename T, typename SupOpt >
+	inline StaticFunctionArgument< T, SupOpt, UseMetaFormat, Ch >
+	staticArgument(const Ch* name,
+				   const Ch* description,
+				   void (*f)(SupOpt&, const T&))
+	{
+		return StaticFunctionArgument< T, SupOpt, UseMetaFormat, Ch >(
+			name, description, f, UseMetaFormat());
+	}
+
+	/**
+	 * Declares an argument which calls a given function with a value
+	 * formatted by a given formatter.
+	 *
+	 * @param name
+	 *     Name of the argument.
+	 * @param description
+	 *     Description of the argument.
+	 * @param f
+	 *     Function to be called when the argument is specified.
+	 * @param format
+	 *     Function object which converts a string into a value of `T`.
+	 */
+	template < typename Ch, typename T, typename SupOpt, typename Format >
+	inline StaticFunctionArgument< T, SupOpt, Format, Ch > staticArgument(
+		const Ch* name,
+		const Ch* description,
+		void (*f)(SupOpt&, const T&),
+		const Format& format)
+	{
+		return StaticFunctionArgument< T, SupOpt, Format, Ch >(
+			name, description, f, format);
+	}
+
+	/**
+	 * Counts the options and arguments in a list of static definitions.
+	 *
+	 * @tparam Defs
+	 *     Types of the static options and arguments.
+	 */
+	template < typename... Defs >
+	struct StaticDefCount;
+
+	/** Empty list. */
+	template <>
+	struct StaticDefCount<> {
+		/** No options. */
+		static const size_t OPTIONS = 0;
+
+		/** No arguments. */
+		static const size_t ARGUMENTS = 0;
+	};
+
+	/** Non-empty list. */
+	template < typename Def, typename... Rest >
+	struct StaticDefCount< Def, Rest... > {
+		/** Number of the options. */
+		static const size_t OPTIONS =
+			(Def::IS_ARGUMENT ? 0 : 1) + StaticDefCount< Rest... >::OPTIONS;
+
+		/** Number of the arguments. */
+		static const size_t ARGUMENTS =
+			(Def::IS_ARGUMENT ? 1 : 0) + StaticDefCount< Rest... >::ARGUMENTS;
+	};
+
+	/**
+	 * Parser for command line options defined at compile time.
+	 *
+	 * Behaves in the same way as `OptionParserBase` configured with the same
+	 * options and arguments, but the options and arguments are fixed by
+	 * the type parameters instead of being added at run time.
+	 * The definitions are stored in a `std::tuple` by value, and the labels
+	 * are stored in a sorted `std::array`.
+	 * Parsing looks up a label by binary search and applies the option
+	 * through a chain of comparisons of the index, which the compiler can
+	 * inline, without virtual function calls, heap allocations or
+	 * reference counting.
+	 *
+	 * Use `makeStaticOptionParser` with `staticOption` and
+	 * `staticArgument` to build an instance.
+	 * The definitions implement `OptionSpec` and `ArgumentSpec`, so
+	 * `DefaultUsagePrinter` prints the same usage as for the equivalent
+	 * `OptionParserBase`.
+	 *
+	 * Unlike `OptionParserBase`, labels must be unique.
+	 *
+	 * @tparam Opt
+	 *     See `OptionParserBase`.
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 * @tparam MetaFormat
+	 *     See `OptionParserBase`.
+	 *     Used by definitions whose formatter is `UseMetaFormat`.
+	 * @tparam Defs
+	 *     Types of the options and arguments.
+	 *     Arguments are processed in this order.
+	 */
+	template < typename Opt,
+			   typename Ch,
+			   template < typename, typename > class MetaFormat,
+			   typename... Defs >
+	class StaticOptionParser {
+	public:
+		/** String of `Ch`. */
+		typedef std::basic_string< Ch > String;
+
+		/** Non-owning view of a string of `Ch`. */
+		typedef optparse::StringView< Ch > StringView;
+
+		/** Result of parsing. */
+		typedef optparse::ParseResult< Ch > ParseResult;
+
+		/** Number of the options. */
+		static const size_t OPTION_COUNT = StaticDefCount< Defs... >::OPTIONS;
+
+		/** Number of the arguments. */
+		static const size_t ARGUMENT_COUNT =
+			StaticDefCount< Defs... >::ARGUMENTS;
+	private:
+		/** Number of the definitions. */
+		static const size_t DEF_COUNT = sizeof...(Defs);
+
+		/** Tuple of the definitions. */
+		typedef std::tuple< Defs... > DefTuple;
+
+		/** Label associated with a definition. */
+		struct LabelEntry {
+			/** Label owned by the definition. */
+			StringView label;
+
+			/** Index of the definition in the tuple. */
+			size_t index;
+
+			/** Whether the option takes a value. */
+			bool takesValue;
+		};
+
+		/** Compares the labels of entries. */
+		struct LabelLess {
+			inline bool operator ()(const LabelEntry& lhs,
+									const LabelEntry& rhs) const
+			{
+				return lhs.label < rhs.label;
+			}
+
+			inline bool operator ()(const LabelEntry& lhs,
+									const StringView& rhs) const
+			{
+				return lhs.label < rhs;
+			}
+		};
+
+		/** Visits the definitions from the `I`-th. */
+		template < size_t I, bool END = (I == DEF_COUNT) >
+		struct Visitor;
+
+		/** Visits no definitions. */
+		template < size_t I >
+		struct Visitor< I, true > {
+			static inline void index(StaticOptionParser&, size_t, size_t) {}
+
+			static inline bool apply(const DefTuple&,
+									 size_t,
+									 Opt&,
+									 ParseResult&)
+			{
+				return true;
+			}
+
+			static inline bool apply(const DefTuple&,
+									 size_t,
+									 Opt&,
+									 const StringView&,
+									 ParseResult&)
+			{
+				return true;
+			}
+
+			static inline void reset(const DefTuple&, Opt&, const Opt&) {}
+		};
+
+		/** Visits the `I`-th and following definitions. */
+		template < size_t I >
+		struct Visitor< I, false > {
+			/** Type of the `I`-th definition. */
+			typedef typename std::tuple_element< I, DefTuple >::type Def;
+
+			/** Whether the `I`-th definition is an argument. */
+			typedef std::integral_constant< bool, Def::IS_ARGUMENT >
+				IsArgument;
+
+			/** Whether the `I`-th definition takes a value. */
+			typedef std::integral_constant< bool, Def::TAKES_VALUE >
+				TakesValue;
+
+			/** Registers the definitions in the tables of `parser`. */
+			static void index(StaticOptionParser& parser,
+							  size_t optionI,
+							  size_t argumentI)
+			{
+				parser.indexDef(
+					std::get< I >(parser.defs), I, optionI, argumentI,
+					IsArgument());
+				Visitor< I + 1 >::index(parser,
+										optionI + (Def::IS_ARGUMENT ? 0 : 1),
+										argumentI + (Def::IS_ARGUMENT ? 1 : 0));
+			}
+
+			/** Applies the `i`-th definition without a value. */
+			static inline bool apply(const DefTuple& defs,
+									 size_t i,
+									 Opt& options,
+									 ParseResult& result)
+			{
+				if (i == I) {
+					return applyNoValue(
+						std::get< I >(defs), options, result, TakesValue());
+				}
+				return Visitor< I + 1 >::apply(defs, i, options, result);
+			}
+
+			/** Applies the `i`-th definition with a value. */
+			static inline bool apply(const DefTuple& defs,
+									 size_t i,
+									 Opt& options,
+									 const StringView& value,
+									 ParseResult& result)
+			{
+				if (i == I) {
+					return applyValue(std::get< I >(defs),
+									  options,
+									  value,
+									  result,
+									  TakesValue());
+				}
+				return Visitor< I + 1 >::apply(
+					defs, i, options, value, result);
+			}
+
+			/** Resets the fields associated with the definitions. */
+			static inline void reset(const DefTuple& defs,
+									 Opt& options,
+									 const Opt& defaults)
+			{
+				std::get< I >(defs).reset(options, defaults);
+				Visitor< I + 1 >::reset(defs, options, defaults);
+			}
+		};
+
+		/** Description of the program. */
+		String description;
+
+		/** Name of the program. Empty by default. */
+		String programName;
+
+		/** Generation of this parser. See `getGeneration`. */
+		size_t generation;
+
+		/** Definitions of the options and arguments. */
+		DefTuple defs;
+
+		/** Labels of the options sorted in lexicographical order. */
+		std::array< LabelEntry, OPTION_COUNT > labels;
+
+		/** Options in the order of the definitions. */
+		std::array< const OptionSpec< Ch >*, OPTION_COUNT > options;
+
+		/** Indices of the arguments in the tuple. */
+		std::array< size_t, ARGUMENT_COUNT > argumentIndices;
+
+		/** Arguments in the order of the definitions. */
+		std::array< const ArgumentSpec< Ch >*, ARGUMENT_COUNT > arguments;
+	public:
+		/**
+		 * Initializes with the description of the program and given
+		 * definitions.
+		 *
+		 * @param description
+		 *     Description of the program.
+		 * @param defs
+		 *     Definitions of the options and arguments.
+		 * @throws ConfigException
+		 *     If a label cannot be an option label
+		 *     (see `OptionParserBase::isLabel`),
+		 *     or if labels are duplicate.
+		 */
+		explicit StaticOptionParser(const String& description,
+									const Defs&... defs)
+			: description(description), generation(0), defs(defs...)
+		{
+			this->index();
+			this->verifyLabels();
+		}
+
+		/**
+		 * Copies a given parser.
+		 *
+		 * The tables are rebuilt because they refer to the definitions.
+		 */
+		StaticOptionParser(const StaticOptionParser& other)
+			: description(other.description),
+			  programName(other.programName),
+			  generation(other.generation),
+			  defs(other.defs)
+		{
+			this->index();
+		}
+
+		/** Returns the description of the program. */
+		inline const String& getDescription() const {
+			return this->description;
+		}
+
+		/**
+		 * Returns the program name.
+		 *
+		 * @return
+		 *     Name of the program.
+		 *     An empty string if `parse` has not yet been called.
+		 */
+		inline const String& getProgramName() const {
+			return this->programName;
+		}
+
+		/**
+		 * Returns the generation of this parser.
+		 *
+		 * Changes only when the program name changes.
+		 * See `OptionParserBase::getGeneration`.
+		 */
+		inline size_t getGeneration() const {
+			return this->generation;
+		}
+
+		/** Returns the number of the options; i.e., `OPTION_COUNT`. */
+		inline size_t getOptionCount() const {
+			return OPTION_COUNT;
+		}
+
+		/**
+		 * Returns the specification of the option at a given index.
+		 *
+		 * Undefined if `i >= this->getOptionCount()`.
+		 */
+		inline const OptionSpec< Ch >& getOption(size_t i) const {
+			return *this->options[i];
+		}
+
+		/** Returns the number of the arguments; i.e., `ARGUMENT_COUNT`. */
+		inline size_t getArgumentCount() const {
+			return ARGUMENT_COUNT;
+		}
+
+		/**
+		 * Returns the specification of the argument at a given index.
+		 *
+		 * Undefined if `i >= this->getArgumentCount()`.
+		 */
+		inline const ArgumentSpec< Ch >& getArgument(size_t i) const {
+			return *this->arguments[i];
+		}
+
+		/**
+		 * Parses given command line arguments.
+		 *
+		 * Updates the program name of this parser with `argv[0]`.
+		 * See `OptionParserBase::parse`.
+		 */
+		Opt parse(int argc, const Ch* const* argv) {
+			Opt options;
+			this->parseInto(options, argc, argv);
+			return options;
+		}
+
+		/**
+		 * Parses given command line arguments without modifying this parser.
+		 *
+		 * Concurrent calls are safe under the same conditions as
+		 * `OptionParserBase::parse`.
+		 */
+		Opt parse(int argc, const Ch* const* argv, String& programName) const {
+			Opt options;
+			this->parseInto(options, argc, argv, programName);
+			return options;
+		}
+
+		/**
+		 * Parses given command line arguments into a given options
+		 * container.
+		 *
+		 * See `OptionParserBase::parseInto`.
+		 */
+		void parseInto(Opt& options, int argc, const Ch* const* argv) {
+			this->tryParseInto(options, argc, argv).raise();
+		}
+
+		/**
+		 * Parses given command line arguments into a given options container
+		 * without modifying this parser.
+		 *
+		 * See `OptionParserBase::parseInto`.
+		 */
+		void parseInto(Opt& options,
+					   int argc,
+					   const Ch* const* argv,
+					   String& programName) const
+		{
+			this->tryParseInto(options, argc, argv, programName).raise();
+		}
+
+		/**
+		 * Parses given command line arguments into a given options container
+		 * without throwing a parsing exception.
+		 *
+		 * See `OptionParserBase::tryParseInto`.
+		 */
+		ParseResult tryParseInto(Opt& options,
+								 int argc,
+								 const Ch* const* argv)
+		{
+			if (argc <= 0) {
+				return tooFewArguments(0);
+			}
+			if (this->programName != argv[0]) {
+				this->programName = argv[0];
+				++this->generation;
+			}
+			return this->tryApplyArguments(options, argc, argv);
+		}
+
+		/**
+		 * Parses given command line arguments into a given options container
+		 * without modifying this parser and without throwing a parsing
+		 * exception.
+		 *
+		 * See `OptionParserBase::tryParseInto`.
+		 */
+		ParseResult tryParseInto(Opt& options,
+								 int argc,
+								 const Ch* const* argv,
+								 String& programName) const
+		{
+			if (argc <= 0) {
+				return tooFewArguments(0);
+			}
+			programName = argv[0];
+			return this->tryApplyArguments(options, argc, argv);
+		}
+
+		/**
+		 * Resets the fields of a given options container which options and
+		 * arguments of this parser substitute.
+		 *
+		 * See `OptionParserBase::resetFields`.
+		 */
+		void resetFields(Opt& options, const Opt& defaults) const {
+			Visitor< 0 >::reset(this->defs, options, defaults);
+		}
+	private:
+		/** Assignment is not allowed. */
+		void operator =(const StaticOptionParser&) = delete;
+
+		/** Builds the tables from the definitions. */
+		void index() {
+			Visitor< 0 >::index(*this, 0, 0);
+			// sorting an empty array hands a null pointer to memmove
+			if (OPTION_COUNT > 1) {
+				std::sort(this->labels.begin(),
+						  this->labels.end(),
+						  LabelLess());
+			}
+		}
+
+		/** Registers a given option. */
+		template < typename Def >
+		void indexDef(const Def& def,
+					  size_t i,
+					  size_t optionI,
+					  size_t,
+					  std::false_type)
+		{
+			const LabelEntry entry = {
+				StringView(def.getLabel()), i, Def::TAKES_VALUE
+			};
+			this->labels[optionI] = entry;
+			this->options[optionI] = &def;
+		}
+
+		/** Registers a given argument. */
+		template < typename Def >
+		void indexDef(const Def& def,
+					  size_t i,
+					  size_t,
+					  size_t argumentI,
+					  std::true_type)
+		{
+			this->argumentIndices[argumentI] = i;
+			this->arguments[argumentI] = &def;
+		}
+
+		/**
+		 * Makes sure that the labels are valid and unique.
+		 *
+		 * @throws ConfigException
+		 *     If a label is invalid or duplicate.
+		 */
+		void verifyLabels() const {
+			for (size_t i = 0; i < OPTION_COUNT; ++i) {
+				if (!OptionParserBase< Opt, Ch, MetaFormat >::isLabel(
+						this->labels[i].label))
+				{
+					OPTPARSE_THROW(ConfigException(
+						"option label must start with dash (-)"));
+				}
+				if (i > 0 && this->labels[i - 1].label == this->labels[i].label)
+				{
+					OPTPARSE_THROW(ConfigException("duplicate option label"));
+				}
+			}
+		}
+
+		/**
+		 * Finds the entry of a given label.
+		 *
+		 * @return
+		 *     Entry of `label`. 0 if no option has `label`.
+		 */
+		const LabelEntry* findLabel(const StringView& label) const {
+			const LabelEntry* first = this->labels.data();
+			const LabelEntry* last = first + OPTION_COUNT;
+			const LabelEntry* found =
+				std::lower_bound(first, last, label, LabelLess());
+			return found != last && found->label == label ? found : 0;
+		}
+
+		/** Applies a definition which takes no value. */
+		template < typename Def >
+		static inline bool applyNoValue(const Def& def,
+										Opt& options,
+										ParseResult& result,
+										std::false_type)
+		{
+			return def.tryApply(options, result);
+		}
+
+		/** Never called for a definition which takes a value. */
+		template < typename Def >
+		static inline bool applyNoValue(const Def&,
+										Opt&,
+										ParseResult&,
+										std::true_type)
+		{
+			return true;
+		}
+
+		/** Applies a definition which takes a value. */
+		template < typename Def >
+		static inline bool applyValue(const Def& def,
+									  Opt& options,
+									  const StringView& value,
+									  ParseResult& result,
+									  std::true_type)
+		{
+			return def.template tryApply< MetaFormat >(options, value, result);
+		}
+
+		/** Never called for a definition which takes no value. */
+		template < typename Def >
+		static inline bool applyValue(const Def&,
+									  Opt&,
+									  const StringView&,
+									  ParseResult&,
+									  std::false_type)
+		{
+			return true;
+		}
+
+		/**
+		 * Applies given command line arguments to a given options container.
+		 *
+		 * Same as `OptionParserBase::tryApplyArguments`.
+		 */
+		ParseResult tryApplyArguments(Opt& options,
+									  int argc,
+									  const Ch* const* argv) const
+		{
+			typedef OptionParserBase< Opt, Ch, MetaFormat > Dynamic;
+			ParseResult result;
+			int argI = 1;
+			size_t nextPos = 0;  // index of the next positional argument
+			while (argI < argc) {
+				if (Dynamic::isLabel(argv[argI])) {
+					// processes an option
+					const StringView label(argv[argI]);
+					const LabelEntry* pEntry = this->findLabel(label);
+					if (pEntry == 0) {
+						result = ParseResult(ParseResult::UNKNOWN_OPTION,
+											 "unknown option",
+											 label);
+						result.setArgIndex(argI);
+						return result;
+					}
+					if (pEntry->takesValue) {
+						if (argI + 1 >= argc) {
+							result = ParseResult(ParseResult::VALUE_NEEDED,
+												 "needs value",
+												 label);
+							result.setArgIndex(argI);
+							return result;
+						}
+						++argI;
+						if (!Visitor< 0 >::apply(this->defs,
+												 pEntry->index,
+												 options,
+												 argv[argI],
+												 result))
+						{
+							result.setArgIndex(argI);
+							return result;
+						}
+					} else if (!Visitor< 0 >::apply(
+						this->defs, pEntry->index, options, result))
+					{
+						result.setArgIndex(argI);
+						return result;
+					}
+				} else {
+					// processes the next positional argument
+					if (nextPos == ARGUMENT_COUNT) {
+						result = ParseResult(ParseResult::TOO_MANY_ARGUMENTS,
+											 "too many arguments");
+						result.setArgIndex(argI);
+						return result;
+					}
+					if (!Visitor< 0 >::apply(this->defs,
+											 this->argumentIndices[nextPos++],
+											 options,
+											 argv[argI],
+											 result))
+					{
+						result.setArgIndex(argI);
+						return result;
+					}
+				}
+				++argI;
+			}
+			if (nextPos != ARGUMENT_COUNT) {
+				return tooFewArguments(argc);
+			}
+			return result;
+		}
+
+		/** Returns a `TOO_FEW_ARGUMENTS` result. */
+		static ParseResult tooFewArguments(int argIndex) {
+			ParseResult result(
+				ParseResult::TOO_FEW_ARGUMENTS, "too few arguments");
+			result.setArgIndex(argIndex);
+			return result;
+		}
+	};
+
+	template < typename Opt,
+			   typename Ch,
+			   template < typename, typename > class MetaFormat,
+			   typename... Defs >
+	const size_t StaticOptionParser< Opt, Ch, MetaFormat, Defs... >
+		::OPTION_COUNT;
+
+	template < typename Opt,
+			   typename Ch,
+			   template < typename, typename > class MetaFormat,
+			   typename... Defs >
+	const size_t StaticOptionParser< Opt, Ch, MetaFormat, Defs... >
+		::ARGUMENT_COUNT;
+
+	/**
+	 * Makes a `StaticOptionParser` from given definitions.
+	 *
+	 * For instance,
+	 *
+	 *     auto parser = optparse::makeStaticOptionParser<
+	 *         Options, optparse::DefaultFormatter >(
+	 *         "test program",
+	 *         optparse::staticOption(
+	 *             "-i", "N", "int option", &Options::i),
+	 *         optparse::staticArgument(
+	 *             "INPUT", "input file", &Options::input));
+	 *
+	 * @tparam Opt
+	 *     See `OptionParserBase`.
+	 * @tparam MetaFormat
+	 *     See `OptionParserBase`.
+	 * @param description
+	 *     Description of the program.
+	 * @param defs
+	 *     Definitions made by `staticOption` and `staticArgument`.
+	 * @return
+	 *     Parser which has `defs`.
+	 * @throws ConfigException
+	 *     If a label is invalid or duplicate.
+	 */
+	template < typename Opt,
+			   template < typename, typename > class MetaFormat,
+			   typename Ch,
+			   typename... Defs >
+	inline StaticOptionParser< Opt, Ch, MetaFormat, Defs... >
+	makeStaticOptionParser(const Ch* description, const Defs&... defs) {
+		return StaticOptionParser< Opt, Ch, MetaFormat, Defs... >(
+			description, defs...);
+	}
+
+}
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef _OPTPARSE_OPTPARSE_STRING_POOL_H
+#define _OPTPARSE_OPTPARSE_STRING_POOL_H
+
+#include "optparse/LabelTable.h"
+#include "optparse/StringView.h"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace optparse {
+
+	/**
+	 * Pool which stores each distinct string only once.
+	 *
+	 * `intern` returns a reference to the pooled copy of a string, which
+	 * never moves and lives as long as the pool, so that many owners of
+	 * equal strings can share a single copy; e.g., value names such as
+	 * "FILE" given to many options.
+	 * A string is never removed from a pool, and keeps the index at which
+	 * it has been interned, so that an owner can associate an index with
+	 * a string; e.g., an option label with an option.
+	 *
+	 * The pooled strings are looked up through an open-addressing table
+	 * of indices hashed by `LabelTable::hash`, which costs a few bytes per
+	 * string.
+	 *
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename Ch >
+	class StringPool {
+	public:
+		/** String of `Ch`. */
+		typedef std::basic_string< Ch > String;
+
+		/** View of a string of `Ch`. */
+		typedef optparse::StringView< Ch > StringView;
+	private:
+		/** Pooled strings. A deque never moves its elements. */
+		std::deque< String > strings;
+
+		/**
+		 * Slots of the lookup table.
+		 *
+		 * Each slot has the index of a string in `strings` plus one, or
+		 * 0 if the slot is empty.
+		 * The size is always a power of two or zero.
+		 */
+		std::vector< unsigned > slots;
+	public:
+		/**
+		 * Returns the pooled copy of a given string.
+		 *
+		 * Copies `str` into this pool unless an equal string is pooled.
+		 *
+		 * @param str
+		 *     String to be interned.
+		 * @return
+		 *     Pooled string equal to `str`.
+		 *     Never moves while this pool lives.
+		 */
+		const String& intern(const StringView& str) {
+			const int i = this->indexOf(str);
+			if (i >= 0) {
+				return this->strings[i];
+			}
+			// keeps the load factor at most 1/2
+			if ((this->strings.size() + 1) * 2 > this->slots.size()) {
+				this->rehash(
+					this->slots.empty() ? 8 : this->slots.size() * 2);
+			}
+			this->strings.push_back(str.str());
+			this->place(this->strings.size() - 1);
+			return this->strings.back();
+		}
+
+		/**
+		 * Finds the index of the pooled string equal to a given string.
+		 *
+		 * Never allocates memory.
+		 *
+		 * @param str
+		 *     String to be searched.
+		 * @return
+		 *     Index of the pooled string equal to `str`; i.e., the number of
+		 *     the strings interned before it.
+		 *     -1 if no such string is pooled.
+		 */
+		int indexOf(const StringView& str) const {
+			if (this->slots.empty()) {
+				return -1;
+			}
+			const size_t mask = this->slots.size() - 1;
+			for (size_t j = LabelTable< Ch >::hash(str, 0) & mask;
+				 this->slots[j] != 0;
+				 j = (j + 1) & mask)
+			{
+				const size_t i = this->slots[j] - 1;
+				if (StringView(this->strings[i]) == str) {
+					return static_cast< int >(i);
+				}
+			}
+			return -1;
+		}
+
+		/**
+		 * Returns the pooled string at a given index.
+		 *
+		 * Undefined if `i >= this->size()`.
+		 *
+		 * @param i
+		 *     Index of the string.
+		 * @return
+		 *     Pooled string at `i`.
+		 */
+		inline const String& operator [](size_t i) const {
+			return this->strings[i];
+		}
+
+		/**
+		 * Returns the number of the pooled strings.
+		 *
+		 * @return
+		 *     Number of the distinct strings in this pool.
+		 */
+		inline size_t size() const {
+			return this->strings.size();
+		}
+	private:
+		/** Places the string at a given index in the lookup table. */
+		void place(size_t i) {
+			const size_t mask = this->slots.size() - 1;
+			size_t j = LabelTable< Ch >::hash(this->strings[i], 0) & mask;
+			while (this->slots[j] != 0) {
+				j = (j + 1) & mask;
+			}
+			this->slots[j] = static_cast< unsigned >(i + 1);
+		}
+
+		/** Rebuilds the lookup table with a given number of slots. */
+		void rehash(size_t slotCount) {
+			this->slots.assign(slotCount, 0);
+			for (size_t i = 0; i < this->strings.size(); ++i) {
+				this->place(i);
+			}
+		}
+	};
+
+}
+
+#endif
@@ -0,0 +1,249 @@
+#ifndef _OPTPARSE_OPTPARSE_STRING_VIEW_H
+#define _OPTPARSE_OPTPARSE_STRING_VIEW_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace optparse {
+
+	/**
+	 * Non-owning reference to a sequence of characters.
+	 *
+	 * A minimal substitute for `std::basic_string_view`, which is not
+	 * available in C++11.
+	 * A `StringView` never allocates memory and never copies characters.
+	 * The referenced characters must outlive the view.
+	 * The referenced sequence does not have to be terminated with a null
+	 * character.
+	 *
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename Ch >
+	class StringView {
+	public:
+		/** String of `Ch`. */
+		typedef std::basic_string< Ch > String;
+
+		/** Character traits of `Ch`. */
+		typedef std::char_traits< Ch > Traits;
+
+		/** Iterator over characters. */
+		typedef const Ch* const_iterator;
+
+		/** Special value which means "until the end". */
+		static const size_t npos = static_cast< size_t >(-1);
+	private:
+		/** Pointer to the first character. */
+		const Ch* ptr;
+
+		/** Number of characters. */
+		size_t len;
+	public:
+		/** Initializes an empty view. */
+		inline StringView() : ptr(0), len(0) {}
+
+		/**
+		 * Initializes a view of a given null-terminated string.
+		 *
+		 * @param str
+		 *     Null-terminated string to be referenced.
+		 */
+		inline StringView(const Ch* str)
+			: ptr(str), len(Traits::length(str)) {}
+
+		/**
+		 * Initializes a view of a given character sequence.
+		 *
+		 * @param str
+		 *     Pointer to the first character to be referenced.
+		 * @param len
+		 *     Number of the characters to be referenced.
+		 */
+		inline StringView(const Ch* str, size_t len) : ptr(str), len(len) {}
+
+		/**
+		 * Initializes a view of a given string.
+		 *
+		 * The view becomes invalid when `str` is modified or destroyed.
+		 *
+		 * @param str
+		 *     String to be referenced.
+		 */
+		inline StringView(const String& str)
+			: ptr(str.data()), len(str.size()) {}
+
+		/**
+		 * Returns the pointer to the first character.
+		 *
+		 * @return
+		 *     Pointer to the first character.
+		 *     Not necessarily followed by a null character.
+		 */
+		inline const Ch* data() const {
+			return this->ptr;
+		}
+
+		/**
+		 * Returns the number of the characters.
+		 *
+		 * @return
+		 *     Number of the characters.
+		 */
+		inline size_t size() const {
+			return this->len;
+		}
+
+		/**
+		 * Returns whether this view is empty.
+		 *
+		 * @return
+		 *     Whether this view is empty.
+		 */
+		inline bool empty() const {
+			return this->len == 0;
+		}
+
+		/** Returns the iterator at the first character. */
+		inline const_iterator begin() const {
+			return this->ptr;
+		}
+
+		/** Returns the iterator after the last character. */
+		inline const_iterator end() const {
+			return this->ptr + this->len;
+		}
+
+		/**
+		 * Returns the character at a given index.
+		 *
+		 * Undefined if `i >= this->size()`.
+		 *
+		 * @param i
+		 *     Index of the character to be obtained.
+		 * @return
+		 *     Character at `i`.
+		 */
+		inline Ch operator [](size_t i) const {
+			return this->ptr[i];
+		}
+
+		/**
+		 * Returns a part of this view.
+		 *
+		 * Undefined if `pos > this->size()`.
+		 *
+		 * @param pos
+		 *     Index of the first character of the part.
+		 * @param n
+		 *     Maximum number of the characters in the part.
+		 *     Until the end by default.
+		 * @return
+		 *     View of the part.
+		 */
+		inline StringView substr(size_t pos, size_t n = npos) const {
+			const size_t rest = this->len - pos;
+			return StringView(this->ptr + pos, n < rest ? n : rest);
+		}
+
+		/**
+		 * Finds the first occurrence of a given character.
+		 *
+		 * @param ch
+		 *     Character to be searched.
+		 * @param pos
+		 *     Index where searching starts.
+		 * @return
+		 *     Index of the first occurrence of `ch`.
+		 *     `npos` if `ch` is not found.
+		 */
+		inline size_t find(Ch ch, size_t pos = 0) const {
+			for (size_t i = pos; i < this->len; ++i) {
+				if (Traits::eq(this->ptr[i], ch)) {
+					return i;
+				}
+			}
+			return npos;
+		}
+
+		/**
+		 * Returns whether this view starts with a given prefix.
+		 *
+		 * @param prefix
+		 *     Prefix to be tested.
+		 * @return
+		 *     Whether this view starts with `prefix`.
+		 */
+		inline bool startsWith(const StringView& prefix) const {
+			return prefix.len <= this->len
+				&& Traits::compare(this->ptr, prefix.ptr, prefix.len) == 0;
+		}
+
+		/**
+		 * Compares this view with another view lexicographically.
+		 *
+		 * @param other
+		 *     View to be compared with.
+		 * @return
+		 *     Negative if this view is less than `other`,
+		 *     0 if this view is equal to `other`,
+		 *     or positive if this view is greater than `other`.
+		 */
+		inline int compare(const StringView& other) const {
+			const size_t n = this->len < other.len ? this->len : other.len;
+			const int c = n > 0 ? Traits::compare(this->ptr, other.ptr, n) : 0;
+			if (c != 0) {
+				return c;
+			}
+			return this->len < other.len ? -1 : (this->len > other.len ? 1 : 0);
+		}
+
+		/**
+		 * Copies the referenced characters into a new string.
+		 *
+		 * @return
+		 *     String equivalent to this view.
+		 */
+		inline String str() const {
+			return String(this->ptr, this->len);
+		}
+
+		/** Returns whether two views are equal. */
+		friend inline bool operator ==(const StringView& lhs,
+									   const StringView& rhs)
+		{
+			return lhs.len == rhs.len
+				&& (lhs.len == 0
+					|| Traits::compare(lhs.ptr, rhs.ptr, lhs.len) == 0);
+		}
+
+		/** Returns whether two views are different. */
+		friend inline bool operator !=(const StringView& lhs,
+									   const StringView& rhs)
+		{
+			return !(lhs == rhs);
+		}
+
+		/** Returns whether a view is less than another view. */
+		friend inline bool operator <(const StringView& lhs,
+									  const StringView& rhs)
+		{
+			return lhs.compare(rhs) < 0;
+		}
+
+		/** Writes the referenced characters to a given stream. */
+		friend inline std::basic_ostream< Ch >& operator <<(
+			std::basic_ostream< Ch >& out, const StringView& view)
+		{
+			return out.write(
+				view.ptr, static_cast< std::streamsize >(view.len));
+		}
+	};
+
+	template < typename Ch >
+	const size_t StringView< Ch >::npos;
+
+}
+
+#endif
@@ -0,0 +1,293 @@
+#ifndef _OPTPARSE_OPTPARSE_SUGGESTION_INDEX_H
+#define _OPTPARSE_OPTPARSE_SUGGESTION_INDEX_H
+
+#include "optparse/StringView.h"
+
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace optparse {
+
+	/**
+	 * Immutable index which finds the labels similar to a given label.
+	 *
+	 * Each label is indexed by its distinct bigrams; i.e., pairs of
+	 * adjacent characters.
+	 * A single edit destroys at most two bigrams, so a label within
+	 * the Levenshtein distance `k` shares all but `2 * k` of its bigrams
+	 * with the searched label.
+	 * `find` counts the shared bigrams through the inverted lists of
+	 * the bigrams of the searched label, and measures the distance only to
+	 * the labels which pass this count and the difference of lengths.
+	 *
+	 * As in `LabelTable`, all of the labels are copied into a single
+	 * contiguous pool, and the inverted lists are stored in a single
+	 * contiguous array.
+	 * An index is built at once by `build` and never changes afterward,
+	 * so concurrent searches are safe.
+	 *
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename Ch >
+	class SuggestionIndex {
+	public:
+		/** String of `Ch`. */
+		typedef std::basic_string< Ch > String;
+
+		/** View of a string of `Ch`. */
+		typedef optparse::StringView< Ch > StringView;
+
+		/** Pair of a label and a value. */
+		typedef std::pair< StringView, int > Entry;
+
+		/** Pair of a distance and a value found by `find`. */
+		typedef std::pair< size_t, int > Match;
+	private:
+		/** Pair of adjacent characters packed into an integer. */
+		typedef unsigned long long Bigram;
+
+		/** Label in the index. */
+		struct Label {
+			/** Offset of the label in the pool. */
+			size_t offset;
+
+			/** Length of the label. */
+			size_t size;
+
+			/** Value associated with the label. */
+			int value;
+
+			/** Number of the distinct bigrams of the label. */
+			size_t bigramCount;
+		};
+
+		/** Pool of the labels. */
+		String pool;
+
+		/** Labels. */
+		std::vector< Label > labels;
+
+		/** Distinct bigrams of all of the labels in ascending order. */
+		std::vector< Bigram > bigrams;
+
+		/**
+		 * Offsets of the inverted lists in `postings`.
+		 *
+		 * The list of `bigrams[i]` is [`offsets[i]`, `offsets[i + 1]`).
+		 */
+		std::vector< size_t > offsets;
+
+		/** Indices of the labels which have each bigram. */
+		std::vector< int > postings;
+	public:
+		/**
+		 * Builds this index from given entries.
+		 *
+		 * Previous contents of this index are discarded.
+		 * Labels must be unique.
+		 * The views in `entries` are not referenced after this call.
+		 *
+		 * @param entries
+		 *     Pairs of a label and a value.
+		 */
+		void build(const std::vector< Entry >& entries) {
+			this->clear();
+			size_t poolSize = 0;
+			for (size_t i = 0; i < entries.size(); ++i) {
+				poolSize += entries[i].first.size();
+			}
+			this->pool.reserve(poolSize);
+			this->labels.reserve(entries.size());
+			// collects pairs of a bigram and a label
+			std::vector< std::pair< Bigram, int > > pairs;
+			std::vector< Bigram > distinct;
+			for (size_t i = 0; i < entries.size(); ++i) {
+				const StringView& label = entries[i].first;
+				getBigrams(label, distinct);
+				const Label entry = {
+					this->pool.size(), label.size(), entries[i].second,
+					distinct.size()
+				};
+				this->pool.append(label.data(), label.size());
+				this->labels.push_back(entry);
+				for (size_t j = 0; j < distinct.size(); ++j) {
+					pairs.push_back(std::make_pair(
+						distinct[j], static_cast< int >(i)));
+				}
+			}
+			// groups the labels by the bigrams
+			std::sort(pairs.begin(), pairs.end());
+			this->postings.reserve(pairs.size());
+			for (size_t i = 0; i < pairs.size(); ++i) {
+				if (i == 0 || pairs[i].first != pairs[i - 1].first) {
+					this->bigrams.push_back(pairs[i].first);
+					this->offsets.push_back(i);
+				}
+				this->postings.push_back(pairs[i].second);
+			}
+			this->offsets.push_back(pairs.size());
+		}
+
+		/** Removes all of the entries. */
+		void clear() {
+			this->pool.clear();
+			this->labels.clear();
+			this->bigrams.clear();
+			this->offsets.clear();
+			this->postings.clear();
+		}
+
+		/** Returns the number of the entries. */
+		inline size_t size() const {
+			return this->labels.size();
+		}
+
+		/** Returns whether this index has no entries. */
+		inline bool empty() const {
+			return this->labels.empty();
+		}
+
+		/**
+		 * Finds the labels within a given distance from a given label.
+		 *
+		 * @param label
+		 *     Label to be searched.
+		 * @param maxDistance
+		 *     Maximum Levenshtein distance of a label to be found.
+		 * @param[out] matches
+		 *     Appended with pairs of the distance and the value of each
+		 *     label found, in the ascending order of the distance and then
+		 *     the value.
+		 */
+		void find(const StringView& label,
+				  size_t maxDistance,
+				  std::vector< Match >& matches) const
+		{
+			if (this->labels.empty()) {
+				return;
+			}
+			// counts the bigrams which each label shares with `label`
+			std::vector< Bigram > distinct;
+			getBigrams(label, distinct);
+			std::vector< size_t > counts(this->labels.size(), 0);
+			for (size_t i = 0; i < distinct.size(); ++i) {
+				const typename std::vector< Bigram >::const_iterator found =
+					std::lower_bound(
+						this->bigrams.begin(), this->bigrams.end(),
+						distinct[i]);
+				if (found == this->bigrams.end() || *found != distinct[i]) {
+					continue;
+				}
+				const size_t bigramI = found - this->bigrams.begin();
+				for (size_t j = this->offsets[bigramI];
+					 j < this->offsets[bigramI + 1];
+					 ++j)
+				{
+					++counts[this->postings[j]];
+				}
+			}
+			const size_t first = matches.size();
+			const size_t lost = 2 * maxDistance;
+			std::vector< size_t > row;
+			for (size_t i = 0; i < this->labels.size(); ++i) {
+				const Label& entry = this->labels[i];
+				// at most `lost` bigrams of either label are not shared
+				if (counts[i] + lost < distinct.size()
+					|| counts[i] + lost < entry.bigramCount)
+				{
+					continue;
+				}
+				const size_t difference = entry.size > label.size()
+					? entry.size - label.size() : label.size() - entry.size;
+				if (difference > maxDistance) {
+					continue;
+				}
+				const size_t d = distance(this->getLabel(entry), label, row);
+				if (d <= maxDistance) {
+					matches.push_back(Match(d, entry.value));
+				}
+			}
+			std::sort(matches.begin() + first, matches.end());
+		}
+
+		/**
+		 * Computes the Levenshtein distance between given strings.
+		 *
+		 * @param a
+		 *     First string.
+		 * @param b
+		 *     Second string.
+		 * @param row
+		 *     Buffer reused between calls to avoid allocations.
+		 * @return
+		 *     Minimum number of insertions, deletions and substitutions of
+		 *     characters which turn `a` into `b`.
+		 */
+		static size_t distance(const StringView& a,
+							   const StringView& b,
+							   std::vector< size_t >& row)
+		{
+			// a common prefix and suffix never changes the distance
+			// labels usually share at least dashes
+			size_t first = 0;
+			size_t aLast = a.size();
+			size_t bLast = b.size();
+			while (first < aLast && first < bLast && a[first] == b[first]) {
+				++first;
+			}
+			while (aLast > first && bLast > first
+				   && a[aLast - 1] == b[bLast - 1])
+			{
+				--aLast;
+				--bLast;
+			}
+			const size_t bSize = bLast - first;
+			row.resize(bSize + 1);
+			for (size_t j = 0; j <= bSize; ++j) {
+				row[j] = j;
+			}
+			for (size_t i = first; i < aLast; ++i) {
+				size_t diagonal = row[0];
+				row[0] = i - first + 1;
+				for (size_t j = 0; j < bSize; ++j) {
+					const size_t above = row[j + 1];
+					const size_t substitution =
+						diagonal + (a[i] == b[first + j] ? 0 : 1);
+					row[j + 1] = std::min(
+						substitution, std::min(above, row[j]) + 1);
+					diagonal = above;
+				}
+			}
+			return row[bSize];
+		}
+	private:
+		/** Returns the label of a given entry. */
+		inline StringView getLabel(const Label& entry) const {
+			return StringView(this->pool.data() + entry.offset, entry.size);
+		}
+
+		/** Collects the distinct bigrams of a given label. */
+		static void getBigrams(const StringView& label,
+							   std::vector< Bigram >& distinct)
+		{
+			typedef typename std::make_unsigned< Ch >::type Unsigned;
+			distinct.clear();
+			for (size_t i = 1; i < label.size(); ++i) {
+				distinct.push_back(
+					(static_cast< Bigram >(
+						static_cast< Unsigned >(label[i - 1])) << 32)
+					| static_cast< Unsigned >(label[i]));
+			}
+			std::sort(distinct.begin(), distinct.end());
+			distinct.erase(std::unique(distinct.begin(), distinct.end()),
+						   distinct.end());
+		}
+	};
+
+}
+
+#endif
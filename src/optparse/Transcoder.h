@@ -0,0 +1,180 @@
+#ifndef _OPTPARSE_OPTPARSE_TRANSCODER_H
+#define _OPTPARSE_OPTPARSE_TRANSCODER_H
+
+#include <cstddef>
+
+namespace optparse {
+
+	/**
+	 * Transcoder of strings of `From` into strings of `To`.
+	 *
+	 * A `char` string is in UTF-8.
+	 * A `wchar_t` string is in UTF-16 if `wchar_t` has 16 bits as on
+	 * Windows, or in UTF-32 otherwise.
+	 * An invalid sequence becomes U+FFFD (replacement character).
+	 *
+	 * A specialization has the following functions,
+	 *  - `static size_t getMaxSize(size_t size)`: returns the maximum number
+	 *    of `To` units transcoded from `size` units of `From`.
+	 *  - `static size_t transcode(const From* first, const From* last,
+	 *    To* out)`: writes the units transcoded from [`first`, `last`) to
+	 *    `out` which has at least `getMaxSize(last - first)` units, and
+	 *    returns the number of the units written.
+	 *    Never allocates memory.
+	 *
+	 * Must be specialized.
+	 *
+	 * @tparam From
+	 *     Type which represents a character of an input.
+	 * @tparam To
+	 *     Type which represents a character of an output.
+	 */
+	template < typename From, typename To >
+	class Transcoder;
+
+	/** Specialization of `Transcoder` from UTF-8 into `wchar_t`. */
+	template <>
+	class Transcoder< char, wchar_t > {
+	public:
+		/**
+		 * Returns the maximum number of `wchar_t` units transcoded from
+		 * a given number of bytes.
+		 *
+		 * A code point never needs more units than bytes.
+		 */
+		static inline size_t getMaxSize(size_t size) {
+			return size;
+		}
+
+		/** Transcodes a given UTF-8 string. See `Transcoder`. */
+		static size_t transcode(const char* first,
+								const char* last,
+								wchar_t* out)
+		{
+			wchar_t* const start = out;
+			while (first != last) {
+				const unsigned char lead = static_cast< unsigned char >(*first);
+				if (lead < 0x80) {
+					// ASCII needs no decoding
+					*out++ = static_cast< wchar_t >(lead);
+					++first;
+					continue;
+				}
+				size_t size;
+				unsigned long cp;
+				unsigned long min;
+				if (lead >= 0xC2 && lead <= 0xDF) {
+					size = 2;
+					cp = lead & 0x1F;
+					min = 0x80;
+				} else if (lead >= 0xE0 && lead <= 0xEF) {
+					size = 3;
+					cp = lead & 0x0F;
+					min = 0x800;
+				} else if (lead >= 0xF0 && lead <= 0xF4) {
+					size = 4;
+					cp = lead & 0x07;
+					min = 0x10000;
+				} else {
+					size = 0;
+					cp = 0;
+					min = 0;
+				}
+				size_t i = 1;
+				while (i < size && first + i != last && isTrail(first[i])) {
+					cp = (cp << 6)
+						| (static_cast< unsigned char >(first[i]) & 0x3F);
+					++i;
+				}
+				if (size == 0
+					|| i < size
+					|| cp < min
+					|| cp > 0x10FFFF
+					|| (cp >= 0xD800 && cp <= 0xDFFF))
+				{
+					// skips only the lead byte of an invalid sequence
+					*out++ = static_cast< wchar_t >(0xFFFD);
+					++first;
+					continue;
+				}
+				first += size;
+				if (sizeof(wchar_t) == 2 && cp >= 0x10000) {
+					// surrogate pair
+					cp -= 0x10000;
+					*out++ = static_cast< wchar_t >(0xD800 + (cp >> 10));
+					*out++ = static_cast< wchar_t >(0xDC00 + (cp & 0x3FF));
+				} else {
+					*out++ = static_cast< wchar_t >(cp);
+				}
+			}
+			return out - start;
+		}
+	private:
+		/** Returns whether a given byte continues a sequence. */
+		static inline bool isTrail(char ch) {
+			return (static_cast< unsigned char >(ch) & 0xC0) == 0x80;
+		}
+	};
+
+	/** Specialization of `Transcoder` from `wchar_t` into UTF-8. */
+	template <>
+	class Transcoder< wchar_t, char > {
+	public:
+		/**
+		 * Returns the maximum number of bytes transcoded from a given
+		 * number of `wchar_t` units.
+		 *
+		 * A UTF-16 unit needs at most 3 bytes, and a UTF-32 unit at most
+		 * 4 bytes.
+		 */
+		static inline size_t getMaxSize(size_t size) {
+			return size * (sizeof(wchar_t) == 2 ? 3 : 4);
+		}
+
+		/** Transcodes a given `wchar_t` string. See `Transcoder`. */
+		static size_t transcode(const wchar_t* first,
+								const wchar_t* last,
+								char* out)
+		{
+			char* const start = out;
+			while (first != last) {
+				unsigned long cp = static_cast< unsigned long >(*first++);
+				if (cp < 0x80) {
+					// ASCII needs no encoding
+					*out++ = static_cast< char >(cp);
+					continue;
+				}
+				if (sizeof(wchar_t) == 2) {
+					cp &= 0xFFFF;
+					if (cp >= 0xD800 && cp <= 0xDBFF && first != last) {
+						const unsigned long low =
+							static_cast< unsigned long >(*first) & 0xFFFF;
+						if (low >= 0xDC00 && low <= 0xDFFF) {
+							cp = 0x10000 + ((cp - 0xD800) << 10)
+								+ (low - 0xDC00);
+							++first;
+						}
+					}
+				}
+				if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+					cp = 0xFFFD;
+				}
+				if (cp < 0x800) {
+					*out++ = static_cast< char >(0xC0 | (cp >> 6));
+				} else if (cp < 0x10000) {
+					*out++ = static_cast< char >(0xE0 | (cp >> 12));
+					*out++ = static_cast< char >(0x80 | ((cp >> 6) & 0x3F));
+				} else {
+					*out++ = static_cast< char >(0xF0 | (cp >> 18));
+					*out++ = static_cast< char >(0x80 | ((cp >> 12) & 0x3F));
+					*out++ = static_cast< char >(0x80 | ((cp >> 6) & 0x3F));
+				}
+				*out++ = static_cast< char >(0x80 | (cp & 0x3F));
+			}
+			return out - start;
+		}
+	};
+
+}
+
+#endif
@@ -0,0 +1,651 @@
+#ifndef _OPTPARSE_OPTPARSE_UNIT_FORMATTER_H
+#define _OPTPARSE_OPTPARSE_UNIT_FORMATTER_H
+
+#include "optparse/OptionParserException.h"
+#include "optparse/StringView.h"
+
+#include <chrono>
+#include <limits>
+#include <type_traits>
+
+namespace optparse {
+
+	/**
+	 * Number of bytes.
+	 *
+	 * `DefaultFormatter` converts a string like "4KiB" into this type.
+	 */
+	class ByteSize {
+	private:
+		/** Number of bytes. */
+		unsigned long long bytes;
+	public:
+		/** Initializes with zero bytes. */
+		inline ByteSize() : bytes(0) {}
+
+		/** Initializes with a given number of bytes. */
+		inline explicit ByteSize(unsigned long long bytes) : bytes(bytes) {}
+
+		/** Returns the number of bytes. */
+		inline unsigned long long getBytes() const {
+			return this->bytes;
+		}
+
+		/** Returns whether this size equals to a given size. */
+		inline bool operator ==(const ByteSize& rhs) const {
+			return this->bytes == rhs.bytes;
+		}
+
+		/** Returns whether this size differs from a given size. */
+		inline bool operator !=(const ByteSize& rhs) const {
+			return this->bytes != rhs.bytes;
+		}
+	};
+
+	/** Helper utilities for `DurationFormatter` and `ByteSizeFormatter`. */
+	class UnitFormatterHelper {
+	public:
+		/** Decimal number `digits * 10^-scale`. */
+		struct Decimal {
+			/** Digits without the decimal point. */
+			unsigned long long digits;
+
+			/** Number of the digits after the decimal point. */
+			unsigned scale;
+
+			/** Whether the number is negative. */
+			bool negative;
+		};
+
+		/** Ratio of a unit. */
+		struct Ratio {
+			/** Numerator. */
+			unsigned long long num;
+
+			/** Denominator. */
+			unsigned long long den;
+		};
+
+		/**
+		 * Reads a decimal number at the beginning of a given string.
+		 *
+		 * Accepts an optional sign, one or more digits and optional
+		 * fraction digits after a decimal point.
+		 * Never allocates memory.
+		 *
+		 * @param[in,out] p
+		 *     Beginning of the string.
+		 *     Set to the end of the number if succeeded.
+		 * @param end
+		 *     End of the string.
+		 * @param[out] number
+		 *     Set to the number if succeeded.
+		 * @param[out] message
+		 *     Set to a brief explanation if failed.
+		 * @return
+		 *     Whether a number is read.
+		 */
+		template < typename Ch >
+		static bool tryReadDecimal(const Ch*& p,
+								   const Ch* end,
+								   Decimal& number,
+								   const char*& message)
+		{
+			const unsigned long long MAX =
+				std::numeric_limits< unsigned long long >::max();
+			const Ch* q = p;
+			Decimal x = { 0, 0, false };
+			if (q != end && (*q == Ch('+') || *q == Ch('-'))) {
+				x.negative = *q == Ch('-');
+				++q;
+			}
+			const Ch* const first = q;
+			bool fraction = false;
+			for (; q != end; ++q) {
+				if (*q == Ch('.') && !fraction && q != first) {
+					fraction = true;
+					continue;
+				}
+				const unsigned d = static_cast< unsigned >(*q - Ch('0'));
+				if (d >= 10) {
+					break;
+				}
+				if (x.digits > (MAX - d) / 10U) {
+					message = "out of range";
+					return false;
+				}
+				x.digits = x.digits * 10U + d;
+				if (fraction) {
+					++x.scale;
+				}
+			}
+			if (q == first || (fraction && (x.scale == 0))) {
+				message = "invalid number";
+				return false;
+			}
+			number = x;
+			p = q;
+			return true;
+		}
+
+		/**
+		 * Computes `number * ratio` which must be an integer.
+		 *
+		 * Never allocates memory.
+		 *
+		 * @param number
+		 *     Number to be scaled. The sign is ignored.
+		 * @param ratio
+		 *     Ratio by which `number` is multiplied.
+		 * @param[out] value
+		 *     Set to the magnitude of the product if succeeded.
+		 * @param[out] message
+		 *     Set to a brief explanation if failed.
+		 * @return
+		 *     Whether the product is an integer representable by
+		 *     `unsigned long long`.
+		 */
+		static bool tryScale(const Decimal& number,
+							 Ratio ratio,
+							 unsigned long long& value,
+							 const char*& message)
+		{
+			unsigned long long digits = number.digits;
+			if (digits == 0) {
+				value = 0;
+				return true;
+			}
+			// divides by 10^scale, absorbing the prime factors 2 and 5
+			// into the numerators wherever possible; a factor which
+			// neither numerator absorbs never becomes absorbable
+			bool inexact = false;
+			for (unsigned i = 0; i < number.scale && !inexact; ++i) {
+				inexact = !divide(digits, ratio, 2)
+					|| !divide(digits, ratio, 5);
+			}
+			if (!inexact) {
+				unsigned long long g = gcd(digits, ratio.den);
+				digits /= g;
+				ratio.den /= g;
+				g = gcd(ratio.num, ratio.den);
+				ratio.num /= g;
+				ratio.den /= g;
+				inexact = ratio.den != 1;
+			}
+			if (inexact) {
+				message = "inexact value";
+				return false;
+			}
+			if (!multiply(digits, ratio.num, value)) {
+				message = "out of range";
+				return false;
+			}
+			return true;
+		}
+
+		/**
+		 * Computes `number * ratio` as a floating point number.
+		 *
+		 * @param number
+		 *     Number to be scaled.
+		 * @param ratio
+		 *     Ratio by which `number` is multiplied.
+		 * @return
+		 *     Product including the sign of `number`.
+		 */
+		static long double scaleFloat(const Decimal& number,
+									  const Ratio& ratio)
+		{
+			long double x = static_cast< long double >(number.digits);
+			for (unsigned i = 0; i < number.scale; ++i) {
+				x /= 10;
+			}
+			x = x * static_cast< long double >(ratio.num)
+				/ static_cast< long double >(ratio.den);
+			return number.negative ? -x : x;
+		}
+
+		/**
+		 * Returns `unit / period` where each of them is a ratio to
+		 * a second.
+		 *
+		 * @param[out] ratio
+		 *     Set to the reduced ratio if succeeded.
+		 * @return
+		 *     Whether the ratio is representable.
+		 */
+		static bool divideRatio(const Ratio& unit,
+								const Ratio& period,
+								Ratio& ratio)
+		{
+			const unsigned long long a = gcd(unit.num, period.num);
+			const unsigned long long b = gcd(unit.den, period.den);
+			return multiply(unit.num / a, period.den / b, ratio.num)
+				&& multiply(unit.den / b, period.num / a, ratio.den);
+		}
+
+		/**
+		 * Converts a magnitude and a sign into a value of an integer type
+		 * `I`.
+		 *
+		 * @param magnitude
+		 *     Magnitude of the value.
+		 * @param negative
+		 *     Whether the value is negative.
+		 * @param[out] value
+		 *     Set to the value if succeeded.
+		 * @return
+		 *     Whether the value is representable by `I`.
+		 */
+		template < typename I >
+		static bool tryToInteger(unsigned long long magnitude,
+								 bool negative,
+								 I& value)
+		{
+			typedef typename std::make_unsigned< I >::type U;
+			const U max = static_cast< U >(std::numeric_limits< I >::max());
+			if (magnitude == 0) {
+				value = 0;
+				return true;
+			}
+			if (!negative) {
+				if (magnitude > max) {
+					return false;
+				}
+				value = static_cast< I >(magnitude);
+				return true;
+			}
+			if (!std::is_signed< I >::value || magnitude - 1 > max) {
+				return false;
+			}
+			value = -static_cast< I >(magnitude - 1) - 1;
+			return true;
+		}
+	private:
+		/** Returns the greatest common divisor of given numbers. */
+		static unsigned long long gcd(unsigned long long a,
+									  unsigned long long b)
+		{
+			while (b != 0) {
+				const unsigned long long r = a % b;
+				a = b;
+				b = r;
+			}
+			return a;
+		}
+
+		/** Multiplies given numbers unless the product overflows. */
+		static inline bool multiply(unsigned long long a,
+									unsigned long long b,
+									unsigned long long& product)
+		{
+			const unsigned long long MAX =
+				std::numeric_limits< unsigned long long >::max();
+			if (b != 0 && a > MAX / b) {
+				return false;
+			}
+			product = a * b;
+			return true;
+		}
+
+		/**
+		 * Divides `digits * ratio` by a prime `f`.
+		 *
+		 * @return
+		 *     `false` if the denominator overflows.
+		 */
+		static inline bool divide(unsigned long long& digits,
+								  Ratio& ratio,
+								  unsigned f)
+		{
+			if (digits % f == 0) {
+				digits /= f;
+			} else if (ratio.num % f == 0) {
+				ratio.num /= f;
+			} else {
+				return multiply(ratio.den, f, ratio.den);
+			}
+			return true;
+		}
+	};
+
+	/**
+	 * Value formatter which converts a string like "10ms" into
+	 * `std::chrono::duration< Rep, Period >`.
+	 *
+	 * A string is a decimal number followed by one of the following units,
+	 *  - "ns": nanoseconds
+	 *  - "us": microseconds
+	 *  - "ms": milliseconds
+	 *  - "s": seconds
+	 *  - "m" or "min": minutes
+	 *  - "h": hours
+	 *  - "d": days
+	 *
+	 * A number without a unit is the count of `Period`.
+	 * If `Rep` is an integer, the duration must be a whole multiple of
+	 * `Period`; e.g., "1.5s" is valid for milliseconds but not for seconds.
+	 * Never allocates memory unless the string is invalid.
+	 *
+	 * `DefaultFormatter` uses this formatter for a duration.
+	 *
+	 * @tparam Rep
+	 *     Type of the count of the duration.
+	 * @tparam Period
+	 *     `std::ratio` of the tick to a second.
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename Rep, typename Period, typename Ch >
+	class DurationFormatter {
+	public:
+		/** Type of the duration. */
+		typedef std::chrono::duration< Rep, Period > Duration;
+	private:
+		/** Ratio. */
+		typedef UnitFormatterHelper::Ratio Ratio;
+	public:
+		/**
+		 * Converts a given string into a duration.
+		 *
+		 * @param valueStr
+		 *     String to be converted.
+		 * @return
+		 *     Duration equivalent to `valueStr`.
+		 * @throws BadValue< Ch >
+		 *     If `valueStr` is invalid.
+		 */
+		Duration operator ()(const StringView< Ch >& valueStr) const {
+			Duration value = Duration();
+			const char* message = "";
+			if (!this->tryFormat(valueStr, value, message)) {
+				OPTPARSE_THROW(BadValue< Ch >(message, valueStr.str()));
+			}
+			return value;
+		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * @param valueStr
+		 *     String to be converted.
+		 * @param[out] value
+		 *     Set to the duration equivalent to `valueStr` if succeeded.
+		 * @param[out] message
+		 *     Set to a brief explanation if failed.
+		 * @return
+		 *     Whether `valueStr` is a valid duration.
+		 */
+		bool tryFormat(const StringView< Ch >& valueStr,
+					   Duration& value,
+					   const char*& message) const
+		{
+			const Ch* p = valueStr.begin();
+			const Ch* const end = valueStr.end();
+			UnitFormatterHelper::Decimal number;
+			if (!UnitFormatterHelper::tryReadDecimal(p, end, number, message))
+			{
+				return false;
+			}
+			Ratio unit;
+			if (!getUnit(StringView< Ch >(p, end - p), unit)) {
+				message = "unknown unit";
+				return false;
+			}
+			const Ratio PERIOD = { Period::num, Period::den };
+			Ratio ratio;
+			if (p == end) {
+				ratio.num = 1;
+				ratio.den = 1;
+			} else if (!UnitFormatterHelper::divideRatio(unit, PERIOD, ratio)) {
+				message = "out of range";
+				return false;
+			}
+			return convert(number, ratio, value, message,
+						   std::is_floating_point< Rep >());
+		}
+	private:
+		/**
+		 * Obtains the ratio of a given unit to a second.
+		 *
+		 * @return
+		 *     Whether `unit` is known. `true` for an empty unit.
+		 */
+		static bool getUnit(const StringView< Ch >& unit, Ratio& ratio) {
+			ratio.num = 1;
+			ratio.den = 1;
+			switch (unit.size()) {
+			case 0:
+				return true;
+			case 1:
+				switch (unit[0]) {
+				case Ch('s'):
+					return true;
+				case Ch('m'):
+					ratio.num = 60;
+					return true;
+				case Ch('h'):
+					ratio.num = 3600;
+					return true;
+				case Ch('d'):
+					ratio.num = 86400;
+					return true;
+				}
+				return false;
+			case 2:
+				if (unit[1] != Ch('s')) {
+					return false;
+				}
+				switch (unit[0]) {
+				case Ch('n'):
+					ratio.den = 1000000000;
+					return true;
+				case Ch('u'):
+					ratio.den = 1000000;
+					return true;
+				case Ch('m'):
+					ratio.den = 1000;
+					return true;
+				}
+				return false;
+			case 3:
+				ratio.num = 60;
+				return unit[0] == Ch('m')
+					&& unit[1] == Ch('i')
+					&& unit[2] == Ch('n');
+			}
+			return false;
+		}
+
+		/** Converts into an integral count. */
+		static bool convert(const UnitFormatterHelper::Decimal& number,
+							const Ratio& ratio,
+							Duration& value,
+							const char*& message,
+							std::false_type)
+		{
+			unsigned long long magnitude;
+			if (!UnitFormatterHelper::tryScale(
+					number, ratio, magnitude, message))
+			{
+				return false;
+			}
+			Rep count;
+			if (!UnitFormatterHelper::tryToInteger(
+					magnitude, number.negative, count))
+			{
+				message = "out of range";
+				return false;
+			}
+			value = Duration(count);
+			return true;
+		}
+
+		/** Converts into a floating point count. */
+		static bool convert(const UnitFormatterHelper::Decimal& number,
+							const Ratio& ratio,
+							Duration& value,
+							const char*&,
+							std::true_type)
+		{
+			value = Duration(static_cast< Rep >(
+				UnitFormatterHelper::scaleFloat(number, ratio)));
+			return true;
+		}
+	};
+
+	/**
+	 * Value formatter which converts a string like "4KiB" into `ByteSize`.
+	 *
+	 * A string is a non-negative decimal number followed by one of the
+	 * following units,
+	 *  - none or "B": bytes
+	 *  - "KiB", "MiB", "GiB", "TiB", "PiB" or "EiB": powers of 1024
+	 *  - "K", "M", "G", "T", "P" or "E": same as above
+	 *  - "KB", "MB", "GB", "TB", "PB" or "EB": powers of 1000
+	 *
+	 * "k" is also accepted as "K".
+	 * The size must be a whole number of bytes; e.g., "1.5KiB" is valid
+	 * but "1.5B" is not.
+	 * Never allocates memory unless the string is invalid.
+	 *
+	 * `DefaultFormatter` uses this formatter for `ByteSize`.
+	 *
+	 * @tparam Ch
+	 *     Type which represents a character.
+	 */
+	template < typename Ch >
+	class ByteSizeFormatter {
+	private:
+		/** Ratio. */
+		typedef UnitFormatterHelper::Ratio Ratio;
+	public:
+		/**
+		 * Converts a given string into a number of bytes.
+		 *
+		 * @param valueStr
+		 *     String to be converted.
+		 * @return
+		 *     Number of bytes equivalent to `valueStr`.
+		 * @throws BadValue< Ch >
+		 *     If `valueStr` is invalid.
+		 */
+		ByteSize operator ()(const StringView< Ch >& valueStr) const {
+			ByteSize value;
+			const char* message = "";
+			if (!this->tryFormat(valueStr, value, message)) {
+				OPTPARSE_THROW(BadValue< Ch >(message, valueStr.str()));
+			}
+			return value;
+		}
+
+		/**
+		 * Non-throwing version of the function call operator.
+		 *
+		 * @param valueStr
+		 *     String to be converted.
+		 * @param[out] value
+		 *     Set to the number of bytes equivalent to `valueStr` if
+		 *     succeeded.
+		 * @param[out] message
+		 *     Set to a brief explanation if failed.
+		 * @return
+		 *     Whether `valueStr` is a valid number of bytes.
+		 */
+		bool tryFormat(const StringView< Ch >& valueStr,
+					   ByteSize& value,
+					   const char*& message) const
+		{
+			const Ch* p = valueStr.begin();
+			const Ch* const end = valueStr.end();
+			UnitFormatterHelper::Decimal number;
+			if (!UnitFormatterHelper::tryReadDecimal(p, end, number, message))
+			{
+				return false;
+			}
+			if (number.negative) {
+				message = "out of range";
+				return false;
+			}
+			Ratio unit;
+			if (!getUnit(StringView< Ch >(p, end - p), unit)) {
+				message = "unknown unit";
+				return false;
+			}
+			unsigned long long bytes;
+			if (!UnitFormatterHelper::tryScale(number, unit, bytes, message)) {
+				return false;
+			}
+			value = ByteSize(bytes);
+			return true;
+		}
+	private:
+		/**
+		 * Obtains the ratio of a given unit to a byte.
+		 *
+		 * @return
+		 *     Whether `unit` is known.
+		 */
+		static bool getUnit(const StringView< Ch >& unit, Ratio& ratio) {
+			ratio.num = 1;
+			ratio.den = 1;
+			if (unit.empty()) {
+				return true;
+			}
+			if (unit.size() == 1 && unit[0] == Ch('B')) {
+				return true;
+			}
+			unsigned exponent;
+			switch (unit[0]) {
+			case Ch('k'):
+			case Ch('K'):
+				exponent = 1;
+				break;
+			case Ch('M'):
+				exponent = 2;
+				break;
+			case Ch('G'):
+				exponent = 3;
+				break;
+			case Ch('T'):
+				exponent = 4;
+				break;
+			case Ch('P'):
+				exponent = 5;
+				break;
+			case Ch('E'):
+				exponent = 6;
+				break;
+			default:
+				return false;
+			}
+			unsigned long long base;
+			switch (unit.size()) {
+			case 1:
+				base = 1024;
+				break;
+			case 2:
+				if (unit[1] != Ch('B')) {
+					return false;
+				}
+				base = 1000;
+				break;
+			case 3:
+				if (unit[1] != Ch('i') || unit[2] != Ch('B')) {
+					return false;
+				}
+				base = 1024;
+				break;
+			default:
+				return false;
+			}
+			for (unsigned i = 0; i < exponent; ++i) {
+				ratio.num *= base;
+			}
+			return true;
+		}
+	};
+
+}
+
+#endif
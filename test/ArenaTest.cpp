@@ -0,0 +1,55 @@
+#include "optparse/Arena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string>
+#include "gtest/gtest.h"
+
+TEST(ArenaTest, allocated_memory_should_be_aligned) {
+	optparse::Arena arena(64);
+	arena.allocate(1, 1);
+	void* p = arena.allocate(sizeof(double), alignof(double));
+	EXPECT_EQ(0U, reinterpret_cast< std::uintptr_t >(p) % alignof(double));
+	EXPECT_EQ(1U + sizeof(double), arena.getUsedBytes());
+}
+
+TEST(ArenaTest, arena_should_grow_beyond_initial_block) {
+	optparse::Arena arena(16);
+	char* p1 = static_cast< char* >(arena.allocate(10, 1));
+	char* p2 = static_cast< char* >(arena.allocate(100, 1));
+	std::fill(p1, p1 + 10, 'a');
+	std::fill(p2, p2 + 100, 'b');
+	EXPECT_EQ('a', p1[9]);
+	EXPECT_EQ('b', p2[0]);
+	EXPECT_EQ(110U, arena.getUsedBytes());
+	arena.release();
+	EXPECT_EQ(0U, arena.getUsedBytes());
+}
+
+TEST(ArenaTest, create_should_construct_object_in_arena) {
+	optparse::Arena arena;
+	std::string* p = arena.create< std::string >(3U, 'x');
+	EXPECT_EQ("xxx", *p);
+	optparse::ArenaDeleter< std::string >(true)(p);
+}
+
+TEST(ArenaTest, allocator_should_back_standard_container) {
+	optparse::Arena arena;
+	typedef optparse::ArenaAllocator< std::pair< const int, int > > Allocator;
+	const Allocator allocator(&arena);
+	std::map< int, int, std::less< int >, Allocator > map(
+		std::less< int >(), allocator);
+	for (int i = 0; i < 100; ++i) {
+		map[i] = i * i;
+	}
+	EXPECT_EQ(81, map[9]);
+	EXPECT_LT(0U, arena.getUsedBytes());
+}
+
+TEST(ArenaTest, allocator_without_arena_should_use_global_new) {
+	typedef optparse::ArenaAllocator< std::pair< const int, int > > Allocator;
+	std::map< int, int, std::less< int >, Allocator > map;
+	map[1] = 2;
+	EXPECT_EQ(2, map[1]);
+}
@@ -0,0 +1,120 @@
+// This file provides tests for CachedUsagePrinter regardless of character
+// type.
+// You need to define the followings before including this header,
+//  - Ch: character type
+//  - String: string type of Ch. must be compatible with std::basic_string
+//  - STR(str): macro to create a character and string literal
+//  - PREFIX(name): macro which prefixes a test case name to avoid conflict
+//
+
+#include "optparse/CachedUsagePrinter.h"
+#include "optparse/DefaultFormatter.h"
+#include "optparse/DefaultUsagePrinter.h"
+#include "optparse/OptionParserBase.h"
+
+#include <sstream>
+#include "gtest/gtest.h"
+
+/** Fixture for the tests of `CachedUsagePrinter`. */
+class PREFIX(CachedUsagePrinterTest) : public ::testing::Test {
+protected:
+	/** Options container. */
+	struct Options {
+		/** Field associated with "-i". */
+		int i;
+
+		/** Field associated with "-j". */
+		int j;
+
+		/** Field associated with the argument. */
+		String input;
+	};
+
+	/** Type of the parser. */
+	typedef optparse::OptionParserBase<
+		Options, Ch, optparse::DefaultFormatter > Parser;
+
+	/** Parser whose usage is printed. */
+	Parser parser;
+
+	/** Configures the parser. */
+	PREFIX(CachedUsagePrinterTest)() : parser(STR("test program")) {
+		this->parser.addOption(
+			STR("-i"), STR("N"), STR("int option"), &Options::i);
+		this->parser.appendArgument(
+			STR("INPUT"), STR("input file"), &Options::input);
+	}
+};
+
+TEST_F(PREFIX(CachedUsagePrinterTest), printUsage_should_print_same_usage_as_DefaultUsagePrinter) {
+	std::basic_ostringstream< Ch > out;
+	optparse::CachedUsagePrinter< Ch > printer(out);
+	printer.printUsage(this->parser);
+	const String usage =
+		optparse::DefaultUsagePrinter< Ch >::renderUsage(this->parser);
+	EXPECT_EQ(usage, out.str());
+	printer.printUsage(this->parser);
+	EXPECT_EQ(usage + usage, out.str());
+}
+
+TEST_F(PREFIX(CachedUsagePrinterTest), usage_should_be_kept_while_parser_is_unchanged) {
+	std::basic_ostringstream< Ch > out;
+	optparse::CachedUsagePrinter< Ch > printer(out);
+	EXPECT_FALSE(printer.isCached(this->parser));
+	const String& usage = printer.getUsage(this->parser);
+	EXPECT_TRUE(printer.isCached(this->parser));
+	const Ch* data = usage.data();
+	EXPECT_EQ(data, printer.getUsage(this->parser).data());
+	// const parsing does not change the parser
+	const Ch* const ARGS[] = { STR("test.exe"), STR("input") };
+	String programName;
+	const Parser& constParser = this->parser;
+	constParser.parse(2, ARGS, programName);
+	EXPECT_TRUE(printer.isCached(this->parser));
+}
+
+TEST_F(PREFIX(CachedUsagePrinterTest), adding_option_should_invalidate_usage) {
+	optparse::CachedUsagePrinter< Ch > printer;
+	printer.getUsage(this->parser);
+	this->parser.addOption(
+		STR("-j"), STR("M"), STR("another int option"), &Options::j);
+	EXPECT_FALSE(printer.isCached(this->parser));
+	EXPECT_NE(String::npos,
+			  printer.getUsage(this->parser).find(STR("[-j M]")));
+}
+
+TEST_F(PREFIX(CachedUsagePrinterTest), appending_argument_should_invalidate_usage) {
+	optparse::CachedUsagePrinter< Ch > printer;
+	printer.getUsage(this->parser);
+	this->parser.appendArgument(
+		STR("OUTPUT"), STR("output file"), &Options::input);
+	EXPECT_FALSE(printer.isCached(this->parser));
+	EXPECT_NE(String::npos,
+			  printer.getUsage(this->parser).find(STR("INPUT OUTPUT")));
+}
+
+TEST_F(PREFIX(CachedUsagePrinterTest), new_program_name_should_invalidate_usage) {
+	optparse::CachedUsagePrinter< Ch > printer;
+	const Ch* const ARGS[] = { STR("test.exe"), STR("input") };
+	this->parser.parse(2, ARGS);
+	printer.getUsage(this->parser);
+	// same program name
+	this->parser.parse(2, ARGS);
+	EXPECT_TRUE(printer.isCached(this->parser));
+	const Ch* const OTHER_ARGS[] = { STR("other.exe"), STR("input") };
+	this->parser.parse(2, OTHER_ARGS);
+	EXPECT_FALSE(printer.isCached(this->parser));
+	EXPECT_EQ(0U, printer.getUsage(this->parser).find(
+		STR("usage: other.exe")));
+}
+
+TEST_F(PREFIX(CachedUsagePrinterTest), usage_of_another_parser_should_be_rendered) {
+	optparse::CachedUsagePrinter< Ch > printer;
+	Parser other(STR("other program"));
+	printer.getUsage(this->parser);
+	EXPECT_FALSE(printer.isCached(other));
+	EXPECT_NE(String::npos,
+			  printer.getUsage(other).find(STR("other program")));
+	printer.invalidate();
+	EXPECT_FALSE(printer.isCached(other));
+}
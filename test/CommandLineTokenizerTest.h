@@ -0,0 +1,116 @@
+// This file provides tests for CommandLineTokenizer regardless of character
+// type.
+// You need to define the followings before including this header,
+//  - Ch: character type
+//  - String: string type of Ch. must be compatible with std::basic_string
+//  - STR(str): macro to create a character and string literal
+//  - PREFIX(name): macro which prefixes a test case name to avoid conflict
+//
+
+#include "optparse/CommandLineTokenizer.h"
+
+#include <vector>
+#include "gtest/gtest.h"
+
+/** Fixture for the tests of `CommandLineTokenizer`. */
+class PREFIX(CommandLineTokenizerTest) : public ::testing::Test {
+protected:
+	/** Buffer of the command line. */
+	String buffer;
+
+	/** Error of the tokenizer. */
+	const char* error;
+
+	/**
+	 * Splits a given command line into tokens.
+	 *
+	 * The error of the tokenizer is stored in `error`.
+	 */
+	std::vector< String > tokenize(const String& line) {
+		this->buffer = line;
+		Ch* first = this->buffer.empty() ? 0 : &this->buffer[0];
+		optparse::CommandLineTokenizer< Ch > tokenizer(
+			first, first + this->buffer.size());
+		std::vector< String > tokens;
+		optparse::StringView< Ch > token;
+		while (tokenizer.next(token)) {
+			// every token must be a view of the buffer
+			EXPECT_TRUE(token.empty() || (first <= token.data()
+				&& token.data() + token.size()
+					<= first + this->buffer.size()));
+			tokens.push_back(token.str());
+		}
+		this->error = tokenizer.getError();
+		return tokens;
+	}
+};
+
+TEST_F(PREFIX(CommandLineTokenizerTest), tokens_should_be_separated_by_whitespace) {
+	const std::vector< String > tokens =
+		this->tokenize(STR("  -i 12\t--flag\r\ninput  "));
+	ASSERT_EQ(4U, tokens.size());
+	EXPECT_EQ(STR("-i"), tokens[0]);
+	EXPECT_EQ(STR("12"), tokens[1]);
+	EXPECT_EQ(STR("--flag"), tokens[2]);
+	EXPECT_EQ(STR("input"), tokens[3]);
+	EXPECT_TRUE(this->error == 0);
+}
+
+TEST_F(PREFIX(CommandLineTokenizerTest), empty_or_blank_line_should_have_no_token) {
+	EXPECT_TRUE(this->tokenize(STR("")).empty());
+	EXPECT_TRUE(this->error == 0);
+	EXPECT_TRUE(this->tokenize(STR(" \t ")).empty());
+	EXPECT_TRUE(this->error == 0);
+}
+
+TEST_F(PREFIX(CommandLineTokenizerTest), single_quotes_should_keep_characters_literally) {
+	const std::vector< String > tokens =
+		this->tokenize(STR("'a b' 'c\\d' '\"'"));
+	ASSERT_EQ(3U, tokens.size());
+	EXPECT_EQ(STR("a b"), tokens[0]);
+	EXPECT_EQ(STR("c\\d"), tokens[1]);
+	EXPECT_EQ(STR("\""), tokens[2]);
+}
+
+TEST_F(PREFIX(CommandLineTokenizerTest), double_quotes_should_allow_escaped_quote_and_backslash) {
+	const std::vector< String > tokens =
+		this->tokenize(STR("\"a \\\"b\\\" \\\\ \\n\" \"'\""));
+	ASSERT_EQ(2U, tokens.size());
+	EXPECT_EQ(STR("a \"b\" \\ \\n"), tokens[0]);
+	EXPECT_EQ(STR("'"), tokens[1]);
+}
+
+TEST_F(PREFIX(CommandLineTokenizerTest), backslash_should_escape_next_character) {
+	const std::vector< String > tokens =
+		this->tokenize(STR("a\\ b \\'c \\\\"));
+	ASSERT_EQ(3U, tokens.size());
+	EXPECT_EQ(STR("a b"), tokens[0]);
+	EXPECT_EQ(STR("'c"), tokens[1]);
+	EXPECT_EQ(STR("\\"), tokens[2]);
+}
+
+TEST_F(PREFIX(CommandLineTokenizerTest), adjacent_parts_should_make_one_token) {
+	const std::vector< String > tokens =
+		this->tokenize(STR("a\"b c\"d'e f' \"\"''"));
+	ASSERT_EQ(2U, tokens.size());
+	EXPECT_EQ(STR("ab cde f"), tokens[0]);
+	EXPECT_EQ(STR(""), tokens[1]);
+}
+
+TEST_F(PREFIX(CommandLineTokenizerTest), unterminated_quote_should_be_error) {
+	const std::vector< String > tokens = this->tokenize(STR("a 'b c"));
+	ASSERT_EQ(1U, tokens.size());
+	EXPECT_EQ(STR("a"), tokens[0]);
+	ASSERT_TRUE(this->error != 0);
+	EXPECT_STREQ("unterminated quote", this->error);
+	this->tokenize(STR("\"b\\\""));
+	ASSERT_TRUE(this->error != 0);
+	EXPECT_STREQ("unterminated quote", this->error);
+}
+
+TEST_F(PREFIX(CommandLineTokenizerTest), trailing_backslash_should_be_error) {
+	const std::vector< String > tokens = this->tokenize(STR("a b\\"));
+	ASSERT_EQ(1U, tokens.size());
+	ASSERT_TRUE(this->error != 0);
+	EXPECT_STREQ("unterminated escape", this->error);
+}
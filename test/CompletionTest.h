@@ -0,0 +1,247 @@
+// This file provides tests for completion and abbreviations of labels
+// regardless of character type.
+// You need to define the followings before including this header,
+//  - Ch: character type
+//  - String: string type of Ch. must be compatible with std::basic_string
+//  - STR(str): macro to create a character and string literal
+//  - PREFIX(name): macro which prefixes a test case name to avoid conflict
+//
+
+#include "optparse/DefaultFormatter.h"
+#include "optparse/OptionParserBase.h"
+#include "optparse/OptionParserException.h"
+
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+
+/** Fixture which completes and abbreviates labels. */
+class PREFIX(CompletionTest) : public ::testing::Test {
+protected:
+	/** Options container. */
+	struct Options {
+		/** Field associated with "--threads". */
+		int threads;
+
+		/** Field associated with "--thread-name". */
+		String threadName;
+
+		/** Field associated with "--verbose". */
+		bool verbose;
+
+		/** Field associated with the first argument. */
+		String input;
+
+		/** Selected command. 0 if no command is selected. */
+		int command;
+
+		/** Field associated with "--force" of "push". */
+		bool force;
+
+		/** Initializes with default values. */
+		Options() : threads(0), verbose(false), command(0), force(false) {}
+	};
+
+	/** Type of the parser. */
+	typedef optparse::OptionParserBase<
+		Options, Ch, optparse::DefaultFormatter > Parser;
+
+	/** Type of a candidate. */
+	typedef typename Parser::Completion Completion;
+
+	/** Type of a result. */
+	typedef optparse::ParseResult< Ch > ParseResult;
+
+	/** Parser under test. */
+	Parser parser;
+
+	/** Configures the parser. */
+	PREFIX(CompletionTest)() : parser(STR("test program")) {
+		this->parser.addOption(STR("--threads"), STR("N"), STR("threads"),
+							   &Options::threads);
+		this->parser.addOption(STR("--thread-name"), STR("NAME"),
+							   STR("thread name"), &Options::threadName);
+		this->parser.addFlag(STR("--verbose"), STR("verbose"),
+							 &Options::verbose);
+		this->parser.appendArgument(
+			STR("INPUT"), STR("input"), &Options::input);
+	}
+
+	/** Configures the parser of "push". */
+	static void configurePush(Parser& parser) {
+		parser.addFlag(STR("--force"), STR("force"), &Options::force);
+	}
+
+	/** Returns the texts of given candidates separated by spaces. */
+	static String texts(const std::vector< Completion >& completions) {
+		String joined;
+		for (size_t i = 0; i < completions.size(); ++i) {
+			if (i > 0) {
+				joined += Ch(' ');
+			}
+			joined += completions[i].text;
+		}
+		return joined;
+	}
+};
+
+TEST_F(PREFIX(CompletionTest), findOptionsWithPrefix_should_find_labels_in_order) {
+	for (int compiled = 0; compiled < 2; ++compiled) {
+		if (compiled) {
+			this->parser.compile();
+		}
+		std::vector< int > indices;
+		EXPECT_EQ(2u, this->parser.findOptionsWithPrefix(
+			STR("--thr"), indices));
+		ASSERT_EQ(2u, indices.size());
+		EXPECT_EQ(1, indices[0]);
+		EXPECT_EQ(0, indices[1]);
+		indices.clear();
+		EXPECT_EQ(3u, this->parser.findOptionsWithPrefix(STR(""), indices));
+		indices.clear();
+		EXPECT_EQ(1u, this->parser.findOptionsWithPrefix(
+			STR("--t"), indices, 1));
+		EXPECT_EQ(1u, indices.size());
+		indices.clear();
+		EXPECT_EQ(0u, this->parser.findOptionsWithPrefix(STR("--x"), indices));
+		EXPECT_EQ(0u, this->parser.findOptionsWithPrefix(
+			STR("--threads-"), indices));
+	}
+}
+
+TEST_F(PREFIX(CompletionTest), complete_should_list_options_with_prefix) {
+	const Ch* const ARGS[] = { STR("test.exe"), STR("--thr") };
+	std::vector< Completion > completions;
+	EXPECT_EQ(2u, this->parser.complete(2, ARGS, completions));
+	ASSERT_EQ(2u, completions.size());
+	EXPECT_EQ(Completion::OPTION, completions[0].kind);
+	EXPECT_EQ(STR("--thread-name"), completions[0].text);
+	EXPECT_EQ(STR("thread name"), completions[0].description);
+	EXPECT_EQ(STR("--threads"), completions[1].text);
+	// the same candidates after the options are compiled
+	this->parser.compile();
+	completions.clear();
+	this->parser.complete(2, ARGS, completions);
+	EXPECT_EQ(STR("--thread-name --threads"), texts(completions));
+}
+
+TEST_F(PREFIX(CompletionTest), complete_should_list_value_name_of_option) {
+	const Ch* const PENDING[] = {
+		STR("test.exe"), STR("--verbose"), STR("--threads"), STR("")
+	};
+	std::vector< Completion > completions;
+	EXPECT_EQ(1u, this->parser.complete(4, PENDING, completions));
+	ASSERT_EQ(1u, completions.size());
+	EXPECT_EQ(Completion::VALUE, completions[0].kind);
+	EXPECT_EQ(STR("N"), completions[0].text);
+	const Ch* const EQUAL[] = { STR("test.exe"), STR("--thread-name=ma") };
+	completions.clear();
+	this->parser.complete(2, EQUAL, completions);
+	ASSERT_EQ(1u, completions.size());
+	EXPECT_EQ(Completion::VALUE, completions[0].kind);
+	EXPECT_EQ(STR("NAME"), completions[0].text);
+}
+
+TEST_F(PREFIX(CompletionTest), complete_should_list_argument_and_commands) {
+	this->parser.addCommand(STR("pull"), STR("pulls"),
+							&Options::command, 1, &configurePush);
+	this->parser.addCommand(STR("push"), STR("pushes"),
+							&Options::command, 2, &configurePush);
+	// an empty word is the argument or any option
+	const Ch* const EMPTY[] = { STR("test.exe") };
+	std::vector< Completion > completions;
+	EXPECT_EQ(4u, this->parser.complete(1, EMPTY, completions));
+	ASSERT_EQ(4u, completions.size());
+	EXPECT_EQ(Completion::ARGUMENT, completions[0].kind);
+	EXPECT_EQ(STR("INPUT"), completions[0].text);
+	EXPECT_EQ(Completion::OPTION, completions[1].kind);
+	// commands follow the argument; errors are ignored
+	const Ch* const COMMAND[] = {
+		STR("test.exe"), STR("--unknown"), STR("in"), STR("pu")
+	};
+	completions.clear();
+	this->parser.complete(4, COMMAND, completions);
+	EXPECT_EQ(STR("pull push"), texts(completions));
+	EXPECT_EQ(Completion::COMMAND, completions[0].kind);
+	EXPECT_EQ(STR("pulls"), completions[0].description);
+	// the parser of the command completes the rest
+	const Ch* const IN_COMMAND[] = {
+		STR("test.exe"), STR("in"), STR("push"), STR("--f")
+	};
+	completions.clear();
+	this->parser.complete(4, IN_COMMAND, completions);
+	EXPECT_EQ(STR("--force"), texts(completions));
+}
+
+TEST_F(PREFIX(CompletionTest), unique_prefix_should_be_accepted_if_enabled) {
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("--threads"), STR("2"), STR("--verb"),
+		STR("--thread-n=main"), STR("in")
+	};
+	Options options;
+	// disabled by default
+	EXPECT_FALSE(this->parser.isAbbreviationsEnabled());
+	ParseResult result = this->parser.tryParseInto(options, 6, ARGS);
+	EXPECT_EQ(ParseResult::UNKNOWN_OPTION, result.getKind());
+	EXPECT_EQ(3, result.getArgIndex());
+	this->parser.setAbbreviationsEnabled(true);
+	for (int compiled = 0; compiled < 2; ++compiled) {
+		if (compiled) {
+			this->parser.compile();
+		}
+		options = Options();
+		// the exact label precedes the abbreviation of "--thread-name"
+		EXPECT_TRUE(this->parser.tryParseInto(options, 6, ARGS).isSuccess());
+		EXPECT_EQ(2, options.threads);
+		EXPECT_TRUE(options.verbose);
+		EXPECT_EQ(STR("main"), options.threadName);
+		EXPECT_EQ(STR("in"), options.input);
+	}
+}
+
+TEST_F(PREFIX(CompletionTest), ambiguous_prefix_should_be_unknown_option) {
+	this->parser.setAbbreviationsEnabled(true);
+	const Ch* const ARGS[] = { STR("test.exe"), STR("--thr"), STR("2") };
+	Options options;
+	const ParseResult result = this->parser.tryParseInto(options, 3, ARGS);
+	EXPECT_EQ(ParseResult::UNKNOWN_OPTION, result.getKind());
+	EXPECT_EQ(1, result.getArgIndex());
+	EXPECT_EQ(std::string("ambiguous option"), result.getMessage());
+	// a short label is never abbreviated
+	const Ch* const SHORT[] = { STR("test.exe"), STR("-t"), STR("in") };
+	EXPECT_EQ(ParseResult::UNKNOWN_OPTION,
+			  this->parser.tryParseInto(options, 3, SHORT).getKind());
+	try {
+		this->parser.parse(3, ARGS);
+		FAIL() << "UnknownOption should have been thrown";
+	} catch (const optparse::UnknownOption< Ch >& e) {
+		ASSERT_EQ(2u, e.getSuggestions().size());
+		EXPECT_EQ(STR("--thread-name"), e.getSuggestions()[0]);
+		EXPECT_EQ(STR("--threads"), e.getSuggestions()[1]);
+	}
+}
+
+TEST_F(PREFIX(CompletionTest), ambiguous_prefix_with_value_should_be_reported_without_value) {
+	this->parser.setAbbreviationsEnabled(true);
+	const Ch* const ARGS[] = { STR("test.exe"), STR("--thr=4") };
+	Options options;
+	const ParseResult result = this->parser.tryParseInto(options, 2, ARGS);
+	EXPECT_EQ(ParseResult::UNKNOWN_OPTION, result.getKind());
+	EXPECT_EQ(1, result.getArgIndex());
+	EXPECT_EQ(std::string("ambiguous option"), result.getMessage());
+	EXPECT_EQ(String(STR("--thr")), result.getLabel().str());
+	try {
+		this->parser.parse(2, ARGS);
+		FAIL() << "UnknownOption should have been thrown";
+	} catch (const optparse::UnknownOption< Ch >& e) {
+		EXPECT_EQ(STR("--thr"), e.getLabel());
+		ASSERT_EQ(2u, e.getSuggestions().size());
+		EXPECT_EQ(STR("--thread-name"), e.getSuggestions()[0]);
+		EXPECT_EQ(STR("--threads"), e.getSuggestions()[1]);
+	}
+	// an unknown label keeps the value
+	const Ch* const UNKNOWN[] = { STR("test.exe"), STR("--x=4") };
+	EXPECT_EQ(String(STR("--x=4")),
+			  this->parser.tryParseInto(options, 2, UNKNOWN)
+				  .getLabel().str());
+}
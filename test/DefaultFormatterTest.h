@@ -7,10 +7,38 @@
 //
 
 #include "optparse/DefaultFormatter.h"
+#include "optparse/FastFormatter.h"
+#include "optparse/OptionParserBase.h"
 
 #include <climits>
 #include "gtest/gtest.h"
 
+/** Value converted by a specialized function call operator. */
+struct PREFIX(Point) {
+	int x;
+	int y;
+};
+
+namespace optparse {
+
+	/** Converts "x,y" into a `Point` as the baseline documents show. */
+	template <>
+	PREFIX(Point) DefaultFormatter< PREFIX(Point), Ch >::operator ()(
+		const String& valueStr) const
+	{
+		const size_t comma = valueStr.find(Ch(','));
+		if (comma == String::npos) {
+			OPTPARSE_THROW(BadValue< Ch >("invalid point", valueStr));
+		}
+		const DefaultFormatter< int, Ch > formatInt;
+		PREFIX(Point) point;
+		point.x = formatInt(valueStr.substr(0, comma));
+		point.y = formatInt(valueStr.substr(comma + 1));
+		return point;
+	}
+
+}
+
 /** String which represents the maximum value representable by `int`. */
 #define STR_INT_MAX  \
 	(sizeof(int) == 8 ? STR("9223372036854775807") : STR("2147483647"))
@@ -434,3 +462,70 @@ TEST(PREFIX(DefaultFormatter_string_Test), string_can_be_copied) {
 	EXPECT_EQ(STR(""), format(STR("")));
 }
 
+
+TEST(PREFIX(DefaultFormatter_view_Test), only_referenced_part_of_view_should_be_formatted) {
+	typedef optparse::StringView< Ch > StringView;
+	typedef optparse::DefaultFormatter< int, Ch > IntFormat;
+	typedef optparse::DefaultFormatter< unsigned int, Ch > UIntFormat;
+	typedef optparse::DefaultFormatter< double, Ch > DoubleFormat;
+	typedef optparse::DefaultFormatter< String, Ch > StringFormat;
+	const Ch* const VALUE = STR("-12.5e3xyz");
+	EXPECT_EQ(-12, IntFormat()(StringView(VALUE, 3)));
+	EXPECT_EQ(12U, UIntFormat()(StringView(VALUE + 1, 2)));
+	EXPECT_DOUBLE_EQ(-12.5e3, DoubleFormat()(StringView(VALUE, 7)));
+	EXPECT_EQ(STR("12.5"), StringFormat()(StringView(VALUE + 1, 4)));
+	EXPECT_THROW(IntFormat()(StringView(VALUE, 4)), optparse::BadValue< Ch >);
+}
+
+TEST(PREFIX(DefaultFormatter_view_Test), long_view_should_be_formatted) {
+	typedef optparse::DefaultFormatter< int, Ch > IntFormat;
+	// longer than the internal buffer of DefaultFormatterHelper::CString
+	String value(100, Ch('0'));
+	value += STR("42");
+	EXPECT_EQ(42, IntFormat()(value));
+}
+
+TEST(PREFIX(DefaultFormatter_view_Test), BadValue_should_have_whole_value) {
+	typedef optparse::StringView< Ch > StringView;
+	typedef optparse::DefaultFormatter< int, Ch > IntFormat;
+	const Ch* const VALUE = STR("12x34");
+	try {
+		IntFormat()(StringView(VALUE, 3));
+		FAIL() << "BadValue should have been thrown";
+	} catch (optparse::BadValue< Ch >& ex) {
+		EXPECT_EQ(STR("12x"), ex.getValue());
+		EXPECT_EQ("invalid integer", ex.getMessage());
+	}
+}
+
+TEST(PREFIX(DefaultFormatter_custom_Test), specialized_string_operator_should_convert_views) {
+	typedef PREFIX(Point) Point;
+	const optparse::DefaultFormatter< Point, Ch > format;
+	EXPECT_EQ(3, format(String(STR("3,4"))).x);
+	EXPECT_EQ(4, format(STR("3,4")).y);
+	const Ch* const VALUE = STR("5,6,7");
+	EXPECT_EQ(6, format(optparse::StringView< Ch >(VALUE, 3)).y);
+	EXPECT_THROW(format(STR("5")), optparse::BadValue< Ch >);
+	const optparse::FastFormatter< Point, Ch > fast;
+	EXPECT_EQ(8, fast(STR("8,9")).x);
+}
+
+TEST(PREFIX(DefaultFormatter_custom_Test), parser_should_use_specialized_string_operator) {
+	struct Options {
+		PREFIX(Point) origin;
+	};
+	optparse::OptionParserBase< Options, Ch, optparse::DefaultFormatter >
+		parser(STR("test program"));
+	parser.addOption(STR("--origin"), STR("X,Y"), STR("origin"),
+					 &Options::origin);
+	const Ch* const ARGS[] = { STR("test.exe"), STR("--origin"), STR("1,2") };
+	const Options options = parser.parse(3, ARGS);
+	EXPECT_EQ(1, options.origin.x);
+	EXPECT_EQ(2, options.origin.y);
+	Options reused = options;
+	const Ch* const BAD[] = { STR("test.exe"), STR("--origin"), STR("1") };
+	const optparse::ParseResult< Ch > result =
+		parser.tryParseInto(reused, 3, BAD);
+	EXPECT_EQ(optparse::ParseResult< Ch >::BAD_VALUE, result.getKind());
+	EXPECT_EQ(std::string("invalid point"), result.getMessage());
+}
@@ -0,0 +1,173 @@
+// This file provides tests for DefaultUsagePrinter regardless of character
+// type.
+// You need to define the followings before including this header,
+//  - Ch: character type
+//  - String: string type of Ch. must be compatible with std::basic_string
+//  - STR(str): macro to create a character and string literal
+//  - PREFIX(name): macro which prefixes a test case name to avoid conflict
+//
+
+#include "optparse/DefaultFormatter.h"
+#include "optparse/DefaultUsagePrinter.h"
+#include "optparse/OptionParserBase.h"
+
+#include <sstream>
+#include "gtest/gtest.h"
+
+/** Fixture for the tests of `DefaultUsagePrinter`. */
+class PREFIX(DefaultUsagePrinterTest) : public ::testing::Test {
+protected:
+	/** Options container. */
+	struct Options {
+		/** Field associated with "-i". */
+		int i;
+
+		/** Field associated with "--flag". */
+		bool flag;
+
+		/** Field associated with the argument. */
+		String input;
+	};
+
+	/** Type of the parser. */
+	typedef optparse::OptionParserBase<
+		Options, Ch, optparse::DefaultFormatter > Parser;
+
+	/** Parser whose usage is printed. */
+	Parser parser;
+
+	/** Configures the parser. */
+	PREFIX(DefaultUsagePrinterTest)() : parser(STR("test program")) {
+		this->parser.addOption(
+			STR("-i"), STR("N"), STR("int option"), &Options::i);
+		this->parser.addOption(
+			STR("--flag"), STR("flag option"), &Options::flag, true);
+		this->parser.appendArgument(
+			STR("INPUT"), STR("input file"), &Options::input);
+		this->parser.appendArgument(
+			STR("OUT"), STR("output file"), &Options::input);
+		const Ch* const ARGS[] = { STR("test.exe"), STR("a"), STR("b") };
+		this->parser.parse(3, ARGS);
+	}
+};
+
+TEST_F(PREFIX(DefaultUsagePrinterTest), printUsage_should_print_usage) {
+	std::basic_ostringstream< Ch > out;
+	optparse::DefaultUsagePrinter< Ch >(out).printUsage(this->parser);
+	EXPECT_EQ(
+		String(STR("usage: test.exe [-i N] [--flag] INPUT OUT\n"))
+		+ STR("\n")
+		+ STR("test program\n")
+		+ STR("\n")
+		+ STR("positional arguments:\n")
+		+ STR("  INPUT  input file\n")
+		+ STR("  OUT    output file\n")
+		+ STR("\n")
+		+ STR("optional arguments:\n")
+		+ STR("  -i N    int option\n")
+		+ STR("  --flag  flag option\n")
+		+ STR("\n"),
+		out.str());
+}
+
+TEST_F(PREFIX(DefaultUsagePrinterTest), options_sharing_texts_should_be_printed_as_others) {
+	this->parser.addOption(
+		STR("-j"), STR("N"), STR("int option"), &Options::i);
+	// replaces "--flag"
+	this->parser.addOption(
+		STR("--flag"), STR("N"), STR("int option"), &Options::i);
+	EXPECT_EQ(
+		String(STR("usage: test.exe [-i N] [--flag N] [-j N] INPUT OUT\n"))
+		+ STR("\n")
+		+ STR("test program\n")
+		+ STR("\n")
+		+ STR("positional arguments:\n")
+		+ STR("  INPUT  input file\n")
+		+ STR("  OUT    output file\n")
+		+ STR("\n")
+		+ STR("optional arguments:\n")
+		+ STR("  -i N      int option\n")
+		+ STR("  --flag N  int option\n")
+		+ STR("  -j N      int option\n")
+		+ STR("\n"),
+		optparse::DefaultUsagePrinter< Ch >::renderUsage(this->parser));
+}
+
+TEST_F(PREFIX(DefaultUsagePrinterTest), renderUsage_should_render_same_text_as_printUsage) {
+	std::basic_ostringstream< Ch > out;
+	optparse::DefaultUsagePrinter< Ch >(out).printUsage(this->parser);
+	EXPECT_EQ(out.str(),
+			  optparse::DefaultUsagePrinter< Ch >::renderUsage(this->parser));
+}
+
+TEST_F(PREFIX(DefaultUsagePrinterTest), renderUsage_should_append_to_given_string) {
+	String usage(STR("prefix\n"));
+	optparse::DefaultUsagePrinter< Ch >::renderUsage(this->parser, usage);
+	EXPECT_EQ(
+		String(STR("prefix\n"))
+		+ optparse::DefaultUsagePrinter< Ch >::renderUsage(this->parser),
+		usage);
+}
+
+TEST_F(PREFIX(DefaultUsagePrinterTest), renderUsage_should_not_reallocate_string_large_enough_for_usage) {
+	String usage;
+	optparse::DefaultUsagePrinter< Ch >::renderUsage(this->parser, usage);
+	String exact;
+	exact.reserve(usage.size());
+	const size_t capacity = exact.capacity();
+	exact.clear();
+	optparse::DefaultUsagePrinter< Ch >::renderUsage(this->parser, exact);
+	EXPECT_EQ(capacity, exact.capacity());
+}
+
+TEST_F(PREFIX(DefaultUsagePrinterTest), variadic_argument_should_be_shown_with_ellipsis) {
+	struct Files {
+		static void add(Options&, const String&) {}
+	};
+	this->parser.appendVariadicArgument(
+		STR("FILE"), STR("more files"), &Files::add);
+	const String usage =
+		optparse::DefaultUsagePrinter< Ch >::renderUsage(this->parser);
+	EXPECT_EQ(0U, usage.find(
+		STR("usage: test.exe [-i N] [--flag] INPUT OUT [FILE ...]\n")));
+	EXPECT_NE(String::npos, usage.find(STR("  FILE   more files\n")));
+	String exact;
+	exact.reserve(usage.size());
+	const size_t capacity = exact.capacity();
+	exact.clear();
+	optparse::DefaultUsagePrinter< Ch >::renderUsage(this->parser, exact);
+	EXPECT_EQ(capacity, exact.capacity());
+}
+
+TEST_F(PREFIX(DefaultUsagePrinterTest), usage_of_parser_without_options_and_arguments_should_have_only_description) {
+	struct Empty {};
+	optparse::OptionParserBase< Empty, Ch, optparse::DefaultFormatter >
+		parser(STR("test program"));
+	EXPECT_EQ(
+		String(STR("usage: \n\ntest program\n\n")),
+		optparse::DefaultUsagePrinter< Ch >::renderUsage(parser));
+}
+
+TEST_F(PREFIX(DefaultUsagePrinterTest), commands_should_be_listed) {
+	struct Configure {
+		void operator ()(Parser&) const {}
+	};
+	this->parser.addCommand(
+		STR("build"), STR("builds"), &Options::i, 1, Configure());
+	this->parser.addCommand(
+		STR("run"), STR("runs"), &Options::i, 2, Configure());
+	const String usage =
+		optparse::DefaultUsagePrinter< Ch >::renderUsage(this->parser);
+	EXPECT_EQ(0U, usage.find(
+		STR("usage: test.exe [-i N] [--flag] INPUT OUT COMMAND ...\n")));
+	EXPECT_NE(String::npos, usage.find(
+		String(STR("commands:\n"))
+		+ STR("  build  builds\n")
+		+ STR("  run    runs\n")));
+	String exact;
+	exact.reserve(usage.size());
+	const size_t capacity = exact.capacity();
+	exact.clear();
+	optparse::DefaultUsagePrinter< Ch >::renderUsage(this->parser, exact);
+	EXPECT_EQ(capacity, exact.capacity());
+}
@@ -0,0 +1,91 @@
+// This file provides tests for EnumFormatter regardless of character type.
+// You need to define the followings before including this header,
+//  - Ch: character type
+//  - String: string type of Ch. must be compatible with std::basic_string
+//  - STR(str): macro to create a character and string literal
+//  - PREFIX(name): macro which prefixes a test case name to avoid conflict
+//
+
+#include "optparse/DefaultFormatter.h"
+#include "optparse/EnumFormatter.h"
+#include "optparse/FastFormatter.h"
+#include "optparse/OptionParserBase.h"
+
+#include <chrono>
+#include <string>
+#include "gtest/gtest.h"
+
+/** Enumeration converted by the formatters. */
+enum class PREFIX(Mode) {
+	FAST, SAFE, DEBUG
+};
+
+namespace optparse {
+
+	/** Names of `Mode`. */
+	template <>
+	struct EnumTraits< PREFIX(Mode) > {
+		static size_t getNames(const EnumName< PREFIX(Mode) >*& names) {
+			static const EnumName< PREFIX(Mode) > NAMES[] = {
+				{ "fast", PREFIX(Mode)::FAST },
+				{ "safe", PREFIX(Mode)::SAFE },
+				{ "debug", PREFIX(Mode)::DEBUG },
+				{ "dbg", PREFIX(Mode)::DEBUG }
+			};
+			names = NAMES;
+			return sizeof(NAMES) / sizeof(NAMES[0]);
+		}
+	};
+
+}
+
+TEST(PREFIX(EnumFormatterTest), names_should_be_converted) {
+	typedef PREFIX(Mode) Mode;
+	const optparse::DefaultFormatter< Mode, Ch > format;
+	EXPECT_EQ(Mode::FAST, format(STR("fast")));
+	EXPECT_EQ(Mode::SAFE, format(STR("safe")));
+	EXPECT_EQ(Mode::DEBUG, format(STR("debug")));
+	EXPECT_EQ(Mode::DEBUG, format(STR("dbg")));
+	Mode mode = Mode::FAST;
+	const char* message = "";
+	EXPECT_FALSE(format.tryFormat(STR("Fast"), mode, message));
+	EXPECT_EQ(std::string("unknown name"), message);
+	EXPECT_FALSE(format.tryFormat(STR(""), mode, message));
+	EXPECT_FALSE(format.tryFormat(STR("fastest"), mode, message));
+	EXPECT_EQ(Mode::FAST, mode);
+	EXPECT_THROW(format(STR("slow")), optparse::BadValue< Ch >);
+	typedef optparse::EnumFormatter< Mode, Ch > Formatter;
+	EXPECT_EQ(std::string("debug"), Formatter::findName(Mode::DEBUG));
+}
+
+TEST(PREFIX(EnumFormatterTest), parser_should_pick_up_typed_formatters) {
+	struct Options {
+		PREFIX(Mode) mode;
+		std::chrono::milliseconds timeout;
+		optparse::ByteSize limit;
+		Options() : mode(PREFIX(Mode)::FAST) {}
+	};
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("--mode"), STR("safe"), STR("--timeout"),
+		STR("1.5s"), STR("--limit"), STR("4KiB")
+	};
+	optparse::OptionParserBase< Options, Ch, optparse::DefaultFormatter >
+		parser(STR("test program"));
+	parser.addOption(STR("--mode"), STR("MODE"), STR("mode"), &Options::mode);
+	parser.addOption(STR("--timeout"), STR("DURATION"), STR("timeout"),
+					 &Options::timeout);
+	parser.addOption(STR("--limit"), STR("SIZE"), STR("limit"),
+					 &Options::limit);
+	Options options = parser.parse(7, ARGS);
+	EXPECT_EQ(PREFIX(Mode)::SAFE, options.mode);
+	EXPECT_EQ(1500, options.timeout.count());
+	EXPECT_EQ(4096u, options.limit.getBytes());
+	optparse::OptionParserBase< Options, Ch, optparse::FastFormatter >
+		fast(STR("test program"));
+	fast.addOption(STR("--mode"), STR("MODE"), STR("mode"), &Options::mode);
+	const Ch* const BAD[] = { STR("test.exe"), STR("--mode"), STR("slow") };
+	const optparse::ParseResult< Ch > result =
+		fast.tryParseInto(options, 3, BAD);
+	EXPECT_EQ(optparse::ParseResult< Ch >::BAD_VALUE, result.getKind());
+	EXPECT_EQ(std::string("unknown name"), result.getMessage());
+}
@@ -0,0 +1,196 @@
+// This file provides tests for FastFormatter regardless of character type.
+// You need to define the followings before including this header,
+//  - Ch: character type
+//  - String: string type of Ch. must be compatible with std::basic_string
+//  - STR(str): macro to create a character and string literal
+//  - PREFIX(name): macro which prefixes a test case name to avoid conflict
+//
+
+#include "optparse/DefaultFormatter.h"
+#include "optparse/FastFormatter.h"
+#include "optparse/OptionParserBase.h"
+
+#include <climits>
+#include <cmath>
+#include <limits>
+#include <string>
+#include "gtest/gtest.h"
+
+/**
+ * Values which FastFormatter and DefaultFormatter should treat in the same
+ * way.
+ */
+static const Ch* const PREFIX(FAST_FORMATTER_VALUES)[] = {
+	STR("0"), STR("1"), STR("-1"), STR("+1"), STR("-0"), STR("007"),
+	STR(" 42"), STR("\t42"), STR("42 "), STR(""), STR(" "), STR("-"),
+	STR("+"), STR("num"), STR("1.5"), STR("1x"), STR("0x10"), STR("--1"),
+	STR("127"), STR("128"), STR("-128"), STR("-129"), STR("255"), STR("256"),
+	STR("32767"), STR("32768"), STR("-32768"), STR("-32769"),
+	STR("65535"), STR("65536"),
+	STR("2147483647"), STR("2147483648"), STR("-2147483648"),
+	STR("-2147483649"), STR("4294967295"), STR("4294967296"),
+	STR("9223372036854775807"), STR("9223372036854775808"),
+	STR("-9223372036854775808"), STR("-9223372036854775809"),
+	STR("18446744073709551615"), STR("18446744073709551616"),
+	STR("99999999999999999999999"), STR("-99999999999999999999999"),
+	STR("3.14"), STR("-1.5e-3"), STR("1.0e+308"), STR("-1.0e+308"),
+	STR("1.0e+309"), STR(".5"), STR("-.5"), STR("5."), STR("."), STR("1e"),
+	STR("1.5e"), STR("1e+"), STR("1e5x"), STR("e5"), STR("1E22"),
+	STR("1e23"), STR("1e-22"), STR("1e-23"), STR("0.1"), STR("0.3"),
+	STR("123456789012345678"), STR("1234567890123456789012"),
+	STR("9007199254740993"), STR("0.000000000000000000000000001"),
+	STR("6.02e+23"), STR("1.0e+38"), STR("1.0e+39"), STR("-1.0e+39"),
+	STR("3.4028234e38"), STR("inf"), STR("-infinity"), STR("nan"),
+	STR("0x1p3"), STR("1e1000"), STR("-0.0")
+};
+
+/**
+ * Expects FastFormatter and DefaultFormatter produce the same result for
+ * every value in `FAST_FORMATTER_VALUES`.
+ */
+template < typename T >
+static void PREFIX(expectSameAsDefault)() {
+	optparse::FastFormatter< T, Ch > fast;
+	optparse::DefaultFormatter< T, Ch > reference;
+	const size_t N = sizeof(PREFIX(FAST_FORMATTER_VALUES))
+		/ sizeof(PREFIX(FAST_FORMATTER_VALUES)[0]);
+	for (size_t i = 0; i < N; ++i) {
+		const String value(PREFIX(FAST_FORMATTER_VALUES)[i]);
+		T expected = T();
+		std::string expectedMessage;
+		try {
+			expected = reference(value);
+		} catch (optparse::BadValue< Ch >& ex) {
+			expectedMessage = ex.getMessage();
+		}
+		try {
+			T actual = fast(value);
+			EXPECT_TRUE(expectedMessage.empty())
+				<< "BadValue should have been thrown for value " << i
+				<< ": " << expectedMessage;
+			if (actual != actual) {
+				// NaN
+				EXPECT_NE(expected, expected) << "value " << i;
+			} else {
+				EXPECT_EQ(expected, actual) << "value " << i;
+				EXPECT_EQ(std::signbit(static_cast< double >(expected)),
+						  std::signbit(static_cast< double >(actual)))
+					<< "value " << i;
+			}
+		} catch (optparse::BadValue< Ch >& ex) {
+			EXPECT_EQ(expectedMessage, ex.getMessage()) << "value " << i;
+			EXPECT_EQ(value, ex.getValue()) << "value " << i;
+		}
+	}
+}
+
+TEST(PREFIX(FastFormatterTest), int_should_be_formatted_as_DefaultFormatter) {
+	PREFIX(expectSameAsDefault)< int >();
+}
+
+TEST(PREFIX(FastFormatterTest), unsigned_int_should_be_formatted_as_DefaultFormatter) {
+	PREFIX(expectSameAsDefault)< unsigned int >();
+}
+
+TEST(PREFIX(FastFormatterTest), short_should_be_formatted_as_DefaultFormatter) {
+	PREFIX(expectSameAsDefault)< short >();
+}
+
+TEST(PREFIX(FastFormatterTest), unsigned_short_should_be_formatted_as_DefaultFormatter) {
+	PREFIX(expectSameAsDefault)< unsigned short >();
+}
+
+TEST(PREFIX(FastFormatterTest), long_should_be_formatted_as_DefaultFormatter) {
+	PREFIX(expectSameAsDefault)< long >();
+}
+
+TEST(PREFIX(FastFormatterTest), unsigned_long_should_be_formatted_as_DefaultFormatter) {
+	PREFIX(expectSameAsDefault)< unsigned long >();
+}
+
+TEST(PREFIX(FastFormatterTest), long_long_should_be_formatted_as_DefaultFormatter) {
+	PREFIX(expectSameAsDefault)< long long >();
+}
+
+TEST(PREFIX(FastFormatterTest), unsigned_long_long_should_be_formatted_as_DefaultFormatter) {
+	PREFIX(expectSameAsDefault)< unsigned long long >();
+}
+
+TEST(PREFIX(FastFormatterTest), double_should_be_formatted_as_DefaultFormatter) {
+	PREFIX(expectSameAsDefault)< double >();
+}
+
+TEST(PREFIX(FastFormatterTest), float_should_be_formatted_as_DefaultFormatter) {
+	PREFIX(expectSameAsDefault)< float >();
+}
+
+TEST(PREFIX(FastFormatterTest), integer_limits_can_be_formatted) {
+	optparse::FastFormatter< int, Ch > intFormat;
+	optparse::FastFormatter< long long, Ch > longLongFormat;
+	optparse::FastFormatter< unsigned long long, Ch > ulongLongFormat;
+	EXPECT_EQ(INT_MAX, intFormat(STR("2147483647")));
+	EXPECT_EQ(INT_MIN, intFormat(STR("-2147483648")));
+	EXPECT_EQ(std::numeric_limits< long long >::min(),
+			  longLongFormat(STR("-9223372036854775808")));
+	EXPECT_EQ(std::numeric_limits< unsigned long long >::max(),
+			  ulongLongFormat(STR("18446744073709551615")));
+}
+
+TEST(PREFIX(FastFormatterTest), negative_value_after_space_should_be_out_of_range_for_unsigned) {
+	optparse::FastFormatter< unsigned long long, Ch > format;
+	try {
+		format(STR("\t-42"));
+		FAIL() << "BadValue should have been thrown";
+	} catch (optparse::BadValue< Ch >& ex) {
+		EXPECT_EQ("out of range", ex.getMessage());
+	}
+}
+
+TEST(PREFIX(FastFormatterTest), simple_double_should_be_exact) {
+	optparse::FastFormatter< double, Ch > format;
+	EXPECT_EQ(0.1, format(STR("0.1")));
+	EXPECT_EQ(123.456, format(STR("123.456")));
+	EXPECT_EQ(-1.5e-3, format(STR("-1.5e-3")));
+	EXPECT_EQ(1e22, format(STR("1e22")));
+	EXPECT_EQ(9007199254740992.0, format(STR("9007199254740992")));
+}
+
+TEST(PREFIX(FastFormatterTest), only_referenced_part_of_view_should_be_formatted) {
+	typedef optparse::StringView< Ch > StringView;
+	optparse::FastFormatter< int, Ch > intFormat;
+	optparse::FastFormatter< double, Ch > doubleFormat;
+	const Ch* const VALUE = STR("-12.5e3xyz");
+	EXPECT_EQ(-12, intFormat(StringView(VALUE, 3)));
+	EXPECT_DOUBLE_EQ(-12.5e3, doubleFormat(StringView(VALUE, 7)));
+}
+
+TEST(PREFIX(FastFormatterTest), string_should_be_formatted_by_DefaultFormatter) {
+	optparse::FastFormatter< String, Ch > format;
+	EXPECT_EQ(STR("value"), format(STR("value")));
+}
+
+TEST(PREFIX(FastFormatterTest), FastFormatter_can_be_MetaFormat) {
+	struct Options {
+		int n;
+		double x;
+		String s;
+
+		Options() : n(0), x(0.0) {}
+	};
+	optparse::OptionParserBase< Options, Ch, optparse::FastFormatter >
+		parser(STR("test program"));
+	parser.addOption(STR("-n"), STR("N"), STR("integer"), &Options::n);
+	parser.addOption(STR("-x"), STR("X"), STR("number"), &Options::x);
+	parser.addOption(STR("-s"), STR("S"), STR("string"), &Options::s);
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("-n"), STR("-7"), STR("-x"), STR("2.5"),
+		STR("-s"), STR("str")
+	};
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options = parser.parse(ARGC, ARGS);
+	EXPECT_EQ(-7, options.n);
+	EXPECT_DOUBLE_EQ(2.5, options.x);
+	EXPECT_EQ(STR("str"), options.s);
+	const Ch* const BAD_ARGS[] = { STR("test.exe"), STR("-n"), STR("7.5") };
+	EXPECT_THROW(parser.parse(3, BAD_ARGS), optparse::BadValue< Ch >);
+}
@@ -0,0 +1,250 @@
+// This file provides tests for KeyValueSource and parsing with sources
+// regardless of character type.
+// You need to define the followings before including this header,
+//  - Ch: character type
+//  - String: string type of Ch. must be compatible with std::basic_string
+//  - STR(str): macro to create a character and string literal
+//  - PREFIX(name): macro which prefixes a test case name to avoid conflict
+//
+
+#include "optparse/DefaultFormatter.h"
+#include "optparse/KeyValueSource.h"
+#include "optparse/OptionParserBase.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+
+/** Fixture which parses with sources. */
+class PREFIX(KeyValueSourceTest) : public ::testing::Test {
+protected:
+	/** Options container. */
+	struct Options {
+		/** Field associated with "--max-jobs". */
+		int maxJobs;
+
+		/** Field associated with "--name". */
+		String name;
+
+		/** Field associated with "--verbose". */
+		bool verbose;
+
+		/** Last file. */
+		String lastFile;
+
+		/** Field associated with "--include". */
+		std::vector< String > includes;
+
+		/** Initializes with default values. */
+		Options() : maxJobs(0), verbose(false) {}
+
+		/** Sets the last file. */
+		static void setFile(Options& options, const String& file) {
+			options.lastFile = file;
+		}
+	};
+
+	/** Type of the parser. */
+	typedef optparse::OptionParserBase<
+		Options, Ch, optparse::DefaultFormatter > Parser;
+
+	/** Type of a result. */
+	typedef optparse::ParseResult< Ch > ParseResult;
+
+	/** Type of a source. */
+	typedef optparse::KeyValueSource< Ch > Source;
+
+	/** Type of a configuration. */
+	typedef optparse::ConfigSource< Ch > ConfigSource;
+
+	/** Type of environment variables. */
+	typedef optparse::EnvironmentSource< Ch > EnvironmentSource;
+
+	/** Parser under test. */
+	Parser parser;
+
+	/** Configures the parser. */
+	PREFIX(KeyValueSourceTest)() : parser(STR("test program")) {
+		this->parser.addOption(STR("--max-jobs"), STR("N"), STR("jobs"),
+							   &Options::maxJobs);
+		this->parser.addOption(
+			STR("--name"), STR("NAME"), STR("name"), &Options::name);
+		this->parser.addFlag(STR("--verbose"), STR("verbose"),
+							 &Options::verbose);
+		this->parser.addListOption(STR("--include"), STR("DIR"),
+								   STR("include"), &Options::includes);
+		this->parser.appendArgument(
+			STR("FILE"), STR("file"), &Options::setFile);
+	}
+
+	/** Parses a given file with given sources. */
+	ParseResult parse(Options& options,
+					  const Ch* file,
+					  Source* const* sources,
+					  size_t sourceCount)
+	{
+		const Ch* const ARGS[] = { STR("test.exe"), file };
+		return this->parser.tryParseWithSources(
+			options, 2, ARGS, sources, sourceCount);
+	}
+};
+
+TEST_F(PREFIX(KeyValueSourceTest), environment_should_read_prefixed_variables) {
+	const Ch* const ENV[] = {
+		STR("PATH=/bin"),
+		STR("APP_MAX_JOBS=4"),
+		STR("APP_UNKNOWN=x"),
+		STR("APP_=y"),
+		STR("APP_NAME=a=b"),
+		0
+	};
+	const String prefix = STR("APP_");
+	EnvironmentSource env(ENV, prefix);
+	typename Source::StringView label;
+	typename Source::StringView value;
+	ASSERT_TRUE(env.next(label, value));
+	EXPECT_EQ(String(STR("--max-jobs")), label.str());
+	EXPECT_EQ(String(STR("4")), value.str());
+	ASSERT_TRUE(env.next(label, value));
+	EXPECT_EQ(String(STR("--unknown")), label.str());
+	ASSERT_TRUE(env.next(label, value));
+	EXPECT_EQ(String(STR("--name")), label.str());
+	EXPECT_EQ(String(STR("a=b")), value.str());
+	EXPECT_FALSE(env.next(label, value));
+	EXPECT_TRUE(env.ignoresUnknownLabels());
+}
+
+TEST_F(PREFIX(KeyValueSourceTest), config_should_skip_comments_and_sections) {
+	const String CONFIG = STR(
+		"# comment\n"
+		"[section]\r\n"
+		"  max_jobs =  8 \r\n"
+		"; comment\n"
+		"\n"
+		"verbose\n"
+		"--name=x y");
+	ConfigSource config(CONFIG.data(), CONFIG.data() + CONFIG.size());
+	typename Source::StringView label;
+	typename Source::StringView value;
+	ASSERT_TRUE(config.next(label, value));
+	EXPECT_EQ(String(STR("--max-jobs")), label.str());
+	EXPECT_EQ(String(STR("8")), value.str());
+	ASSERT_TRUE(config.next(label, value));
+	EXPECT_EQ(String(STR("--verbose")), label.str());
+	EXPECT_TRUE(value.empty());
+	ASSERT_TRUE(config.next(label, value));
+	EXPECT_EQ(String(STR("--name")), label.str());
+	EXPECT_EQ(String(STR("x y")), value.str());
+	EXPECT_FALSE(config.next(label, value));
+	EXPECT_FALSE(config.ignoresUnknownLabels());
+}
+
+TEST_F(PREFIX(KeyValueSourceTest), later_source_and_command_line_should_win) {
+	const String CONFIG = STR("max_jobs=2\nname=config\nverbose=yes\n");
+	ConfigSource config(CONFIG.data(), CONFIG.data() + CONFIG.size());
+	const Ch* const ENV[] = { STR("APP_MAX_JOBS=4"), 0 };
+	EnvironmentSource env(ENV, STR("APP_"));
+	Source* const SOURCES[] = { &config, &env };
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("--name"), STR("argv"), STR("file")
+	};
+	Options options;
+	EXPECT_TRUE(this->parser.tryParseWithSources(
+		options, 4, ARGS, SOURCES, 2).isSuccess());
+	EXPECT_EQ(4, options.maxJobs);
+	EXPECT_EQ(STR("argv"), options.name);
+	EXPECT_TRUE(options.verbose);
+	EXPECT_EQ(STR("file"), options.lastFile);
+}
+
+TEST_F(PREFIX(KeyValueSourceTest), list_option_should_take_values_of_last_source) {
+	const String CONFIG = STR("include=a\ninclude=b\n");
+	ConfigSource config(CONFIG.data(), CONFIG.data() + CONFIG.size());
+	Source* const CONFIG_ONLY[] = { &config };
+	Options options;
+	EXPECT_TRUE(this->parse(options, STR("f"), CONFIG_ONLY, 1).isSuccess());
+	ASSERT_EQ(2u, options.includes.size());
+	EXPECT_EQ(STR("a"), options.includes[0]);
+	EXPECT_EQ(STR("b"), options.includes[1]);
+	// a later source replaces the values of an earlier one
+	ConfigSource config2(CONFIG.data(), CONFIG.data() + CONFIG.size());
+	const Ch* const ENV[] = { STR("APP_INCLUDE=c"), 0 };
+	EnvironmentSource env(ENV, STR("APP_"));
+	Source* const SOURCES[] = { &config2, &env };
+	Options overridden;
+	EXPECT_TRUE(this->parse(overridden, STR("f"), SOURCES, 2).isSuccess());
+	ASSERT_EQ(1u, overridden.includes.size());
+	EXPECT_EQ(STR("c"), overridden.includes[0]);
+	// the command line replaces the values of every source
+	ConfigSource config3(CONFIG.data(), CONFIG.data() + CONFIG.size());
+	Source* const AGAIN[] = { &config3 };
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("--include"), STR("d"), STR("--include"),
+		STR("e"), STR("f")
+	};
+	Options onCommandLine;
+	EXPECT_TRUE(this->parser.tryParseWithSources(
+		onCommandLine, 6, ARGS, AGAIN, 1).isSuccess());
+	ASSERT_EQ(2u, onCommandLine.includes.size());
+	EXPECT_EQ(STR("d"), onCommandLine.includes[0]);
+	EXPECT_EQ(STR("e"), onCommandLine.includes[1]);
+}
+
+TEST_F(PREFIX(KeyValueSourceTest), only_winning_value_should_be_formatted) {
+	const String CONFIG = STR("max_jobs=bad\n");
+	ConfigSource config(CONFIG.data(), CONFIG.data() + CONFIG.size());
+	const Ch* const ENV[] = { STR("APP_MAX_JOBS=3"), 0 };
+	EnvironmentSource env(ENV, STR("APP_"));
+	Source* const SOURCES[] = { &config, &env };
+	Options options;
+	EXPECT_TRUE(this->parse(options, STR("f"), SOURCES, 2).isSuccess());
+	EXPECT_EQ(3, options.maxJobs);
+	// the bad value wins without the environment variable
+	ConfigSource alone(CONFIG.data(), CONFIG.data() + CONFIG.size());
+	Source* const ALONE[] = { &alone };
+	const ParseResult result = this->parse(options, STR("f"), ALONE, 1);
+	EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+	EXPECT_EQ(-1, result.getArgIndex());
+	EXPECT_EQ(String(STR("bad")), result.getValue().str());
+}
+
+TEST_F(PREFIX(KeyValueSourceTest), off_value_should_not_apply_flag) {
+	const String CONFIG = STR("verbose=Off\n");
+	ConfigSource config(CONFIG.data(), CONFIG.data() + CONFIG.size());
+	Source* const SOURCES[] = { &config };
+	Options options;
+	EXPECT_TRUE(this->parse(options, STR("f"), SOURCES, 1).isSuccess());
+	EXPECT_FALSE(options.verbose);
+	EXPECT_TRUE(Source::isOff(STR("FALSE")));
+	EXPECT_FALSE(Source::isOff(STR("offset")));
+}
+
+TEST_F(PREFIX(KeyValueSourceTest), unknown_key_in_config_should_be_error) {
+	const String CONFIG = STR("unknown_key=1\n");
+	ConfigSource config(CONFIG.data(), CONFIG.data() + CONFIG.size());
+	Source* const SOURCES[] = { &config };
+	Options options;
+	const ParseResult result = this->parse(options, STR("f"), SOURCES, 1);
+	EXPECT_EQ(ParseResult::UNKNOWN_OPTION, result.getKind());
+	EXPECT_EQ(String(STR("--unknown-key")), result.getLabel().str());
+}
+
+TEST_F(PREFIX(KeyValueSourceTest), config_should_be_read_from_file) {
+	const std::string path = sizeof(Ch) == 1
+		? "config_char.ini" : "config_wchar_t.ini";
+	{
+		std::ofstream out(path.c_str(), std::ios::binary);
+		out << "name = from file\n";
+	}
+	ConfigSource config;
+	const String widePath(path.begin(), path.end());
+	EXPECT_TRUE(config.open(widePath.c_str()));
+	Source* const SOURCES[] = { &config };
+	Options options;
+	EXPECT_TRUE(this->parse(options, STR("f"), SOURCES, 1).isSuccess());
+	EXPECT_EQ(STR("from file"), options.name);
+	std::remove(path.c_str());
+	EXPECT_FALSE(config.open(STR("no/such/config.ini")));
+}
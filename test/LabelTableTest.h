@@ -0,0 +1,115 @@
+// This file provides tests for LabelTable regardless of character type.
+// You need to define the followings before including this header,
+//  - Ch: character type
+//  - String: string type of Ch. must be compatible with std::basic_string
+//  - STR(str): macro to create a character and string literal
+//  - PREFIX(name): macro which prefixes a test case name to avoid conflict
+//
+
+#include "optparse/LabelTable.h"
+
+#include <sstream>
+#include <vector>
+#include "gtest/gtest.h"
+
+/** Builds a table of the labels "--label0", "--label1", ... */
+static void PREFIX(buildManyLabels)(optparse::LabelTable< Ch >& table,
+									std::vector< String >& labels,
+									int n)
+{
+	typedef optparse::LabelTable< Ch > Table;
+	labels.clear();
+	for (int i = 0; i < n; ++i) {
+		std::basic_ostringstream< Ch > label;
+		label << STR("--label") << i;
+		labels.push_back(label.str());
+	}
+	std::vector< Table::Entry > entries;
+	for (int i = 0; i < n; ++i) {
+		entries.push_back(Table::Entry(labels[i], i));
+	}
+	table.build(entries);
+}
+
+TEST(PREFIX(LabelTableTest), table_should_be_empty_by_default) {
+	optparse::LabelTable< Ch > table;
+	EXPECT_TRUE(table.empty());
+	EXPECT_EQ(0U, table.size());
+	EXPECT_EQ(-1, table.find(STR("-o")));
+}
+
+TEST(PREFIX(LabelTableTest), find_should_return_value_associated_with_label) {
+	typedef optparse::LabelTable< Ch > Table;
+	Table table;
+	std::vector< Table::Entry > entries;
+	entries.push_back(Table::Entry(STR("-o"), 0));
+	entries.push_back(Table::Entry(STR("--option"), 1));
+	entries.push_back(Table::Entry(STR("-"), 2));
+	table.build(entries);
+	ASSERT_EQ(3U, table.size());
+	EXPECT_EQ(0, table.find(STR("-o")));
+	EXPECT_EQ(1, table.find(STR("--option")));
+	EXPECT_EQ(2, table.find(STR("-")));
+}
+
+TEST(PREFIX(LabelTableTest), find_should_return_minus_one_for_unknown_label) {
+	typedef optparse::LabelTable< Ch > Table;
+	Table table;
+	std::vector< Table::Entry > entries;
+	entries.push_back(Table::Entry(STR("-o"), 0));
+	entries.push_back(Table::Entry(STR("--option"), 1));
+	table.build(entries);
+	EXPECT_EQ(-1, table.find(STR("-O")));
+	EXPECT_EQ(-1, table.find(STR("--opt")));
+	EXPECT_EQ(-1, table.find(STR("--options")));
+	EXPECT_EQ(-1, table.find(STR("")));
+}
+
+TEST(PREFIX(LabelTableTest), table_should_be_independent_of_source_strings) {
+	typedef optparse::LabelTable< Ch > Table;
+	Table table;
+	{
+		String label(STR("--temporary"));
+		std::vector< Table::Entry > entries;
+		entries.push_back(Table::Entry(label, 7));
+		table.build(entries);
+		label.assign(STR("--overwritten"));
+	}
+	EXPECT_EQ(7, table.find(STR("--temporary")));
+}
+
+TEST(PREFIX(LabelTableTest), find_should_work_with_many_labels) {
+	optparse::LabelTable< Ch > table;
+	std::vector< String > labels;
+	PREFIX(buildManyLabels)(table, labels, 1000);
+	ASSERT_EQ(1000U, table.size());
+	for (int i = 0; i < 1000; ++i) {
+		EXPECT_EQ(i, table.find(labels[i]));
+	}
+	EXPECT_EQ(-1, table.find(STR("--label1000")));
+}
+
+TEST(PREFIX(LabelTableTest), slot_count_should_be_proportional_to_number_of_labels) {
+	optparse::LabelTable< Ch > table;
+	std::vector< String > labels;
+	const int COUNTS[] = { 1, 2, 3, 150, 200, 2000 };
+	for (size_t c = 0; c < sizeof(COUNTS) / sizeof(COUNTS[0]); ++c) {
+		const size_t n = static_cast< size_t >(COUNTS[c]);
+		PREFIX(buildManyLabels)(table, labels, COUNTS[c]);
+		// the smallest power of two which is at least 2n
+		EXPECT_GE(table.getSlotCount(), 2 * n);
+		EXPECT_LT(table.getSlotCount(), 4 * n);
+		for (size_t i = 0; i < n; ++i) {
+			EXPECT_EQ(static_cast< int >(i), table.find(labels[i]));
+		}
+	}
+}
+
+TEST(PREFIX(LabelTableTest), clear_should_remove_all_entries) {
+	optparse::LabelTable< Ch > table;
+	std::vector< String > labels;
+	PREFIX(buildManyLabels)(table, labels, 10);
+	table.clear();
+	EXPECT_TRUE(table.empty());
+	EXPECT_EQ(-1, table.find(labels[0]));
+}
@@ -0,0 +1,85 @@
+// This file provides tests for builds without exceptions regardless of
+// character type.
+// You need to define the followings before including this header,
+//  - Ch: character type
+//  - String: string type of Ch. must be compatible with std::basic_string
+//  - STR(str): macro to create a character and string literal
+//  - PREFIX(name): macro which prefixes a test case name to avoid conflict
+//
+// This file must be compiled with exceptions disabled; e.g., -fno-exceptions.
+//
+
+#include "optparse/DefaultFormatter.h"
+#include "optparse/FastFormatter.h"
+#include "optparse/OptionParserBase.h"
+
+#include "gtest/gtest.h"
+
+#if OPTPARSE_EXCEPTIONS
+#error "this test must be compiled without exceptions"
+#endif
+
+/** Options container for the tests. */
+struct PREFIX(NoExceptionsOptions) {
+	/** Integer option. */
+	int n;
+
+	/** Floating point option. */
+	double x;
+
+	/** Unsigned argument. */
+	unsigned int u;
+
+	/** Initializes with default values. */
+	PREFIX(NoExceptionsOptions)() : n(0), x(0.0), u(0) {}
+};
+
+/** Configures a given parser. */
+template < typename Parser >
+static void PREFIX(configureNoExceptionsParser)(Parser& parser) {
+	typedef PREFIX(NoExceptionsOptions) Options;
+	parser.addOption(STR("-n"), STR("N"), STR("integer"), &Options::n);
+	parser.addOption(STR("-x"), STR("X"), STR("number"), &Options::x);
+	parser.appendArgument(STR("U"), STR("unsigned"), &Options::u);
+	parser.compile();
+}
+
+TEST(PREFIX(NoExceptionsTest), tryParseInto_should_parse_valid_arguments) {
+	typedef PREFIX(NoExceptionsOptions) Options;
+	optparse::OptionParserBase< Options, Ch, optparse::DefaultFormatter >
+		parser(STR("test program"));
+	PREFIX(configureNoExceptionsParser)(parser);
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("-n"), STR("-3"), STR("-x"), STR("2.5"), STR("7")
+	};
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options;
+	ASSERT_TRUE(parser.tryParseInto(options, ARGC, ARGS).isSuccess());
+	EXPECT_EQ(-3, options.n);
+	EXPECT_DOUBLE_EQ(2.5, options.x);
+	EXPECT_EQ(7U, options.u);
+}
+
+TEST(PREFIX(NoExceptionsTest), tryParseInto_should_report_errors) {
+	typedef PREFIX(NoExceptionsOptions) Options;
+	typedef optparse::ParseResult< Ch > ParseResult;
+	optparse::OptionParserBase< Options, Ch, optparse::FastFormatter >
+		parser(STR("test program"));
+	PREFIX(configureNoExceptionsParser)(parser);
+	Options options;
+	const Ch* const BAD_ARGS[] = { STR("test.exe"), STR("-n"), STR("1.5") };
+	ParseResult result = parser.tryParseInto(options, 3, BAD_ARGS);
+	EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+	EXPECT_EQ(2, result.getArgIndex());
+	EXPECT_STREQ("invalid integer", result.getMessage());
+	const Ch* const UNKNOWN_ARGS[] = { STR("test.exe"), STR("-q") };
+	result = parser.tryParseInto(options, 2, UNKNOWN_ARGS);
+	EXPECT_EQ(ParseResult::UNKNOWN_OPTION, result.getKind());
+	const Ch* const NEGATIVE_ARGS[] = { STR("test.exe"), STR("-1") };
+	result = parser.tryParseInto(options, 2, NEGATIVE_ARGS);
+	EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+	EXPECT_STREQ("out of range", result.getMessage());
+	const Ch* const NO_ARGS[] = { STR("test.exe") };
+	result = parser.tryParseInto(options, 1, NO_ARGS);
+	EXPECT_EQ(ParseResult::TOO_FEW_ARGUMENTS, result.getKind());
+}
@@ -9,8 +9,13 @@
 #include "gtest_helper.h"
 
 #include "optparse/DefaultFormatter.h"
+#include "optparse/Executor.h"
 #include "optparse/OptionParserBase.h"
 
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
 #include "gtest/gtest.h"
 
 /**
@@ -264,6 +269,18 @@ TEST(PREFIX(OptionParserBaseTest), string_starting_with_dash_followed_by_another
 	EXPECT_TRUE(Parser::isLabel(STR("--9")));
 }
 
+TEST(PREFIX(OptionParserBaseTest), isLabel_should_test_only_referenced_part_of_string_view) {
+	struct Dummy {};
+	typedef optparse::OptionParserBase<
+		Dummy, Ch, optparse::DefaultFormatter > Parser;
+	typedef optparse::StringView< Ch > StringView;
+	const Ch* const LABELS = STR("-1-o");
+	EXPECT_FALSE(Parser::isLabel(StringView(LABELS, 2)));
+	EXPECT_TRUE(Parser::isLabel(StringView(LABELS + 2, 2)));
+	EXPECT_TRUE(Parser::isLabel(StringView(LABELS + 2, 1)));
+	EXPECT_FALSE(Parser::isLabel(StringView(LABELS + 2, 0)));
+}
+
 TEST(PREFIX(OptionParserBaseTest), custom_format_field_option_can_be_added) {
 	struct Dummy {
 		int field;
@@ -422,6 +439,28 @@ TEST(PREFIX(OptionParserBaseTest), custom_format_function_argument_can_be_added)
 	EXPECT_EQ(STR("XFUN"), parser.getArgument(0).getValueName());
 }
 
+TEST(PREFIX(OptionParserBaseTest), view_format_should_receive_view_of_command_line_argument) {
+	struct Options {
+		const Ch* pValue;
+
+		Options() : pValue(0) {}
+	};
+	struct ViewFormat {
+		const Ch* operator ()(const optparse::StringView< Ch >& value) const {
+			return value.data();
+		}
+	};
+	optparse::OptionParserBase< Options, Ch, optparse::DefaultFormatter >
+		parser(STR("test program"));
+	parser.addOption(
+		STR("-v"), STR("V"), STR("view option"), &Options::pValue,
+		ViewFormat());
+	const Ch* const ARGS[] = { STR("test.exe"), STR("-v"), STR("value") };
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options = parser.parse(ARGC, ARGS);
+	EXPECT_EQ(ARGS[2], options.pValue);
+}
+
 /** Fixture for the tests that parse options. */
 class PREFIX(OptionsParsingTest) : public ::testing::Test {
 protected:
@@ -637,6 +676,629 @@ TEST_F(PREFIX(OptionsParsingTest), flag_function_should_be_called_if_specified)
 	EXPECT_TRUE(options.flag);
 }
 
+TEST_F(PREFIX(OptionsParsingTest), replaced_option_should_be_applied) {
+	this->pParser->addOption(
+		STR("-i"), STR("S"), STR("replaced int option"), &Options::s);
+	const Ch* const ARGS[] = { STR("test.exe"), STR("-i"), STR("str") };
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options = this->pParser->parse(ARGC, ARGS);
+	EXPECT_EQ(0, options.i);
+	EXPECT_EQ(STR("str"), options.s);
+}
+
+TEST_F(PREFIX(OptionsParsingTest), equal_texts_of_options_should_be_stored_once) {
+	// "-s" and "--fs" take "STR", "--custom" and "--customf" take "X"
+	EXPECT_EQ(&this->pParser->getOption(2).getValueName(),
+			  &this->pParser->getOption(9).getValueName());
+	EXPECT_EQ(&this->pParser->getOption(3).getValueName(),
+			  &this->pParser->getOption(10).getValueName());
+	EXPECT_NE(&this->pParser->getOption(2).getDescription(),
+			  &this->pParser->getOption(9).getDescription());
+	// the label survives the replacement of the option
+	const String* pLabel = &this->pParser->getOption(0).getLabel();
+	this->pParser->addOption(
+		STR("-i"), STR("STR"), STR("replaced int option"), &Options::s);
+	EXPECT_EQ(pLabel, &this->pParser->getOption(0).getLabel());
+	EXPECT_EQ(STR("-i"), this->pParser->getOption(0).getLabel());
+	EXPECT_EQ(STR("replaced int option"),
+			  this->pParser->getOption(0).getDescription());
+	EXPECT_EQ(&this->pParser->getOption(2).getValueName(),
+			  &this->pParser->getOption(0).getValueName());
+	const Ch* const ARGS[] = { STR("test.exe"), STR("-i"), STR("str") };
+	Options options = this->pParser->parse(3, ARGS);
+	EXPECT_EQ(STR("str"), options.s);
+	typedef optparse::ParseResult< Ch > ParseResult;
+	const ParseResult result = this->pParser->tryParseInto(options, 2, ARGS);
+	EXPECT_EQ(ParseResult::VALUE_NEEDED, result.getKind());
+	EXPECT_EQ(String(STR("-i")), result.getLabel().str());
+}
+
+TEST_F(PREFIX(OptionsParsingTest), compiled_parser_should_apply_options) {
+	this->pParser->compile();
+	ASSERT_TRUE(this->pParser->isCompiled());
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("-i"), STR("4649"), STR("--flag"), STR("-S")
+	};
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options = this->pParser->parse(ARGC, ARGS);
+	EXPECT_EQ(4649, options.i);
+	EXPECT_TRUE(options.flag);
+	EXPECT_EQ(STR("constant"), options.S);
+}
+
+TEST_F(PREFIX(OptionsParsingTest), compiled_parser_should_throw_UnknownOption_for_unknown_option) {
+	this->pParser->compile();
+	const Ch* const ARGS[] = { STR("test.exe"), STR("--unknown") };
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	ASSERT_THROW(this->pParser->parse(ARGC, ARGS),
+				 optparse::UnknownOption< Ch >);
+}
+
+TEST_F(PREFIX(OptionsParsingTest), adding_option_should_discard_compiled_table) {
+	this->pParser->compile();
+	this->pParser->addOption(
+		STR("--new"), STR("N"), STR("new option"), &Options::i);
+	EXPECT_FALSE(this->pParser->isCompiled());
+	const Ch* const ARGS[] = { STR("test.exe"), STR("--new"), STR("12") };
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options = this->pParser->parse(ARGC, ARGS);
+	EXPECT_EQ(12, options.i);
+}
+
+TEST_F(PREFIX(OptionsParsingTest), const_parse_should_not_modify_program_name_of_parser) {
+	const Ch* const ARGS[] = { STR("test.exe"), STR("-i"), STR("4649") };
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	const optparse::OptionParserBase< Options, Ch, optparse::DefaultFormatter >&
+		parser = *this->pParser;
+	String programName;
+	Options options = parser.parse(ARGC, ARGS, programName);
+	EXPECT_EQ(4649, options.i);
+	EXPECT_EQ(STR("test.exe"), programName);
+	EXPECT_EQ(STR(""), parser.getProgramName());
+}
+
+TEST_F(PREFIX(OptionsParsingTest), const_parse_should_be_callable_from_multiple_threads) {
+	this->pParser->compile();
+	const optparse::OptionParserBase< Options, Ch, optparse::DefaultFormatter >*
+		pParser = this->pParser;
+	const int N_THREADS = 4;
+	int results[N_THREADS] = { 0 };
+	std::vector< std::thread > threads;
+	for (int t = 0; t < N_THREADS; ++t) {
+		threads.push_back(std::thread([pParser, &results, t]() {
+			const Ch* const ARGS[] = {
+				STR("test.exe"), STR("-i"), STR("1"), STR("--fn"), STR("2")
+			};
+			const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+			String programName;
+			for (int i = 0; i < 1000; ++i) {
+				Options options = pParser->parse(ARGC, ARGS, programName);
+				results[t] += options.i + options.fn;
+			}
+		}));
+	}
+	for (int t = 0; t < N_THREADS; ++t) {
+		threads[t].join();
+		EXPECT_EQ(3000, results[t]);
+	}
+}
+
+TEST_F(PREFIX(OptionsParsingTest), label_followed_by_equal_should_take_value_after_equal) {
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("--fn=42"), STR("-i=3"), STR("--fs=a=b"),
+		STR("-s=")
+	};
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options;
+	options.s = STR("not empty");
+	this->pParser->parseInto(options, ARGC, ARGS);
+	EXPECT_EQ(42, options.fn);
+	EXPECT_EQ(3, options.i);
+	EXPECT_EQ(STR("a=b"), options.fs);
+	EXPECT_EQ(STR(""), options.s);
+}
+
+TEST_F(PREFIX(OptionsParsingTest), equal_should_not_be_given_to_option_without_value) {
+	typedef optparse::ParseResult< Ch > ParseResult;
+	const Ch* const ARGS[] = { STR("test.exe"), STR("--flag=yes") };
+	Options options;
+	const ParseResult result = this->pParser->tryParseInto(options, 2, ARGS);
+	EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+	EXPECT_EQ(1, result.getArgIndex());
+	EXPECT_EQ(String(STR("--flag")), result.getLabel().str());
+	EXPECT_EQ(String(STR("yes")), result.getValue().str());
+	EXPECT_FALSE(options.flag);
+}
+
+TEST_F(PREFIX(OptionsParsingTest), cluster_of_single_character_options_should_be_applied) {
+	const Ch* const ARGS[] = { STR("test.exe"), STR("-CD"), STR("-Si12") };
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options = this->pParser->parse(ARGC, ARGS);
+	EXPECT_EQ(123, options.C);
+	EXPECT_DOUBLE_EQ(3.14, options.D);
+	EXPECT_EQ(STR("constant"), options.S);
+	EXPECT_EQ(12, options.i);
+}
+
+TEST_F(PREFIX(OptionsParsingTest), last_option_in_cluster_should_take_next_argument) {
+	const Ch* const ARGS[] = { STR("test.exe"), STR("-Cs"), STR("-value") };
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options = this->pParser->parse(ARGC, ARGS);
+	EXPECT_EQ(123, options.C);
+	EXPECT_EQ(STR("-value"), options.s);
+	const Ch* const MISSING[] = { STR("test.exe"), STR("-Cs") };
+	EXPECT_THROW(this->pParser->parse(2, MISSING), optparse::ValueNeeded< Ch >);
+}
+
+TEST_F(PREFIX(OptionsParsingTest), cluster_with_unknown_option_should_be_unknown_option) {
+	typedef optparse::ParseResult< Ch > ParseResult;
+	const Ch* const ARGS[] = { STR("test.exe"), STR("-CX") };
+	Options options;
+	const ParseResult result = this->pParser->tryParseInto(options, 2, ARGS);
+	EXPECT_EQ(ParseResult::UNKNOWN_OPTION, result.getKind());
+	EXPECT_EQ(String(STR("-CX")), result.getLabel().str());
+	const Ch* const LONG[] = { STR("test.exe"), STR("--CD") };
+	EXPECT_THROW(this->pParser->parse(2, LONG), optparse::UnknownOption< Ch >);
+	const Ch* const UNKNOWN_EQ[] = { STR("test.exe"), STR("--unknown=1") };
+	EXPECT_THROW(this->pParser->parse(2, UNKNOWN_EQ),
+				 optparse::UnknownOption< Ch >);
+}
+
+TEST_F(PREFIX(OptionsParsingTest), exact_label_should_precede_cluster) {
+	this->pParser->addOption(
+		STR("-CD"), STR("exact option"), &Options::setFlag);
+	const Ch* const ARGS[] = { STR("test.exe"), STR("-CD") };
+	Options options = this->pParser->parse(2, ARGS);
+	EXPECT_TRUE(options.flag);
+	EXPECT_EQ(0, options.C);
+}
+
+TEST_F(PREFIX(OptionsParsingTest), flag_should_substitute_bool_field) {
+	this->pParser->addFlag(STR("-f"), STR("flag"), &Options::flag);
+	this->pParser->addFlag(
+		STR("--no-flag"), STR("negative flag"), &Options::flag, false);
+	const Ch* const ARGS[] = { STR("test.exe"), STR("-f") };
+	EXPECT_TRUE(this->pParser->parse(2, ARGS).flag);
+	// the last one wins
+	const Ch* const BOTH[] = { STR("test.exe"), STR("-f"), STR("--no-flag") };
+	EXPECT_FALSE(this->pParser->parse(3, BOTH).flag);
+	const Ch* const REVERSED[] = {
+		STR("test.exe"), STR("--no-flag"), STR("-f")
+	};
+	this->pParser->compile();
+	EXPECT_TRUE(this->pParser->parse(3, REVERSED).flag);
+	const optparse::OptionSpec< Ch >& spec = this->pParser->getOption(
+		this->pParser->getOptionCount() - 2);
+	EXPECT_EQ(String(STR("-f")), spec.getLabel());
+	EXPECT_FALSE(spec.needsValue());
+	EXPECT_EQ(String(STR("flag")), spec.getDescription());
+}
+
+TEST_F(PREFIX(OptionsParsingTest), flag_should_be_applied_in_cluster) {
+	this->pParser->addFlag(STR("-f"), STR("flag"), &Options::flag);
+	const Ch* const ARGS[] = { STR("test.exe"), STR("-Cfi"), STR("7") };
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options = this->pParser->parse(ARGC, ARGS);
+	EXPECT_TRUE(options.flag);
+	EXPECT_EQ(123, options.C);
+	EXPECT_EQ(7, options.i);
+	const Ch* const EQ[] = { STR("test.exe"), STR("-f=1") };
+	EXPECT_THROW(this->pParser->parse(2, EQ), optparse::BadValue< Ch >);
+}
+
+TEST_F(PREFIX(OptionsParsingTest), option_replacing_flag_should_be_applied) {
+	this->pParser->addFlag(STR("-f"), STR("flag"), &Options::flag);
+	this->pParser->addOption(STR("-f"), STR("const int option"), &Options::C, 5);
+	const Ch* const ARGS[] = { STR("test.exe"), STR("-f") };
+	Options options = this->pParser->parse(2, ARGS);
+	EXPECT_FALSE(options.flag);
+	EXPECT_EQ(5, options.C);
+}
+
+TEST_F(PREFIX(OptionsParsingTest), resetFields_should_reset_flag) {
+	this->pParser->addFlag(STR("-f"), STR("flag"), &Options::flag);
+	Options options;
+	options.flag = true;
+	this->pParser->resetFields(options, Options());
+	EXPECT_FALSE(options.flag);
+}
+
+TEST_F(PREFIX(OptionsParsingTest), tryParseLazy_should_record_options_without_formatting) {
+	typedef optparse::ParseResult< Ch > ParseResult;
+	typedef typename optparse::OptionParserBase<
+		Options, Ch, optparse::DefaultFormatter >::Matches Matches;
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("-i"), STR("12"), STR("-d"), STR("xyz"),
+		STR("-i"), STR("34"), STR("--flag")
+	};
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Matches matches;
+	EXPECT_TRUE(this->pParser->tryParseLazy(ARGC, ARGS, matches).isSuccess());
+	EXPECT_EQ(4u, matches.size());
+	EXPECT_EQ(2u, matches.count(STR("-i")));
+	EXPECT_TRUE(matches.contains(STR("--flag")));
+	EXPECT_FALSE(matches.contains(STR("-s")));
+	EXPECT_FALSE(matches.contains(STR("--unknown")));
+	EXPECT_EQ(34, matches.get(STR("-i"), 0));
+	EXPECT_EQ(String(STR("none")), matches.get(STR("-s"), String(STR("none"))));
+	// the bad value is reported on access
+	double d = 0;
+	ParseResult result;
+	EXPECT_FALSE(matches.tryGet(STR("-d"), d, result));
+	EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+	EXPECT_EQ(4, result.getArgIndex());
+	EXPECT_EQ(String(STR("-d")), result.getLabel().str());
+	EXPECT_EQ(String(STR("xyz")), result.getValue().str());
+	EXPECT_THROW(matches.get(STR("-d"), 0.0), optparse::BadValue< Ch >);
+}
+
+TEST_F(PREFIX(OptionsParsingTest), lazy_matches_should_be_applied_on_demand) {
+	typedef optparse::ParseResult< Ch > ParseResult;
+	typedef typename optparse::OptionParserBase<
+		Options, Ch, optparse::DefaultFormatter >::Matches Matches;
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("--custom"), STR("abc"), STR("--fn=5"),
+		STR("-CD"), STR("-d"), STR("bad")
+	};
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Matches matches;
+	EXPECT_TRUE(this->pParser->tryParseLazy(ARGC, ARGS, matches).isSuccess());
+	Options options;
+	// the format of the option is used
+	EXPECT_TRUE(matches.tryApply(options, STR("--custom")).isSuccess());
+	EXPECT_EQ(3, options.custom);
+	EXPECT_EQ(0, options.fn);
+	EXPECT_TRUE(matches.tryApply(options, STR("-s")).isSuccess());
+	const ParseResult result = matches.validate(options);
+	EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+	EXPECT_EQ(6, result.getArgIndex());
+	EXPECT_EQ(5, options.fn);
+	EXPECT_EQ(123, options.C);
+	EXPECT_DOUBLE_EQ(3.14, options.D);
+}
+
+TEST_F(PREFIX(OptionsParsingTest), tryParseLazy_should_report_unknown_option_and_missing_value) {
+	typedef optparse::ParseResult< Ch > ParseResult;
+	typedef typename optparse::OptionParserBase<
+		Options, Ch, optparse::DefaultFormatter >::Matches Matches;
+	Matches matches;
+	const Ch* const UNKNOWN[] = { STR("test.exe"), STR("-i"), STR("1"), STR("-X") };
+	ParseResult result = this->pParser->tryParseLazy(4, UNKNOWN, matches);
+	EXPECT_EQ(ParseResult::UNKNOWN_OPTION, result.getKind());
+	EXPECT_EQ(3, result.getArgIndex());
+	const Ch* const MISSING[] = { STR("test.exe"), STR("-i") };
+	result = this->pParser->tryParseLazy(2, MISSING, matches);
+	EXPECT_EQ(ParseResult::VALUE_NEEDED, result.getKind());
+	EXPECT_EQ(0u, matches.size());
+}
+
+/** Options container which has lists. */
+struct PREFIX(ListOptions) {
+	/** Field associated with "-I". */
+	std::vector< String > includes;
+
+	/** Field associated with "-n". */
+	std::vector< int > numbers;
+};
+
+TEST(PREFIX(OptionParserBaseTest), list_option_should_append_every_value) {
+	typedef PREFIX(ListOptions) Options;
+	optparse::OptionParserBase< Options, Ch, optparse::DefaultFormatter >
+		parser(STR("test program"));
+	parser.addListOption(STR("-I"), STR("DIR"), STR("include directory"),
+						 &Options::includes);
+	parser.addListOption(STR("-n"), STR("N,..."), STR("numbers"),
+						 &Options::numbers, Ch(','));
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("-I"), STR("a,b"), STR("-Ic"), STR("-n"),
+		STR("1,2,3"), STR("-I=d"), STR("-n4")
+	};
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options = parser.parse(ARGC, ARGS);
+	ASSERT_EQ(3u, options.includes.size());
+	EXPECT_EQ(STR("a,b"), options.includes[0]);
+	EXPECT_EQ(STR("c"), options.includes[1]);
+	EXPECT_EQ(STR("d"), options.includes[2]);
+	// the vectors are reserved at once
+	EXPECT_EQ(3u, options.includes.capacity());
+	ASSERT_EQ(4u, options.numbers.size());
+	EXPECT_EQ(1, options.numbers[0]);
+	EXPECT_EQ(3, options.numbers[2]);
+	EXPECT_EQ(4, options.numbers[3]);
+	EXPECT_EQ(4u, options.numbers.capacity());
+	EXPECT_FALSE(parser.getOption(1).getValueName().empty());
+	EXPECT_TRUE(parser.getOption(1).needsValue());
+}
+
+TEST(PREFIX(OptionParserBaseTest), list_option_should_report_bad_piece) {
+	typedef PREFIX(ListOptions) Options;
+	typedef optparse::ParseResult< Ch > ParseResult;
+	optparse::OptionParserBase< Options, Ch, optparse::DefaultFormatter >
+		parser(STR("test program"));
+	parser.addListOption(STR("-n"), STR("N,..."), STR("numbers"),
+						 &Options::numbers, Ch(','));
+	const Ch* const ARGS[] = { STR("test.exe"), STR("-n"), STR("1,x,3") };
+	Options options;
+	const ParseResult result = parser.tryParseInto(options, 3, ARGS);
+	EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+	EXPECT_EQ(2, result.getArgIndex());
+	EXPECT_EQ(String(STR("x")), result.getValue().str());
+	EXPECT_EQ(1u, options.numbers.size());
+	Options defaults;
+	defaults.numbers.push_back(9);
+	parser.resetFields(options, defaults);
+	EXPECT_EQ(defaults.numbers, options.numbers);
+}
+
+TEST(PREFIX(OptionParserBaseTest), independent_list_option_should_append_in_order) {
+	typedef PREFIX(ListOptions) Options;
+	typedef optparse::ParseResult< Ch > ParseResult;
+	optparse::OptionParserBase< Options, Ch, optparse::DefaultFormatter >
+		parser(STR("test program"));
+	parser.addListOption(STR("-I"), STR("DIR"), STR("include directory"),
+						 &Options::includes);
+	parser.addListOption(STR("-n"), STR("N,..."), STR("numbers"),
+						 &Options::numbers, Ch(','));
+	parser.setIndependent(STR("-I"));
+	parser.setIndependent(STR("-n"));
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("-I"), STR("a"), STR("-n"), STR("1,2"),
+		STR("-Ib"), STR("-n3")
+	};
+	Options options;
+	EXPECT_TRUE(parser.tryParseParallel(
+		options, 7, ARGS, optparse::ThreadExecutor(2)).isSuccess());
+	ASSERT_EQ(2u, options.includes.size());
+	EXPECT_EQ(STR("a"), options.includes[0]);
+	EXPECT_EQ(STR("b"), options.includes[1]);
+	ASSERT_EQ(3u, options.numbers.size());
+	EXPECT_EQ(3, options.numbers[2]);
+	// the pieces before a bad piece are appended as tryParseInto does
+	const Ch* const BAD[] = { STR("test.exe"), STR("-n"), STR("1,x,3") };
+	options = Options();
+	const ParseResult result = parser.tryParseParallel(
+		options, 3, BAD, optparse::ThreadExecutor(2));
+	EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+	EXPECT_EQ(2, result.getArgIndex());
+	EXPECT_EQ(String(STR("x")), result.getValue().str());
+	EXPECT_EQ(1u, options.numbers.size());
+}
+
+TEST_F(PREFIX(OptionsParsingTest), parseLine_should_apply_options_in_string) {
+	String line(STR("-i 12 -s \"hello world\" --flag --fs 'a b'"));
+	Options options;
+	const optparse::OptionParserBase< Options, Ch, optparse::DefaultFormatter >&
+		parser = *this->pParser;
+	parser.parseLine(options, line);
+	EXPECT_EQ(12, options.i);
+	EXPECT_EQ(STR("hello world"), options.s);
+	EXPECT_TRUE(options.flag);
+	EXPECT_EQ(STR("a b"), options.fs);
+	EXPECT_EQ(STR(""), parser.getProgramName());
+}
+
+TEST_F(PREFIX(OptionsParsingTest), tryParseLine_should_report_error_with_token_index) {
+	typedef optparse::ParseResult< Ch > ParseResult;
+	Options options;
+	String line(STR("-i 1 --unknown"));
+	ParseResult result = this->pParser->tryParseLine(options, line);
+	EXPECT_EQ(ParseResult::UNKNOWN_OPTION, result.getKind());
+	EXPECT_EQ(2, result.getArgIndex());
+	EXPECT_EQ(String(STR("--unknown")), result.getLabel().str());
+	line = STR("-i \"X\"");
+	result = this->pParser->tryParseLine(options, line);
+	EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+	EXPECT_EQ(1, result.getArgIndex());
+	EXPECT_EQ(String(STR("X")), result.getValue().str());
+	line = STR("-i");
+	result = this->pParser->tryParseLine(options, line);
+	EXPECT_EQ(ParseResult::VALUE_NEEDED, result.getKind());
+	EXPECT_EQ(0, result.getArgIndex());
+	line = STR("-i 1 -s 'abc");
+	result = this->pParser->tryParseLine(options, line);
+	EXPECT_EQ(ParseResult::BAD_SYNTAX, result.getKind());
+	EXPECT_EQ(3, result.getArgIndex());
+	EXPECT_STREQ("unterminated quote", result.getMessage());
+	EXPECT_THROW(result.raise(), optparse::BadSyntax);
+	line = STR("");
+	EXPECT_TRUE(this->pParser->tryParseLine(options, line).isSuccess());
+}
+
+TEST_F(PREFIX(OptionsParsingTest), parseLine_should_throw_BadSyntax_for_unterminated_escape) {
+	String line(STR("-s abc\\"));
+	Options options;
+	EXPECT_THROW(this->pParser->parseLine(options, line), optparse::BadSyntax);
+}
+
+TEST_F(PREFIX(OptionsParsingTest), tryParseBatch_should_parse_each_command_line) {
+	typedef optparse::ParseResult< Ch > ParseResult;
+	const Ch* const ARGS1[] = { STR("test.exe"), STR("-i"), STR("1") };
+	const Ch* const ARGS2[] = { STR("test.exe"), STR("-i"), STR("X") };
+	const Ch* const ARGS3[] = { STR("other.exe"), STR("--flag") };
+	const optparse::ArgvSpan< Ch > spans[] = {
+		optparse::ArgvSpan< Ch >(3, ARGS1),
+		optparse::ArgvSpan< Ch >(3, ARGS2),
+		optparse::ArgvSpan< Ch >(2, ARGS3),
+		optparse::ArgvSpan< Ch >()
+	};
+	std::vector< Options > options(4);
+	std::vector< ParseResult > results(4);
+	const optparse::OptionParserBase< Options, Ch, optparse::DefaultFormatter >&
+		parser = *this->pParser;
+	parser.tryParseBatch(spans, spans + 4, options.begin(), results.begin());
+	EXPECT_TRUE(results[0].isSuccess());
+	EXPECT_EQ(1, options[0].i);
+	EXPECT_EQ(ParseResult::BAD_VALUE, results[1].getKind());
+	EXPECT_EQ(2, results[1].getArgIndex());
+	EXPECT_TRUE(results[2].isSuccess());
+	EXPECT_TRUE(options[2].flag);
+	EXPECT_FALSE(options[0].flag);
+	EXPECT_EQ(ParseResult::TOO_FEW_ARGUMENTS, results[3].getKind());
+	EXPECT_EQ(STR(""), parser.getProgramName());
+}
+
+TEST_F(PREFIX(OptionsParsingTest), tryParseBatch_with_ThreadExecutor_should_match_serial_parsing) {
+	typedef optparse::ParseResult< Ch > ParseResult;
+	this->pParser->compile();
+	const Ch* const GOOD[] = {
+		STR("test.exe"), STR("-i"), STR("7"), STR("--fn"), STR("2")
+	};
+	const Ch* const BAD[] = { STR("test.exe"), STR("--unknown") };
+	const size_t N = 1000;
+	std::vector< optparse::ArgvSpan< Ch > > spans;
+	for (size_t i = 0; i < N; ++i) {
+		spans.push_back(i % 3 == 0
+			? optparse::ArgvSpan< Ch >(2, BAD)
+			: optparse::ArgvSpan< Ch >(5, GOOD));
+	}
+	std::vector< Options > serialOptions(N);
+	std::vector< ParseResult > serialResults(N);
+	this->pParser->tryParseBatch(spans.begin(), spans.end(),
+								 serialOptions.begin(), serialResults.begin(),
+								 optparse::SerialExecutor());
+	std::vector< Options > options(N);
+	std::vector< ParseResult > results(N);
+	this->pParser->tryParseBatch(spans.begin(), spans.end(),
+								 options.begin(), results.begin(),
+								 optparse::ThreadExecutor(4));
+	for (size_t i = 0; i < N; ++i) {
+		EXPECT_EQ(serialResults[i].getKind(), results[i].getKind());
+		EXPECT_EQ(serialOptions[i].i, options[i].i);
+		EXPECT_EQ(serialOptions[i].fn, options[i].fn);
+	}
+	EXPECT_EQ(ParseResult::UNKNOWN_OPTION, results[0].getKind());
+	EXPECT_EQ(7, options[1].i);
+}
+
+TEST_F(PREFIX(OptionsParsingTest), tryParseParallel_should_apply_values_in_order) {
+	EXPECT_TRUE(this->pParser->setIndependent(STR("-i")));
+	EXPECT_TRUE(this->pParser->setIndependent(STR("-s")));
+	EXPECT_TRUE(this->pParser->setIndependent(STR("--fn")));
+	EXPECT_TRUE(this->pParser->setIndependent(STR("--flag")));
+	EXPECT_FALSE(this->pParser->setIndependent(STR("--unknown")));
+	EXPECT_TRUE(this->pParser->isIndependent(STR("-i")));
+	EXPECT_FALSE(this->pParser->isIndependent(STR("-d")));
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("-i"), STR("1"), STR("-s"), STR("abc"),
+		STR("--fn"), STR("2"), STR("-d"), STR("1.5"), STR("-i"), STR("3"),
+		STR("--flag"), STR("--fn=4")
+	};
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	const Options serial = this->pParser->parse(ARGC, ARGS);
+	Options options;
+	EXPECT_TRUE(this->pParser->tryParseParallel(
+		options, ARGC, ARGS, optparse::ThreadExecutor(4)).isSuccess());
+	// the last value wins
+	EXPECT_EQ(3, options.i);
+	EXPECT_EQ(serial.i, options.i);
+	EXPECT_EQ(STR("abc"), options.s);
+	EXPECT_DOUBLE_EQ(1.5, options.d);
+	EXPECT_EQ(4, options.fn);
+	EXPECT_TRUE(options.flag);
+	// replacing an option clears the mark
+	this->pParser->addOption(
+		STR("-i"), STR("N"), STR("int option"), &Options::i);
+	EXPECT_FALSE(this->pParser->isIndependent(STR("-i")));
+}
+
+TEST_F(PREFIX(OptionsParsingTest), tryParseParallel_should_report_first_error_in_order) {
+	typedef optparse::ParseResult< Ch > ParseResult;
+	this->pParser->setIndependent(STR("-i"));
+	this->pParser->setIndependent(STR("--fn"));
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("-i"), STR("1"), STR("-d"), STR("bad"),
+		STR("--fn"), STR("X"), STR("-i"), STR("2")
+	};
+	Options options;
+	ParseResult result = this->pParser->tryParseParallel(
+		options, 9, ARGS, optparse::ThreadExecutor(4));
+	EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+	EXPECT_EQ(4, result.getArgIndex());
+	EXPECT_EQ(1, options.i);
+	// an independent value is reported at its position
+	const Ch* const LATER[] = {
+		STR("test.exe"), STR("-s"), STR("a"), STR("--fn"), STR("X"),
+		STR("-i"), STR("Y")
+	};
+	options = Options();
+	result = this->pParser->tryParseParallel(
+		options, 7, LATER, optparse::SerialExecutor());
+	EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+	EXPECT_EQ(4, result.getArgIndex());
+	EXPECT_EQ(String(STR("--fn")), result.getLabel().str());
+	EXPECT_EQ(String(STR("X")), result.getValue().str());
+	EXPECT_EQ(STR("a"), options.s);
+	EXPECT_EQ(0, options.i);
+	EXPECT_THROW(this->pParser->parseParallel(
+					 options, 7, LATER, optparse::SerialExecutor()),
+				 optparse::BadValue< Ch >);
+}
+
+TEST(PREFIX(OptionParserBaseTest), ThreadExecutor_should_run_each_task_once) {
+	const size_t N = 37;
+	std::vector< int > counts(N, 0);
+	optparse::ThreadExecutor(4)(N, [&counts](size_t i) { ++counts[i]; });
+	EXPECT_EQ(std::vector< int >(N, 1), counts);
+	// more threads than tasks
+	optparse::ThreadExecutor(64)(3, [&counts](size_t i) { ++counts[i]; });
+	EXPECT_EQ(2, counts[2]);
+	EXPECT_EQ(1, counts[3]);
+}
+
+TEST(PREFIX(OptionParserBaseTest), ThreadExecutor_should_rethrow_exception_thrown_by_task) {
+	EXPECT_THROW(
+		optparse::ThreadExecutor(4)(100, [](size_t i) {
+			if (i == 70) {
+				throw optparse::ConfigException("error");
+			}
+		}),
+		optparse::ConfigException);
+}
+
+TEST_F(PREFIX(OptionsParsingTest), parseInto_should_keep_fields_not_specified) {
+	const Ch* const ARGS[] = { STR("test.exe"), STR("-i"), STR("4649") };
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options;
+	options.d = 1.5;
+	options.s = STR("previous");
+	this->pParser->parseInto(options, ARGC, ARGS);
+	EXPECT_EQ(4649, options.i);
+	EXPECT_DOUBLE_EQ(1.5, options.d);
+	EXPECT_EQ(STR("previous"), options.s);
+	EXPECT_EQ(STR("test.exe"), this->pParser->getProgramName());
+}
+
+TEST_F(PREFIX(OptionsParsingTest), const_parseInto_should_store_program_name) {
+	const Ch* const ARGS[] = { STR("test.exe"), STR("-s"), STR("str") };
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	const optparse::OptionParserBase< Options, Ch, optparse::DefaultFormatter >&
+		parser = *this->pParser;
+	Options options;
+	String programName;
+	parser.parseInto(options, ARGC, ARGS, programName);
+	EXPECT_EQ(STR("str"), options.s);
+	EXPECT_EQ(STR("test.exe"), programName);
+	EXPECT_EQ(STR(""), parser.getProgramName());
+}
+
+TEST_F(PREFIX(OptionsParsingTest), resetFields_should_reset_only_substituted_fields) {
+	Options defaults;
+	defaults.i = 1;
+	defaults.C = 2;
+	defaults.s = STR("default");
+	Options options;
+	options.i = 10;
+	options.C = 20;
+	options.s = STR("used");
+	options.fn = 30;
+	this->pParser->resetFields(options, defaults);
+	EXPECT_EQ(1, options.i);
+	EXPECT_EQ(2, options.C);
+	EXPECT_EQ(STR("default"), options.s);
+	// substituted only through a function
+	EXPECT_EQ(30, options.fn);
+}
+
 TEST_F(PREFIX(OptionsParsingTest), TooFewArguments_should_be_thrown_if_no_arguments_are_given) {
 	const Ch* const ARGS[] = { STR("ignored") };
 	const int ARGC = 0;
@@ -669,6 +1331,248 @@ TEST_F(PREFIX(OptionsParsingTest), UnknownOption_should_be_thrown_if_unknown_opt
 				 optparse::UnknownOption< Ch >);
 }
 
+TEST_F(PREFIX(OptionsParsingTest), UnknownOption_should_have_similar_labels) {
+	const Ch* const ARGS[] = { STR("test.exe"), STR("--custon") };
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	for (int compiled = 0; compiled < 2; ++compiled) {
+		if (compiled) {
+			this->pParser->compile();
+		}
+		try {
+			this->pParser->parse(ARGC, ARGS);
+			ADD_FAILURE() << "UnknownOption is not thrown";
+		} catch (optparse::UnknownOption< Ch >& ex) {
+			ASSERT_EQ(2U, ex.getSuggestions().size());
+			EXPECT_EQ(STR("--custom"), ex.getSuggestions()[0]);
+			EXPECT_EQ(STR("--customf"), ex.getSuggestions()[1]);
+		}
+	}
+}
+
+TEST_F(PREFIX(OptionsParsingTest), suggestLabels_should_append_at_most_max_count) {
+	std::vector< String > suggestions;
+	EXPECT_EQ(1U, this->pParser->suggestLabels(STR("--flga"), suggestions));
+	EXPECT_EQ(0U, this->pParser->suggestLabels(STR("--zzzzzz"), suggestions));
+	EXPECT_EQ(1U,
+			  this->pParser->suggestLabels(STR("--fx"), suggestions, 1));
+	ASSERT_EQ(2U, suggestions.size());
+	EXPECT_EQ(STR("--flag"), suggestions[0]);
+	EXPECT_EQ(STR("--fn"), suggestions[1]);
+}
+
+TEST_F(PREFIX(OptionsParsingTest), tryParseInto_should_succeed_for_valid_arguments) {
+	typedef optparse::ParseResult< Ch > ParseResult;
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("-i"), STR("12"), STR("--flag"), STR("-C")
+	};
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options;
+	ParseResult result = this->pParser->tryParseInto(options, ARGC, ARGS);
+	EXPECT_TRUE(result.isSuccess());
+	EXPECT_EQ(ParseResult::SUCCESS, result.getKind());
+	EXPECT_EQ(-1, result.getArgIndex());
+	EXPECT_EQ(12, options.i);
+	EXPECT_TRUE(options.flag);
+	EXPECT_EQ(123, options.C);
+	EXPECT_EQ(STR("test.exe"), this->pParser->getProgramName());
+}
+
+TEST_F(PREFIX(OptionsParsingTest), tryParseInto_should_report_unknown_option) {
+	typedef optparse::ParseResult< Ch > ParseResult;
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("-i"), STR("1"), STR("--unknown")
+	};
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options;
+	ParseResult result = this->pParser->tryParseInto(options, ARGC, ARGS);
+	EXPECT_FALSE(result.isSuccess());
+	EXPECT_EQ(ParseResult::UNKNOWN_OPTION, result.getKind());
+	EXPECT_EQ(3, result.getArgIndex());
+	EXPECT_EQ(String(STR("--unknown")), result.getLabel().str());
+	EXPECT_STREQ("unknown option", result.getMessage());
+	EXPECT_THROW(result.raise(), optparse::UnknownOption< Ch >);
+}
+
+TEST_F(PREFIX(OptionsParsingTest), tryParseInto_should_report_value_needed) {
+	typedef optparse::ParseResult< Ch > ParseResult;
+	const Ch* const ARGS[] = { STR("test.exe"), STR("-i") };
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options;
+	ParseResult result = this->pParser->tryParseInto(options, ARGC, ARGS);
+	EXPECT_EQ(ParseResult::VALUE_NEEDED, result.getKind());
+	EXPECT_EQ(1, result.getArgIndex());
+	EXPECT_EQ(String(STR("-i")), result.getLabel().str());
+	EXPECT_THROW(result.raise(), optparse::ValueNeeded< Ch >);
+}
+
+TEST_F(PREFIX(OptionsParsingTest), tryParseInto_should_report_bad_value) {
+	typedef optparse::ParseResult< Ch > ParseResult;
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("-s"), STR("str"), STR("-i"), STR("AHO")
+	};
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options;
+	options.i = 7;
+	ParseResult result = this->pParser->tryParseInto(options, ARGC, ARGS);
+	EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+	EXPECT_EQ(4, result.getArgIndex());
+	EXPECT_EQ(String(STR("-i")), result.getLabel().str());
+	EXPECT_EQ(String(STR("AHO")), result.getValue().str());
+	EXPECT_STREQ("invalid integer", result.getMessage());
+	// options before the error are applied, and the bad one is not
+	EXPECT_EQ(STR("str"), options.s);
+	EXPECT_EQ(7, options.i);
+	try {
+		result.raise();
+		FAIL() << "BadValue should have been thrown";
+	} catch (optparse::BadValue< Ch >& ex) {
+		EXPECT_EQ("invalid integer", ex.getMessage());
+		EXPECT_EQ(STR("-i"), ex.getLabel());
+		EXPECT_EQ(STR("AHO"), ex.getValue());
+	}
+}
+
+TEST_F(PREFIX(OptionsParsingTest), tryParseInto_should_report_bad_value_for_function_option) {
+	typedef optparse::ParseResult< Ch > ParseResult;
+	const Ch* const ARGS[] = { STR("test.exe"), STR("--fd"), STR("real") };
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options;
+	String programName;
+	ParseResult result =
+		static_cast< const optparse::OptionParserBase<
+			Options, Ch, optparse::DefaultFormatter >& >(*this->pParser)
+				.tryParseInto(options, ARGC, ARGS, programName);
+	EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+	EXPECT_EQ(2, result.getArgIndex());
+	EXPECT_EQ(String(STR("--fd")), result.getLabel().str());
+	EXPECT_STREQ("invalid number", result.getMessage());
+	EXPECT_EQ(STR("test.exe"), programName);
+	EXPECT_TRUE(this->pParser->getProgramName().empty());
+}
+
+TEST_F(PREFIX(OptionsParsingTest), tryParseInto_should_report_too_many_and_too_few_arguments) {
+	typedef optparse::ParseResult< Ch > ParseResult;
+	const Ch* const ARGS[] = { STR("test.exe"), STR("-C"), STR("arg") };
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options;
+	ParseResult result = this->pParser->tryParseInto(options, ARGC, ARGS);
+	EXPECT_EQ(ParseResult::TOO_MANY_ARGUMENTS, result.getKind());
+	EXPECT_EQ(2, result.getArgIndex());
+	EXPECT_THROW(result.raise(), optparse::TooManyArguments);
+	result = this->pParser->tryParseInto(options, 0, ARGS);
+	EXPECT_EQ(ParseResult::TOO_FEW_ARGUMENTS, result.getKind());
+	EXPECT_EQ(0, result.getArgIndex());
+	EXPECT_THROW(result.raise(), optparse::TooFewArguments);
+}
+
+TEST(PREFIX(OptionParserBaseTest), moved_result_should_refer_to_moved_copy) {
+	typedef optparse::ParseResult< Ch > ParseResult;
+	// longer than the small string buffer, so the copy is handed over
+	String label(STR("--a-label-long-enough-to-be-allocated"));
+	String value(STR("a-value-long-enough-to-be-allocated-as-well"));
+	ParseResult pinned(ParseResult::BAD_VALUE, "bad", label, value);
+	pinned.setArgIndex(3);
+	pinned.pin();
+	const Ch* const text = pinned.getLabel().data();
+	label.assign(label.size(), Ch('x'));
+	value.assign(value.size(), Ch('x'));
+	ParseResult moved(std::move(pinned));
+	EXPECT_EQ(text, moved.getLabel().data());
+	EXPECT_EQ(STR("--a-label-long-enough-to-be-allocated"),
+			  moved.getLabel().str());
+	EXPECT_EQ(STR("a-value-long-enough-to-be-allocated-as-well"),
+			  moved.getValue().str());
+	EXPECT_EQ(3, moved.getArgIndex());
+	EXPECT_TRUE(pinned.getLabel().empty());
+	ParseResult assigned;
+	assigned = std::move(moved);
+	EXPECT_EQ(text, assigned.getLabel().data());
+	EXPECT_EQ(STR("a-value-long-enough-to-be-allocated-as-well"),
+			  assigned.getValue().str());
+	EXPECT_EQ(std::string("bad"), assigned.getMessage());
+	// a short pinned text is re-pointed too
+	ParseResult shortResult(ParseResult::VALUE_NEEDED, "", STR("-i"));
+	shortResult.pin();
+	assigned = std::move(shortResult);
+	EXPECT_EQ(STR("-i"), assigned.getLabel().str());
+	EXPECT_TRUE(assigned.getValue().empty());
+}
+
+TEST(PREFIX(OptionParserBaseTest), tryParseInto_should_translate_exceptions_thrown_by_functions_and_formats) {
+	typedef optparse::ParseResult< Ch > ParseResult;
+	struct Options {
+		int n;
+
+		Options() : n(0) {}
+
+		static void help(Options&) {
+			throw optparse::HelpNeeded();
+		}
+
+		static int throwingFormat(const String& value) {
+			throw optparse::BadValue< Ch >("custom error", value);
+		}
+	};
+	optparse::OptionParserBase< Options, Ch, optparse::DefaultFormatter >
+		parser(STR("test program"));
+	parser.addOption(STR("-h"), STR("help"), &Options::help);
+	parser.addOption(
+		STR("-n"), STR("N"), STR("custom"), &Options::n,
+		&Options::throwingFormat);
+	const Ch* const HELP_ARGS[] = { STR("test.exe"), STR("-h") };
+	Options options;
+	ParseResult result = parser.tryParseInto(options, 2, HELP_ARGS);
+	EXPECT_EQ(ParseResult::HELP_NEEDED, result.getKind());
+	EXPECT_EQ(1, result.getArgIndex());
+	EXPECT_THROW(result.raise(), optparse::HelpNeeded);
+	const Ch* const BAD_ARGS[] = { STR("test.exe"), STR("-n"), STR("x") };
+	result = parser.tryParseInto(options, 3, BAD_ARGS);
+	EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+	EXPECT_EQ(2, result.getArgIndex());
+	EXPECT_EQ(String(STR("-n")), result.getLabel().str());
+	EXPECT_EQ(String(STR("x")), result.getValue().str());
+	EXPECT_STREQ("custom error", result.getMessage());
+}
+
+TEST(PREFIX(OptionParserBaseTest), tryFormat_of_custom_format_should_be_used) {
+	typedef optparse::ParseResult< Ch > ParseResult;
+	struct Options {
+		int n;
+
+		Options() : n(0) {}
+	};
+	struct TryFormat {
+		int operator ()(const optparse::StringView< Ch >&) const {
+			ADD_FAILURE() << "tryFormat should have been called";
+			return 0;
+		}
+
+		bool tryFormat(const optparse::StringView< Ch >& value,
+					   int& n,
+					   const char*& message) const
+		{
+			if (value.size() > 3) {
+				message = "too long";
+				return false;
+			}
+			n = static_cast< int >(value.size());
+			return true;
+		}
+	};
+	optparse::OptionParserBase< Options, Ch, optparse::DefaultFormatter >
+		parser(STR("test program"));
+	parser.addOption(
+		STR("-n"), STR("N"), STR("custom"), &Options::n, TryFormat());
+	const Ch* const ARGS[] = { STR("test.exe"), STR("-n"), STR("abc") };
+	Options options;
+	EXPECT_TRUE(parser.tryParseInto(options, 3, ARGS).isSuccess());
+	EXPECT_EQ(3, options.n);
+	const Ch* const BAD_ARGS[] = { STR("test.exe"), STR("-n"), STR("abcd") };
+	ParseResult result = parser.tryParseInto(options, 3, BAD_ARGS);
+	EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+	EXPECT_STREQ("too long", result.getMessage());
+}
+
 /** Fixture for the tests that parse arguments. */
 class PREFIX(ArgumentsParsingTest) : public ::testing::Test {
 protected:
@@ -786,6 +1690,235 @@ TEST_F(PREFIX(ArgumentsParsingTest), arguments_should_be_substituted) {
 	EXPECT_EQ(15, args.customf);
 }
 
+TEST_F(PREFIX(ArgumentsParsingTest), parseLine_should_substitute_arguments_like_argv) {
+	typedef optparse::ParseResult< Ch > ParseResult;
+	String line(STR("123 3.14 str custom -3 -1.5e-3 called "
+					"'custom function'"));
+	Arguments args;
+	this->pParser->parseLine(args, line);
+	EXPECT_EQ(123, args.i);
+	EXPECT_DOUBLE_EQ(-1.5e-3, args.fd);
+	EXPECT_EQ(15, args.customf);
+	line = STR("1 2");
+	ParseResult result = this->pParser->tryParseLine(args, line);
+	EXPECT_EQ(ParseResult::TOO_FEW_ARGUMENTS, result.getKind());
+	EXPECT_EQ(2, result.getArgIndex());
+}
+
+/** Fixture for the tests of variadic arguments and sessions. */
+class PREFIX(SessionTest) : public ::testing::Test {
+protected:
+	/** Options container. */
+	struct Options {
+		/** Field associated with "-i". */
+		int i;
+
+		/** Field associated with the first argument. */
+		String output;
+
+		/** Number of the files given. */
+		int fileCount;
+
+		/** Sum of the lengths of the files. */
+		size_t totalLength;
+
+		/** Initializes with default values. */
+		Options() : i(0), fileCount(0), totalLength(0) {}
+
+		/** Counts a given file. */
+		static void addFile(Options& options, const String& file) {
+			++options.fileCount;
+			options.totalLength += file.size();
+		}
+	};
+
+	/** Type of the parser. */
+	typedef optparse::OptionParserBase<
+		Options, Ch, optparse::DefaultFormatter > Parser;
+
+	/** Type of a session. */
+	typedef typename Parser::Session Session;
+
+	/** Type of a result. */
+	typedef optparse::ParseResult< Ch > ParseResult;
+
+	/** Parser under test. */
+	Parser parser;
+
+	/** Configures the parser. */
+	PREFIX(SessionTest)() : parser(STR("test program")) {
+		this->parser.addOption(
+			STR("-i"), STR("N"), STR("int option"), &Options::i);
+		this->parser.appendArgument(
+			STR("OUTPUT"), STR("output file"), &Options::output);
+		this->parser.appendVariadicArgument(
+			STR("FILE"), STR("input files"), &Options::addFile);
+	}
+};
+
+TEST_F(PREFIX(SessionTest), variadic_argument_should_take_remaining_values) {
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("out"), STR("a"), STR("-i"), STR("3"),
+		STR("bc"), STR("def")
+	};
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options = this->parser.parse(ARGC, ARGS);
+	EXPECT_EQ(STR("out"), options.output);
+	EXPECT_EQ(3, options.i);
+	EXPECT_EQ(3, options.fileCount);
+	EXPECT_EQ(6U, options.totalLength);
+	EXPECT_TRUE(this->parser.getArgument(1).isVariadic());
+	EXPECT_FALSE(this->parser.getArgument(0).isVariadic());
+}
+
+TEST_F(PREFIX(SessionTest), variadic_argument_may_take_no_value) {
+	const Ch* const ARGS[] = { STR("test.exe"), STR("out") };
+	Options options = this->parser.parse(2, ARGS);
+	EXPECT_EQ(0, options.fileCount);
+	const Ch* const NO_ARGS[] = { STR("test.exe") };
+	EXPECT_THROW(this->parser.parse(1, NO_ARGS), optparse::TooFewArguments);
+}
+
+TEST_F(PREFIX(SessionTest), argument_cannot_be_appended_after_variadic_argument) {
+	EXPECT_THROW(
+		this->parser.appendArgument(
+			STR("MORE"), STR("more"), &Options::output),
+		optparse::ConfigException);
+	EXPECT_THROW(
+		this->parser.appendVariadicArgument(
+			STR("MORE"), STR("more"), &Options::addFile),
+		optparse::ConfigException);
+	EXPECT_EQ(2U, this->parser.getArgumentCount());
+}
+
+TEST_F(PREFIX(SessionTest), session_should_apply_tokens_as_they_are_fed) {
+	Options options;
+	Session session(this->parser, options);
+	EXPECT_TRUE(session.feed(STR("-i")));
+	EXPECT_EQ(0, options.i);
+	EXPECT_TRUE(session.feed(String(STR("42"))));
+	EXPECT_EQ(42, options.i);
+	EXPECT_TRUE(session.feed(STR("out")));
+	for (int i = 0; i < 1000; ++i) {
+		EXPECT_TRUE(session.feed(STR("file")));
+	}
+	EXPECT_EQ(1000, options.fileCount);
+	EXPECT_TRUE(session.finish().isSuccess());
+	EXPECT_EQ(1003, session.getTokenCount());
+}
+
+TEST_F(PREFIX(SessionTest), session_should_read_tokens_from_stream) {
+	std::basic_ostringstream< Ch > content;
+	content << STR("-i 7 out\n");
+	for (int i = 0; i < 10000; ++i) {
+		content << STR("'dir/file name' f") << std::endl;
+	}
+	std::basic_istringstream< Ch > in(content.str());
+	Options options;
+	Session session(this->parser, options);
+	EXPECT_TRUE(session.feedStream(in));
+	EXPECT_TRUE(session.finish().isSuccess());
+	EXPECT_EQ(7, options.i);
+	EXPECT_EQ(20000, options.fileCount);
+	EXPECT_EQ(10000U * 14U, options.totalLength);
+}
+
+TEST_F(PREFIX(SessionTest), session_error_should_not_refer_to_fed_token) {
+	Options options;
+	Session session(this->parser, options);
+	{
+		String token(STR("-i"));
+		session.feed(token);
+		token = STR("XYZ");
+		EXPECT_FALSE(session.feed(token));
+		token = STR("overwritten");
+	}
+	EXPECT_FALSE(session.feed(STR("out")));
+	const ParseResult& result = session.finish();
+	EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+	EXPECT_EQ(1, result.getArgIndex());
+	EXPECT_EQ(String(STR("-i")), result.getLabel().str());
+	EXPECT_EQ(String(STR("XYZ")), result.getValue().str());
+	EXPECT_THROW(result.raise(), optparse::BadValue< Ch >);
+}
+
+TEST_F(PREFIX(SessionTest), finish_should_report_missing_value_and_arguments) {
+	Options options;
+	Session missingValue(this->parser, options);
+	missingValue.feed(STR("out"));
+	missingValue.feed(STR("-i"));
+	const ParseResult& result = missingValue.finish();
+	EXPECT_EQ(ParseResult::VALUE_NEEDED, result.getKind());
+	EXPECT_EQ(1, result.getArgIndex());
+	EXPECT_EQ(String(STR("-i")), result.getLabel().str());
+	Session missingArgument(this->parser, options);
+	EXPECT_EQ(ParseResult::TOO_FEW_ARGUMENTS,
+			  missingArgument.finish().getKind());
+	Session badSyntax(this->parser, options);
+	String line(STR("out 'a"));
+	EXPECT_FALSE(badSyntax.feedLine(&line[0], &line[0] + line.size()));
+	EXPECT_EQ(ParseResult::BAD_SYNTAX, badSyntax.finish().getKind());
+}
+
+TEST(PREFIX(OptionParserBaseTest), parseInto_should_accept_options_without_default_constructor) {
+	struct Options {
+		int i;
+
+		explicit Options(int i) : i(i) {}
+	};
+	optparse::OptionParserBase< Options, Ch, optparse::DefaultFormatter >
+		parser(STR("test program"));
+	parser.addOption(STR("-i"), STR("N"), STR("int option"), &Options::i);
+	const Ch* const ARGS[] = { STR("test.exe"), STR("-i"), STR("3") };
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options(0);
+	parser.parseInto(options, ARGC, ARGS);
+	EXPECT_EQ(3, options.i);
+}
+
+TEST(PREFIX(OptionParserBaseTest), parser_with_arena_should_allocate_options_in_arena) {
+	struct Options {
+		int i;
+
+		String s;
+
+		bool flag;
+
+		Options() : i(0), flag(false) {}
+	};
+	optparse::Arena arena;
+	{
+		optparse::OptionParserBase< Options, Ch, optparse::DefaultFormatter >
+			parser(STR("test program"), arena);
+		parser.addOption(
+			STR("-i"), STR("N"), STR("int option"), &Options::i);
+		parser.addOption(
+			STR("-s"), STR("STR"), STR("string option"), &Options::s);
+		parser.addOption(
+			STR("--flag"), STR("flag option"), &Options::flag, true);
+		parser.appendArgument(STR("S"), STR("string argument"), &Options::s);
+		const size_t usedBytes = arena.getUsedBytes();
+		EXPECT_LT(0U, usedBytes);
+		// replaces "-i"
+		parser.addOption(
+			STR("-i"), STR("M"), STR("another int option"), &Options::i);
+		EXPECT_LT(usedBytes, arena.getUsedBytes());
+		ASSERT_EQ(3U, parser.getOptionCount());
+		EXPECT_EQ(STR("M"), parser.getOption(0).getValueName());
+		parser.compile();
+		const Ch* const ARGS[] = {
+			STR("test.exe"), STR("-i"), STR("3"), STR("--flag"), STR("str")
+		};
+		const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+		Options options = parser.parse(ARGC, ARGS);
+		EXPECT_EQ(3, options.i);
+		EXPECT_TRUE(options.flag);
+		EXPECT_EQ(STR("str"), options.s);
+	}
+	// the parser has destroyed the options but left the memory
+	EXPECT_LT(0U, arena.getUsedBytes());
+}
+
 TEST_F(PREFIX(ArgumentsParsingTest), TooFewArguments_should_be_thrown_if_not_enough_arguments_are_given) {
 	const Ch* const ARGS[] = { STR("test.exe"), STR("123") };
 	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
@@ -840,3 +1973,232 @@ TEST_F(PREFIX(ArgumentsParsingTest), BadValue_should_be_thrown_if_non_number_is_
 	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
 	ASSERT_THROW(this->pParser->parse(ARGC, ARGS), optparse::BadValue< Ch >);
 }
+
+TEST_F(PREFIX(ArgumentsParsingTest), tryParseInto_should_report_missing_argument_at_end) {
+	typedef optparse::ParseResult< Ch > ParseResult;
+	const Ch* const ARGS[] = { STR("test.exe"), STR("123") };
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Arguments args;
+	ParseResult result = this->pParser->tryParseInto(args, ARGC, ARGS);
+	EXPECT_EQ(ParseResult::TOO_FEW_ARGUMENTS, result.getKind());
+	EXPECT_EQ(ARGC, result.getArgIndex());
+	EXPECT_EQ(123, args.i);
+}
+
+TEST_F(PREFIX(ArgumentsParsingTest), tryParseInto_should_report_bad_value_for_function_argument) {
+	typedef optparse::ParseResult< Ch > ParseResult;
+	const Ch* const ARGS[] = {
+		STR("test.exe"),
+		STR("123"),
+		STR("3.14"),
+		STR("str"),
+		STR("custom"),
+		STR("three"),
+		STR("-1.5e-3"),
+		STR("called"),
+		STR("custom function")
+	};
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Arguments args;
+	ParseResult result = this->pParser->tryParseInto(args, ARGC, ARGS);
+	EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+	EXPECT_EQ(5, result.getArgIndex());
+	EXPECT_EQ(String(STR("fn")), result.getLabel().str());
+	EXPECT_EQ(String(STR("three")), result.getValue().str());
+}
+
+/** Fixture of a parser which has sub-commands. */
+class PREFIX(CommandTest) : public ::testing::Test {
+protected:
+	/** Sub-commands. */
+	enum CommandKind {
+		NO_COMMAND,
+		BUILD,
+		DEPLOY
+	};
+
+	/** Options container shared by the commands. */
+	struct Options {
+		/** Field associated with "-v". */
+		bool verbose;
+
+		/** Selected command. */
+		CommandKind command;
+
+		/** Field associated with "-j" of "build". */
+		int jobs;
+
+		/** Field associated with the argument of "build". */
+		String target;
+
+		/** Field associated with "--force" of "deploy". */
+		bool force;
+
+		/** Initializes with default values. */
+		Options()
+			: verbose(false), command(NO_COMMAND), jobs(1), force(false) {}
+
+		/** Ignores a given value. */
+		static void ignore(Options&, const String&) {}
+	};
+
+	/** Type of the parser. */
+	typedef optparse::OptionParserBase<
+		Options, Ch, optparse::DefaultFormatter > Parser;
+
+	/** Type of a result. */
+	typedef optparse::ParseResult< Ch > ParseResult;
+
+	/** Number of the parsers of "build" built so far. */
+	static int buildCount;
+
+	/** Configures the parser of "build". */
+	static void configureBuild(Parser& parser) {
+		++buildCount;
+		parser.addOption(STR("-j"), STR("N"), STR("jobs"), &Options::jobs);
+		parser.appendArgument(
+			STR("TARGET"), STR("target"), &Options::target);
+	}
+
+	/** Configures the parser of "deploy". */
+	static void configureDeploy(Parser& parser) {
+		parser.addFlag(STR("--force"), STR("force"), &Options::force);
+	}
+
+	/** Parser under test. */
+	Parser parser;
+
+	/** Configures the parser. */
+	PREFIX(CommandTest)() : parser(STR("test program")) {
+		buildCount = 0;
+		this->parser.addFlag(STR("-v"), STR("verbose"), &Options::verbose);
+		this->parser.addCommand(STR("build"), STR("builds a target"),
+								&Options::command, BUILD, &configureBuild);
+		this->parser.addCommand(STR("deploy"), STR("deploys"),
+								&Options::command, DEPLOY, &configureDeploy);
+	}
+};
+
+int PREFIX(CommandTest)::buildCount = 0;
+
+TEST_F(PREFIX(CommandTest), command_should_parse_rest_of_arguments) {
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("-v"), STR("build"), STR("-j"), STR("4"),
+		STR("all")
+	};
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options = this->parser.parse(ARGC, ARGS);
+	EXPECT_TRUE(options.verbose);
+	EXPECT_EQ(BUILD, options.command);
+	EXPECT_EQ(4, options.jobs);
+	EXPECT_EQ(STR("all"), options.target);
+	EXPECT_EQ(1, buildCount);
+	EXPECT_EQ(2u, this->parser.getCommandCount());
+	EXPECT_EQ(String(STR("deploy")), this->parser.getCommand(1).getName());
+}
+
+TEST_F(PREFIX(CommandTest), only_selected_command_should_be_built) {
+	const Ch* const ARGS[] = { STR("test.exe"), STR("deploy"), STR("--force") };
+	Options options = this->parser.parse(3, ARGS);
+	EXPECT_EQ(DEPLOY, options.command);
+	EXPECT_TRUE(options.force);
+	EXPECT_EQ(0, buildCount);
+}
+
+TEST_F(PREFIX(CommandTest), errors_in_command_should_have_index_in_argv) {
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("build"), STR("all"), STR("-j")
+	};
+	Options options;
+	ParseResult result = this->parser.tryParseInto(options, 4, ARGS);
+	EXPECT_EQ(ParseResult::VALUE_NEEDED, result.getKind());
+	EXPECT_EQ(3, result.getArgIndex());
+	// the parser of the command has been released
+	EXPECT_EQ(String(STR("-j")), result.getLabel().str());
+	const Ch* const OPTION[] = { STR("test.exe"), STR("build"), STR("-v") };
+	result = this->parser.tryParseInto(options, 3, OPTION);
+	EXPECT_EQ(ParseResult::UNKNOWN_OPTION, result.getKind());
+	EXPECT_EQ(2, result.getArgIndex());
+}
+
+TEST_F(PREFIX(CommandTest), unknown_option_of_command_should_suggest_labels_of_command) {
+	const Ch* const ARGS[] = { STR("test.exe"), STR("deploy"), STR("--forse") };
+	try {
+		this->parser.parse(3, ARGS);
+		FAIL() << "UnknownOption should have been thrown";
+	} catch (optparse::UnknownOption< Ch >& ex) {
+		EXPECT_EQ(STR("--forse"), ex.getLabel());
+		ASSERT_EQ(1U, ex.getSuggestions().size());
+		EXPECT_EQ(STR("--force"), ex.getSuggestions()[0]);
+	}
+	Options options;
+	const ParseResult result = this->parser.tryParseInto(options, 3, ARGS);
+	EXPECT_TRUE(result.hasSuggestions());
+	ASSERT_EQ(1U, result.getSuggestions().size());
+	EXPECT_EQ(STR("--force"), result.getSuggestions()[0]);
+	// "-v" of the parent is not an option of "deploy"
+	const Ch* const PARENT[] = { STR("test.exe"), STR("deploy"), STR("-v") };
+	try {
+		this->parser.parse(3, PARENT);
+		FAIL() << "UnknownOption should have been thrown";
+	} catch (optparse::UnknownOption< Ch >& ex) {
+		EXPECT_TRUE(ex.getSuggestions().empty());
+	}
+}
+
+TEST_F(PREFIX(CommandTest), equal_texts_of_commands_should_be_stored_once) {
+	this->parser.addCommand(STR("ship"), STR("deploys"),
+							&Options::command, DEPLOY, &configureDeploy);
+	this->parser.addOption(STR("--target"), STR("deploy"), STR("deploys"),
+						   &Options::target);
+	ASSERT_EQ(3u, this->parser.getCommandCount());
+	const String& description = this->parser.getCommand(1).getDescription();
+	EXPECT_EQ(&description, &this->parser.getCommand(2).getDescription());
+	EXPECT_EQ(&description, &this->parser.getOption(1).getDescription());
+	// the name of a command and a value name share a copy
+	EXPECT_EQ(&this->parser.getCommand(1).getName(),
+			  &this->parser.getOption(1).getValueName());
+	const Ch* const ARGS[] = { STR("test.exe"), STR("ship"), STR("--force") };
+	const Options options = this->parser.parse(3, ARGS);
+	EXPECT_EQ(DEPLOY, options.command);
+	EXPECT_TRUE(options.force);
+}
+
+TEST_F(PREFIX(CommandTest), command_should_be_required) {
+	const Ch* const MISSING[] = { STR("test.exe"), STR("-v") };
+	EXPECT_THROW(this->parser.parse(2, MISSING), optparse::TooFewArguments);
+	const Ch* const UNKNOWN[] = { STR("test.exe"), STR("clean") };
+	Options options;
+	const ParseResult result = this->parser.tryParseInto(options, 2, UNKNOWN);
+	EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+	EXPECT_STREQ("unknown command", result.getMessage());
+	EXPECT_EQ(String(STR("clean")), result.getValue().str());
+}
+
+TEST_F(PREFIX(CommandTest), session_should_feed_command) {
+	Options options;
+	typename Parser::Session session(this->parser, options);
+	EXPECT_TRUE(session.feed(STR("build")));
+	EXPECT_TRUE(session.feed(STR("-j")));
+	EXPECT_TRUE(session.feed(STR("8")));
+	EXPECT_EQ(ParseResult::TOO_FEW_ARGUMENTS, session.finish().getKind());
+	typename Parser::Session complete(this->parser, options);
+	EXPECT_TRUE(complete.feed(STR("build")));
+	EXPECT_TRUE(complete.feed(STR("lib")));
+	EXPECT_FALSE(complete.feed(STR("extra")));
+	EXPECT_EQ(2, complete.getResult().getArgIndex());
+	EXPECT_EQ(8, options.jobs);
+	EXPECT_EQ(STR("lib"), options.target);
+}
+
+TEST_F(PREFIX(CommandTest), command_cannot_follow_variadic_argument) {
+	struct Configure {
+		void operator ()(Parser&) const {}
+	};
+	Parser parser(STR("variadic"));
+	parser.appendVariadicArgument(
+		STR("X"), STR("values"), &Options::ignore);
+	EXPECT_THROW(parser.addCommand(STR("c"), STR("command"),
+								   &Options::command, BUILD, Configure()),
+				 optparse::ConfigException);
+}
@@ -0,0 +1,209 @@
+// This file provides tests for observers of parsing regardless of character
+// type.
+// You need to define the followings before including this header,
+//  - Ch: character type
+//  - String: string type of Ch. must be compatible with std::basic_string
+//  - STR(str): macro to create a character and string literal
+//  - PREFIX(name): macro which prefixes a test case name to avoid conflict
+//
+
+#include "optparse/DefaultFormatter.h"
+#include "optparse/OptionParserBase.h"
+#include "optparse/ParseObserver.h"
+
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+
+/** Fixture which observes parsing. */
+class PREFIX(ParseObserverTest) : public ::testing::Test {
+protected:
+	/** Options container. */
+	struct Options {
+		/** Field associated with "-n". */
+		int n;
+
+		/** Field associated with "--verbose". */
+		bool verbose;
+
+		/** Field associated with the argument of "build". */
+		String target;
+
+		/** Selected command. */
+		int command;
+
+		/** Initializes with default values. */
+		Options() : n(0), verbose(false), command(0) {}
+	};
+
+	/** Observer which logs the calls. */
+	class LogObserver {
+	public:
+		/** Timer which is the number of the calls so far. */
+		typedef size_t Timer;
+	private:
+		/** Log of the calls. */
+		std::vector< std::string >* pLog;
+	public:
+		/** Initializes without a log. */
+		LogObserver() : pLog(0) {}
+
+		/** Initializes with a log. */
+		explicit LogObserver(std::vector< std::string >& log)
+			: pLog(&log) {}
+
+		/** Logs the start. */
+		Timer startParse() const {
+			this->log("start");
+			return this->pLog != 0 ? this->pLog->size() : 0;
+		}
+
+		/** Logs the end. */
+		void finishParse(const Timer& timer,
+						 const optparse::ParseResult< Ch >& result) const
+		{
+			this->log(result.isSuccess() ? "finish" : "fail");
+			EXPECT_TRUE(this->pLog == 0 || timer <= this->pLog->size());
+		}
+
+		/** Logs an option. */
+		void observeOption(int optionI, bool accepted) const {
+			this->log(std::string("option") + char('0' + optionI)
+					  + (accepted ? "" : "!"));
+		}
+
+		/** Logs an argument. */
+		void observeArgument(size_t pos, bool accepted) const {
+			this->log(std::string("argument") + char('0' + pos)
+					  + (accepted ? "" : "!"));
+		}
+
+		/** Logs a command and returns this observer. */
+		template < typename Parser >
+		LogObserver observeCommand(int commandI, const Parser&) const {
+			this->log(std::string("command") + char('0' + commandI));
+			return *this;
+		}
+	private:
+		/** Appends a given entry to the log. */
+		void log(const std::string& entry) const {
+			if (this->pLog != 0) {
+				this->pLog->push_back(entry);
+			}
+		}
+	};
+
+	/** Type of the parser with statistics. */
+	typedef optparse::OptionParserBase< Options,
+										Ch,
+										optparse::DefaultFormatter,
+										optparse::StatisticsObserver > Parser;
+
+	/** Type of the parser with the logging observer. */
+	typedef optparse::OptionParserBase<
+		Options, Ch, optparse::DefaultFormatter, LogObserver > LogParser;
+
+	/** Configures the parser of "build". */
+	template < typename P >
+	static void configureBuild(P& parser) {
+		parser.appendArgument(
+			STR("TARGET"), STR("target"), &Options::target);
+	}
+
+	/** Configures a given parser. */
+	template < typename P >
+	static void configure(P& parser) {
+		parser.addOption(STR("-n"), STR("N"), STR("number"), &Options::n);
+		parser.addFlag(STR("--verbose"), STR("verbose"), &Options::verbose);
+		parser.addCommand(STR("build"), STR("builds"), &Options::command, 1,
+						  &configureBuild< P >);
+	}
+};
+
+TEST_F(PREFIX(ParseObserverTest), observer_should_be_told_applied_tokens) {
+	std::vector< std::string > log;
+	LogParser parser(STR("test program"));
+	configure(parser);
+	parser.setObserver(LogObserver(log));
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("--verbose"), STR("-n"), STR("x"),
+	};
+	Options options;
+	parser.tryParseInto(options, 4, ARGS);
+	const char* const EXPECTED[] = { "start", "option1", "option0!", "fail" };
+	EXPECT_EQ(std::vector< std::string >(EXPECTED, EXPECTED + 4), log);
+	log.clear();
+	const Ch* const COMMAND[] = {
+		STR("test.exe"), STR("-n"), STR("1"), STR("build"), STR("all")
+	};
+	EXPECT_TRUE(parser.tryParseInto(options, 5, COMMAND).isSuccess());
+	const char* const COMMAND_EXPECTED[] = {
+		"start", "option0", "command0", "start", "argument0", "finish",
+		"finish"
+	};
+	EXPECT_EQ(std::vector< std::string >(
+				  COMMAND_EXPECTED, COMMAND_EXPECTED + 7),
+			  log);
+}
+
+TEST_F(PREFIX(ParseObserverTest), statistics_should_count_hits_and_rejections) {
+	Parser parser(STR("test program"));
+	configure(parser);
+	optparse::ParseStatistics statistics(parser);
+	parser.setObserver(optparse::StatisticsObserver(statistics));
+	ASSERT_EQ(2u, statistics.getOptionCount());
+	const Ch* const GOOD[] = {
+		STR("test.exe"), STR("-n"), STR("2"), STR("-n"), STR("3"),
+		STR("build"), STR("all")
+	};
+	const Ch* const BAD[] = { STR("test.exe"), STR("-n"), STR("x") };
+	Options options;
+	EXPECT_TRUE(statistics.getCommand(0) == 0);
+	EXPECT_TRUE(parser.tryParseInto(options, 7, GOOD).isSuccess());
+	EXPECT_FALSE(parser.tryParseInto(options, 3, BAD).isSuccess());
+	EXPECT_EQ(3u, statistics.getOptionHits(0));
+	EXPECT_EQ(1u, statistics.getOptionRejections(0));
+	EXPECT_EQ(0u, statistics.getOptionHits(1));
+	EXPECT_EQ(2u, statistics.getParseCount());
+	const optparse::ParseStatistics* pBuild = statistics.getCommand(0);
+	ASSERT_TRUE(pBuild != 0);
+	EXPECT_EQ(1u, pBuild->getArgumentHits(0));
+	EXPECT_EQ(0u, pBuild->getArgumentRejections(0));
+	EXPECT_EQ(1u, pBuild->getParseCount());
+}
+
+TEST_F(PREFIX(ParseObserverTest), lazy_matches_should_be_counted_when_applied) {
+	Parser parser(STR("test program"));
+	parser.addFlag(STR("--verbose"), STR("verbose"), &Options::verbose);
+	optparse::ParseStatistics statistics(parser);
+	parser.setObserver(optparse::StatisticsObserver(statistics));
+	typename Parser::Matches matches;
+	const Ch* const ARGS[] = { STR("test.exe"), STR("--verbose") };
+	EXPECT_TRUE(parser.tryParseLazy(2, ARGS, matches).isSuccess());
+	EXPECT_EQ(0u, statistics.getOptionHits(0));
+	EXPECT_EQ(1u, statistics.getParseCount());
+	Options options;
+	EXPECT_TRUE(matches.validate(options).isSuccess());
+	EXPECT_EQ(1u, statistics.getOptionHits(0));
+}
+
+TEST_F(PREFIX(ParseObserverTest), durations_should_be_in_buckets) {
+	optparse::ParseStatistics statistics(0, 0, 0);
+	statistics.recordDuration(0);
+	statistics.recordDuration(1);
+	statistics.recordDuration(2);
+	statistics.recordDuration(3);
+	statistics.recordDuration(1000);
+	statistics.recordDuration(~0ULL);
+	EXPECT_EQ(2u, statistics.getDurationCount(0));
+	EXPECT_EQ(2u, statistics.getDurationCount(1));
+	EXPECT_EQ(1u, statistics.getDurationCount(9));
+	EXPECT_EQ(1u, statistics.getDurationCount(
+		optparse::ParseStatistics::BUCKET_COUNT - 1));
+	EXPECT_EQ(6u, statistics.getParseCount());
+	// a default observer records nothing
+	const optparse::StatisticsObserver observer;
+	observer.observeOption(0, true);
+	observer.finishParse(observer.startParse(), 0);
+	EXPECT_TRUE(observer.getStatistics() == 0);
+}
@@ -0,0 +1,292 @@
+// This file provides tests for ParserSnapshot and SnapshotOptionParser
+// regardless of character type.
+// You need to define the followings before including this header,
+//  - Ch: character type
+//  - String: string type of Ch. must be compatible with std::basic_string
+//  - STR(str): macro to create a character and string literal
+//  - PREFIX(name): macro which prefixes a test case name to avoid conflict
+//
+
+#include "optparse/DefaultFormatter.h"
+#include "optparse/OptionParserBase.h"
+#include "optparse/ParserSnapshot.h"
+
+#include <sstream>
+#include <string>
+#include "gtest/gtest.h"
+
+/** Fixture which takes a snapshot of a parser. */
+class PREFIX(ParserSnapshotTest) : public ::testing::Test {
+protected:
+	/** Options container. */
+	struct Options {
+		/** Field associated with "-i". */
+		int i;
+
+		/** Field associated with "--fn". */
+		int fn;
+
+		/** Field associated with "-v". */
+		bool verbose;
+
+		/** Field associated with "--quiet". */
+		bool quiet;
+
+		/** Field associated with the first argument. */
+		String input;
+
+		/** Number of the files. */
+		int fileCount;
+
+		/** Initializes with default values. */
+		Options()
+			: i(0), fn(0), verbose(false), quiet(false), fileCount(0) {}
+
+		/** Sets the `fn` field to a given value. */
+		static void setFn(Options& options, const int& x) {
+			options.fn = x;
+		}
+
+		/** Turns on the `quiet` field. */
+		static void setQuiet(Options& options) {
+			options.quiet = true;
+		}
+
+		/** Counts a given file. */
+		static void addFile(Options& options, const String&) {
+			++options.fileCount;
+		}
+
+		/** Rejects any value given to "--fn". */
+		static void rejectFn(Options&, const int&) {
+			throw optparse::BadValue< Ch >("rejected", String(STR("34")));
+		}
+
+		/** Requests help instead of turning on the `quiet` field. */
+		static void needHelp(Options&) {
+			throw optparse::HelpNeeded();
+		}
+	};
+
+	/** Type of the parser of which a snapshot is taken. */
+	typedef optparse::OptionParserBase<
+		Options, Ch, optparse::DefaultFormatter > Parser;
+
+	/** Type of the builder. */
+	typedef optparse::ParserSnapshotBuilder< Ch > Builder;
+
+	/** Type of the parser with a snapshot. */
+	typedef optparse::SnapshotOptionParser<
+		Options, Ch, optparse::DefaultFormatter > SnapshotParser;
+
+	/** Type of a result. */
+	typedef optparse::ParseResult< Ch > ParseResult;
+
+	/** Parser of which a snapshot is taken. */
+	Parser parser;
+
+	/** Configures the parser. */
+	PREFIX(ParserSnapshotTest)() : parser(STR("test program")) {
+		this->parser.addOption(
+			STR("-i"), STR("N"), STR("int option"), &Options::i);
+		this->parser.addOption(
+			STR("--fn"), STR("N"), STR("function option"), &Options::setFn);
+		this->parser.addFlag(STR("-v"), STR("verbose"), &Options::verbose);
+		this->parser.addOption(
+			STR("--quiet"), STR("quiet"), &Options::setQuiet);
+		this->parser.addOption(STR("--unused"), STR("VALUE"), STR("unused"),
+							   &Options::input);
+		this->parser.appendArgument(
+			STR("INPUT"), STR("input"), &Options::input);
+		this->parser.appendVariadicArgument(
+			STR("FILE"), STR("files"), &Options::addFile);
+	}
+
+	/** Binds the fields and functions of the options and arguments. */
+	static void bind(SnapshotParser& snapshotParser) {
+		snapshotParser.bindOption(STR("-i"), &Options::i);
+		snapshotParser.bindOption(STR("--fn"), &Options::setFn);
+		snapshotParser.bindFlag(STR("-v"), &Options::verbose);
+		snapshotParser.bindOption(STR("--quiet"), &Options::setQuiet);
+		snapshotParser.bindArgument(0, &Options::input);
+		snapshotParser.bindArgument(1, &Options::addFile);
+	}
+
+	/** Returns the slots of a given builder as written in a source. */
+	static std::string slots(const Builder& builder) {
+		const optparse::ParserSnapshot< Ch > snapshot = builder.getSnapshot();
+		std::ostringstream out;
+		for (size_t j = 0; j < snapshot.slotCount; ++j) {
+			out << (j > 0 ? " " : "") << snapshot.slots[j] << ',';
+		}
+		return out.str();
+	}
+
+	/** Returns the seed of a given builder as written in a source. */
+	static std::string seed(const Builder& builder) {
+		std::ostringstream out;
+		out << builder.getSnapshot().seed;
+		return out.str();
+	}
+};
+
+TEST_F(PREFIX(ParserSnapshotTest), snapshot_should_have_every_option) {
+	const Builder builder(this->parser);
+	const optparse::ParserSnapshot< Ch > snapshot = builder.getSnapshot();
+	EXPECT_EQ(String(STR("test program")),
+			  snapshot.getString(snapshot.description).str());
+	ASSERT_EQ(this->parser.getOptionCount(), snapshot.optionCount);
+	for (size_t i = 0; i < snapshot.optionCount; ++i) {
+		const optparse::OptionSpec< Ch >& option = this->parser.getOption(i);
+		const optparse::SnapshotOption& entry = snapshot.options[i];
+		EXPECT_EQ(static_cast< int >(i),
+				  snapshot.find(option.getLabel().c_str()));
+		EXPECT_EQ(option.getLabel(), snapshot.getString(entry.label).str());
+		EXPECT_EQ(option.getValueName(),
+				  snapshot.getString(entry.valueName).str());
+		EXPECT_EQ(option.getDescription(),
+				  snapshot.getString(entry.description).str());
+		EXPECT_EQ(option.needsValue(), entry.takesValue);
+	}
+	EXPECT_EQ(-1, snapshot.find(STR("--unknown")));
+	EXPECT_EQ(-1, snapshot.find(STR("-")));
+	ASSERT_EQ(2u, snapshot.argumentCount);
+	EXPECT_EQ(String(STR("INPUT")),
+			  snapshot.getString(snapshot.arguments[0].name).str());
+	EXPECT_FALSE(snapshot.arguments[0].variadic);
+	EXPECT_TRUE(snapshot.arguments[1].variadic);
+}
+
+TEST_F(PREFIX(ParserSnapshotTest), snapshot_parser_should_apply_bindings) {
+	const Builder builder(this->parser);
+	const optparse::ParserSnapshot< Ch > snapshot = builder.getSnapshot();
+	SnapshotParser snapshotParser(snapshot);
+	bind(snapshotParser);
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("-i"), STR("12"), STR("in"), STR("--fn"),
+		STR("34"), STR("-v"), STR("a"), STR("--quiet"), STR("--unused"),
+		STR("x"), STR("b")
+	};
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	const Options options = snapshotParser.parse(ARGC, ARGS);
+	EXPECT_EQ(12, options.i);
+	EXPECT_EQ(34, options.fn);
+	EXPECT_TRUE(options.verbose);
+	EXPECT_TRUE(options.quiet);
+	// the unbound option is ignored
+	EXPECT_EQ(STR("in"), options.input);
+	EXPECT_EQ(2, options.fileCount);
+}
+
+TEST_F(PREFIX(ParserSnapshotTest), snapshot_parser_should_report_errors) {
+	const Builder builder(this->parser);
+	const optparse::ParserSnapshot< Ch > snapshot = builder.getSnapshot();
+	SnapshotParser snapshotParser(snapshot);
+	bind(snapshotParser);
+	Options options;
+	const Ch* const UNKNOWN[] = { STR("test.exe"), STR("in"), STR("-x") };
+	ParseResult result = snapshotParser.tryParseInto(options, 3, UNKNOWN);
+	EXPECT_EQ(ParseResult::UNKNOWN_OPTION, result.getKind());
+	EXPECT_EQ(2, result.getArgIndex());
+	const Ch* const BAD[] = { STR("test.exe"), STR("-i"), STR("x") };
+	result = snapshotParser.tryParseInto(options, 3, BAD);
+	EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+	EXPECT_EQ(2, result.getArgIndex());
+	EXPECT_EQ(String(STR("-i")), result.getLabel().str());
+	const Ch* const NO_VALUE[] = { STR("test.exe"), STR("in"), STR("-i") };
+	result = snapshotParser.tryParseInto(options, 3, NO_VALUE);
+	EXPECT_EQ(ParseResult::VALUE_NEEDED, result.getKind());
+	const Ch* const NO_INPUT[] = { STR("test.exe"), STR("-v") };
+	result = snapshotParser.tryParseInto(options, 2, NO_INPUT);
+	EXPECT_EQ(ParseResult::TOO_FEW_ARGUMENTS, result.getKind());
+}
+
+TEST_F(PREFIX(ParserSnapshotTest), snapshot_parser_should_report_errors_of_bound_functions) {
+	const Builder builder(this->parser);
+	const optparse::ParserSnapshot< Ch > snapshot = builder.getSnapshot();
+	SnapshotParser snapshotParser(snapshot);
+	snapshotParser.bindOption(STR("--fn"), &Options::rejectFn);
+	snapshotParser.bindOption(STR("--quiet"), &Options::needHelp);
+	Options options;
+	const Ch* const BAD[] = { STR("test.exe"), STR("--fn"), STR("34") };
+	ParseResult result = snapshotParser.tryParseInto(options, 3, BAD);
+	EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+	EXPECT_EQ(2, result.getArgIndex());
+	EXPECT_EQ(String(STR("--fn")), result.getLabel().str());
+	const Ch* const HELP[] = { STR("test.exe"), STR("--quiet") };
+	result = snapshotParser.tryParseInto(options, 2, HELP);
+	EXPECT_EQ(ParseResult::HELP_NEEDED, result.getKind());
+	EXPECT_EQ(1, result.getArgIndex());
+}
+
+TEST_F(PREFIX(ParserSnapshotTest), ConfigException_should_be_thrown_for_bad_binding) {
+	const Builder builder(this->parser);
+	const optparse::ParserSnapshot< Ch > snapshot = builder.getSnapshot();
+	SnapshotParser snapshotParser(snapshot);
+	EXPECT_THROW(snapshotParser.bindOption(STR("-x"), &Options::i),
+				 optparse::ConfigException);
+	EXPECT_THROW(snapshotParser.bindOption(STR("-v"), &Options::i),
+				 optparse::ConfigException);
+	EXPECT_THROW(snapshotParser.bindFlag(STR("-i"), &Options::verbose),
+				 optparse::ConfigException);
+	EXPECT_THROW(snapshotParser.bindArgument(2, &Options::input),
+				 optparse::ConfigException);
+}
+
+TEST_F(PREFIX(ParserSnapshotTest), write_should_generate_source) {
+	Parser small(STR("program?"));
+	small.addOption(STR("-n"), STR("N"), STR("count\n\"quoted\""),
+					&Options::i);
+	small.appendArgument(STR("INPUT"), STR("input\x01" "a"), &Options::input);
+	const Builder builder(small);
+	std::ostringstream out;
+	builder.write(out, "SNAPSHOT");
+	const std::string type = sizeof(Ch) == 1 ? "char" : "wchar_t";
+	const std::string prefix = sizeof(Ch) == 1 ? "" : "L";
+	const std::string expected =
+		"// Generated by optparse::ParserSnapshotBuilder. Do not edit.\n"
+		"#include \"optparse/ParserSnapshot.h\"\n"
+		"\n"
+		"extern const optparse::ParserSnapshot< " + type + " > SNAPSHOT;\n"
+		"\n"
+		"static const " + type + " SNAPSHOT_POOL[] =\n"
+		"\t" + prefix + "\"program\\?-nNcount\\n\\\"quoted\\\"INPUTinput"
+		"\\x1\" " + prefix + "\"a\";\n"
+		"\n"
+		"static const optparse::SnapshotOption SNAPSHOT_OPTIONS[] = {\n"
+		"\t{ { 8, 2 }, { 10, 1 }, { 11, 14 }, true },\n"
+		"};\n"
+		"\n"
+		"static const optparse::SnapshotArgument SNAPSHOT_ARGUMENTS[] = {\n"
+		"\t{ { 25, 5 }, { 30, 7 }, false },\n"
+		"};\n"
+		"\n"
+		"static const int SNAPSHOT_SLOTS[] = {\n"
+		"\t" + slots(builder) + "\n"
+		"};\n"
+		"\n"
+		"const optparse::ParserSnapshot< " + type + " > SNAPSHOT = {\n"
+		"\tSNAPSHOT_POOL,\n"
+		"\t{ 0, 8 },\n"
+		"\tSNAPSHOT_OPTIONS, 1,\n"
+		"\tSNAPSHOT_ARGUMENTS, 1,\n"
+		"\tSNAPSHOT_SLOTS, 2,\n"
+		"\t" + seed(builder) + "\n"
+		"};\n";
+	EXPECT_EQ(expected, out.str());
+}
+
+TEST_F(PREFIX(ParserSnapshotTest), write_should_escape_non_ASCII_characters_as_unsigned) {
+	// "caf\xE9" whose last character is negative if Ch is a signed char
+	String description(STR("caf"));
+	description += static_cast< Ch >(0xE9);
+	Parser small(description);
+	const Builder builder(small);
+	std::ostringstream out;
+	builder.write(out, "SNAPSHOT");
+	const std::string prefix = sizeof(Ch) == 1 ? "" : "L";
+	const std::string source = out.str();
+	EXPECT_NE(std::string::npos,
+			  source.find("\t" + prefix + "\"caf\\xe9\" " + prefix + "\"\";"))
+		<< source;
+}
@@ -0,0 +1,236 @@
+// This file provides tests for ResponseFile and response file expansion
+// regardless of character type.
+// You need to define the followings before including this header,
+//  - Ch: character type
+//  - String: string type of Ch. must be compatible with std::basic_string
+//  - STR(str): macro to create a character and string literal
+//  - PREFIX(name): macro which prefixes a test case name to avoid conflict
+//
+
+#include "optparse/DefaultFormatter.h"
+#include "optparse/OptionParserBase.h"
+#include "optparse/ResponseFile.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "gtest/gtest.h"
+
+/** Fixture which writes a response file. */
+class PREFIX(ResponseFileTest) : public ::testing::Test {
+protected:
+	/** Options container. */
+	struct Options {
+		/** Field associated with "-i". */
+		int i;
+
+		/** Field associated with "-s". */
+		String s;
+
+		/** Number of the files. */
+		int fileCount;
+
+		/** Last file. */
+		String lastFile;
+
+		/** Initializes with default values. */
+		Options() : i(0), fileCount(0) {}
+
+		/** Counts a given file. */
+		static void addFile(Options& options, const String& file) {
+			++options.fileCount;
+			options.lastFile = file;
+		}
+	};
+
+	/** Type of the parser. */
+	typedef optparse::OptionParserBase<
+		Options, Ch, optparse::DefaultFormatter > Parser;
+
+	/** Type of a result. */
+	typedef optparse::ParseResult< Ch > ParseResult;
+
+	/** Path to the response file. */
+	std::string path;
+
+	/** `path` as a string of `Ch`. */
+	String atPath;
+
+	/** Parser under test. */
+	Parser parser;
+
+	/** Configures the parser. */
+	PREFIX(ResponseFileTest)() : parser(STR("test program")) {
+		this->path = std::string(
+			::testing::UnitTest::GetInstance()->current_test_info()->name())
+			+ (sizeof(Ch) == 1 ? "_char.rsp" : "_wchar_t.rsp");
+		this->atPath = STR("@");
+		this->atPath.append(this->path.begin(), this->path.end());
+		this->parser.addOption(
+			STR("-i"), STR("N"), STR("int option"), &Options::i);
+		this->parser.addOption(
+			STR("-s"), STR("STR"), STR("string option"), &Options::s);
+		this->parser.appendVariadicArgument(
+			STR("FILE"), STR("files"), &Options::addFile);
+		this->parser.setResponseFilesEnabled(true);
+	}
+
+	/** Removes the response file. */
+	virtual void TearDown() {
+		std::remove(this->path.c_str());
+	}
+
+	/** Writes given contents into the response file. */
+	void write(const std::string& contents) {
+		std::ofstream out(this->path.c_str(), std::ios::binary);
+		out << contents;
+	}
+
+	/** Returns the path to the response file as a string of `Ch`. */
+	String widePath() const {
+		return this->atPath.substr(1);
+	}
+};
+
+TEST_F(PREFIX(ResponseFileTest), open_should_read_contents_of_file) {
+	this->write("-i 1 'a b'\n");
+	optparse::ResponseFile< Ch > file;
+	ASSERT_TRUE(file.open(this->widePath().c_str()));
+	EXPECT_EQ(String(STR("-i 1 'a b'\n")), String(file.begin(), file.end()));
+	EXPECT_EQ(sizeof(Ch) == 1 && OPTPARSE_USE_MMAP != 0, file.isMapped());
+	file.close();
+	EXPECT_TRUE(file.begin() == file.end());
+}
+
+TEST_F(PREFIX(ResponseFileTest), non_ASCII_contents_should_be_decoded_from_UTF8) {
+	// "-s café €" in UTF-8
+	this->write("-s caf\xC3\xA9 \xE2\x82\xAC\n");
+	const Ch* const ARGS[] = { STR("test.exe"), this->atPath.c_str() };
+	Options options = this->parser.parse(2, ARGS);
+	EXPECT_EQ(String(STR("caf\u00E9")), options.s);
+	EXPECT_EQ(String(STR("\u20AC")), options.lastFile);
+	// a path is encoded in UTF-8 as well
+	const std::string utf8Path = this->path + "_\xC3\xA9t\xC3\xA9";
+	{
+		std::ofstream out(utf8Path.c_str(), std::ios::binary);
+		out << "-i 7";
+	}
+	String widePath = this->widePath();
+	widePath += STR("_\u00E9t\u00E9");
+	optparse::ResponseFile< Ch > file;
+	const bool opened = file.open(widePath.c_str());
+	std::remove(utf8Path.c_str());
+	ASSERT_TRUE(opened);
+	EXPECT_EQ(String(STR("-i 7")), String(file.begin(), file.end()));
+}
+
+TEST_F(PREFIX(ResponseFileTest), open_should_fail_for_missing_file) {
+	optparse::ResponseFile< Ch > file;
+	EXPECT_FALSE(file.open(STR("no/such/file.rsp")));
+}
+
+TEST_F(PREFIX(ResponseFileTest), empty_file_should_have_no_contents) {
+	this->write("");
+	optparse::ResponseFile< Ch > file;
+	ASSERT_TRUE(file.open(this->widePath().c_str()));
+	EXPECT_TRUE(file.begin() == file.end());
+}
+
+TEST_F(PREFIX(ResponseFileTest), response_file_should_be_expanded_in_place) {
+	this->write("-i 42\n\"x y\" -s 'str'\n\nz\n");
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("a"), this->atPath.c_str(), STR("b")
+	};
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options = this->parser.parse(ARGC, ARGS);
+	EXPECT_EQ(42, options.i);
+	EXPECT_EQ(STR("str"), options.s);
+	EXPECT_EQ(4, options.fileCount);
+	EXPECT_EQ(STR("b"), options.lastFile);
+}
+
+TEST_F(PREFIX(ResponseFileTest), response_file_should_not_be_expanded_unless_enabled) {
+	this->write("-i 42\n");
+	this->parser.setResponseFilesEnabled(false);
+	const Ch* const ARGS[] = { STR("test.exe"), this->atPath.c_str() };
+	Options options = this->parser.parse(2, ARGS);
+	EXPECT_EQ(0, options.i);
+	EXPECT_EQ(this->atPath, options.lastFile);
+}
+
+TEST_F(PREFIX(ResponseFileTest), single_at_should_not_be_response_file) {
+	const Ch* const ARGS[] = { STR("test.exe"), STR("@") };
+	Options options = this->parser.parse(2, ARGS);
+	EXPECT_EQ(STR("@"), options.lastFile);
+}
+
+TEST_F(PREFIX(ResponseFileTest), error_in_response_file_should_outlive_file) {
+	this->write("-i 1 -i XYZ");
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("a"), this->atPath.c_str()
+	};
+	Options options;
+	String programName;
+	const ParseResult result =
+		this->parser.tryParseInto(options, 3, ARGS, programName);
+	EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+	EXPECT_EQ(2, result.getArgIndex());
+	EXPECT_EQ(String(STR("-i")), result.getLabel().str());
+	EXPECT_EQ(String(STR("XYZ")), result.getValue().str());
+	// the copy refers to its own label and value
+	ParseResult copy;
+	copy = result;
+	EXPECT_EQ(String(STR("XYZ")), copy.getValue().str());
+	EXPECT_NE(result.getValue().data(), copy.getValue().data());
+}
+
+TEST_F(PREFIX(ResponseFileTest), missing_response_file_should_be_error) {
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("a"), STR("@no/such/file.rsp")
+	};
+	Options options;
+	String programName;
+	const ParseResult result =
+		this->parser.tryParseInto(options, 3, ARGS, programName);
+	EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+	EXPECT_EQ(2, result.getArgIndex());
+	EXPECT_STREQ("cannot read response file", result.getMessage());
+	EXPECT_EQ(String(STR("no/such/file.rsp")), result.getValue().str());
+}
+
+TEST_F(PREFIX(ResponseFileTest), syntax_error_in_response_file_should_be_error) {
+	this->write("-s 'abc\n");
+	const Ch* const ARGS[] = { STR("test.exe"), this->atPath.c_str() };
+	Options options;
+	String programName;
+	const ParseResult result =
+		this->parser.tryParseInto(options, 2, ARGS, programName);
+	EXPECT_EQ(ParseResult::BAD_SYNTAX, result.getKind());
+	EXPECT_EQ(1, result.getArgIndex());
+}
+
+TEST_F(PREFIX(ResponseFileTest), session_should_feed_response_file) {
+	this->write("-i 5 a b c");
+	Options options;
+	typename Parser::Session session(this->parser, options);
+	EXPECT_TRUE(session.feed(STR("first")));
+	EXPECT_TRUE(session.feedFile(this->widePath().c_str()));
+	EXPECT_TRUE(session.finish().isSuccess());
+	EXPECT_EQ(5, options.i);
+	EXPECT_EQ(4, options.fileCount);
+	typename Parser::Session missing(this->parser, options);
+	EXPECT_FALSE(missing.feedFile(STR("no/such/file.rsp")));
+	EXPECT_STREQ("cannot read response file", missing.finish().getMessage());
+}
+
+TEST_F(PREFIX(ResponseFileTest), lazy_matches_should_outlive_response_file) {
+	this->write("-s 'from file' -i 9 x");
+	const Ch* const ARGS[] = { STR("test.exe"), this->atPath.c_str() };
+	typename Parser::Matches matches;
+	EXPECT_TRUE(this->parser.tryParseLazy(2, ARGS, matches).isSuccess());
+	EXPECT_EQ(String(STR("from file")), matches.get(STR("-s"), String()));
+	Options options;
+	EXPECT_TRUE(matches.validate(options).isSuccess());
+	EXPECT_EQ(9, options.i);
+	EXPECT_EQ(STR("x"), options.lastFile);
+}
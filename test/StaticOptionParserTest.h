@@ -0,0 +1,348 @@
+// This file provides tests for StaticOptionParser regardless of character
+// type.
+// You need to define the followings before including this header,
+//  - Ch: character type
+//  - String: string type of Ch. must be compatible with std::basic_string
+//  - STR(str): macro to create a character and string literal
+//  - PREFIX(name): macro which prefixes a test case name to avoid conflict
+//
+
+#include "optparse/DefaultFormatter.h"
+#include "optparse/DefaultUsagePrinter.h"
+#include "optparse/OptionParserBase.h"
+#include "optparse/StaticOptionParser.h"
+
+#include <sstream>
+#include "gtest/gtest.h"
+
+/** Fixture for the tests of `StaticOptionParser`. */
+class PREFIX(StaticOptionParserTest) : public ::testing::Test {
+protected:
+	/** Options to be substituted. */
+	struct Options {
+		/** Field associated with "-i". 0 by default. */
+		int i;
+
+		/** Field associated with "-s". Empty by default. */
+		String s;
+
+		/** Field associated with "--custom". 0 by default. */
+		int custom;
+
+		/** Field associated with "-C". 0 by default. */
+		int C;
+
+		/** Field associated with "--fn". 0 by default. */
+		int fn;
+
+		/** Field associated with "--flag". false by default. */
+		bool flag;
+
+		/** Field associated with the first argument. 0 by default. */
+		int pos;
+
+		/** Field associated with the second argument. Empty by default. */
+		String fpos;
+
+		/** Initializes with default values. */
+		Options() : i(0), custom(0), C(0), fn(0), flag(false), pos(0) {}
+
+		/** Formats the custom field value. */
+		static int formatCustom(const String& value) {
+			return static_cast< int >(value.size());
+		}
+
+		/** Sets the `fn` field to a given value. */
+		static void setFn(Options& options, const int& x) {
+			options.fn = x;
+		}
+
+		/** Turns the `flag` field into `true`. */
+		static void setFlag(Options& options) {
+			options.flag = true;
+		}
+
+		/** Sets the `fpos` field to a given value. */
+		static void setFpos(Options& options, const String& str) {
+			options.fpos = str;
+		}
+	};
+
+	/** Formatter of the custom field. */
+	typedef int (*CustomFormat)(const String&);
+
+	/** Type of the static parser under test. */
+	typedef optparse::StaticOptionParser<
+		Options,
+		Ch,
+		optparse::DefaultFormatter,
+		optparse::StaticMemberOption<
+			int, Options, optparse::UseMetaFormat, Ch >,
+		optparse::StaticMemberOption<
+			String, Options, optparse::UseMetaFormat, Ch >,
+		optparse::StaticMemberOption< int, Options, CustomFormat, Ch >,
+		optparse::StaticConstMemberOption< int, Options, Ch >,
+		optparse::StaticFunctionOption<
+			int, Options, optparse::UseMetaFormat, Ch >,
+		optparse::StaticConstFunctionOption< Options, Ch >,
+		optparse::StaticMemberArgument<
+			int, Options, optparse::UseMetaFormat, Ch >,
+		optparse::StaticFunctionArgument<
+			String, Options, optparse::UseMetaFormat, Ch > > Parser;
+
+	/** Result of parsing. */
+	typedef optparse::ParseResult< Ch > ParseResult;
+
+	/** Makes the static parser under test. */
+	static Parser makeParser() {
+		return optparse::makeStaticOptionParser<
+			Options, optparse::DefaultFormatter >(
+			STR("test program"),
+			optparse::staticOption(
+				STR("-i"), STR("N"), STR("int option"), &Options::i),
+			optparse::staticOption(
+				STR("-s"), STR("STR"), STR("string option"), &Options::s),
+			optparse::staticOption(
+				STR("--custom"), STR("X"), STR("custom int option"),
+				&Options::custom, &Options::formatCustom),
+			optparse::staticOption(
+				STR("-C"), STR("const int option"), &Options::C, 123),
+			optparse::staticOption(
+				STR("--fn"), STR("INT"), STR("int function option"),
+				&Options::setFn),
+			optparse::staticOption(
+				STR("--flag"), STR("function option"), &Options::setFlag),
+			optparse::staticArgument(
+				STR("POS"), STR("int argument"), &Options::pos),
+			optparse::staticArgument(
+				STR("FPOS"), STR("string function argument"),
+				&Options::setFpos));
+	}
+};
+
+TEST_F(PREFIX(StaticOptionParserTest), counts_should_be_known_at_compile_time) {
+	static_assert(Parser::OPTION_COUNT == 6, "six options");
+	static_assert(Parser::ARGUMENT_COUNT == 2, "two arguments");
+	auto parser = makeParser();
+	EXPECT_EQ(6U, parser.getOptionCount());
+	EXPECT_EQ(2U, parser.getArgumentCount());
+	EXPECT_EQ(STR("test program"), parser.getDescription());
+	EXPECT_EQ(STR(""), parser.getProgramName());
+}
+
+TEST_F(PREFIX(StaticOptionParserTest), specs_should_be_in_order_of_definitions) {
+	auto parser = makeParser();
+	EXPECT_EQ(STR("-i"), parser.getOption(0).getLabel());
+	EXPECT_EQ(STR("int option"), parser.getOption(0).getDescription());
+	EXPECT_TRUE(parser.getOption(0).needsValue());
+	EXPECT_EQ(STR("N"), parser.getOption(0).getValueName());
+	EXPECT_EQ(STR("-C"), parser.getOption(3).getLabel());
+	EXPECT_FALSE(parser.getOption(3).needsValue());
+	EXPECT_EQ(STR(""), parser.getOption(3).getValueName());
+	EXPECT_EQ(STR("--flag"), parser.getOption(5).getLabel());
+	EXPECT_EQ(STR("POS"), parser.getArgument(0).getValueName());
+	EXPECT_EQ(STR("FPOS"), parser.getArgument(1).getValueName());
+	EXPECT_EQ(STR("string function argument"),
+			  parser.getArgument(1).getDescription());
+}
+
+TEST_F(PREFIX(StaticOptionParserTest), parse_should_apply_options_and_arguments) {
+	auto parser = makeParser();
+	const Ch* const ARGS[] = {
+		STR("test.exe"),
+		STR("-i"), STR("4649"),
+		STR("-s"), STR("string"),
+		STR("--custom"), STR("abc"),
+		STR("-C"),
+		STR("--fn"), STR("-123"),
+		STR("--flag"),
+		STR("42"),
+		STR("fpos")
+	};
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options = parser.parse(ARGC, ARGS);
+	EXPECT_EQ(STR("test.exe"), parser.getProgramName());
+	EXPECT_EQ(4649, options.i);
+	EXPECT_EQ(STR("string"), options.s);
+	EXPECT_EQ(3, options.custom);
+	EXPECT_EQ(123, options.C);
+	EXPECT_EQ(-123, options.fn);
+	EXPECT_TRUE(options.flag);
+	EXPECT_EQ(42, options.pos);
+	EXPECT_EQ(STR("fpos"), options.fpos);
+}
+
+TEST_F(PREFIX(StaticOptionParserTest), const_parse_should_store_program_name) {
+	const auto parser = makeParser();
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("-i"), STR("1"), STR("2"), STR("fpos")
+	};
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	String programName;
+	Options options = parser.parse(ARGC, ARGS, programName);
+	EXPECT_EQ(STR("test.exe"), programName);
+	EXPECT_EQ(STR(""), parser.getProgramName());
+	EXPECT_EQ(1, options.i);
+	EXPECT_EQ(2, options.pos);
+}
+
+TEST_F(PREFIX(StaticOptionParserTest), tryParseInto_should_report_errors) {
+	auto parser = makeParser();
+	Options options;
+	{
+		const Ch* const ARGS[] = { STR("test.exe"), STR("-x") };
+		ParseResult result = parser.tryParseInto(options, 2, ARGS);
+		EXPECT_EQ(ParseResult::UNKNOWN_OPTION, result.getKind());
+		EXPECT_EQ(1, result.getArgIndex());
+		EXPECT_EQ(STR("-x"), result.getLabel().str());
+	}
+	{
+		const Ch* const ARGS[] = { STR("test.exe"), STR("-i") };
+		ParseResult result = parser.tryParseInto(options, 2, ARGS);
+		EXPECT_EQ(ParseResult::VALUE_NEEDED, result.getKind());
+		EXPECT_EQ(1, result.getArgIndex());
+	}
+	{
+		const Ch* const ARGS[] = { STR("test.exe"), STR("-i"), STR("x") };
+		ParseResult result = parser.tryParseInto(options, 3, ARGS);
+		EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+		EXPECT_EQ(2, result.getArgIndex());
+		EXPECT_EQ(STR("-i"), result.getLabel().str());
+		EXPECT_EQ(STR("x"), result.getValue().str());
+	}
+	{
+		const Ch* const ARGS[] = { STR("test.exe"), STR("--fn"), STR("x") };
+		ParseResult result = parser.tryParseInto(options, 3, ARGS);
+		EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+		EXPECT_EQ(STR("--fn"), result.getLabel().str());
+	}
+	{
+		const Ch* const ARGS[] = { STR("test.exe"), STR("1") };
+		ParseResult result = parser.tryParseInto(options, 2, ARGS);
+		EXPECT_EQ(ParseResult::TOO_FEW_ARGUMENTS, result.getKind());
+		EXPECT_EQ(2, result.getArgIndex());
+	}
+	{
+		const Ch* const ARGS[] = {
+			STR("test.exe"), STR("1"), STR("2"), STR("3")
+		};
+		ParseResult result = parser.tryParseInto(options, 4, ARGS);
+		EXPECT_EQ(ParseResult::TOO_MANY_ARGUMENTS, result.getKind());
+		EXPECT_EQ(3, result.getArgIndex());
+	}
+	{
+		const Ch* const ARGS[] = { STR("test.exe"), STR("x"), STR("2") };
+		ParseResult result = parser.tryParseInto(options, 3, ARGS);
+		EXPECT_EQ(ParseResult::BAD_VALUE, result.getKind());
+		EXPECT_EQ(1, result.getArgIndex());
+		EXPECT_EQ(STR("POS"), result.getLabel().str());
+	}
+}
+
+TEST_F(PREFIX(StaticOptionParserTest), parse_should_throw_equivalent_exceptions) {
+	auto parser = makeParser();
+	const Ch* const UNKNOWN[] = { STR("test.exe"), STR("-x") };
+	EXPECT_THROW(parser.parse(2, UNKNOWN), optparse::UnknownOption< Ch >);
+	const Ch* const BAD[] = { STR("test.exe"), STR("-i"), STR("x") };
+	EXPECT_THROW(parser.parse(3, BAD), optparse::BadValue< Ch >);
+	const Ch* const FEW[] = { STR("test.exe") };
+	EXPECT_THROW(parser.parse(1, FEW), optparse::TooFewArguments);
+}
+
+TEST_F(PREFIX(StaticOptionParserTest), copied_parser_should_parse_with_its_own_definitions) {
+	auto original = makeParser();
+	auto parser(original);
+	const Ch* const ARGS[] = {
+		STR("test.exe"), STR("--custom"), STR("abcd"), STR("1"), STR("x")
+	};
+	const int ARGC = sizeof(ARGS) / sizeof(ARGS[0]);
+	Options options = parser.parse(ARGC, ARGS);
+	EXPECT_EQ(4, options.custom);
+	EXPECT_EQ(&parser.getOption(0), &parser.getOption(0));
+	EXPECT_NE(&original.getOption(0), &parser.getOption(0));
+}
+
+TEST_F(PREFIX(StaticOptionParserTest), resetFields_should_reset_only_substituted_fields) {
+	const auto parser = makeParser();
+	Options options;
+	options.i = 1;
+	options.C = 2;
+	options.fn = 3;
+	options.pos = 4;
+	options.fpos = STR("fpos");
+	parser.resetFields(options, Options());
+	EXPECT_EQ(0, options.i);
+	EXPECT_EQ(0, options.C);
+	EXPECT_EQ(3, options.fn);
+	EXPECT_EQ(0, options.pos);
+	EXPECT_EQ(STR("fpos"), options.fpos);
+}
+
+TEST_F(PREFIX(StaticOptionParserTest), usage_should_be_same_as_dynamic_parser) {
+	auto parser = makeParser();
+	optparse::OptionParserBase< Options, Ch, optparse::DefaultFormatter >
+		dynamic(STR("test program"));
+	dynamic.addOption(STR("-i"), STR("N"), STR("int option"), &Options::i);
+	dynamic.addOption(
+		STR("-s"), STR("STR"), STR("string option"), &Options::s);
+	dynamic.addOption(
+		STR("--custom"), STR("X"), STR("custom int option"),
+		&Options::custom, &Options::formatCustom);
+	dynamic.addOption(STR("-C"), STR("const int option"), &Options::C, 123);
+	dynamic.addOption(
+		STR("--fn"), STR("INT"), STR("int function option"),
+		&Options::setFn);
+	dynamic.addOption(
+		STR("--flag"), STR("function option"), &Options::setFlag);
+	dynamic.appendArgument(STR("POS"), STR("int argument"), &Options::pos);
+	dynamic.appendArgument(
+		STR("FPOS"), STR("string function argument"), &Options::setFpos);
+	std::basic_ostringstream< Ch > staticOut;
+	std::basic_ostringstream< Ch > dynamicOut;
+	optparse::DefaultUsagePrinter< Ch >(staticOut).printUsage(parser);
+	optparse::DefaultUsagePrinter< Ch >(dynamicOut).printUsage(dynamic);
+	EXPECT_EQ(dynamicOut.str(), staticOut.str());
+	EXPECT_NE(String::npos, staticOut.str().find(STR("--custom X")));
+}
+
+TEST(PREFIX(StaticOptionParserConfigTest), ConfigException_should_be_thrown_if_label_is_invalid) {
+	struct Options {
+		int i;
+	};
+	EXPECT_THROW(
+		(optparse::makeStaticOptionParser<
+			Options, optparse::DefaultFormatter >(
+			STR("test program"),
+			optparse::staticOption(
+				STR("i"), STR("N"), STR("int option"), &Options::i))),
+		optparse::ConfigException);
+}
+
+TEST(PREFIX(StaticOptionParserConfigTest), ConfigException_should_be_thrown_if_labels_are_duplicate) {
+	struct Options {
+		int i;
+
+		int j;
+	};
+	EXPECT_THROW(
+		(optparse::makeStaticOptionParser<
+			Options, optparse::DefaultFormatter >(
+			STR("test program"),
+			optparse::staticOption(
+				STR("-i"), STR("N"), STR("int option"), &Options::i),
+			optparse::staticOption(
+				STR("-i"), STR("N"), STR("another int option"),
+				&Options::j))),
+		optparse::ConfigException);
+}
+
+TEST(PREFIX(StaticOptionParserConfigTest), parser_without_definitions_should_accept_only_program_name) {
+	struct Options {};
+	auto parser = optparse::makeStaticOptionParser<
+		Options, optparse::DefaultFormatter >(STR("test program"));
+	const Ch* const ARGS[] = { STR("test.exe"), STR("-x") };
+	Options options;
+	EXPECT_TRUE(parser.tryParseInto(options, 1, ARGS).isSuccess());
+	EXPECT_EQ(optparse::ParseResult< Ch >::UNKNOWN_OPTION,
+			  parser.tryParseInto(options, 2, ARGS).getKind());
+}
@@ -0,0 +1,68 @@
+// This file provides tests for StringPool regardless of character type.
+// You need to define the followings before including this header,
+//  - Ch: character type
+//  - String: string type of Ch. must be compatible with std::basic_string
+//  - STR(str): macro to create a character and string literal
+//  - PREFIX(name): macro which prefixes a test case name to avoid conflict
+//
+
+#include "optparse/StringPool.h"
+
+#include <sstream>
+#include <vector>
+#include "gtest/gtest.h"
+
+TEST(PREFIX(StringPoolTest), pool_should_be_empty_by_default) {
+	const optparse::StringPool< Ch > pool;
+	EXPECT_EQ(0U, pool.size());
+	EXPECT_EQ(-1, pool.indexOf(STR("-o")));
+}
+
+TEST(PREFIX(StringPoolTest), intern_should_return_copy_of_string) {
+	optparse::StringPool< Ch > pool;
+	const String label(STR("--option"));
+	const String& pooled = pool.intern(label);
+	EXPECT_EQ(label, pooled);
+	EXPECT_NE(&label, &pooled);
+	EXPECT_EQ(0, pool.indexOf(STR("--option")));
+	EXPECT_EQ(&pooled, &pool[0]);
+	EXPECT_EQ(1U, pool.size());
+}
+
+TEST(PREFIX(StringPoolTest), equal_strings_should_be_interned_once) {
+	optparse::StringPool< Ch > pool;
+	const String& first = pool.intern(STR("FILE"));
+	const String& empty = pool.intern(STR(""));
+	EXPECT_EQ(&first, &pool.intern(String(STR("FILE"))));
+	EXPECT_EQ(&empty, &pool.intern(STR("")));
+	EXPECT_TRUE(empty.empty());
+	EXPECT_EQ(2U, pool.size());
+}
+
+TEST(PREFIX(StringPoolTest), find_should_compare_only_referenced_part_of_view) {
+	optparse::StringPool< Ch > pool;
+	pool.intern(STR("-o"));
+	const String text(STR("-option"));
+	const optparse::StringView< Ch > prefix(text.data(), 2);
+	EXPECT_EQ(0, pool.indexOf(prefix));
+	EXPECT_EQ(-1, pool.indexOf(STR("-option")));
+}
+
+TEST(PREFIX(StringPoolTest), pooled_strings_should_not_move_while_pool_grows) {
+	optparse::StringPool< Ch > pool;
+	std::vector< const String* > pooled;
+	for (int i = 0; i < 1000; ++i) {
+		std::basic_ostringstream< Ch > text;
+		text << STR("text that is too long for a short string ") << i;
+		pooled.push_back(&pool.intern(text.str()));
+	}
+	ASSERT_EQ(1000U, pool.size());
+	for (int i = 0; i < 1000; ++i) {
+		std::basic_ostringstream< Ch > text;
+		text << STR("text that is too long for a short string ") << i;
+		EXPECT_EQ(i, pool.indexOf(text.str()));
+		EXPECT_EQ(pooled[i], &pool[i]);
+		EXPECT_EQ(pooled[i], &pool.intern(text.str()));
+	}
+	EXPECT_EQ(1000U, pool.size());
+}
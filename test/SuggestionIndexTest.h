@@ -0,0 +1,73 @@
+// This file provides tests for SuggestionIndex regardless of character type.
+// You need to define the followings before including this header,
+//  - Ch: character type
+//  - String: string type of Ch. must be compatible with std::basic_string
+//  - STR(str): macro to create a character and string literal
+//  - PREFIX(name): macro which prefixes a test case name to avoid conflict
+//
+
+#include "optparse/SuggestionIndex.h"
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+#include "gtest/gtest.h"
+
+TEST(PREFIX(SuggestionIndexTest), distance_should_count_edits) {
+	typedef optparse::SuggestionIndex< Ch > Index;
+	std::vector< size_t > row;
+	EXPECT_EQ(0U, Index::distance(STR("--flag"), STR("--flag"), row));
+	EXPECT_EQ(1U, Index::distance(STR("--flag"), STR("--flg"), row));
+	EXPECT_EQ(1U, Index::distance(STR("--flag"), STR("--flags"), row));
+	EXPECT_EQ(1U, Index::distance(STR("--flag"), STR("--flog"), row));
+	EXPECT_EQ(2U, Index::distance(STR("--flag"), STR("--flga"), row));
+	EXPECT_EQ(3U, Index::distance(STR("kitten"), STR("sitting"), row));
+	EXPECT_EQ(2U, Index::distance(STR(""), STR("-o"), row));
+	EXPECT_EQ(2U, Index::distance(STR("-o"), STR(""), row));
+}
+
+TEST(PREFIX(SuggestionIndexTest), empty_index_should_find_nothing) {
+	optparse::SuggestionIndex< Ch > index;
+	std::vector< optparse::SuggestionIndex< Ch >::Match > matches;
+	index.find(STR("-o"), 2, matches);
+	EXPECT_TRUE(index.empty());
+	EXPECT_TRUE(matches.empty());
+}
+
+TEST(PREFIX(SuggestionIndexTest), find_should_agree_with_every_distance) {
+	typedef optparse::SuggestionIndex< Ch > Index;
+	std::vector< String > labels;
+	for (int i = 0; i < 300; ++i) {
+		std::basic_ostringstream< Ch > label;
+		label << STR("--opt") << (i * 7919 % 1000) << STR("-x");
+		labels.push_back(label.str());
+	}
+	std::vector< Index::Entry > entries;
+	for (size_t i = 0; i < labels.size(); ++i) {
+		entries.push_back(Index::Entry(labels[i], static_cast< int >(i)));
+	}
+	Index index;
+	index.build(entries);
+	ASSERT_EQ(labels.size(), index.size());
+	const Ch* const QUERIES[] = {
+		STR("--opt12-x"), STR("--opt1000-x"), STR("--op5-"), STR("-o"),
+		STR("--zzz")
+	};
+	std::vector< size_t > row;
+	for (size_t q = 0; q < sizeof(QUERIES) / sizeof(QUERIES[0]); ++q) {
+		for (size_t maxDistance = 0; maxDistance <= 3; ++maxDistance) {
+			std::vector< Index::Match > expected;
+			for (size_t i = 0; i < labels.size(); ++i) {
+				const size_t d = Index::distance(labels[i], QUERIES[q], row);
+				if (d <= maxDistance) {
+					expected.push_back(
+						Index::Match(d, static_cast< int >(i)));
+				}
+			}
+			std::sort(expected.begin(), expected.end());
+			std::vector< Index::Match > matches;
+			index.find(QUERIES[q], maxDistance, matches);
+			EXPECT_EQ(expected, matches);
+		}
+	}
+}
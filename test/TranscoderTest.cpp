@@ -0,0 +1,130 @@
+#include "optparse/DefaultFormatter.h"
+#include "optparse/OptionParserBase.h"
+#include "optparse/Transcoder.h"
+
+#include <string>
+#include "gtest/gtest.h"
+
+namespace {
+
+	/** Transcodes a given UTF-8 string into a `wchar_t` string. */
+	std::wstring decode(const std::string& str) {
+		typedef optparse::Transcoder< char, wchar_t > Transcoder;
+		std::wstring out(Transcoder::getMaxSize(str.size()) + 1, L'\0');
+		out.resize(Transcoder::transcode(
+			str.data(), str.data() + str.size(), &out[0]));
+		return out;
+	}
+
+	/** Transcodes a given `wchar_t` string into a UTF-8 string. */
+	std::string encode(const std::wstring& str) {
+		typedef optparse::Transcoder< wchar_t, char > Transcoder;
+		std::string out(Transcoder::getMaxSize(str.size()) + 1, '\0');
+		out.resize(Transcoder::transcode(
+			str.data(), str.data() + str.size(), &out[0]));
+		return out;
+	}
+
+	/** Options container of the parsers. */
+	template < typename Ch >
+	struct Options {
+		/** Field associated with "-n". */
+		int n;
+
+		/** Field associated with "--name". */
+		std::basic_string< Ch > name;
+
+		/** Field associated with the argument. */
+		std::basic_string< Ch > input;
+
+		/** Initializes with default values. */
+		Options() : n(0) {}
+	};
+
+	/** Configures a given parser. */
+	template < typename Parser, typename Ch >
+	void configure(Parser& parser, const Ch* n, const Ch* name, const Ch* x)
+	{
+		typedef Options< Ch > Opt;
+		parser.addOption(n, x, x, &Opt::n);
+		parser.addOption(name, x, x, &Opt::name);
+		parser.appendArgument(x, x, &Opt::input);
+	}
+
+}
+
+TEST(TranscoderTest, utf8_should_be_decoded) {
+	EXPECT_EQ(std::wstring(L"abc"), decode("abc"));
+	// U+00E9, U+3042 and U+1F600
+	const std::wstring decoded = decode("\xC3\xA9\xE3\x81\x82\xF0\x9F\x98\x80");
+	if (sizeof(wchar_t) == 2) {
+		EXPECT_EQ(std::wstring(L"\x00E9\x3042\xD83D\xDE00"), decoded);
+	} else {
+		EXPECT_EQ(std::wstring(1, wchar_t(0xE9)) + wchar_t(0x3042)
+					  + wchar_t(0x1F600),
+				  decoded);
+	}
+}
+
+TEST(TranscoderTest, invalid_utf8_should_be_replaced) {
+	const wchar_t R = static_cast< wchar_t >(0xFFFD);
+	// a stray trail byte, an overlong form and a truncated sequence
+	EXPECT_EQ(std::wstring(1, R) + L'a', decode("\x80" "a"));
+	EXPECT_EQ(std::wstring(2, R), decode("\xC0\xAF"));
+	EXPECT_EQ(std::wstring(2, R) + L'b', decode("\xE3\x81" "b"));
+	// an encoded surrogate
+	EXPECT_EQ(std::wstring(3, R), decode("\xED\xA0\x80"));
+}
+
+TEST(TranscoderTest, wchar_t_should_be_encoded) {
+	EXPECT_EQ(std::string("abc"), encode(L"abc"));
+	EXPECT_EQ(std::string("\xC3\xA9\xE3\x81\x82\xF0\x9F\x98\x80"),
+			  encode(decode("\xC3\xA9\xE3\x81\x82\xF0\x9F\x98\x80")));
+	// a lone surrogate
+	EXPECT_EQ(std::string("\xEF\xBF\xBD" "a"),
+			  encode(std::wstring(1, static_cast< wchar_t >(0xD800)) + L'a'));
+}
+
+TEST(TranscoderTest, wchar_t_parser_should_parse_utf8_arguments) {
+	typedef Options< wchar_t > Opt;
+	optparse::OptionParserBase< Opt, wchar_t, optparse::DefaultFormatter >
+		parser(L"test program");
+	configure(parser, L"-n", L"--name", L"X");
+	const std::string longInput(300, 'x');
+	const char* const ARGS[] = {
+		"test\xC3\xA9.exe", "-n", "12", "--name=\xE3\x81\x82",
+		longInput.c_str()
+	};
+	const Opt options = parser.parseTranscoded(5, ARGS);
+	EXPECT_EQ(L"test\x00E9.exe", parser.getProgramName());
+	EXPECT_EQ(12, options.n);
+	EXPECT_EQ(L"\x3042", options.name);
+	EXPECT_EQ(std::wstring(300, L'x'), options.input);
+	// the result is pinned
+	const char* const BAD[] = { "test.exe", "-n", "\xC3\xA9" };
+	Opt bad;
+	std::wstring programName;
+	const optparse::ParseResult< wchar_t > result =
+		parser.tryParseTranscoded(bad, 3, BAD, programName);
+	EXPECT_EQ(optparse::ParseResult< wchar_t >::BAD_VALUE, result.getKind());
+	EXPECT_EQ(2, result.getArgIndex());
+	EXPECT_EQ(L"\x00E9", result.getValue().str());
+	EXPECT_EQ(L"test.exe", programName);
+}
+
+TEST(TranscoderTest, char_parser_should_parse_wchar_t_arguments) {
+	typedef Options< char > Opt;
+	optparse::OptionParserBase< Opt, char, optparse::DefaultFormatter >
+		parser("test program");
+	configure(parser, "-n", "--name", "X");
+	const wchar_t* const ARGS[] = {
+		L"test.exe", L"--name", L"\x3042", L"-n", L"3", L"in"
+	};
+	const Opt options = parser.parseTranscoded(6, ARGS);
+	EXPECT_EQ(3, options.n);
+	EXPECT_EQ("\xE3\x81\x82", options.name);
+	EXPECT_EQ("in", options.input);
+	const wchar_t* const UNKNOWN[] = { L"test.exe", L"--nam\x00E9" };
+	EXPECT_THROW(parser.parseTranscoded(2, UNKNOWN),
+				 optparse::UnknownOption< char >);
+}
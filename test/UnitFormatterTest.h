@@ -0,0 +1,93 @@
+// This file provides tests for DurationFormatter and ByteSizeFormatter
+// regardless of character type.
+// You need to define the followings before including this header,
+//  - Ch: character type
+//  - String: string type of Ch. must be compatible with std::basic_string
+//  - STR(str): macro to create a character and string literal
+//  - PREFIX(name): macro which prefixes a test case name to avoid conflict
+//
+
+#include "optparse/DefaultFormatter.h"
+#include "optparse/UnitFormatter.h"
+
+#include <chrono>
+#include <string>
+#include "gtest/gtest.h"
+
+TEST(PREFIX(UnitFormatterTest), durations_should_be_converted) {
+	const optparse::DefaultFormatter< std::chrono::nanoseconds, Ch > ns;
+	EXPECT_EQ(10000000, ns(STR("10ms")).count());
+	EXPECT_EQ(5, ns(STR("5ns")).count());
+	EXPECT_EQ(2500, ns(STR("2.5us")).count());
+	EXPECT_EQ(-3000000000LL, ns(STR("-3s")).count());
+	EXPECT_EQ(7200000000000LL, ns(STR("2h")).count());
+	EXPECT_EQ(42, ns(STR("42")).count());
+	const optparse::DefaultFormatter< std::chrono::seconds, Ch > s;
+	EXPECT_EQ(90, s(STR("1.5m")).count());
+	EXPECT_EQ(120, s(STR("2min")).count());
+	EXPECT_EQ(86400, s(STR("1d")).count());
+	EXPECT_EQ(2, s(STR("2000ms")).count());
+	EXPECT_EQ(0, s(STR("0.0ns")).count());
+	const optparse::DefaultFormatter< std::chrono::hours, Ch > h;
+	EXPECT_EQ(2, h(STR("7200s")).count());
+	const optparse::DefaultFormatter<
+		std::chrono::duration< double >, Ch > seconds;
+	EXPECT_DOUBLE_EQ(0.0015, seconds(STR("1.5ms")).count());
+	EXPECT_DOUBLE_EQ(-120.0, seconds(STR("-2m")).count());
+}
+
+TEST(PREFIX(UnitFormatterTest), invalid_durations_should_be_rejected) {
+	const optparse::DefaultFormatter< std::chrono::seconds, Ch > s;
+	std::chrono::seconds value(7);
+	const char* message = "";
+	EXPECT_FALSE(s.tryFormat(STR("1.5s"), value, message));
+	EXPECT_EQ(std::string("inexact value"), message);
+	EXPECT_FALSE(s.tryFormat(STR("10ks"), value, message));
+	EXPECT_EQ(std::string("unknown unit"), message);
+	EXPECT_FALSE(s.tryFormat(STR("ms"), value, message));
+	EXPECT_EQ(std::string("invalid number"), message);
+	EXPECT_FALSE(s.tryFormat(STR(""), value, message));
+	EXPECT_FALSE(s.tryFormat(STR("1."), value, message));
+	EXPECT_FALSE(s.tryFormat(STR(".5s"), value, message));
+	EXPECT_FALSE(s.tryFormat(STR("1s "), value, message));
+	EXPECT_EQ(7, value.count());
+	const optparse::DefaultFormatter<
+		std::chrono::duration< int, std::milli >, Ch > ms;
+	std::chrono::duration< int, std::milli > small(0);
+	EXPECT_FALSE(ms.tryFormat(STR("30d"), small, message));
+	EXPECT_EQ(std::string("out of range"), message);
+	EXPECT_TRUE(ms.tryFormat(STR("-2147483648ms"), small, message));
+	EXPECT_FALSE(ms.tryFormat(STR("-2147483649ms"), small, message));
+	const optparse::DefaultFormatter<
+		std::chrono::duration< unsigned, std::milli >, Ch > unsignedMs;
+	std::chrono::duration< unsigned, std::milli > unsignedValue(0);
+	EXPECT_FALSE(unsignedMs.tryFormat(STR("-1ms"), unsignedValue, message));
+	EXPECT_THROW(s(STR("1x")), optparse::BadValue< Ch >);
+}
+
+TEST(PREFIX(UnitFormatterTest), byte_sizes_should_be_converted) {
+	typedef optparse::ByteSize ByteSize;
+	const optparse::DefaultFormatter< ByteSize, Ch > format;
+	EXPECT_EQ(ByteSize(123), format(STR("123")));
+	EXPECT_EQ(ByteSize(123), format(STR("123B")));
+	EXPECT_EQ(ByteSize(4096), format(STR("4KiB")));
+	EXPECT_EQ(ByteSize(4096), format(STR("4K")));
+	EXPECT_EQ(ByteSize(4096), format(STR("4k")));
+	EXPECT_EQ(ByteSize(4000), format(STR("4KB")));
+	EXPECT_EQ(ByteSize(1536), format(STR("1.5KiB")));
+	EXPECT_EQ(ByteSize(3ULL << 30), format(STR("3GiB")));
+	EXPECT_EQ(ByteSize(2000000000000ULL), format(STR("2TB")));
+	EXPECT_EQ(ByteSize(1ULL << 60), format(STR("1EiB")));
+	ByteSize value(1);
+	const char* message = "";
+	EXPECT_FALSE(format.tryFormat(STR("1.5B"), value, message));
+	EXPECT_EQ(std::string("inexact value"), message);
+	EXPECT_FALSE(format.tryFormat(STR("16EiB"), value, message));
+	EXPECT_EQ(std::string("out of range"), message);
+	EXPECT_FALSE(format.tryFormat(STR("-1K"), value, message));
+	EXPECT_FALSE(format.tryFormat(STR("1Ki"), value, message));
+	EXPECT_EQ(std::string("unknown unit"), message);
+	EXPECT_FALSE(format.tryFormat(STR("1KIB"), value, message));
+	EXPECT_FALSE(format.tryFormat(STR("1b"), value, message));
+	EXPECT_EQ(ByteSize(1), value);
+}
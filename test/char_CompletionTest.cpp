@@ -0,0 +1,8 @@
+#include <string>
+
+typedef char Ch;
+typedef std::string String;
+#define STR(str)  str
+#define PREFIX(name)  char_ ## name
+
+#include "CompletionTest.h"